@@ -12,7 +12,13 @@ namespace Alpaca
     int close_all_positions();
     int order_market(const char *symbol, float notional, const char *side);
     int order_limit(const char *symbol, int qty, float limit_price, const char *side);
+    int order_bracket(const char *symbol, int qty, const char *side, float take_profit, float stop_loss);
+    int order_oco(const char *symbol, int qty, const char *side, float take_profit, float stop_loss);
+    int order_trailing_stop(const char *symbol, int qty, const char *side, float trail_percent);
     bool has_position_in(const char *symbol);
     bool has_order_for(const char *symbol);
     int cancel_orders_for(const char *symbol);
+    // Sends every request to url instead of the paper API, e.g. the local stand-in in
+    // test/alpaca_standin.py; a null ca_cert talks plain HTTP.
+    void set_base_url(const char *url, const char *ca_cert);
 }
\ No newline at end of file
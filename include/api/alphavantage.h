@@ -17,6 +17,9 @@ namespace AlphaVantage
     DynamicJsonDocument quote(const char *symbol);
     DynamicJsonDocument sma(const char *symbol, const char *interval, const char *time_period, const char *series_type);
     DynamicJsonDocument market_open();
-    std::vector<TimeSeries> hourly(const char *symbol);
-    std::vector<TimeSeries> daily(const char *symbol);
+    // bars is the history needed, 0 for the whole compact window. Requests are always
+    // compact, so bars over its 100 are capped there with a warning; the result is
+    // trimmed to bars.
+    std::vector<TimeSeries> hourly(const char *symbol, int bars = 0);
+    std::vector<TimeSeries> daily(const char *symbol, int bars = 0);
 }
\ No newline at end of file
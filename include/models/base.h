@@ -7,7 +7,6 @@ namespace Base
 {
 
     float typical_price(float high, float low, float close);
-    std::vector<float> typical_prices(std::vector<AlphaVantage::TimeSeries> ts);
-    float slope_from_prices(std::vector<float> &prices, int period);
+    std::vector<float> typical_prices(const std::vector<AlphaVantage::TimeSeries> &ts);
     Logic::Decision decision_with_position(Logic::Decision decision, Logic::Position position);
 }
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#include <vector>
+
+namespace Batch
+{
+    // Prices for many symbols laid out time-major with the symbols interleaved, so
+    // row(t) holds every symbol's value at step t and the indicators below advance
+    // all symbols per step in SIMD lanes. Outputs start at each indicator's ta-lib
+    // lookback, like the single-symbol TA wrappers.
+    struct Matrix
+    {
+        int symbols{0};
+        int steps{0};
+        std::vector<float> values;
+
+        void resize(int symbols_, int steps_);
+        float *row(int t) { return values.data() + t * symbols; }
+        const float *row(int t) const { return values.data() + t * symbols; }
+        float &at(int t, int symbol) { return values[t * symbols + symbol]; }
+        float at(int t, int symbol) const { return values[t * symbols + symbol]; }
+    };
+
+    // Interleaves per-symbol series that end on the same bar, keeping the shortest length.
+    Matrix interleave(const std::vector<std::vector<float>> &series);
+
+    int EMA(const Matrix &prices, int period, Matrix &out);
+    int RSI(const Matrix &prices, int period, Matrix &out);
+    int MACD(const Matrix &prices, int fastPeriod, int slowPeriod, int signalPeriod, Matrix &outMACD, Matrix &outMACDSignal, Matrix &outMACDHist);
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include "api/alphavantage.h"
+#include <vector>
+#include <stdint.h>
+
+namespace Candles
+{
+    // The 61 ta-lib candlestick patterns, in TA_CDL* order. Each one's bit in Signals
+    // is 1 << its value.
+    enum class Pattern
+    {
+        CDL2CROWS,
+        CDL3BLACKCROWS,
+        CDL3INSIDE,
+        CDL3LINESTRIKE,
+        CDL3OUTSIDE,
+        CDL3STARSINSOUTH,
+        CDL3WHITESOLDIERS,
+        CDLABANDONEDBABY,
+        CDLADVANCEBLOCK,
+        CDLBELTHOLD,
+        CDLBREAKAWAY,
+        CDLCLOSINGMARUBOZU,
+        CDLCONCEALBABYSWALL,
+        CDLCOUNTERATTACK,
+        CDLDARKCLOUDCOVER,
+        CDLDOJI,
+        CDLDOJISTAR,
+        CDLDRAGONFLYDOJI,
+        CDLENGULFING,
+        CDLEVENINGDOJISTAR,
+        CDLEVENINGSTAR,
+        CDLGAPSIDESIDEWHITE,
+        CDLGRAVESTONEDOJI,
+        CDLHAMMER,
+        CDLHANGINGMAN,
+        CDLHARAMI,
+        CDLHARAMICROSS,
+        CDLHIGHWAVE,
+        CDLHIKKAKE,
+        CDLHIKKAKEMOD,
+        CDLHOMINGPIGEON,
+        CDLIDENTICAL3CROWS,
+        CDLINNECK,
+        CDLINVERTEDHAMMER,
+        CDLKICKING,
+        CDLKICKINGBYLENGTH,
+        CDLLADDERBOTTOM,
+        CDLLONGLEGGEDDOJI,
+        CDLLONGLINE,
+        CDLMARUBOZU,
+        CDLMATCHINGLOW,
+        CDLMATHOLD,
+        CDLMORNINGDOJISTAR,
+        CDLMORNINGSTAR,
+        CDLONNECK,
+        CDLPIERCING,
+        CDLRICKSHAWMAN,
+        CDLRISEFALL3METHODS,
+        CDLSEPARATINGLINES,
+        CDLSHOOTINGSTAR,
+        CDLSHORTLINE,
+        CDLSPINNINGTOP,
+        CDLSTALLEDPATTERN,
+        CDLSTICKSANDWICH,
+        CDLTAKURI,
+        CDLTASUKIGAP,
+        CDLTHRUSTING,
+        CDLTRISTAR,
+        CDLUNIQUE3RIVER,
+        CDLUPSIDEGAP2CROWS,
+        CDLXSIDEGAP3METHODS
+    };
+
+    const int pattern_count{61};
+
+    const char *name(Pattern pattern);
+
+    // Bars a pattern needs before its first signal, as TA_CDL*_Lookback reports it
+    // for the default candle settings.
+    int lookback(Pattern pattern);
+
+    // Every pattern's result for one bar. found has a bit per pattern that fired,
+    // bullish marks the ones ta-lib reports as positive, and confirmed marks hikkake
+    // breakouts (ta-lib's +-200).
+    struct Signals
+    {
+        uint64_t found{0};
+        uint64_t bullish{0};
+        uint64_t confirmed{0};
+
+        bool has(Pattern pattern) const;
+
+        // The TA_CDL* output for pattern: 0, +-100, or +-200 for a confirmed hikkake.
+        int value(Pattern pattern) const;
+    };
+
+    // Features of one bar shared by every pattern: body and shadow lengths, colour,
+    // the candle-setting averages (ta-lib's TA_CANDLEAVERAGE) over the bars before
+    // it, and shape bits for the comparisons against those averages. Kept in double
+    // so thresholds match the double ta-lib functions.
+    struct Candle
+    {
+        double open;
+        double high;
+        double low;
+        double close;
+        double body;
+        double upper;
+        double lower;
+        double range;
+        int color;
+        double average[11];
+        uint32_t shape;
+    };
+
+    // Evaluates all 61 patterns for each new bar in one pass. Per-bar features,
+    // averages and shape bits are computed once and read by every pattern, instead of
+    // each TA_CDL* call redoing its own double-precision running sums and
+    // comparisons. Signals match the ta-lib functions run over the same history from
+    // its first bar. Only ta-lib's default candle settings are supported: the
+    // averages are built for their 10- and 5-bar periods and factors, so
+    // TA_SetCandleSettings has no effect here.
+    class Scanner
+    {
+    public:
+        Signals update(float open, float high, float low, float close);
+        void reset();
+        int count() const { return seen; }
+
+    private:
+        // ta-lib's hikkake state: the last inside-bar breakout and the bar before it,
+        // whose high or low a close has to clear within three bars to confirm it.
+        struct Hikkake
+        {
+            int index{0};
+            int result{0};
+            double high{0};
+            double low{0};
+        };
+
+        static const int depth{16};
+
+        const Candle &back(int offset) const { return bars[(seen - 1 - offset) & (depth - 1)]; }
+        int hikkake(Hikkake &state, bool detected);
+
+        Candle bars[depth];
+        int seen{0};
+        Hikkake plain;
+        Hikkake modified;
+    };
+
+    void scan(const float *open, const float *high, const float *low, const float *close, int size, std::vector<Signals> &out);
+    void scan(const std::vector<AlphaVantage::TimeSeries> &bars, std::vector<Signals> &out);
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "api/alphavantage.h"
+#include <vector>
+
+namespace Fill
+{
+    struct Bars
+    {
+        std::vector<float> open;
+        std::vector<float> high;
+        std::vector<float> low;
+        std::vector<float> close;
+        std::vector<float> volume;
+
+        int size() const { return close.size(); }
+    };
+
+    struct Orders
+    {
+        std::vector<int> bar;      // bar the order was decided on, fills start at bar + 1
+        std::vector<float> qty;    // shares, always positive
+        std::vector<float> side;   // +1 buy, -1 sell
+        std::vector<float> limit;  // limit price, 0 for market orders
+
+        int size() const { return bar.size(); }
+        void add(int bar_, float qty_, float side_, float limit_ = 0);
+    };
+
+    struct Fills
+    {
+        std::vector<int> order;
+        std::vector<int> bar;
+        std::vector<float> qty;
+        std::vector<float> price;
+
+        int size() const { return order.size(); }
+        void clear();
+    };
+
+    // Writes the reference fill price for every order into out_price, indexed like orders.
+    typedef void (*PriceModel)(const Bars &bars, const Orders &orders, float *out_price);
+
+    void next_bar_open(const Bars &bars, const Orders &orders, float *out_price);
+    // The next bar's (open + high + low + close) / 4. A bar carries one volume for all
+    // its prices, so this is the nearest to its VWAP the bars allow.
+    void bar_ohlc4(const Bars &bars, const Orders &orders, float *out_price);
+
+    struct Config
+    {
+        PriceModel model;
+        float half_spread;       // fraction of price paid to cross the spread
+        float impact;            // fraction of price per sqrt(qty / bar volume)
+        float max_participation; // share of a bar's volume a resting limit order can take
+        int limit_lifetime;      // bars a limit order rests before it is cancelled
+    };
+
+    const Config default_config{next_bar_open, 0.0002, 0.1, 0.1, 1};
+
+    Bars columns(const std::vector<AlphaVantage::TimeSeries> &ts);
+    void apply_slippage(const Bars &bars, const Orders &orders, Config config, float *inout_price);
+    void simulate(const Bars &bars, const Orders &orders, Config config, Fills &fills);
+}
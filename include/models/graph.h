@@ -0,0 +1,68 @@
+#pragma once
+#include "api/alphavantage.h"
+#include <vector>
+
+namespace Graph
+{
+    typedef int Node;
+
+    enum class Kind
+    {
+        TYPICAL,
+        RSI,
+        EMA,
+        MACD,
+        MACD_SIGNAL,
+        MACD_HIST
+    };
+
+    // A bar series plus the indicators declared on it. Declaring the same indicator
+    // twice returns the same node, and every node is computed at most once per
+    // evaluate(), so strategies can share typical prices, RSI and MACD outputs.
+    class Frame
+    {
+    public:
+        Node typical();
+        Node rsi(Node input, int period);
+        Node ema(Node input, int period);
+        Node macd(Node input, int fast, int slow, int signal);
+        Node macd_signal(Node input, int fast, int slow, int signal);
+        Node macd_hist(Node input, int fast, int slow, int signal);
+
+        // Declares that only the last count values of node are read. In tail-only mode
+        // each node is then computed over just the bars its consumers need, and
+        // history() reports how many bars the data layer has to fetch (0 = everything).
+        // The tails are only close to a full computation with an unstable period set
+        // (TA::set_unstable_period), and history() is 0 until the first evaluation.
+        void require(Node node, int count);
+        void set_tail_only(bool enabled);
+        int history();
+
+        void evaluate(std::vector<AlphaVantage::TimeSeries> ts);
+        const std::vector<float> &values(Node node);
+        float last(Node node);
+        float slope(Node node, int period);
+
+    private:
+        struct Definition
+        {
+            Kind kind;
+            Node input;
+            int a;
+            int b;
+            int c;
+        };
+
+        Node declare(Kind kind, Node input, int a = 0, int b = 0, int c = 0);
+        int lookback(Node node);
+        void compute(Node node);
+
+        bool tail_only{false};
+
+        std::vector<AlphaVantage::TimeSeries> bars;
+        std::vector<Definition> definitions;
+        std::vector<std::vector<float>> outputs;
+        std::vector<bool> fresh;
+        std::vector<int> needed;
+    };
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+namespace Kernels
+{
+    // Host-side array kernels for backtests. Each one picks AVX2 or NEON at runtime
+    // when available and falls back to the scalar loop elsewhere (including the ESP32).
+    // Functions returning int give the number of outputs written, ta-lib style: the
+    // first output lines up with input index period - 1 (period for rolling_slope and
+    // rsi_many).
+
+    bool has_avx2();
+    // SIMD is on by default where available; turning it off runs the scalar loops,
+    // so the two paths can be compared on the same machine.
+    void set_simd(bool enabled);
+
+    void typical_prices(const float *high, const float *low, const float *close, int size, float *out);
+    // The SIMD rolling sums carry float partial sums through blocks of 1024 outputs,
+    // so they drift by a few ulps of the window sum before each restart: sma stays
+    // within 1e-5 of the price level of TA_SMA, the scalar loop within 1e-6.
+    int rolling_sum(const float *in, int size, int period, float *out);
+    int sma(const float *in, int size, int period, float *out);
+    // Regression slope of each period + 1 values (Rolling::slope), scalar only.
+    int rolling_slope(const float *in, int size, int period, float *out);
+
+    // EMA of many series at once. in and out are time-major with the series
+    // interleaved, in[t * series + s], so each time step is one contiguous row.
+    int ema_many(const float *in, int series, int size, int period, float *out);
+    // RSI of many series at once, laid out like ema_many. The SIMD paths need AVX2 or
+    // AArch64 NEON (for its division); 32-bit NEON runs the scalar loop.
+    int rsi_many(const float *in, int series, int size, int period, float *out);
+}
@@ -1,9 +1,39 @@
 #pragma once
 #include "models/logic.h"
+#include "models/graph.h"
+#include "models/strategy.h"
 
 namespace MACD
 {
-    Logic::Trend hourly_macd_look(const char *symbol);
-    Logic::Trend daily_macd_look(const char *symbol);
-    Logic::Trend trend(const char *symbol);
+    // What a look decides on: the latest MACD, signal and histogram and their slopes
+    // over the timeframe's slope period. ready is false until there are enough values.
+    struct Reading
+    {
+        bool ready;
+        float macd;
+        float signal;
+        float hist;
+        float macd_slope;
+        float signal_slope;
+        float hist_slope;
+    };
+
+    template <typename Config>
+    Reading hourly_macd_reading(Graph::Frame &frame);
+    template <typename Config>
+    Reading daily_macd_reading(Graph::Frame &frame);
+
+    template <typename Config>
+    Logic::Trend hourly_macd_look(const Reading &reading);
+    template <typename Config>
+    Logic::Trend daily_macd_look(const Reading &reading);
+    template <typename Config>
+    Logic::Trend hourly_macd_look(Graph::Frame &frame);
+    template <typename Config>
+    Logic::Trend daily_macd_look(Graph::Frame &frame);
+    // Instantiated in the .cpp for each Strategy variant; add new variants there.
+    template <typename Config = Strategy::DefaultMACD>
+    Logic::Trend trend(const Reading &hourly, const Reading &daily);
+    template <typename Config = Strategy::DefaultMACD>
+    Logic::Trend trend(Graph::Frame &hourly_frame, Graph::Frame &daily_frame);
 }
\ No newline at end of file
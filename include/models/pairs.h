@@ -0,0 +1,34 @@
+#pragma once
+#include "models/batch.h"
+#include <vector>
+
+namespace Pairs
+{
+    // TA_BETA's per-bar returns, (p[t] - p[t-1]) / p[t-1] or 0 when p[t-1] is 0, for
+    // every symbol of prices. One step shorter than prices; row t is the return into
+    // step t + 1.
+    void returns(const Batch::Matrix &prices, Batch::Matrix &out);
+
+    // Correlation and beta of every pair of symbols over all the steps of a returns
+    // matrix. correlation(i, j) is TA_CORREL of the two columns and beta(i, j) is
+    // TA_BETA with symbol i as the market and j as the asset (the slope of j's returns
+    // on i's), both with a period covering every step. Both are 0 when i's (or, for
+    // the correlation, j's) variance is 0, as in ta-lib.
+    struct Matrix
+    {
+        int symbols{0};
+        std::vector<float> correlations;
+        std::vector<float> betas;
+
+        void resize(int symbols_);
+        float correlation(int i, int j) const { return correlations[i * symbols + j]; }
+        float beta(int i, int j) const { return betas[i * symbols + j]; }
+    };
+
+    // Centres each return column on its mean, then accumulates the co-moments of
+    // every pair tile by tile: a tile's block of accumulators stays in L1 while the
+    // steps stream past, each step's slice of a row feeding all of the tile's pairs.
+    // Tiles on and above the diagonal are shared out between threads (0 for one per
+    // core). Returns false when returns has fewer than two steps.
+    bool matrix(const Batch::Matrix &returns, Matrix &out, int threads = 0);
+}
@@ -0,0 +1,164 @@
+#pragma once
+#include <vector>
+
+namespace Rolling
+{
+    // Running means, variances and co-moment of (x, y) pairs. add() and remove() are
+    // Welford's updates: they work on deviations from the running means rather than
+    // on raw sums of squares, so float keeps its precision when the values are large
+    // next to their spread (prices) and removing old values doesn't cancel it away.
+    // Variances are population ones, like TA_VAR.
+    class Moments
+    {
+    public:
+        void add(float x, float y);
+        void remove(float x, float y);
+        // Moves every x seen by dx, which leaves the spreads unchanged.
+        void shift(float dx) { mx += dx; }
+        void clear();
+
+        int count() const { return n; }
+        float mean_x() const { return mx; }
+        float mean_y() const { return my; }
+        float variance_x() const;
+        float variance_y() const;
+        float covariance() const;
+        // Least squares line of y on x, its intercept taken at x = 0.
+        float slope() const;
+        float intercept() const;
+        float correlation() const;
+
+    private:
+        int n{0};
+        float mx{0};
+        float my{0};
+        float sxx{0};
+        float syy{0};
+        float sxy{0};
+    };
+
+    // The last period values of a series, each update O(1). x is a value's position in
+    // the window, 0 for the oldest, as in TA_LINEARREG_SLOPE and TA_LINEARREG_INTERCEPT.
+    class Series
+    {
+    public:
+        Series(int period);
+        bool update(float value);
+        bool ready() const { return filled == period; }
+        void reset();
+
+        int size() const { return filled; }
+        // The i-th oldest value in the window.
+        float at(int i) const;
+
+        float mean() const;
+        float variance() const { return moments.variance_y(); }
+        float stddev() const;
+        float slope() const { return moments.slope(); }
+        float intercept() const;
+        // The regression line at the newest value, as TA_LINEARREG.
+        float linearreg() const;
+
+    private:
+        void rebuild();
+
+        int period;
+        std::vector<float> ring;
+        int head{0};
+        int filled{0};
+        int updates{0};
+        float origin{0};
+        Moments moments;
+    };
+
+    // The last period (x, y) pairs of two series updated together.
+    class Pair
+    {
+    public:
+        Pair(int period);
+        bool update(float x, float y);
+        bool ready() const { return filled == period; }
+        void reset();
+
+        float covariance() const { return moments.covariance(); }
+        float correlation() const { return moments.correlation(); }
+        // Slope of y on x; TA_BETA's beta when x and y are the two return series.
+        float beta() const { return moments.slope(); }
+
+    private:
+        void rebuild();
+
+        int period;
+        std::vector<float> ring_x;
+        std::vector<float> ring_y;
+        int head{0};
+        int filled{0};
+        int updates{0};
+        float origin_x{0};
+        float origin_y{0};
+        Moments moments;
+    };
+
+    // Welford's updates still round a little each time, mostly in the running means.
+    // The windows keep their values relative to an origin near their mean so those
+    // means stay small, and every rebuild_windows windows' worth of updates replay the
+    // window from its values around a fresh origin, so neither the rounding nor the
+    // distance to the origin builds up over long runs. That costs one extra add per
+    // rebuild_windows updates.
+    const int rebuild_windows{8};
+
+    // Calls emit(n, mean, variance) for each period-wide window of in, n counting from
+    // the first full one, and returns the number of windows. The same updates as
+    // Series, read straight from the caller's array, so nothing is allocated.
+    template <typename Emit>
+    int windows(const float *in, int size, int period, Emit emit)
+    {
+        if (period < 1 || size < period)
+        {
+            return 0;
+        }
+
+        Moments moments;
+        float origin{in[0]};
+        int updates{0};
+        int n{0};
+        for (int i = 0; i < size; i++)
+        {
+            if (i >= period)
+            {
+                moments.remove(0, in[i - period] - origin);
+            }
+            moments.add(0, in[i] - origin);
+
+            if (++updates == rebuild_windows * period)
+            {
+                origin += moments.mean_y();
+                moments.clear();
+                for (int j = i - period + 1; j <= i; j++)
+                {
+                    moments.add(0, in[j] - origin);
+                }
+                updates = 0;
+            }
+            if (i >= period - 1)
+            {
+                emit(n++, origin + moments.mean_y(), moments.variance_y());
+            }
+        }
+        return n;
+    }
+
+    // Least squares slope of count values against their position, the per-bar trend
+    // the strategies read.
+    float slope(const float *values, int count);
+
+    // Array versions over columnar bars. As in ta-lib, out[0] lines up with input index
+    // period - 1 and the return value is the number of outputs written.
+    int variance(const float *in, int size, int period, float *out);
+    int stddev(const float *in, int size, int period, float *out);
+    int slope(const float *in, int size, int period, float *out);
+    int intercept(const float *in, int size, int period, float *out);
+    int linearreg(const float *in, int size, int period, float *out);
+    int correlation(const float *x, const float *y, int size, int period, float *out);
+    int beta(const float *x, const float *y, int size, int period, float *out);
+}
@@ -1,9 +1,36 @@
 #pragma once
 #include "logic.h"
+#include "models/graph.h"
+#include "models/strategy.h"
 
 namespace RSI
 {
-    Logic::Trend hourly_rsi_look(const char *symbol);
-    Logic::Trend daily_rsi_look(const char *symbol);
-    Logic::Trend trend(const char *symbol);
+    // What a look decides on: the latest RSI and EMA(RSI) and their slopes over the
+    // last Config::slope_period + 1 values. ready is false until there are that many.
+    struct Reading
+    {
+        bool ready;
+        float rsi;
+        float rsi_ema;
+        float rsi_slope;
+        float rsi_ema_slope;
+    };
+
+    // Declares the nodes on frame and reads them; both timeframes use the same windows.
+    template <typename Config>
+    Reading rsi_reading(Graph::Frame &frame);
+
+    template <typename Config>
+    Logic::Trend hourly_rsi_look(const Reading &reading);
+    template <typename Config>
+    Logic::Trend daily_rsi_look(const Reading &reading);
+    template <typename Config>
+    Logic::Trend hourly_rsi_look(Graph::Frame &frame);
+    template <typename Config>
+    Logic::Trend daily_rsi_look(Graph::Frame &frame);
+    // Instantiated in the .cpp for each Strategy variant; add new variants there.
+    template <typename Config = Strategy::DefaultRSI>
+    Logic::Trend trend(const Reading &hourly, const Reading &daily);
+    template <typename Config = Strategy::DefaultRSI>
+    Logic::Trend trend(Graph::Frame &hourly_frame, Graph::Frame &daily_frame);
 }
\ No newline at end of file
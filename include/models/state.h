@@ -0,0 +1,28 @@
+#pragma once
+#include "api/alphavantage.h"
+#include "models/stream.h"
+#include <vector>
+
+namespace State
+{
+    // The last bar folded into a snapshot. After a reset it is looked up in a fresh
+    // compact fetch so only the bars after it are fed to the restored indicators.
+    struct Mark
+    {
+        float open;
+        float high;
+        float low;
+        float close;
+    };
+
+    Mark mark(const AlphaVantage::TimeSeries &bar);
+
+    // Index of the first bar after mark, or -1 if mark isn't in bars and the
+    // indicators have to be rebuilt from the full history.
+    int resume_from(const std::vector<AlphaVantage::TimeSeries> &bars, const Mark &mark);
+
+    // Snapshots live in the "state" NVS namespace under key (at most 15 characters).
+    bool save(const char *key, const Stream::Snapshot &snapshot, const Mark &mark);
+    bool load(const char *key, Stream::Snapshot &snapshot, Mark &mark);
+    void forget(const char *key);
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <vector>
+#include "models/rolling.h"
+#include "models/ta.h"
+
+namespace Strategy
+{
+    // Largest lookback a strategy may ask the data layer for; AlphaVantage answers
+    // anything up to this from a compact request, and the TA scratch arena is sized
+    // for it.
+    const int max_history{TA_MAX_BARS};
+
+    // Exit legs sent with every entry, as fractions of the entry price. Alpaca works
+    // them server-side, so stops don't wait for the next run.
+    const float take_profit{0.04f};
+    const float stop_loss{0.02f};
+
+    // The unstable period setup() passes to TA::set_unstable_period().
+    const int unstable_period{TA_UNSTABLE_PERIOD};
+
+    // Strategy parameters as template arguments, so each variant compiles into its own
+    // specialized looks and several variants can be linked side by side. Float
+    // thresholds are passed in hundredths since they can't be template arguments.
+    // history is a compile-time bound only: the bars a variant needs before its look
+    // is ready, checked against max_history. Nothing fetches by it; Trade folds in
+    // whole compact windows and the indicator streams say when they are ready.
+    template <int Period, int SlopePeriod, int Oversold, int Overbought, int FlatBufferHundredths>
+    struct RSI
+    {
+        static constexpr int period{Period};
+        static constexpr int slope_period{SlopePeriod};
+        static constexpr int oversold{Oversold};
+        static constexpr int overbought{Overbought};
+        static constexpr float flat_buffer{FlatBufferHundredths / 100.0f};
+
+        // RSI, then EMA(RSI), then the slope window.
+        static constexpr int history{(Period + unstable_period) + (Period - 1 + unstable_period) + SlopePeriod + 1};
+        static_assert(history <= max_history, "RSI variant needs more bars than a compact request returns");
+    };
+
+    template <int FastPeriod, int SlowPeriod, int SignalPeriod, int HourlySlopePeriod, int DailySlopePeriod, int Overbought, int FlatBufferHundredths>
+    struct MACD
+    {
+        static constexpr int fast_period{FastPeriod};
+        static constexpr int slow_period{SlowPeriod};
+        static constexpr int signal_period{SignalPeriod};
+        static constexpr int hourly_slope_period{HourlySlopePeriod};
+        static constexpr int daily_slope_period{DailySlopePeriod};
+        static constexpr int overbought{Overbought};
+        static constexpr float flat_buffer{FlatBufferHundredths / 100.0f};
+
+        static constexpr int slope_period{HourlySlopePeriod > DailySlopePeriod ? HourlySlopePeriod : DailySlopePeriod};
+        static constexpr int history{(SlowPeriod - 1 + unstable_period) + (SignalPeriod - 1 + unstable_period) + slope_period + 1};
+        static_assert(FastPeriod < SlowPeriod, "MACD fast period must be shorter than the slow period");
+        static_assert(history <= max_history, "MACD variant needs more bars than a compact request returns");
+    };
+
+    typedef RSI<14, 7, 30, 70, 25> DefaultRSI;
+    typedef RSI<9, 4, 30, 70, 25> FastRSI;
+    typedef MACD<12, 26, 9, 6, 12, 2, 20> DefaultMACD;
+    typedef MACD<8, 17, 9, 4, 8, 2, 20> FastMACD;
+
+    // The last Count values of a series in a stack buffer, so a look's slope and
+    // current value come from a window sized at compile time.
+    template <int Count>
+    struct Window
+    {
+        float values[Count];
+
+        // False, leaving values as they were, when series has fewer than Count values.
+        bool fill(const std::vector<float> &series)
+        {
+            const int offset{static_cast<int>(series.size()) - Count};
+            if (offset < 0)
+            {
+                return false;
+            }
+            for (int i = 0; i < Count; i++)
+            {
+                values[i] = series[offset + i];
+            }
+            return true;
+        }
+
+        float last() const
+        {
+            return values[Count - 1];
+        }
+
+        // Least squares slope per bar, as Graph::Frame::slope over Count - 1 periods.
+        float slope() const
+        {
+            return Rolling::slope(values, Count);
+        }
+    };
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include <string.h>
+#include "models/rolling.h"
+
+namespace Stream
+{
+    // Incremental indicators fed one bar at a time. Each update is O(1) and, once
+    // warmed up, tracks the matching ta-lib batch output for the same history.
+
+    // Raw byte image of indicator state. save() appends to it and restore() reads it
+    // back in the same order; restore fails if the recorded periods don't match the
+    // object's, so a changed strategy config falls back to a full rebuild. A failed
+    // restore leaves the object exactly as it was.
+    class Snapshot
+    {
+    public:
+        template <typename T>
+        void put(const T &value)
+        {
+            const uint8_t *raw{reinterpret_cast<const uint8_t *>(&value)};
+            bytes.insert(bytes.end(), raw, raw + sizeof(T));
+        }
+
+        template <typename T>
+        bool get(T &value)
+        {
+            if (position + sizeof(T) > bytes.size())
+            {
+                return false;
+            }
+            memcpy(&value, bytes.data() + position, sizeof(T));
+            position += sizeof(T);
+            return true;
+        }
+
+        template <typename T>
+        bool expect(const T &value)
+        {
+            T stored;
+            return get(stored) && stored == value;
+        }
+
+        void clear()
+        {
+            bytes.clear();
+            position = 0;
+        }
+
+        void rewind() { position = 0; }
+
+        std::vector<uint8_t> bytes;
+
+    private:
+        size_t position{0};
+    };
+
+    class EMA
+    {
+    public:
+        EMA(int period);
+        bool update(float value);
+        bool ready() const { return count >= period; }
+        float value() const { return current; }
+        void save(Snapshot &snapshot) const;
+        bool restore(Snapshot &snapshot);
+
+    private:
+        int period;
+        float k;
+        int count{0};
+        float sum{0};
+        float current{0};
+    };
+
+    class RSI
+    {
+    public:
+        RSI(int period);
+        bool update(float price);
+        bool ready() const { return count > period; }
+        float value() const { return current; }
+        void save(Snapshot &snapshot) const;
+        bool restore(Snapshot &snapshot);
+
+    private:
+        int period;
+        int count{0};
+        float last_price{0};
+        float gain{0};
+        float loss{0};
+        float current{0};
+    };
+
+    class MACD
+    {
+    public:
+        MACD(int fast_period, int slow_period, int signal_period);
+        bool update(float price);
+        bool ready() const { return signal_ema.ready(); }
+        float macd() const { return current_macd; }
+        float signal() const { return signal_ema.value(); }
+        float hist() const { return current_macd - signal_ema.value(); }
+        void save(Snapshot &snapshot) const;
+        bool restore(Snapshot &snapshot);
+
+    private:
+        int fast_period;
+        int slow_period;
+        float fast_k;
+        float slow_k;
+        int count{0};
+        float fast_sum{0};
+        float slow_sum{0};
+        float fast{0};
+        float slow{0};
+        float current_macd{0};
+        EMA signal_ema;
+    };
+
+    // RSI of the price followed by an EMA of that RSI, the chain hourly_rsi_look uses.
+    class RSIEMA
+    {
+    public:
+        RSIEMA(int rsi_period, int ema_period);
+        bool update(float price);
+        bool ready() const { return ema_.ready(); }
+        float rsi() const { return rsi_.value(); }
+        float ema() const { return ema_.value(); }
+        void save(Snapshot &snapshot) const;
+        bool restore(Snapshot &snapshot);
+
+    private:
+        RSI rsi_;
+        EMA ema_;
+    };
+
+    // Same value as Graph::Frame::slope over the values seen so far: the regression
+    // slope of the last period + 1 values.
+    class Slope
+    {
+    public:
+        Slope(int period);
+        bool update(float value) { return series.update(value); }
+        bool ready() const { return series.ready(); }
+        float value() const { return series.slope(); }
+        void save(Snapshot &snapshot) const;
+        bool restore(Snapshot &snapshot);
+
+    private:
+        int period;
+        Rolling::Series series;
+    };
+}
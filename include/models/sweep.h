@@ -0,0 +1,32 @@
+#pragma once
+#include <vector>
+
+namespace Sweep
+{
+    // One indicator evaluated for many parameter sets over the same prices. Values are
+    // stored time-major, row(t) holding every parameter set at bar t, so each bar is a
+    // single pass over contiguous state. Bars before a set's lookback are NaN; the rest
+    // are, to float rounding, ta-lib's value for the same bar. An unstable period only
+    // makes TA_EMA and TA_RSI leave out their first values, but it moves TA_MACD's
+    // signal seed, so MACD matches with the EMA unstable period at 0.
+    struct Matrix
+    {
+        int sets{0};
+        int size{0};
+        std::vector<float> values;
+
+        void resize(int sets_, int size_);
+        float *row(int t) { return values.data() + t * sets; }
+        const float *row(int t) const { return values.data() + t * sets; }
+        float at(int set, int t) const { return values[t * sets + set]; }
+    };
+
+    // Periods are checked like ta-lib's: 2 to 100000, 1 to 100000 for the MACD signal.
+    // With any of them out of range the call returns false and leaves its outputs empty.
+    bool EMA(const float *in, int size, const std::vector<int> &periods, Matrix &out);
+    bool RSI(const float *in, int size, const std::vector<int> &periods, Matrix &out);
+
+    // Every (fast, slow) combination with fast < slow, in fast-major order. pairs
+    // receives the combinations so callers can map rows back to parameters.
+    bool MACD(const float *in, int size, const std::vector<int> &fastPeriods, const std::vector<int> &slowPeriods, int signalPeriod, std::vector<std::pair<int, int>> &pairs, Matrix &outMACD, Matrix &outMACDSignal, Matrix &outMACDHist);
+}
@@ -1,11 +1,62 @@
 #pragma once
 #include <ta_func.h>
 #include <vector>
+#include <stddef.h>
+
+// Longest series the wrappers are sized for: a compact AlphaVantage fetch, which
+// Strategy::max_history keeps every look within.
+#define TA_MAX_BARS 100
+// The double path stages up to three outputs (MACD) in the scratch arena, the fixed
+// path its input and outputs at two values per double. The float path writes straight
+// into the caller's vectors and gets no arena.
+#if defined(TA_FIXED_POINT) || !defined(TA_SINGLE_PRECISION)
+#define TA_SCRATCH_DOUBLES (3 * TA_MAX_BARS)
+#endif
+// ta-lib's own temporaries (TA_MACD's two EMA buffers and the like) only arise on the
+// double path; single-precision builds never call into ta-lib's kernels.
+#ifndef TA_SINGLE_PRECISION
+#define TA_WORKSPACE_DOUBLES (2 * TA_MAX_BARS)
+#endif
+// The unstable period tail-only frames are tuned for; see set_unstable_period().
+#define TA_UNSTABLE_PERIOD 24
 
 namespace TA
 {
+    // Per-thread bump allocator for the wrappers' temporary buffers. take() returns
+    // nullptr once the arena is exhausted (or was never allocated) and the wrapper fails
+    // with TA_ALLOC_ERR; high_water() is the most doubles ever taken at once.
+    namespace Scratch
+    {
+        void init(size_t capacity);
+        double *take(size_t count);
+        size_t mark();
+        void rewind(size_t mark);
+        void reset();
+        void release();
+        size_t high_water();
+    }
+
+    // Double builds also hand ta-lib a workspace of TA_WORKSPACE_DOUBLES for the
+    // temporary arrays of TA_MACD and the like, so repeated calls don't go through
+    // malloc. Single-precision builds allocate neither it nor the arena; anything they
+    // still run through ta-lib (TA::Function) takes its temporaries from TA_Malloc.
     void init();
-    TA_RetCode EMA(std::vector<float> &prices, int period, std::vector<float> &outReal);
-    TA_RetCode RSI(std::vector<float> &prices, int period, std::vector<float> &outReal);
-    TA_RetCode MACD(std::vector<float> &prices, int fastPeriod, int slowPeriod, int signalPeriod, std::vector<float> &outMACD, std::vector<float> &outMACDSignal, std::vector<float> &outMACDHist);
-}
\ No newline at end of file
+
+    // Sets the EMA and RSI unstable period (which MACD inherits) in the calling thread's
+    // ta-lib settings; the Float and Fixed paths read it back from there. init() leaves
+    // ta-lib's default of 0. Tail-only frames need it so every seed sits well before the
+    // values they read.
+    void set_unstable_period(int period);
+
+    // Gives the calling thread its own copy of the ta-lib settings set up by init()
+    // and its own scratch arena, so indicator work can run on several threads
+    // without sharing either. Call after init(); shutdown_thread() frees both.
+    void init_thread();
+    void shutdown_thread();
+
+    // A tail > 0 asks for only the last tail outputs, computed from the lookback's worth
+    // of bars before them (TA_*_Lookback, including the unstable period).
+    TA_RetCode EMA(const std::vector<float> &prices, int period, std::vector<float> &outReal, int tail = 0);
+    TA_RetCode RSI(const std::vector<float> &prices, int period, std::vector<float> &outReal, int tail = 0);
+    TA_RetCode MACD(const std::vector<float> &prices, int fastPeriod, int slowPeriod, int signalPeriod, std::vector<float> &outMACD, std::vector<float> &outMACDSignal, std::vector<float> &outMACDHist, int tail = 0);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <stdint.h>
+
+#define TA_FIXED_FRACTION_BITS 16
+#define TA_FIXED_COEFFICIENT_BITS 30
+
+namespace TA
+{
+    // Fixed-point versions of the strategy's kernels for builds with TA_FIXED_POINT,
+    // avoiding the ESP32's software doubles entirely. Prices and outputs are Q15.16
+    // (int32_t, range about +/-32767, resolution 1.5e-5); smoothing factors are Q1.30
+    // and products are taken in 64 bits with round-to-nearest, so errors stay
+    // unbiased instead of drifting the way truncation does.
+    //
+    // Error against TA_EMA/TA_RSI/TA_MACD on the same inputs, with prices quantized to
+    // Q15.16 on entry:
+    //   typical  <= 0.5 LSB (7.6e-6)
+    //   EMA      <= (period + 1) / 4 LSB from per-step rounding, ~1e-4 for period 26
+    //   RSI      <= 5e-4 (on the 0-100 scale) for period 14
+    //   MACD     <= 1e-4 on the line, signal and histogram for 12/26/9
+    // Seeding, alignment and the unstable skip follow TA::Float.
+    namespace Fixed
+    {
+        typedef int32_t q16;
+
+        q16 from_float(float value);
+        float to_float(q16 value);
+
+        q16 typical(q16 high, q16 low, q16 close);
+        int EMA(const q16 *in, int size, int period, q16 *out, int unstable = 0);
+        int RSI(const q16 *in, int size, int period, q16 *out, int unstable = 0);
+        int MACD(const q16 *in, int size, int fastPeriod, int slowPeriod, int signalPeriod, q16 *outMACD, q16 *outMACDSignal, q16 *outMACDHist, int unstable = 0);
+    }
+}
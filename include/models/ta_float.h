@@ -0,0 +1,22 @@
+#pragma once
+
+namespace TA
+{
+    // Single-precision versions of the ta-lib kernels the strategy uses. They follow
+    // ta-lib's default (non-Metastock) seeding so the outputs line up with
+    // TA_EMA/TA_RSI/TA_MACD, and return the number of values written to out.
+    // unstable matches TA_SetUnstablePeriod: that many leading outputs are computed
+    // but not written. SMA, ATR and BBANDS cover the rest of the functions the
+    // strategies read; with the inputs and outputs all float spans owned by the
+    // caller, none of them allocates.
+    namespace Float
+    {
+        int EMA(const float *in, int size, int period, float *out, int unstable = 0);
+        int RSI(const float *in, int size, int period, float *out, int unstable = 0);
+        int MACD(const float *in, int size, int fastPeriod, int slowPeriod, int signalPeriod, float *outMACD, float *outMACDSignal, float *outMACDHist, int unstable = 0);
+        int SMA(const float *in, int size, int period, float *out);
+        int ATR(const float *high, const float *low, const float *close, int size, int period, float *out, int unstable = 0);
+        // TA_BBANDS with its default simple moving average as the middle band.
+        int BBANDS(const float *in, int size, int period, float nbDevUp, float nbDevDn, float *outUpper, float *outMiddle, float *outLower);
+    }
+}
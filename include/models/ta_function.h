@@ -0,0 +1,93 @@
+#pragma once
+#include <ta_abstract.h>
+
+namespace TA
+{
+    // Any ta-lib function called through the abstract interface. The handle and the
+    // parameter holder are resolved once on construction, so repeated calls only bind
+    // the caller's arrays and run the function, with no lookup or allocation.
+    //
+    //     TA::Function bbands{"BBANDS"};
+    //     bbands.inputs(closes).options(20, 2, 2, 0).outputs(upper, middle, lower);
+    //     bbands.call(0, size - 1, &outBegIdx, &outNbElement);
+    //
+    // An option is set by the type ta-lib declares for it, not by the C++ type of the
+    // value, so 2 and 2.0 both work for a real and an integer option; a fraction given
+    // to an integer option fails with TA_BAD_PARAM. Inputs and outputs are doubles (or
+    // ints): the abstract interface has no single-precision binding, so float series
+    // go through the TA_S_<FUNC> functions directly.
+    class Function
+    {
+    public:
+        Function(const char *name);
+        ~Function();
+        Function(const Function &) = delete;
+        Function &operator=(const Function &) = delete;
+
+        bool valid() const { return params != nullptr; }
+        const TA_FuncInfo *info() const { return info_; }
+
+        Function &input(unsigned int index, const double *values);
+        Function &input(unsigned int index, const int *values);
+        Function &price(unsigned int index, const double *open, const double *high, const double *low, const double *close, const double *volume, const double *openInterest);
+        Function &option(unsigned int index, int value) { return option(index, static_cast<double>(value)); }
+        Function &option(unsigned int index, double value);
+        Function &output(unsigned int index, double *values);
+        Function &output(unsigned int index, int *values);
+
+        template <typename... Inputs>
+        Function &inputs(Inputs... values)
+        {
+            return bind_inputs(0, values...);
+        }
+
+        template <typename... Options>
+        Function &options(Options... values)
+        {
+            return bind_options(0, values...);
+        }
+
+        template <typename... Outputs>
+        Function &outputs(Outputs... values)
+        {
+            return bind_outputs(0, values...);
+        }
+
+        int lookback() const;
+        TA_RetCode call(int startIdx, int endIdx, int *outBegIdx, int *outNbElement);
+        TA_RetCode status() const { return retCode; }
+
+    private:
+        Function &bind_inputs(unsigned int) { return *this; }
+        Function &bind_options(unsigned int) { return *this; }
+        Function &bind_outputs(unsigned int) { return *this; }
+
+        template <typename T, typename... Rest>
+        Function &bind_inputs(unsigned int index, T value, Rest... rest)
+        {
+            input(index, value);
+            return bind_inputs(index + 1, rest...);
+        }
+
+        template <typename T, typename... Rest>
+        Function &bind_options(unsigned int index, T value, Rest... rest)
+        {
+            option(index, value);
+            return bind_options(index + 1, rest...);
+        }
+
+        template <typename T, typename... Rest>
+        Function &bind_outputs(unsigned int index, T value, Rest... rest)
+        {
+            output(index, value);
+            return bind_outputs(index + 1, rest...);
+        }
+
+        void check(TA_RetCode code);
+
+        const TA_FuncHandle *handle{nullptr};
+        const TA_FuncInfo *info_{nullptr};
+        TA_ParamHolder *params{nullptr};
+        TA_RetCode retCode{TA_SUCCESS};
+    };
+}
@@ -3,5 +3,8 @@
 
 namespace Trade
 {
+    // Loads the indicator state saved for symbol by the last swing_trade_leveraged()
+    // run; call once from setup().
+    void restore(const char *symbol);
     void swing_trade_leveraged(const char *symbol, const char *up_stock, const char *down_stock, float percentage);
 }
\ No newline at end of file
@@ -50,6 +50,7 @@ extern "C" {
 #endif
 
 #include <stdio.h>
+#include <stddef.h>
 #include <limits.h>
 #include <float.h>
 
@@ -142,6 +143,78 @@ void TA_SetRetCodeInfo( TA_RetCode theRetCode, TA_RetCodeInfo *retCodeInfo );
 TA_RetCode TA_Initialize( void );
 TA_RetCode TA_Shutdown( void );
 
+/* TA-Lib settings (unstable periods, compatibility and candle settings)
+ * are shared by all threads by default, so changing them while another
+ * thread calls TA functions is unsafe.
+ *
+ * A thread can instead work on its own TA_Context:
+ *
+ *    TA_ContextAlloc() returns a copy of the settings currently used by
+ *    the calling thread.
+ *
+ *    TA_SetThreadContext() binds a context to the calling thread. From then
+ *    on, TA_SetUnstablePeriod(), TA_SetCompatibility(), TA_SetCandleSettings()
+ *    and every TA function called on that thread use only that context.
+ *    Passing NULL binds the thread back to the shared settings.
+ *
+ *    TA_ContextFree() releases a context. It must not be bound to any
+ *    thread anymore.
+ *
+ *    TA_Initialize() and TA_Shutdown() only reset the shared settings.
+ *    A context stays bound to its thread and keeps its own settings.
+ *
+ * With one context per thread, TA functions can run in parallel with
+ * different settings and without any locking.
+ *
+ * Example:
+ *        TA_Context *context;
+ *
+ *        TA_ContextAlloc( &context );
+ *        TA_SetThreadContext( context );
+ *        TA_SetUnstablePeriod( TA_FUNC_UNST_EMA, 30 );
+ *        ... TA function calls on this thread ...
+ *        TA_SetThreadContext( NULL );
+ *        TA_ContextFree( context );
+ */
+typedef struct TA_LibcPriv TA_Context;
+
+TA_RetCode TA_ContextAlloc( TA_Context **context );
+TA_RetCode TA_ContextFree( TA_Context *context );
+TA_RetCode TA_SetThreadContext( TA_Context *context );
+
+/* Memory used by TA-Lib.
+ *
+ * TA_SetAllocator() replaces malloc/realloc/free for every allocation
+ * done by TA-Lib. All three functions must be provided, or all three
+ * NULL to restore the C library. 'opaque' is passed back on each call.
+ * Set it before allocating any TA-Lib object (like a TA_ParamHolder)
+ * since these are released with the allocator in place at that time.
+ *
+ * TA_SetWorkspace() provides a buffer for the temporary arrays some
+ * functions need for their intermediate results (MACD, STOCH, MA...).
+ * They are taken from the buffer and given back before the function
+ * returns, so after the first calls no allocation happens at all. A
+ * temporary that does not fit in what is left of the buffer falls back
+ * on the allocator. Pass NULL to stop using a workspace.
+ * TA_GetWorkspacePeak() returns the most bytes the workspace ever held,
+ * to help sizing it.
+ *
+ * Like the other settings, the allocator and the workspace belong to the
+ * calling thread's TA_Context (a new context does not inherit the
+ * workspace) and are reset by TA_Initialize().
+ */
+typedef void *(*TA_AllocFunc)( size_t size, void *opaque );
+typedef void *(*TA_ReallocFunc)( void *ptr, size_t size, void *opaque );
+typedef void (*TA_FreeFunc)( void *ptr, void *opaque );
+
+TA_RetCode TA_SetAllocator( TA_AllocFunc allocFunc,
+                            TA_ReallocFunc reallocFunc,
+                            TA_FreeFunc freeFunc,
+                            void *opaque );
+
+TA_RetCode TA_SetWorkspace( void *buffer, size_t size );
+TA_RetCode TA_GetWorkspacePeak( size_t *peak );
+
 #ifdef __cplusplus
 }
 #endif
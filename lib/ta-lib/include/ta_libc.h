@@ -47,5 +47,9 @@
    #include "ta_abstract.h"
 #endif
 
+#ifndef TA_STREAM_H
+   #include "ta_stream.h"
+#endif
+
 #endif
 
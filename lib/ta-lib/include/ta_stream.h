@@ -0,0 +1,1186 @@
+/* TA-LIB Copyright (c) 1999-2007, Mario Fortier
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in
+ *   the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * - Neither name of author nor the names of its contributors
+ *   may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef TA_STREAM_H
+#define TA_STREAM_H
+
+#ifndef TA_COMMON_H
+   #include "ta_common.h"
+#endif
+
+/* This header contains the prototype of the streaming version of some
+ * Technical Analysis functions.
+ *
+ * A batch function (see ta_func.h) processes a whole range of bars on
+ * each call. Its streaming version instead keeps its state between calls
+ * and processes one new bar at a time, in constant time:
+ *
+ *    TA_<FUNC>_StateInit() allocates the state. The optional inputs and
+ *    their default values are the same as for TA_<FUNC>. The unstable
+ *    period and the compatibility used are the ones of the calling
+ *    thread at that time.
+ *
+ *    TA_<FUNC>_StateUpdate() processes the next bar. 'outNBElement' is
+ *    set to 1 when the outputs were written, or to 0 while the bars
+ *    consumed are still within the lookback period.
+ *
+ *    TA_<FUNC>_StateFree() frees the state.
+ *
+ * When all the bars are streamed from the first one, the outputs are
+ * the same as the ones returned by TA_<FUNC> for these bars.
+ *
+ * All the MA types are streamed, including by the functions taking a
+ * TA_MAType. One exception to the identical outputs: TA_BBANDS with
+ * the MAMA type and a period longer than the MAMA lookback returns
+ * the middle band of an earlier bar than its deviation. The stream
+ * keeps both on the same bar.
+ *
+ * Not streamed:
+ *    - The candlestick patterns, the price transforms, the math
+ *      transforms, BOP, ADD, SUB, MULT and DIV. Calling the batch
+ *      function on the last bars (lookback+1 at most) already costs
+ *      the same for each bar.
+ *    - LINEARREG, LINEARREG_ANGLE, LINEARREG_INTERCEPT,
+ *      LINEARREG_SLOPE and TSF. The batch functions sum the whole
+ *      period again for each bar, so a stream would cost the same as
+ *      calling them on the last 'period' bars.
+ *    - MINMAX, MAXINDEX, MININDEX and MINMAXINDEX. MINMAX is a
+ *      TA_MIN_State and a TA_MAX_State. The indexes are positions in
+ *      the batch input, and which of two equal values is reported
+ *      depends on when the batch function rescans its window.
+ *    - MAVP, whose period changes with each bar.
+ *
+ * Example:
+ *        TA_EMA_State *state;
+ *        int outNBElement;
+ *        double ema;
+ *
+ *        TA_EMA_StateInit( &state, 20 );
+ *        for( i=0; i < nbBar; i++ )
+ *        {
+ *           TA_EMA_StateUpdate( state, close[i], &outNBElement, &ema );
+ *           if( outNBElement == 1 )
+ *              ... 'ema' is the EMA at bar 'i' ...
+ *        }
+ *        TA_EMA_StateFree( state );
+ */
+
+/* TA-LIB Developer Note: Do not modify this file, it is automaticaly
+ *                        generated by gen_code.
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef TA_DEFS_H
+   #include "ta_defs.h"
+#endif
+
+
+/*
+ * TA_AD - Chaikin A/D Line
+ */
+typedef struct TA_AD_State TA_AD_State;
+
+TA_RetCode TA_AD_StateInit( TA_AD_State **state );
+
+TA_RetCode TA_AD_StateUpdate( TA_AD_State *state,
+                              double        inHigh,
+                              double        inLow,
+                              double        inClose,
+                              double        inVolume,
+                              int          *outNBElement,
+                              double       *outReal );
+
+TA_RetCode TA_AD_StateFree( TA_AD_State *state );
+
+/*
+ * TA_ADOSC - Chaikin A/D Oscillator
+ */
+typedef struct TA_ADOSC_State TA_ADOSC_State;
+
+TA_RetCode TA_ADOSC_StateInit( TA_ADOSC_State **state,
+                               int           optInFastPeriod, /* From 2 to 100000 */
+                               int           optInSlowPeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_ADOSC_StateUpdate( TA_ADOSC_State *state,
+                                 double        inHigh,
+                                 double        inLow,
+                                 double        inClose,
+                                 double        inVolume,
+                                 int          *outNBElement,
+                                 double       *outReal );
+
+TA_RetCode TA_ADOSC_StateFree( TA_ADOSC_State *state );
+
+/*
+ * TA_ADX - Average Directional Movement Index
+ */
+typedef struct TA_ADX_State TA_ADX_State;
+
+TA_RetCode TA_ADX_StateInit( TA_ADX_State **state,
+                             int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_ADX_StateUpdate( TA_ADX_State *state,
+                               double        inHigh,
+                               double        inLow,
+                               double        inClose,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_ADX_StateFree( TA_ADX_State *state );
+
+/*
+ * TA_ADXR - Average Directional Movement Index Rating
+ */
+typedef struct TA_ADXR_State TA_ADXR_State;
+
+TA_RetCode TA_ADXR_StateInit( TA_ADXR_State **state,
+                              int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_ADXR_StateUpdate( TA_ADXR_State *state,
+                                double        inHigh,
+                                double        inLow,
+                                double        inClose,
+                                int          *outNBElement,
+                                double       *outReal );
+
+TA_RetCode TA_ADXR_StateFree( TA_ADXR_State *state );
+
+/*
+ * TA_APO - Absolute Price Oscillator
+ */
+typedef struct TA_APO_State TA_APO_State;
+
+TA_RetCode TA_APO_StateInit( TA_APO_State **state,
+                             int           optInFastPeriod, /* From 2 to 100000 */
+                             int           optInSlowPeriod, /* From 2 to 100000 */
+                             TA_MAType     optInMAType );
+
+TA_RetCode TA_APO_StateUpdate( TA_APO_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_APO_StateFree( TA_APO_State *state );
+
+/*
+ * TA_AROON - Aroon
+ */
+typedef struct TA_AROON_State TA_AROON_State;
+
+TA_RetCode TA_AROON_StateInit( TA_AROON_State **state,
+                               int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_AROON_StateUpdate( TA_AROON_State *state,
+                                 double        inHigh,
+                                 double        inLow,
+                                 int          *outNBElement,
+                                 double       *outAroonDown,
+                                 double       *outAroonUp );
+
+TA_RetCode TA_AROON_StateFree( TA_AROON_State *state );
+
+/*
+ * TA_AROONOSC - Aroon Oscillator
+ */
+typedef struct TA_AROONOSC_State TA_AROONOSC_State;
+
+TA_RetCode TA_AROONOSC_StateInit( TA_AROONOSC_State **state,
+                                  int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_AROONOSC_StateUpdate( TA_AROONOSC_State *state,
+                                    double        inHigh,
+                                    double        inLow,
+                                    int          *outNBElement,
+                                    double       *outReal );
+
+TA_RetCode TA_AROONOSC_StateFree( TA_AROONOSC_State *state );
+
+/*
+ * TA_ATR - Average True Range
+ */
+typedef struct TA_ATR_State TA_ATR_State;
+
+TA_RetCode TA_ATR_StateInit( TA_ATR_State **state,
+                             int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_ATR_StateUpdate( TA_ATR_State *state,
+                               double        inHigh,
+                               double        inLow,
+                               double        inClose,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_ATR_StateFree( TA_ATR_State *state );
+
+/*
+ * TA_BBANDS - Bollinger Bands
+ */
+typedef struct TA_BBANDS_State TA_BBANDS_State;
+
+TA_RetCode TA_BBANDS_StateInit( TA_BBANDS_State **state,
+                                int           optInTimePeriod, /* From 2 to 100000 */
+                                double        optInNbDevUp, /* From TA_REAL_MIN to TA_REAL_MAX */
+                                double        optInNbDevDn, /* From TA_REAL_MIN to TA_REAL_MAX */
+                                TA_MAType     optInMAType );
+
+TA_RetCode TA_BBANDS_StateUpdate( TA_BBANDS_State *state,
+                                  double        inReal,
+                                  int          *outNBElement,
+                                  double       *outRealUpperBand,
+                                  double       *outRealMiddleBand,
+                                  double       *outRealLowerBand );
+
+TA_RetCode TA_BBANDS_StateFree( TA_BBANDS_State *state );
+
+/*
+ * TA_BETA - Beta
+ */
+typedef struct TA_BETA_State TA_BETA_State;
+
+TA_RetCode TA_BETA_StateInit( TA_BETA_State **state,
+                              int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_BETA_StateUpdate( TA_BETA_State *state,
+                                double        inReal0,
+                                double        inReal1,
+                                int          *outNBElement,
+                                double       *outReal );
+
+TA_RetCode TA_BETA_StateFree( TA_BETA_State *state );
+
+/*
+ * TA_CCI - Commodity Channel Index
+ */
+typedef struct TA_CCI_State TA_CCI_State;
+
+TA_RetCode TA_CCI_StateInit( TA_CCI_State **state,
+                             int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_CCI_StateUpdate( TA_CCI_State *state,
+                               double        inHigh,
+                               double        inLow,
+                               double        inClose,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_CCI_StateFree( TA_CCI_State *state );
+
+/*
+ * TA_CMO - Chande Momentum Oscillator
+ */
+typedef struct TA_CMO_State TA_CMO_State;
+
+TA_RetCode TA_CMO_StateInit( TA_CMO_State **state,
+                             int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_CMO_StateUpdate( TA_CMO_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_CMO_StateFree( TA_CMO_State *state );
+
+/*
+ * TA_CORREL - Pearson's Correlation Coefficient (r)
+ */
+typedef struct TA_CORREL_State TA_CORREL_State;
+
+TA_RetCode TA_CORREL_StateInit( TA_CORREL_State **state,
+                                int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_CORREL_StateUpdate( TA_CORREL_State *state,
+                                  double        inReal0,
+                                  double        inReal1,
+                                  int          *outNBElement,
+                                  double       *outReal );
+
+TA_RetCode TA_CORREL_StateFree( TA_CORREL_State *state );
+
+/*
+ * TA_DEMA - Double Exponential Moving Average
+ */
+typedef struct TA_DEMA_State TA_DEMA_State;
+
+TA_RetCode TA_DEMA_StateInit( TA_DEMA_State **state,
+                              int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_DEMA_StateUpdate( TA_DEMA_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outReal );
+
+TA_RetCode TA_DEMA_StateFree( TA_DEMA_State *state );
+
+/*
+ * TA_DX - Directional Movement Index
+ */
+typedef struct TA_DX_State TA_DX_State;
+
+TA_RetCode TA_DX_StateInit( TA_DX_State **state,
+                            int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_DX_StateUpdate( TA_DX_State *state,
+                              double        inHigh,
+                              double        inLow,
+                              double        inClose,
+                              int          *outNBElement,
+                              double       *outReal );
+
+TA_RetCode TA_DX_StateFree( TA_DX_State *state );
+
+/*
+ * TA_EMA - Exponential Moving Average
+ */
+typedef struct TA_EMA_State TA_EMA_State;
+
+TA_RetCode TA_EMA_StateInit( TA_EMA_State **state,
+                             int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_EMA_StateUpdate( TA_EMA_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_EMA_StateFree( TA_EMA_State *state );
+
+/*
+ * TA_HT_DCPERIOD - Hilbert Transform - Dominant Cycle Period
+ */
+typedef struct TA_HT_DCPERIOD_State TA_HT_DCPERIOD_State;
+
+TA_RetCode TA_HT_DCPERIOD_StateInit( TA_HT_DCPERIOD_State **state );
+
+TA_RetCode TA_HT_DCPERIOD_StateUpdate( TA_HT_DCPERIOD_State *state,
+                                       double        inReal,
+                                       int          *outNBElement,
+                                       double       *outReal );
+
+TA_RetCode TA_HT_DCPERIOD_StateFree( TA_HT_DCPERIOD_State *state );
+
+/*
+ * TA_HT_DCPHASE - Hilbert Transform - Dominant Cycle Phase
+ */
+typedef struct TA_HT_DCPHASE_State TA_HT_DCPHASE_State;
+
+TA_RetCode TA_HT_DCPHASE_StateInit( TA_HT_DCPHASE_State **state );
+
+TA_RetCode TA_HT_DCPHASE_StateUpdate( TA_HT_DCPHASE_State *state,
+                                      double        inReal,
+                                      int          *outNBElement,
+                                      double       *outReal );
+
+TA_RetCode TA_HT_DCPHASE_StateFree( TA_HT_DCPHASE_State *state );
+
+/*
+ * TA_HT_PHASOR - Hilbert Transform - Phasor Components
+ */
+typedef struct TA_HT_PHASOR_State TA_HT_PHASOR_State;
+
+TA_RetCode TA_HT_PHASOR_StateInit( TA_HT_PHASOR_State **state );
+
+TA_RetCode TA_HT_PHASOR_StateUpdate( TA_HT_PHASOR_State *state,
+                                     double        inReal,
+                                     int          *outNBElement,
+                                     double       *outInPhase,
+                                     double       *outQuadrature );
+
+TA_RetCode TA_HT_PHASOR_StateFree( TA_HT_PHASOR_State *state );
+
+/*
+ * TA_HT_SINE - Hilbert Transform - SineWave
+ */
+typedef struct TA_HT_SINE_State TA_HT_SINE_State;
+
+TA_RetCode TA_HT_SINE_StateInit( TA_HT_SINE_State **state );
+
+TA_RetCode TA_HT_SINE_StateUpdate( TA_HT_SINE_State *state,
+                                   double        inReal,
+                                   int          *outNBElement,
+                                   double       *outSine,
+                                   double       *outLeadSine );
+
+TA_RetCode TA_HT_SINE_StateFree( TA_HT_SINE_State *state );
+
+/*
+ * TA_HT_TRENDLINE - Hilbert Transform - Instantaneous Trendline
+ */
+typedef struct TA_HT_TRENDLINE_State TA_HT_TRENDLINE_State;
+
+TA_RetCode TA_HT_TRENDLINE_StateInit( TA_HT_TRENDLINE_State **state );
+
+TA_RetCode TA_HT_TRENDLINE_StateUpdate( TA_HT_TRENDLINE_State *state,
+                                        double        inReal,
+                                        int          *outNBElement,
+                                        double       *outReal );
+
+TA_RetCode TA_HT_TRENDLINE_StateFree( TA_HT_TRENDLINE_State *state );
+
+/*
+ * TA_HT_TRENDMODE - Hilbert Transform - Trend vs Cycle Mode
+ */
+typedef struct TA_HT_TRENDMODE_State TA_HT_TRENDMODE_State;
+
+TA_RetCode TA_HT_TRENDMODE_StateInit( TA_HT_TRENDMODE_State **state );
+
+TA_RetCode TA_HT_TRENDMODE_StateUpdate( TA_HT_TRENDMODE_State *state,
+                                        double        inReal,
+                                        int          *outNBElement,
+                                        int          *outInteger );
+
+TA_RetCode TA_HT_TRENDMODE_StateFree( TA_HT_TRENDMODE_State *state );
+
+/*
+ * TA_KAMA - Kaufman Adaptive Moving Average
+ */
+typedef struct TA_KAMA_State TA_KAMA_State;
+
+TA_RetCode TA_KAMA_StateInit( TA_KAMA_State **state,
+                              int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_KAMA_StateUpdate( TA_KAMA_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outReal );
+
+TA_RetCode TA_KAMA_StateFree( TA_KAMA_State *state );
+
+/*
+ * TA_MA - Moving average
+ */
+typedef struct TA_MA_State TA_MA_State;
+
+TA_RetCode TA_MA_StateInit( TA_MA_State **state,
+                            int           optInTimePeriod, /* From 1 to 100000 */
+                            TA_MAType     optInMAType );
+
+TA_RetCode TA_MA_StateUpdate( TA_MA_State *state,
+                              double        inReal,
+                              int          *outNBElement,
+                              double       *outReal );
+
+TA_RetCode TA_MA_StateFree( TA_MA_State *state );
+
+/*
+ * TA_MACD - Moving Average Convergence/Divergence
+ */
+typedef struct TA_MACD_State TA_MACD_State;
+
+TA_RetCode TA_MACD_StateInit( TA_MACD_State **state,
+                              int           optInFastPeriod, /* From 2 to 100000 */
+                              int           optInSlowPeriod, /* From 2 to 100000 */
+                              int           optInSignalPeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_MACD_StateUpdate( TA_MACD_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outMACD,
+                                double       *outMACDSignal,
+                                double       *outMACDHist );
+
+TA_RetCode TA_MACD_StateFree( TA_MACD_State *state );
+
+/*
+ * TA_MACDEXT - MACD with controllable MA type
+ */
+typedef struct TA_MACDEXT_State TA_MACDEXT_State;
+
+TA_RetCode TA_MACDEXT_StateInit( TA_MACDEXT_State **state,
+                                 int           optInFastPeriod, /* From 2 to 100000 */
+                                 TA_MAType     optInFastMAType,
+                                 int           optInSlowPeriod, /* From 2 to 100000 */
+                                 TA_MAType     optInSlowMAType,
+                                 int           optInSignalPeriod, /* From 1 to 100000 */
+                                 TA_MAType     optInSignalMAType );
+
+TA_RetCode TA_MACDEXT_StateUpdate( TA_MACDEXT_State *state,
+                                   double        inReal,
+                                   int          *outNBElement,
+                                   double       *outMACD,
+                                   double       *outMACDSignal,
+                                   double       *outMACDHist );
+
+TA_RetCode TA_MACDEXT_StateFree( TA_MACDEXT_State *state );
+
+/*
+ * TA_MACDFIX - Moving Average Convergence/Divergence Fix 12/26
+ */
+typedef struct TA_MACDFIX_State TA_MACDFIX_State;
+
+TA_RetCode TA_MACDFIX_StateInit( TA_MACDFIX_State **state,
+                                 int           optInSignalPeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_MACDFIX_StateUpdate( TA_MACDFIX_State *state,
+                                   double        inReal,
+                                   int          *outNBElement,
+                                   double       *outMACD,
+                                   double       *outMACDSignal,
+                                   double       *outMACDHist );
+
+TA_RetCode TA_MACDFIX_StateFree( TA_MACDFIX_State *state );
+
+/*
+ * TA_MAMA - MESA Adaptive Moving Average
+ */
+typedef struct TA_MAMA_State TA_MAMA_State;
+
+TA_RetCode TA_MAMA_StateInit( TA_MAMA_State **state,
+                              double        optInFastLimit, /* From 0.01 to 0.99 */
+                              double        optInSlowLimit ); /* From 0.01 to 0.99 */
+
+TA_RetCode TA_MAMA_StateUpdate( TA_MAMA_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outMAMA,
+                                double       *outFAMA );
+
+TA_RetCode TA_MAMA_StateFree( TA_MAMA_State *state );
+
+/*
+ * TA_MAX - Highest value over a specified period
+ */
+typedef struct TA_MAX_State TA_MAX_State;
+
+TA_RetCode TA_MAX_StateInit( TA_MAX_State **state,
+                             int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_MAX_StateUpdate( TA_MAX_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_MAX_StateFree( TA_MAX_State *state );
+
+/*
+ * TA_MFI - Money Flow Index
+ */
+typedef struct TA_MFI_State TA_MFI_State;
+
+TA_RetCode TA_MFI_StateInit( TA_MFI_State **state,
+                             int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_MFI_StateUpdate( TA_MFI_State *state,
+                               double        inHigh,
+                               double        inLow,
+                               double        inClose,
+                               double        inVolume,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_MFI_StateFree( TA_MFI_State *state );
+
+/*
+ * TA_MIDPOINT - MidPoint over period
+ */
+typedef struct TA_MIDPOINT_State TA_MIDPOINT_State;
+
+TA_RetCode TA_MIDPOINT_StateInit( TA_MIDPOINT_State **state,
+                                  int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_MIDPOINT_StateUpdate( TA_MIDPOINT_State *state,
+                                    double        inReal,
+                                    int          *outNBElement,
+                                    double       *outReal );
+
+TA_RetCode TA_MIDPOINT_StateFree( TA_MIDPOINT_State *state );
+
+/*
+ * TA_MIDPRICE - Midpoint Price over period
+ */
+typedef struct TA_MIDPRICE_State TA_MIDPRICE_State;
+
+TA_RetCode TA_MIDPRICE_StateInit( TA_MIDPRICE_State **state,
+                                  int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_MIDPRICE_StateUpdate( TA_MIDPRICE_State *state,
+                                    double        inHigh,
+                                    double        inLow,
+                                    int          *outNBElement,
+                                    double       *outReal );
+
+TA_RetCode TA_MIDPRICE_StateFree( TA_MIDPRICE_State *state );
+
+/*
+ * TA_MIN - Lowest value over a specified period
+ */
+typedef struct TA_MIN_State TA_MIN_State;
+
+TA_RetCode TA_MIN_StateInit( TA_MIN_State **state,
+                             int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_MIN_StateUpdate( TA_MIN_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_MIN_StateFree( TA_MIN_State *state );
+
+/*
+ * TA_MINUS_DI - Minus Directional Indicator
+ */
+typedef struct TA_MINUS_DI_State TA_MINUS_DI_State;
+
+TA_RetCode TA_MINUS_DI_StateInit( TA_MINUS_DI_State **state,
+                                  int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_MINUS_DI_StateUpdate( TA_MINUS_DI_State *state,
+                                    double        inHigh,
+                                    double        inLow,
+                                    double        inClose,
+                                    int          *outNBElement,
+                                    double       *outReal );
+
+TA_RetCode TA_MINUS_DI_StateFree( TA_MINUS_DI_State *state );
+
+/*
+ * TA_MINUS_DM - Minus Directional Movement
+ */
+typedef struct TA_MINUS_DM_State TA_MINUS_DM_State;
+
+TA_RetCode TA_MINUS_DM_StateInit( TA_MINUS_DM_State **state,
+                                  int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_MINUS_DM_StateUpdate( TA_MINUS_DM_State *state,
+                                    double        inHigh,
+                                    double        inLow,
+                                    int          *outNBElement,
+                                    double       *outReal );
+
+TA_RetCode TA_MINUS_DM_StateFree( TA_MINUS_DM_State *state );
+
+/*
+ * TA_MOM - Momentum
+ */
+typedef struct TA_MOM_State TA_MOM_State;
+
+TA_RetCode TA_MOM_StateInit( TA_MOM_State **state,
+                             int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_MOM_StateUpdate( TA_MOM_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_MOM_StateFree( TA_MOM_State *state );
+
+/*
+ * TA_NATR - Normalized Average True Range
+ */
+typedef struct TA_NATR_State TA_NATR_State;
+
+TA_RetCode TA_NATR_StateInit( TA_NATR_State **state,
+                              int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_NATR_StateUpdate( TA_NATR_State *state,
+                                double        inHigh,
+                                double        inLow,
+                                double        inClose,
+                                int          *outNBElement,
+                                double       *outReal );
+
+TA_RetCode TA_NATR_StateFree( TA_NATR_State *state );
+
+/*
+ * TA_OBV - On Balance Volume
+ */
+typedef struct TA_OBV_State TA_OBV_State;
+
+TA_RetCode TA_OBV_StateInit( TA_OBV_State **state );
+
+TA_RetCode TA_OBV_StateUpdate( TA_OBV_State *state,
+                               double        inReal,
+                               double        inVolume,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_OBV_StateFree( TA_OBV_State *state );
+
+/*
+ * TA_PLUS_DI - Plus Directional Indicator
+ */
+typedef struct TA_PLUS_DI_State TA_PLUS_DI_State;
+
+TA_RetCode TA_PLUS_DI_StateInit( TA_PLUS_DI_State **state,
+                                 int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_PLUS_DI_StateUpdate( TA_PLUS_DI_State *state,
+                                   double        inHigh,
+                                   double        inLow,
+                                   double        inClose,
+                                   int          *outNBElement,
+                                   double       *outReal );
+
+TA_RetCode TA_PLUS_DI_StateFree( TA_PLUS_DI_State *state );
+
+/*
+ * TA_PLUS_DM - Plus Directional Movement
+ */
+typedef struct TA_PLUS_DM_State TA_PLUS_DM_State;
+
+TA_RetCode TA_PLUS_DM_StateInit( TA_PLUS_DM_State **state,
+                                 int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_PLUS_DM_StateUpdate( TA_PLUS_DM_State *state,
+                                   double        inHigh,
+                                   double        inLow,
+                                   int          *outNBElement,
+                                   double       *outReal );
+
+TA_RetCode TA_PLUS_DM_StateFree( TA_PLUS_DM_State *state );
+
+/*
+ * TA_PPO - Percentage Price Oscillator
+ */
+typedef struct TA_PPO_State TA_PPO_State;
+
+TA_RetCode TA_PPO_StateInit( TA_PPO_State **state,
+                             int           optInFastPeriod, /* From 2 to 100000 */
+                             int           optInSlowPeriod, /* From 2 to 100000 */
+                             TA_MAType     optInMAType );
+
+TA_RetCode TA_PPO_StateUpdate( TA_PPO_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_PPO_StateFree( TA_PPO_State *state );
+
+/*
+ * TA_ROC - Rate of change : ((price/prevPrice)-1)*100
+ */
+typedef struct TA_ROC_State TA_ROC_State;
+
+TA_RetCode TA_ROC_StateInit( TA_ROC_State **state,
+                             int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_ROC_StateUpdate( TA_ROC_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_ROC_StateFree( TA_ROC_State *state );
+
+/*
+ * TA_ROCP - Rate of change Percentage: (price-prevPrice)/prevPrice
+ */
+typedef struct TA_ROCP_State TA_ROCP_State;
+
+TA_RetCode TA_ROCP_StateInit( TA_ROCP_State **state,
+                              int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_ROCP_StateUpdate( TA_ROCP_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outReal );
+
+TA_RetCode TA_ROCP_StateFree( TA_ROCP_State *state );
+
+/*
+ * TA_ROCR - Rate of change ratio: (price/prevPrice)
+ */
+typedef struct TA_ROCR_State TA_ROCR_State;
+
+TA_RetCode TA_ROCR_StateInit( TA_ROCR_State **state,
+                              int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_ROCR_StateUpdate( TA_ROCR_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outReal );
+
+TA_RetCode TA_ROCR_StateFree( TA_ROCR_State *state );
+
+/*
+ * TA_ROCR100 - Rate of change ratio 100 scale: (price/prevPrice)*100
+ */
+typedef struct TA_ROCR100_State TA_ROCR100_State;
+
+TA_RetCode TA_ROCR100_StateInit( TA_ROCR100_State **state,
+                                 int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_ROCR100_StateUpdate( TA_ROCR100_State *state,
+                                   double        inReal,
+                                   int          *outNBElement,
+                                   double       *outReal );
+
+TA_RetCode TA_ROCR100_StateFree( TA_ROCR100_State *state );
+
+/*
+ * TA_RSI - Relative Strength Index
+ */
+typedef struct TA_RSI_State TA_RSI_State;
+
+TA_RetCode TA_RSI_StateInit( TA_RSI_State **state,
+                             int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_RSI_StateUpdate( TA_RSI_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_RSI_StateFree( TA_RSI_State *state );
+
+/*
+ * TA_SAR - Parabolic SAR
+ */
+typedef struct TA_SAR_State TA_SAR_State;
+
+TA_RetCode TA_SAR_StateInit( TA_SAR_State **state,
+                             double        optInAcceleration, /* From 0 to TA_REAL_MAX */
+                             double        optInMaximum ); /* From 0 to TA_REAL_MAX */
+
+TA_RetCode TA_SAR_StateUpdate( TA_SAR_State *state,
+                               double        inHigh,
+                               double        inLow,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_SAR_StateFree( TA_SAR_State *state );
+
+/*
+ * TA_SAREXT - Parabolic SAR - Extended
+ */
+typedef struct TA_SAREXT_State TA_SAREXT_State;
+
+TA_RetCode TA_SAREXT_StateInit( TA_SAREXT_State **state,
+                                double        optInStartValue, /* From TA_REAL_MIN to TA_REAL_MAX */
+                                double        optInOffsetOnReverse, /* From 0 to TA_REAL_MAX */
+                                double        optInAccelerationInitLong, /* From 0 to TA_REAL_MAX */
+                                double        optInAccelerationLong, /* From 0 to TA_REAL_MAX */
+                                double        optInAccelerationMaxLong, /* From 0 to TA_REAL_MAX */
+                                double        optInAccelerationInitShort, /* From 0 to TA_REAL_MAX */
+                                double        optInAccelerationShort, /* From 0 to TA_REAL_MAX */
+                                double        optInAccelerationMaxShort ); /* From 0 to TA_REAL_MAX */
+
+TA_RetCode TA_SAREXT_StateUpdate( TA_SAREXT_State *state,
+                                  double        inHigh,
+                                  double        inLow,
+                                  int          *outNBElement,
+                                  double       *outReal );
+
+TA_RetCode TA_SAREXT_StateFree( TA_SAREXT_State *state );
+
+/*
+ * TA_SMA - Simple Moving Average
+ */
+typedef struct TA_SMA_State TA_SMA_State;
+
+TA_RetCode TA_SMA_StateInit( TA_SMA_State **state,
+                             int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_SMA_StateUpdate( TA_SMA_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_SMA_StateFree( TA_SMA_State *state );
+
+/*
+ * TA_STDDEV - Standard Deviation
+ */
+typedef struct TA_STDDEV_State TA_STDDEV_State;
+
+TA_RetCode TA_STDDEV_StateInit( TA_STDDEV_State **state,
+                                int           optInTimePeriod, /* From 2 to 100000 */
+                                double        optInNbDev ); /* From TA_REAL_MIN to TA_REAL_MAX */
+
+TA_RetCode TA_STDDEV_StateUpdate( TA_STDDEV_State *state,
+                                  double        inReal,
+                                  int          *outNBElement,
+                                  double       *outReal );
+
+TA_RetCode TA_STDDEV_StateFree( TA_STDDEV_State *state );
+
+/*
+ * TA_STOCH - Stochastic
+ */
+typedef struct TA_STOCH_State TA_STOCH_State;
+
+TA_RetCode TA_STOCH_StateInit( TA_STOCH_State **state,
+                               int           optInFastK_Period, /* From 1 to 100000 */
+                               int           optInSlowK_Period, /* From 1 to 100000 */
+                               TA_MAType     optInSlowK_MAType,
+                               int           optInSlowD_Period, /* From 1 to 100000 */
+                               TA_MAType     optInSlowD_MAType );
+
+TA_RetCode TA_STOCH_StateUpdate( TA_STOCH_State *state,
+                                 double        inHigh,
+                                 double        inLow,
+                                 double        inClose,
+                                 int          *outNBElement,
+                                 double       *outSlowK,
+                                 double       *outSlowD );
+
+TA_RetCode TA_STOCH_StateFree( TA_STOCH_State *state );
+
+/*
+ * TA_STOCHF - Stochastic Fast
+ */
+typedef struct TA_STOCHF_State TA_STOCHF_State;
+
+TA_RetCode TA_STOCHF_StateInit( TA_STOCHF_State **state,
+                                int           optInFastK_Period, /* From 1 to 100000 */
+                                int           optInFastD_Period, /* From 1 to 100000 */
+                                TA_MAType     optInFastD_MAType );
+
+TA_RetCode TA_STOCHF_StateUpdate( TA_STOCHF_State *state,
+                                  double        inHigh,
+                                  double        inLow,
+                                  double        inClose,
+                                  int          *outNBElement,
+                                  double       *outFastK,
+                                  double       *outFastD );
+
+TA_RetCode TA_STOCHF_StateFree( TA_STOCHF_State *state );
+
+/*
+ * TA_STOCHRSI - Stochastic Relative Strength Index
+ */
+typedef struct TA_STOCHRSI_State TA_STOCHRSI_State;
+
+TA_RetCode TA_STOCHRSI_StateInit( TA_STOCHRSI_State **state,
+                                  int           optInTimePeriod, /* From 2 to 100000 */
+                                  int           optInFastK_Period, /* From 1 to 100000 */
+                                  int           optInFastD_Period, /* From 1 to 100000 */
+                                  TA_MAType     optInFastD_MAType );
+
+TA_RetCode TA_STOCHRSI_StateUpdate( TA_STOCHRSI_State *state,
+                                    double        inReal,
+                                    int          *outNBElement,
+                                    double       *outFastK,
+                                    double       *outFastD );
+
+TA_RetCode TA_STOCHRSI_StateFree( TA_STOCHRSI_State *state );
+
+/*
+ * TA_SUM - Summation
+ */
+typedef struct TA_SUM_State TA_SUM_State;
+
+TA_RetCode TA_SUM_StateInit( TA_SUM_State **state,
+                             int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_SUM_StateUpdate( TA_SUM_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_SUM_StateFree( TA_SUM_State *state );
+
+/*
+ * TA_T3 - Triple Exponential Moving Average (T3)
+ */
+typedef struct TA_T3_State TA_T3_State;
+
+TA_RetCode TA_T3_StateInit( TA_T3_State **state,
+                            int           optInTimePeriod, /* From 2 to 100000 */
+                            double        optInVFactor ); /* From 0 to 1 */
+
+TA_RetCode TA_T3_StateUpdate( TA_T3_State *state,
+                              double        inReal,
+                              int          *outNBElement,
+                              double       *outReal );
+
+TA_RetCode TA_T3_StateFree( TA_T3_State *state );
+
+/*
+ * TA_TEMA - Triple Exponential Moving Average
+ */
+typedef struct TA_TEMA_State TA_TEMA_State;
+
+TA_RetCode TA_TEMA_StateInit( TA_TEMA_State **state,
+                              int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_TEMA_StateUpdate( TA_TEMA_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outReal );
+
+TA_RetCode TA_TEMA_StateFree( TA_TEMA_State *state );
+
+/*
+ * TA_TRANGE - True Range
+ */
+typedef struct TA_TRANGE_State TA_TRANGE_State;
+
+TA_RetCode TA_TRANGE_StateInit( TA_TRANGE_State **state );
+
+TA_RetCode TA_TRANGE_StateUpdate( TA_TRANGE_State *state,
+                                  double        inHigh,
+                                  double        inLow,
+                                  double        inClose,
+                                  int          *outNBElement,
+                                  double       *outReal );
+
+TA_RetCode TA_TRANGE_StateFree( TA_TRANGE_State *state );
+
+/*
+ * TA_TRIMA - Triangular Moving Average
+ */
+typedef struct TA_TRIMA_State TA_TRIMA_State;
+
+TA_RetCode TA_TRIMA_StateInit( TA_TRIMA_State **state,
+                               int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_TRIMA_StateUpdate( TA_TRIMA_State *state,
+                                 double        inReal,
+                                 int          *outNBElement,
+                                 double       *outReal );
+
+TA_RetCode TA_TRIMA_StateFree( TA_TRIMA_State *state );
+
+/*
+ * TA_TRIX - 1-day Rate-Of-Change (ROC) of a Triple Smooth EMA
+ */
+typedef struct TA_TRIX_State TA_TRIX_State;
+
+TA_RetCode TA_TRIX_StateInit( TA_TRIX_State **state,
+                              int           optInTimePeriod ); /* From 1 to 100000 */
+
+TA_RetCode TA_TRIX_StateUpdate( TA_TRIX_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outReal );
+
+TA_RetCode TA_TRIX_StateFree( TA_TRIX_State *state );
+
+/*
+ * TA_ULTOSC - Ultimate Oscillator
+ */
+typedef struct TA_ULTOSC_State TA_ULTOSC_State;
+
+TA_RetCode TA_ULTOSC_StateInit( TA_ULTOSC_State **state,
+                                int           optInTimePeriod1, /* From 1 to 100000 */
+                                int           optInTimePeriod2, /* From 1 to 100000 */
+                                int           optInTimePeriod3 ); /* From 1 to 100000 */
+
+TA_RetCode TA_ULTOSC_StateUpdate( TA_ULTOSC_State *state,
+                                  double        inHigh,
+                                  double        inLow,
+                                  double        inClose,
+                                  int          *outNBElement,
+                                  double       *outReal );
+
+TA_RetCode TA_ULTOSC_StateFree( TA_ULTOSC_State *state );
+
+/*
+ * TA_VAR - Variance
+ */
+typedef struct TA_VAR_State TA_VAR_State;
+
+TA_RetCode TA_VAR_StateInit( TA_VAR_State **state,
+                             int           optInTimePeriod, /* From 1 to 100000 */
+                             double        optInNbDev ); /* From TA_REAL_MIN to TA_REAL_MAX */
+
+TA_RetCode TA_VAR_StateUpdate( TA_VAR_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_VAR_StateFree( TA_VAR_State *state );
+
+/*
+ * TA_WILLR - Williams' %R
+ */
+typedef struct TA_WILLR_State TA_WILLR_State;
+
+TA_RetCode TA_WILLR_StateInit( TA_WILLR_State **state,
+                               int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_WILLR_StateUpdate( TA_WILLR_State *state,
+                                 double        inHigh,
+                                 double        inLow,
+                                 double        inClose,
+                                 int          *outNBElement,
+                                 double       *outReal );
+
+TA_RetCode TA_WILLR_StateFree( TA_WILLR_State *state );
+
+/*
+ * TA_WMA - Weighted Moving Average
+ */
+typedef struct TA_WMA_State TA_WMA_State;
+
+TA_RetCode TA_WMA_StateInit( TA_WMA_State **state,
+                             int           optInTimePeriod ); /* From 2 to 100000 */
+
+TA_RetCode TA_WMA_StateUpdate( TA_WMA_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal );
+
+TA_RetCode TA_WMA_StateFree( TA_WMA_State *state );
+
+/*
+ * TA_HT - All the Hilbert Transform outputs
+ *
+ * The HT_* functions above each run their own Hilbert Transform. This
+ * state runs it once per bar and provides all their outputs, so a
+ * caller needing the cycle and the trend mode pays for one transform.
+ *
+ * Outputs start once all six HT functions have theirs. Outputs not
+ * wanted can be NULL.
+ *
+ * The dominant cycle phase, sine wave, trendline and trend mode are the
+ * same as the ones of the HT functions. TA_HT_DCPERIOD and TA_HT_PHASOR
+ * start their transform 25 bars earlier, so the dominant cycle period
+ * and phasor components here differ slightly from theirs, less and
+ * less as bars are consumed.
+ */
+typedef struct TA_HT_State TA_HT_State;
+
+TA_RetCode TA_HT_StateInit( TA_HT_State **state );
+
+TA_RetCode TA_HT_StateUpdate( TA_HT_State *state,
+                              double       inReal,
+                              int         *outNBElement,
+                              double      *outDCPeriod,
+                              double      *outDCPhase,
+                              double      *outInPhase,
+                              double      *outQuadrature,
+                              double      *outSine,
+                              double      *outLeadSine,
+                              double      *outTrendline,
+                              int         *outTrendMode );
+
+TA_RetCode TA_HT_StateFree( TA_HT_State *state );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/***************/
+/* End of File */
+/***************/
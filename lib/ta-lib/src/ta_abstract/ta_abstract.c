@@ -62,6 +62,7 @@
 #include <ctype.h>
 #include "ta_common.h"
 #include "../ta_common/ta_memory.h"
+#include "../ta_common/ta_global.h"
 #include "ta_abstract.h"
 #include "ta_def_ui.h"
 #include "ta_frame_priv.h"
@@ -73,6 +74,17 @@
 
 /**** External variables declarations. ****/
 
+#if defined( TA_REGISTRY )
+/* In a registry build the tables hold only the functions the
+ * application registered. They come from the ta_registry.h generated
+ * by ta_registry.py and are searched like gen_code searches the full
+ * tables, so nothing refers to any other function: the linker drops
+ * their code, frames and metadata.
+ */
+#include "ta_registry.h"
+#define TA_TABLE(letter)      TA_REG_Table##letter
+#define TA_TABLE_SIZE(letter) &TA_REG_Table##letter##Size
+#else
 /* The interface definition of all functions are accessible
  * through one of the following 26 tables.
  */
@@ -100,7 +112,18 @@ extern const unsigned int TA_DEF_TableASize, TA_DEF_TableBSize,
     TA_DEF_TableWSize, TA_DEF_TableXSize,
     TA_DEF_TableYSize, TA_DEF_TableZSize;
 
-#ifndef TA_GEN_CODE
+#define TA_TABLE(letter)      &TA_DEF_Table##letter
+#define TA_TABLE_SIZE(letter) &TA_DEF_Table##letter##Size
+#endif
+
+/* gen_code and the registry builds find the functions by going
+ * through the tables above instead of the generated indexes.
+ */
+#if defined( TA_GEN_CODE ) || defined( TA_REGISTRY )
+#define TA_SCAN_TABLES
+#endif
+
+#ifndef TA_SCAN_TABLES
 /* In gen_code, these value does not exist (they are generated by
  * gen_code itself!)
  * Consequently, the code, when being used to make the gen_code
@@ -109,6 +132,12 @@ extern const unsigned int TA_DEF_TableASize, TA_DEF_TableBSize,
  */
 extern const TA_FuncDef **TA_PerGroupFuncDef[];
 extern const unsigned int TA_PerGroupSize[];
+
+/* Perfect hash of the function names (see TA_FuncNameHash). */
+extern const unsigned int TA_FuncHashSize;
+extern const unsigned int TA_FuncHashNbBucket;
+extern const unsigned short TA_FuncHashDisplace[];
+extern const TA_FuncDef *TA_FuncHashTable[];
 #endif
 
 /**** Global variables definitions.    ****/
@@ -119,6 +148,12 @@ extern const unsigned int TA_PerGroupSize[];
 #define min(a, b) (((a) < (b)) ? (a) : (b))
 #endif
 
+/* Freed TA_ParamHolder kept by each TA_Context for reuse. */
+#define TA_PARAM_HOLDER_POOL_MAX 16
+
+/* Offset of each part of a TA_ParamHolder allocation. */
+#define TA_PARAM_HOLDER_ALIGN(x) (((x) + sizeof(double) - 1) & ~(sizeof(double) - 1))
+
 typedef struct
 {
    unsigned int magicNumber;
@@ -144,24 +179,24 @@ static TA_RetCode getFuncNameByIdx(TA_GroupId groupId,
 
 static const TA_FuncDef **TA_DEF_Tables[26] =
     {
-        &TA_DEF_TableA, &TA_DEF_TableB, &TA_DEF_TableC, &TA_DEF_TableD, &TA_DEF_TableE,
-        &TA_DEF_TableF, &TA_DEF_TableG, &TA_DEF_TableH, &TA_DEF_TableI, &TA_DEF_TableJ,
-        &TA_DEF_TableK, &TA_DEF_TableL, &TA_DEF_TableM, &TA_DEF_TableN, &TA_DEF_TableO,
-        &TA_DEF_TableP, &TA_DEF_TableQ, &TA_DEF_TableR, &TA_DEF_TableS, &TA_DEF_TableT,
-        &TA_DEF_TableU, &TA_DEF_TableV, &TA_DEF_TableW, &TA_DEF_TableX, &TA_DEF_TableY,
-        &TA_DEF_TableZ};
+        TA_TABLE(A), TA_TABLE(B), TA_TABLE(C), TA_TABLE(D), TA_TABLE(E),
+        TA_TABLE(F), TA_TABLE(G), TA_TABLE(H), TA_TABLE(I), TA_TABLE(J),
+        TA_TABLE(K), TA_TABLE(L), TA_TABLE(M), TA_TABLE(N), TA_TABLE(O),
+        TA_TABLE(P), TA_TABLE(Q), TA_TABLE(R), TA_TABLE(S), TA_TABLE(T),
+        TA_TABLE(U), TA_TABLE(V), TA_TABLE(W), TA_TABLE(X), TA_TABLE(Y),
+        TA_TABLE(Z)};
 
 static const unsigned int *TA_DEF_TablesSize[26] =
     {
-        &TA_DEF_TableASize, &TA_DEF_TableBSize, &TA_DEF_TableCSize,
-        &TA_DEF_TableDSize, &TA_DEF_TableESize, &TA_DEF_TableFSize,
-        &TA_DEF_TableGSize, &TA_DEF_TableHSize, &TA_DEF_TableISize,
-        &TA_DEF_TableJSize, &TA_DEF_TableKSize, &TA_DEF_TableLSize,
-        &TA_DEF_TableMSize, &TA_DEF_TableNSize, &TA_DEF_TableOSize,
-        &TA_DEF_TablePSize, &TA_DEF_TableQSize, &TA_DEF_TableRSize,
-        &TA_DEF_TableSSize, &TA_DEF_TableTSize, &TA_DEF_TableUSize,
-        &TA_DEF_TableVSize, &TA_DEF_TableWSize, &TA_DEF_TableXSize,
-        &TA_DEF_TableYSize, &TA_DEF_TableZSize};
+        TA_TABLE_SIZE(A), TA_TABLE_SIZE(B), TA_TABLE_SIZE(C),
+        TA_TABLE_SIZE(D), TA_TABLE_SIZE(E), TA_TABLE_SIZE(F),
+        TA_TABLE_SIZE(G), TA_TABLE_SIZE(H), TA_TABLE_SIZE(I),
+        TA_TABLE_SIZE(J), TA_TABLE_SIZE(K), TA_TABLE_SIZE(L),
+        TA_TABLE_SIZE(M), TA_TABLE_SIZE(N), TA_TABLE_SIZE(O),
+        TA_TABLE_SIZE(P), TA_TABLE_SIZE(Q), TA_TABLE_SIZE(R),
+        TA_TABLE_SIZE(S), TA_TABLE_SIZE(T), TA_TABLE_SIZE(U),
+        TA_TABLE_SIZE(V), TA_TABLE_SIZE(W), TA_TABLE_SIZE(X),
+        TA_TABLE_SIZE(Y), TA_TABLE_SIZE(Z)};
 
 /**** Global functions definitions.   ****/
 TA_RetCode TA_GroupTableAlloc(TA_StringTable **table)
@@ -365,8 +400,69 @@ TA_RetCode TA_FuncTableFree(TA_StringTable *table)
    return TA_SUCCESS;
 }
 
+/* Hash of a function name, used by TA_GetFuncHandle and by
+ * gen_code when building the TA_FuncHashTable.
+ */
+unsigned int TA_FuncNameHash(const char *name, unsigned int seed)
+{
+   unsigned int hash;
+
+   /* FNV-1a, followed by a mix so the low bits depend on all characters. */
+   hash = 2166136261u ^ (seed * 0x9E3779B9u);
+   while (*name != '\0')
+   {
+      hash ^= (unsigned char)*name++;
+      hash *= 16777619u;
+   }
+
+   hash ^= hash >> 15;
+   hash *= 0x2C1B3C6Du;
+   hash ^= hash >> 12;
+
+   return hash;
+}
+
 TA_RetCode TA_GetFuncHandle(const char *name, const TA_FuncHandle **handle)
 {
+#ifndef TA_SCAN_TABLES
+   const TA_FuncDef *funcDef;
+   unsigned int bucket, slot;
+
+   if ((name == NULL) || (handle == NULL))
+   {
+      return TA_BAD_PARAM;
+   }
+
+   *handle = NULL;
+
+   if (name[0] == '\0')
+   {
+      return TA_BAD_PARAM;
+   }
+
+   /* The generated hash gives each function its own slot. Any
+    * other name falls on an empty slot or on a different function.
+    */
+   bucket = TA_FuncNameHash(name, 0) & (TA_FuncHashNbBucket - 1);
+   slot = TA_FuncNameHash(name, TA_FuncHashDisplace[bucket]) & (TA_FuncHashSize - 1);
+
+   funcDef = TA_FuncHashTable[slot];
+   if (!funcDef)
+   {
+      return TA_FUNC_NOT_FOUND;
+   }
+
+   if (!funcDef->funcInfo)
+      return TA_INTERNAL_ERROR(3);
+
+   if (strcmp(funcDef->funcInfo->name, name) != 0)
+   {
+      return TA_FUNC_NOT_FOUND;
+   }
+
+   *handle = (TA_FuncHandle *)funcDef;
+   return TA_SUCCESS;
+#else
    char firstChar, tmp;
    const TA_FuncDef **funcDefTable;
    const TA_FuncDef *funcDef;
@@ -427,6 +523,7 @@ TA_RetCode TA_GetFuncHandle(const char *name, const TA_FuncHandle **handle)
    }
 
    return TA_FUNC_NOT_FOUND;
+#endif
 }
 
 TA_RetCode TA_GetFuncInfo(const TA_FuncHandle *handle,
@@ -600,12 +697,13 @@ TA_RetCode TA_ParamHolderAlloc(const TA_FuncHandle *handle,
 
    TA_FuncDef *funcDef;
    unsigned int allocSize, i;
+   unsigned int privOffset, inOffset, optInOffset, outOffset;
    TA_ParamHolderInput *input;
    TA_ParamHolderOptInput *optInput;
    TA_ParamHolderOutput *output;
 
    const TA_FuncInfo *funcInfo;
-   TA_ParamHolder *newParams;
+   TA_ParamHolder *newParams, *prevParams;
    TA_ParamHolderPriv *newParamsPriv;
 
    const TA_InputParameterInfo **inputInfo;
@@ -631,65 +729,66 @@ TA_RetCode TA_ParamHolderAlloc(const TA_FuncHandle *handle,
    if (!funcInfo)
       return TA_INVALID_HANDLE;
 
-   /* Allocate the TA_ParamHolder. */
-   newParams = (TA_ParamHolder *)TA_Malloc(sizeof(TA_ParamHolder) + sizeof(TA_ParamHolderPriv));
-   if (!newParams)
-   {
-      *allocatedParams = NULL;
-      return TA_ALLOC_ERR;
-   }
-
-   memset(newParams, 0, sizeof(TA_ParamHolder) + sizeof(TA_ParamHolderPriv));
-   newParamsPriv = (TA_ParamHolderPriv *)(((char *)newParams) + sizeof(TA_ParamHolder));
-   newParamsPriv->magicNumber = TA_PARAM_HOLDER_PRIV_MAGIC_NB;
-   newParams->hiddenData = newParamsPriv;
-
-   /* From this point, TA_ParamHolderFree can be safely called. */
-
-   /* Allocate the array of structure holding the info
-    * for each parameter.
-    */
    if (funcInfo->nbInput == 0)
       return TA_INTERNAL_ERROR(2);
 
-   allocSize = (funcInfo->nbInput) * sizeof(TA_ParamHolderInput);
-   input = (TA_ParamHolderInput *)TA_Malloc(allocSize);
-
-   if (!input)
+   /* The TA_ParamHolder, its TA_ParamHolderPriv and the array of
+    * structure holding the info for each parameter are all in
+    * one allocation.
+    */
+   privOffset = TA_PARAM_HOLDER_ALIGN(sizeof(TA_ParamHolder));
+   inOffset = privOffset + TA_PARAM_HOLDER_ALIGN(sizeof(TA_ParamHolderPriv));
+   optInOffset = inOffset + TA_PARAM_HOLDER_ALIGN((funcInfo->nbInput) * sizeof(TA_ParamHolderInput));
+   outOffset = optInOffset + TA_PARAM_HOLDER_ALIGN((funcInfo->nbOptInput) * sizeof(TA_ParamHolderOptInput));
+   allocSize = outOffset + (funcInfo->nbOutput) * sizeof(TA_ParamHolderOutput);
+
+   /* Reuse a freed TA_ParamHolder of the same function when
+    * there is one in the pool. Pooled holders are linked
+    * through their hiddenData.
+    */
+   prevParams = NULL;
+   newParams = (TA_ParamHolder *)TA_Globals->paramHolderPool;
+   while (newParams)
    {
-      TA_ParamHolderFree(newParams);
-      *allocatedParams = NULL;
-      return TA_ALLOC_ERR;
+      newParamsPriv = (TA_ParamHolderPriv *)(((char *)newParams) + privOffset);
+      if (newParamsPriv->funcInfo == funcInfo)
+      {
+         if (prevParams)
+            prevParams->hiddenData = newParams->hiddenData;
+         else
+            TA_Globals->paramHolderPool = newParams->hiddenData;
+         TA_Globals->paramHolderPoolSize--;
+         break;
+      }
+      prevParams = newParams;
+      newParams = (TA_ParamHolder *)newParams->hiddenData;
    }
-   memset(input, 0, allocSize);
-   newParamsPriv->in = input;
 
-   if (funcInfo->nbOptInput == 0)
-      optInput = NULL;
-   else
+   if (!newParams)
    {
-      allocSize = (funcInfo->nbOptInput) * sizeof(TA_ParamHolderOptInput);
-      optInput = (TA_ParamHolderOptInput *)TA_Malloc(allocSize);
-
-      if (!optInput)
+      newParams = (TA_ParamHolder *)TA_Malloc(allocSize);
+      if (!newParams)
       {
-         TA_ParamHolderFree(newParams);
          *allocatedParams = NULL;
          return TA_ALLOC_ERR;
       }
-      memset(optInput, 0, allocSize);
    }
+
+   memset(newParams, 0, allocSize);
+   newParamsPriv = (TA_ParamHolderPriv *)(((char *)newParams) + privOffset);
+   newParamsPriv->magicNumber = TA_PARAM_HOLDER_PRIV_MAGIC_NB;
+   newParams->hiddenData = newParamsPriv;
+
+   input = (TA_ParamHolderInput *)(((char *)newParams) + inOffset);
+   newParamsPriv->in = input;
+
+   if (funcInfo->nbOptInput == 0)
+      optInput = NULL;
+   else
+      optInput = (TA_ParamHolderOptInput *)(((char *)newParams) + optInOffset);
    newParamsPriv->optIn = optInput;
 
-   allocSize = (funcInfo->nbOutput) * sizeof(TA_ParamHolderOutput);
-   output = (TA_ParamHolderOutput *)TA_Malloc(allocSize);
-   if (!output)
-   {
-      TA_ParamHolderFree(newParams);
-      *allocatedParams = NULL;
-      return TA_ALLOC_ERR;
-   }
-   memset(output, 0, allocSize);
+   output = (TA_ParamHolderOutput *)(((char *)newParams) + outOffset);
    newParamsPriv->out = output;
 
    newParamsPriv->funcInfo = funcInfo;
@@ -731,10 +830,6 @@ TA_RetCode TA_ParamHolderFree(TA_ParamHolder *paramsToFree)
 {
    TA_ParamHolderPriv *paramPriv;
 
-   TA_ParamHolderInput *input;
-   TA_ParamHolderOptInput *optInput;
-   TA_ParamHolderOutput *output;
-
    if (!paramsToFree)
    {
       return TA_SUCCESS;
@@ -752,17 +847,15 @@ TA_RetCode TA_ParamHolderFree(TA_ParamHolder *paramsToFree)
       return TA_INVALID_PARAM_HOLDER;
    }
 
-   optInput = paramPriv->optIn;
-   if (optInput)
-      TA_Free(optInput);
-
-   input = paramPriv->in;
-   if (input)
-      TA_Free(input);
-
-   output = paramPriv->out;
-   if (output)
-      TA_Free(output);
+   /* Keep it for the next TA_ParamHolderAlloc of that function. */
+   if (TA_Globals->paramHolderPoolSize < TA_PARAM_HOLDER_POOL_MAX)
+   {
+      paramPriv->magicNumber = 0;
+      paramsToFree->hiddenData = TA_Globals->paramHolderPool;
+      TA_Globals->paramHolderPool = paramsToFree;
+      TA_Globals->paramHolderPoolSize++;
+      return TA_SUCCESS;
+   }
 
    TA_Free(paramsToFree);
 
@@ -1231,8 +1324,8 @@ static TA_RetCode getGroupId(const char *groupString, unsigned int *groupId)
 
 static TA_RetCode getGroupSize(TA_GroupId groupId, unsigned int *groupSize)
 {
-#ifdef TA_GEN_CODE
-   /* Code used only when compiled with gen_code. */
+#ifdef TA_SCAN_TABLES
+   /* Code used when compiled with gen_code or a registry. */
 
    unsigned int i, j;
    const TA_FuncDef **funcDefTable;
@@ -1280,8 +1373,8 @@ static TA_RetCode getFuncNameByIdx(TA_GroupId groupId,
                                    const char **stringPtr)
 #endif
 {
-#ifdef TA_GEN_CODE
-   /* Code used only when compiled with gen_code. */
+#ifdef TA_SCAN_TABLES
+   /* Code used when compiled with gen_code or a registry. */
 
    unsigned int curIdx;
    unsigned int i, j, found;
@@ -168,6 +168,9 @@ typedef struct
    const TA_FrameLookback lookback;
 } TA_FuncDef;
 
+/* Hash of a function name, see TA_FuncHashTable in ta_group_idx.c */
+unsigned int TA_FuncNameHash( const char *name, unsigned int seed );
+
 /* The following MACROs are helpers being used in
  * the tables\table<a..z>.c files.
  */
@@ -40,9 +40,13 @@
  *       TA_PerGroupFuncDef
  *       TA_PerGroupSize
  *       TA_TotalNbFunction
+ *       TA_FuncHashTable (and its TA_FuncHashDisplace)
  *
  * These constant allows mainly to speed optimize functionality related to
  * sequential access to TA_DefFunc by TA_GroupId (see ta_abstract.c)
+ *
+ * TA_FuncHashTable is a perfect hash of the function names used
+ * by TA_GetFuncHandle.
  */
 #include <stddef.h>
 #include "ta_def_ui.h"
@@ -442,6 +446,275 @@ SIZE_GROUP_7+
 SIZE_GROUP_8+
 SIZE_GROUP_9;
 
+/* Generated */ const unsigned int TA_FuncHashSize = 256;
+/* Generated */ const unsigned int TA_FuncHashNbBucket = 64;
+
+/* Generated */ const unsigned short TA_FuncHashDisplace[64] = {
+2,3,1,3,1,1,1,1,2,1,6,1,3,0,3,1,
+0,1,4,2,2,2,4,0,2,2,8,6,1,4,2,1,
+10,5,3,0,1,11,1,1,0,1,4,6,0,8,4,7,
+4,2,1,1,3,9,2,2,1,3,1,2,1,1,5,2
+/* Generated */ };
+
+/* Generated */ const TA_FuncDef *TA_FuncHashTable[256] = {
+&TA_DEF_LINEARREG,
+NULL,
+NULL,
+NULL,
+&TA_DEF_CDLHIKKAKE,
+&TA_DEF_COS,
+&TA_DEF_TYPPRICE,
+&TA_DEF_CDLSPINNINGTOP,
+&TA_DEF_CDLSTALLEDPATTERN,
+&TA_DEF_CDLHANGINGMAN,
+NULL,
+NULL,
+NULL,
+&TA_DEF_CDLTRISTAR,
+&TA_DEF_ADOSC,
+&TA_DEF_CDLGAPSIDESIDEWHITE,
+&TA_DEF_CDLGRAVESTONEDOJI,
+&TA_DEF_MACDFIX,
+NULL,
+NULL,
+NULL,
+NULL,
+&TA_DEF_CEIL,
+&TA_DEF_ROCR100,
+&TA_DEF_HT_DCPHASE,
+NULL,
+&TA_DEF_MAXINDEX,
+&TA_DEF_CDL3INSIDE,
+&TA_DEF_MIN,
+&TA_DEF_CDLBREAKAWAY,
+&TA_DEF_ROC,
+&TA_DEF_CDLRICKSHAWMAN,
+&TA_DEF_CORREL,
+NULL,
+NULL,
+NULL,
+&TA_DEF_CDLTHRUSTING,
+&TA_DEF_CDLDARKCLOUDCOVER,
+NULL,
+NULL,
+&TA_DEF_TEMA,
+&TA_DEF_MAX,
+&TA_DEF_EXP,
+NULL,
+NULL,
+&TA_DEF_STDDEV,
+NULL,
+&TA_DEF_CDLHIKKAKEMOD,
+&TA_DEF_CDLMATHOLD,
+&TA_DEF_CDLSTICKSANDWICH,
+&TA_DEF_MULT,
+&TA_DEF_MAMA,
+NULL,
+&TA_DEF_TRIMA,
+&TA_DEF_CDLPIERCING,
+&TA_DEF_CDLONNECK,
+&TA_DEF_CDLRISEFALL3METHODS,
+NULL,
+&TA_DEF_WILLR,
+&TA_DEF_CDLLONGLEGGEDDOJI,
+&TA_DEF_LINEARREG_SLOPE,
+&TA_DEF_MINMAXINDEX,
+NULL,
+&TA_DEF_SMA,
+&TA_DEF_ADXR,
+&TA_DEF_HT_DCPERIOD,
+&TA_DEF_LINEARREG_ANGLE,
+&TA_DEF_STOCH,
+NULL,
+&TA_DEF_FLOOR,
+NULL,
+NULL,
+&TA_DEF_AROON,
+&TA_DEF_CDLEVENINGSTAR,
+&TA_DEF_NATR,
+&TA_DEF_PLUS_DM,
+NULL,
+&TA_DEF_HT_TRENDMODE,
+NULL,
+NULL,
+&TA_DEF_DIV,
+NULL,
+&TA_DEF_BETA,
+&TA_DEF_PPO,
+&TA_DEF_MININDEX,
+&TA_DEF_CDLSHOOTINGSTAR,
+&TA_DEF_MINUS_DM,
+&TA_DEF_CMO,
+NULL,
+&TA_DEF_CDLIDENTICAL3CROWS,
+&TA_DEF_CDLCONCEALBABYSWALL,
+NULL,
+&TA_DEF_MAVP,
+&TA_DEF_CDLMORNINGSTAR,
+NULL,
+&TA_DEF_LN,
+&TA_DEF_CDLHIGHWAVE,
+NULL,
+&TA_DEF_ASIN,
+NULL,
+NULL,
+&TA_DEF_CDLTASUKIGAP,
+&TA_DEF_MINUS_DI,
+NULL,
+NULL,
+&TA_DEF_OBV,
+NULL,
+NULL,
+NULL,
+&TA_DEF_CDLMARUBOZU,
+&TA_DEF_MACD,
+&TA_DEF_CDLINVERTEDHAMMER,
+NULL,
+&TA_DEF_MINMAX,
+NULL,
+NULL,
+&TA_DEF_TRANGE,
+NULL,
+&TA_DEF_CDL3STARSINSOUTH,
+NULL,
+NULL,
+&TA_DEF_PLUS_DI,
+&TA_DEF_ADD,
+NULL,
+NULL,
+&TA_DEF_ULTOSC,
+NULL,
+&TA_DEF_CDL3LINESTRIKE,
+&TA_DEF_CDLHARAMI,
+&TA_DEF_ROCR,
+&TA_DEF_EMA,
+NULL,
+&TA_DEF_AROONOSC,
+&TA_DEF_BOP,
+&TA_DEF_CDLENGULFING,
+&TA_DEF_CDLKICKINGBYLENGTH,
+&TA_DEF_CDLXSIDEGAP3METHODS,
+&TA_DEF_SQRT,
+NULL,
+NULL,
+&TA_DEF_CDLINNECK,
+NULL,
+&TA_DEF_TANH,
+NULL,
+NULL,
+NULL,
+NULL,
+NULL,
+&TA_DEF_HT_PHASOR,
+&TA_DEF_CDLKICKING,
+&TA_DEF_DX,
+&TA_DEF_APO,
+&TA_DEF_CDLHOMINGPIGEON,
+&TA_DEF_WMA,
+NULL,
+&TA_DEF_AVGPRICE,
+NULL,
+NULL,
+&TA_DEF_CDL2CROWS,
+&TA_DEF_ROCP,
+NULL,
+NULL,
+&TA_DEF_SUB,
+&TA_DEF_BBANDS,
+NULL,
+&TA_DEF_LOG10,
+&TA_DEF_WCLPRICE,
+&TA_DEF_MEDPRICE,
+&TA_DEF_T3,
+NULL,
+NULL,
+&TA_DEF_AD,
+&TA_DEF_ACOS,
+NULL,
+&TA_DEF_CDL3OUTSIDE,
+&TA_DEF_CDLHAMMER,
+NULL,
+&TA_DEF_SUM,
+NULL,
+NULL,
+&TA_DEF_HT_TRENDLINE,
+NULL,
+NULL,
+&TA_DEF_ATR,
+&TA_DEF_STOCHRSI,
+&TA_DEF_MFI,
+&TA_DEF_VAR,
+&TA_DEF_MA,
+NULL,
+NULL,
+NULL,
+NULL,
+&TA_DEF_CDLABANDONEDBABY,
+&TA_DEF_CDLLADDERBOTTOM,
+&TA_DEF_MACDEXT,
+&TA_DEF_CDLDRAGONFLYDOJI,
+NULL,
+NULL,
+NULL,
+NULL,
+NULL,
+NULL,
+&TA_DEF_SIN,
+NULL,
+&TA_DEF_TAN,
+&TA_DEF_TRIX,
+&TA_DEF_HT_SINE,
+&TA_DEF_CDLDOJISTAR,
+&TA_DEF_CCI,
+&TA_DEF_DEMA,
+&TA_DEF_SAREXT,
+NULL,
+&TA_DEF_CDLEVENINGDOJISTAR,
+&TA_DEF_CDLMORNINGDOJISTAR,
+&TA_DEF_LINEARREG_INTERCEPT,
+&TA_DEF_CDLUNIQUE3RIVER,
+&TA_DEF_MOM,
+&TA_DEF_CDLSEPARATINGLINES,
+NULL,
+&TA_DEF_CDLUPSIDEGAP2CROWS,
+&TA_DEF_COSH,
+&TA_DEF_CDLBELTHOLD,
+&TA_DEF_CDLCOUNTERATTACK,
+NULL,
+&TA_DEF_CDLMATCHINGLOW,
+&TA_DEF_CDLCLOSINGMARUBOZU,
+&TA_DEF_MIDPOINT,
+NULL,
+&TA_DEF_CDLSHORTLINE,
+&TA_DEF_CDLTAKURI,
+NULL,
+&TA_DEF_TSF,
+&TA_DEF_MIDPRICE,
+&TA_DEF_CDL3WHITESOLDIERS,
+&TA_DEF_ATAN,
+NULL,
+NULL,
+&TA_DEF_ADX,
+NULL,
+&TA_DEF_SAR,
+NULL,
+&TA_DEF_CDLLONGLINE,
+NULL,
+&TA_DEF_RSI,
+&TA_DEF_CDL3BLACKCROWS,
+NULL,
+&TA_DEF_STOCHF,
+NULL,
+&TA_DEF_KAMA,
+&TA_DEF_CDLADVANCEBLOCK,
+NULL,
+NULL,
+&TA_DEF_CDLHARAMICROSS,
+&TA_DEF_CDLDOJI,
+NULL,
+&TA_DEF_SINH
+/* Generated */ };
+
 /***************/
 /* End of File */
 /***************/
@@ -62,7 +62,9 @@
 #include "ta_common.h"
 #include "ta_magic_nb.h"
 #include "ta_global.h"
+#include "ta_memory.h"
 #include "ta_func.h"
+#include "ta_abstract.h"
 
 /**** External functions declarations. ****/
 /* None */
@@ -73,15 +75,24 @@
 /**** Global variables definitions.    ****/
 
 /* The entry point for all globals */
-TA_LibcPriv ta_theGlobals = {0,{{0,0,0}},0,0,0,0,(TA_Compatibility)0,{0},{{(TA_CandleSettingType)0,(TA_RangeType)0,0,0}}};
+TA_LibcPriv ta_theGlobals = {0,{{0,0,0}},0,0,0,0,(TA_Compatibility)0,{0},{{(TA_CandleSettingType)0,(TA_RangeType)0,0,0}},
+                             0,0,0,0,  /* Allocator */
+                             0,0,0,0,0,/* Workspace */
+                             0,0};     /* ParamHolder pool */
 
-TA_LibcPriv *TA_Globals = &ta_theGlobals;
+/* Each thread starts on the shared settings. */
+TA_THREAD_LOCAL TA_LibcPriv *TA_Globals = &ta_theGlobals;
 
 /**** Local declarations.              ****/
-/* None */
+
+/* Workspace blocks are kept aligned for any TA-Lib array type. */
+#define TA_WORKSPACE_ALIGN sizeof(double)
+#define TA_WORKSPACE_ROUND(x) (((x)+TA_WORKSPACE_ALIGN-1) & ~(size_t)(TA_WORKSPACE_ALIGN-1))
 
 /**** Local functions declarations.    ****/
-/* None */
+static void freeParamHolderPool( TA_LibcPriv *globals );
+static void restoreCandleDefaultSettings( TA_LibcPriv *globals,
+                                          TA_CandleSettingType settingType );
 
 /**** Local variables definitions.     ****/
 /* None */
@@ -89,27 +100,41 @@ TA_LibcPriv *TA_Globals = &ta_theGlobals;
 /**** Global functions definitions.   ****/
 TA_RetCode TA_Initialize( void )
 {
+   /* Always initialize the shared settings, even when the calling
+    * thread has a TA_Context bound. That context stays bound.
+    */
+   TA_LibcPriv *globals = &ta_theGlobals;
+
+   /* Initializing again, release what was kept from before. */
+   if( globals->magicNb == TA_LIBC_PRIV_MAGIC_NB )
+      freeParamHolderPool( globals );
+
    /* Initialize the "global variable" used to manage the global
     * variables of all other modules...
     */
-   memset( TA_Globals, 0, sizeof( TA_LibcPriv ) );
-   TA_Globals->magicNb = TA_LIBC_PRIV_MAGIC_NB;	  
+   memset( globals, 0, sizeof( TA_LibcPriv ) );
+   globals->magicNb = TA_LIBC_PRIV_MAGIC_NB;	  
 
    /*** At this point, TA_Shutdown can be called to clean-up. ***/
 
    /* Set the default value to global variables */
-   TA_RestoreCandleDefaultSettings( TA_AllCandleSettings );
+   restoreCandleDefaultSettings( globals, TA_AllCandleSettings );
 
    return TA_SUCCESS;
 }
 
 TA_RetCode TA_Shutdown( void )
 {
-   if( TA_Globals->magicNb != TA_LIBC_PRIV_MAGIC_NB )
+   /* Like TA_Initialize, only the shared settings are affected. */
+   TA_LibcPriv *globals = &ta_theGlobals;
+
+   if( globals->magicNb != TA_LIBC_PRIV_MAGIC_NB )
       return TA_LIB_NOT_INITIALIZE;
 
+   freeParamHolderPool( globals );
+
    /* Initialize to all zero to make sure we invalidate that object. */
-   memset( TA_Globals, 0, sizeof( TA_LibcPriv ) );
+   memset( globals, 0, sizeof( TA_LibcPriv ) );
 
    return TA_SUCCESS;
 }
@@ -132,6 +157,208 @@ TA_RetCode TA_SetCandleSettings( TA_CandleSettingType settingType,
 }
 
 TA_RetCode TA_RestoreCandleDefaultSettings( TA_CandleSettingType settingType )
+{
+    if( settingType > TA_AllCandleSettings )
+        return TA_BAD_PARAM;
+    restoreCandleDefaultSettings( TA_Globals, settingType );
+    return TA_SUCCESS;
+}
+
+TA_RetCode TA_ContextAlloc( TA_Context **context )
+{
+   TA_LibcPriv *newContext;
+
+   if( !context )
+      return TA_BAD_PARAM;
+
+   *context = NULL;
+
+   if( TA_Globals->magicNb != TA_LIBC_PRIV_MAGIC_NB )
+      return TA_LIB_NOT_INITIALIZE;
+
+   newContext = (TA_LibcPriv *)malloc( sizeof( TA_LibcPriv ) );
+   if( !newContext )
+      return TA_ALLOC_ERR;
+
+   /* Start from the settings currently seen by the calling thread.
+    * The workspace is not shared: each context provides its own.
+    */
+   memcpy( newContext, TA_Globals, sizeof( TA_LibcPriv ) );
+   newContext->workspace     = NULL;
+   newContext->workspaceSize = 0;
+   newContext->workspaceUsed = 0;
+   newContext->workspacePeak = 0;
+   newContext->workspaceLive = 0;
+   newContext->paramHolderPool     = NULL;
+   newContext->paramHolderPoolSize = 0;
+
+   *context = newContext;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ContextFree( TA_Context *context )
+{
+   if( !context )
+      return TA_BAD_PARAM;
+
+   if( context == &ta_theGlobals )
+      return TA_BAD_OBJECT;
+
+   if( context->magicNb != TA_LIBC_PRIV_MAGIC_NB )
+      return TA_BAD_OBJECT;
+
+   if( TA_Globals == context )
+      TA_Globals = &ta_theGlobals;
+
+   freeParamHolderPool( context );
+
+   /* Invalidate the object before freeing it. */
+   memset( context, 0, sizeof( TA_LibcPriv ) );
+   free( context );
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_SetThreadContext( TA_Context *context )
+{
+   if( !context )
+   {
+      TA_Globals = &ta_theGlobals;
+      return TA_SUCCESS;
+   }
+
+   if( context->magicNb != TA_LIBC_PRIV_MAGIC_NB )
+      return TA_BAD_OBJECT;
+
+   TA_Globals = context;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_SetAllocator( TA_AllocFunc allocFunc,
+                            TA_ReallocFunc reallocFunc,
+                            TA_FreeFunc freeFunc,
+                            void *opaque )
+{
+   if( !allocFunc || !reallocFunc || !freeFunc )
+   {
+      if( allocFunc || reallocFunc || freeFunc )
+         return TA_BAD_PARAM;
+      opaque = NULL;
+   }
+
+   TA_Globals->allocFunc   = allocFunc;
+   TA_Globals->reallocFunc = reallocFunc;
+   TA_Globals->freeFunc    = freeFunc;
+   TA_Globals->allocOpaque = opaque;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_SetWorkspace( void *buffer, size_t size )
+{
+   size_t skip;
+
+   /* Cannot be swapped while temporaries are taken from it. */
+   if( TA_Globals->workspaceLive != 0 )
+      return TA_BAD_OBJECT;
+
+   TA_Globals->workspace     = NULL;
+   TA_Globals->workspaceSize = 0;
+   TA_Globals->workspaceUsed = 0;
+   TA_Globals->workspacePeak = 0;
+
+   if( !buffer || size == 0 )
+      return TA_SUCCESS;
+
+   skip = TA_WORKSPACE_ROUND( (size_t)buffer ) - (size_t)buffer;
+   if( size <= skip )
+      return TA_BAD_PARAM;
+
+   TA_Globals->workspace     = (char *)buffer + skip;
+   TA_Globals->workspaceSize = size - skip;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_GetWorkspacePeak( size_t *peak )
+{
+   if( !peak )
+      return TA_BAD_PARAM;
+
+   *peak = TA_Globals->workspacePeak;
+   return TA_SUCCESS;
+}
+
+void *TA_PrivMalloc( size_t size )
+{
+   if( TA_Globals->allocFunc )
+      return TA_Globals->allocFunc( size, TA_Globals->allocOpaque );
+   return malloc( size );
+}
+
+void *TA_PrivRealloc( void *ptr, size_t size )
+{
+   if( TA_Globals->reallocFunc )
+      return TA_Globals->reallocFunc( ptr, size, TA_Globals->allocOpaque );
+   return realloc( ptr, size );
+}
+
+void TA_PrivFree( void *ptr )
+{
+   if( !ptr )
+      return;
+   if( TA_Globals->freeFunc )
+      TA_Globals->freeFunc( ptr, TA_Globals->allocOpaque );
+   else
+      free( ptr );
+}
+
+void *TA_PrivArrayAlloc( size_t size )
+{
+   TA_LibcPriv *globals = TA_Globals;
+   size_t blockSize;
+   void *block;
+
+   if( globals->workspace )
+   {
+      blockSize = TA_WORKSPACE_ROUND( size );
+      if( blockSize <= globals->workspaceSize - globals->workspaceUsed )
+      {
+         block = globals->workspace + globals->workspaceUsed;
+         globals->workspaceUsed += blockSize;
+         globals->workspaceLive++;
+         if( globals->workspaceUsed > globals->workspacePeak )
+            globals->workspacePeak = globals->workspaceUsed;
+         return block;
+      }
+   }
+
+   return TA_PrivMalloc( size );
+}
+
+void TA_PrivArrayFree( void *ptr )
+{
+   TA_LibcPriv *globals = TA_Globals;
+   char *block = (char *)ptr;
+
+   if( globals->workspace &&
+       block >= globals->workspace &&
+       block < globals->workspace + globals->workspaceSize )
+   {
+      /* Temporaries may be freed in any order: the whole
+       * workspace is reclaimed once the last one is back.
+       */
+      if( globals->workspaceLive > 0 && --globals->workspaceLive == 0 )
+         globals->workspaceUsed = 0;
+      return;
+   }
+
+   TA_PrivFree( ptr );
+}
+
+/**** Local functions definitions.     ****/
+static void restoreCandleDefaultSettings( TA_LibcPriv *globals,
+                                          TA_CandleSettingType settingType )
 {
     const TA_CandleSetting TA_CandleDefaultSettings[] = {
         /* real body is long when it's longer than the average of the 10 previous candles' real body */
@@ -162,17 +389,31 @@ TA_RetCode TA_RestoreCandleDefaultSettings( TA_CandleSettingType settingType )
     };
 
     int i;
-    if( settingType > TA_AllCandleSettings )
-        return TA_BAD_PARAM;
     if( settingType == TA_AllCandleSettings )
         for( i = 0; i < TA_AllCandleSettings; ++i )
-            TA_Globals->candleSettings[i] = TA_CandleDefaultSettings[i];
+            globals->candleSettings[i] = TA_CandleDefaultSettings[i];
     else
-        TA_Globals->candleSettings[settingType] = TA_CandleDefaultSettings[settingType];
-    return TA_SUCCESS;
+        globals->candleSettings[settingType] = TA_CandleDefaultSettings[settingType];
 }
 
-/**** Local functions definitions.     ****/
-/* None */
+static void freeParamHolderPool( TA_LibcPriv *globals )
+{
+   TA_ParamHolder *params, *next;
+
+   /* Pooled TA_ParamHolder are linked through their hiddenData. */
+   params = (TA_ParamHolder *)globals->paramHolderPool;
+   while( params )
+   {
+      next = (TA_ParamHolder *)params->hiddenData;
+      if( globals->freeFunc )
+         globals->freeFunc( params, globals->allocOpaque );
+      else
+         free( params );
+      params = next;
+   }
+
+   globals->paramHolderPool     = NULL;
+   globals->paramHolderPoolSize = 0;
+}
 
 
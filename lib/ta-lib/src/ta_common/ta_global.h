@@ -88,8 +88,8 @@ typedef struct
   void *global;
 } TA_ModuleControl;
 
-/* This is the hidden implementation of TA_Libc. */
-typedef struct
+/* This is the hidden implementation of TA_Libc, also used as TA_Context. */
+typedef struct TA_LibcPriv
 {
    unsigned int magicNb; /* Unique identifier of this object. */
    TA_ModuleControl moduleControl[TA_NB_GLOBAL_ID];
@@ -109,11 +109,42 @@ typedef struct
    /* For handling the candlestick global settings */
    TA_CandleSetting candleSettings[TA_AllCandleSettings];
 
+   /* Allocator behind TA_Malloc/TA_Realloc/TA_Free, NULL for the C library. */
+   TA_AllocFunc allocFunc;
+   TA_ReallocFunc reallocFunc;
+   TA_FreeFunc freeFunc;
+   void *allocOpaque;
+
+   /* Caller-provided buffer for the ARRAY_ALLOC temporaries. */
+   char *workspace;
+   size_t workspaceSize;
+   size_t workspaceUsed;
+   size_t workspacePeak;
+   unsigned int workspaceLive; /* Temporaries not yet freed. */
+
+   /* Freed TA_ParamHolder kept for reuse by TA_ParamHolderAlloc. */
+   void *paramHolderPool;
+   unsigned int paramHolderPoolSize;
+
 } TA_LibcPriv;
 
+/* Storage class for per-thread variables. Without compiler
+ * support, all threads share the same variable.
+ */
+#if defined( _MSC_VER )
+   #define TA_THREAD_LOCAL __declspec(thread)
+#elif defined( __GNUC__ )
+   #define TA_THREAD_LOCAL __thread
+#else
+   #define TA_THREAD_LOCAL
+#endif
+
 /* The following global is used all over the place 
  * and is the entry point for all other globals.
+ *
+ * Each thread has its own pointer: it refers to the shared
+ * settings unless a TA_Context was bound with TA_SetThreadContext.
  */
-extern TA_LibcPriv *TA_Globals;
+extern TA_THREAD_LOCAL TA_LibcPriv *TA_Globals;
 
 #endif
@@ -8,10 +8,21 @@
 
    #include <stdlib.h> 
 
+   /* Go through the allocator set with TA_SetAllocator. */
+   void *TA_PrivMalloc( size_t size );
+   void *TA_PrivRealloc( void *ptr, size_t size );
+   void  TA_PrivFree( void *ptr );
+
+   /* Temporary arrays, taken from the workspace set with
+    * TA_SetWorkspace when there is room left.
+    */
+   void *TA_PrivArrayAlloc( size_t size );
+   void  TA_PrivArrayFree( void *ptr );
+
    /* Interface macros */
-   #define TA_Malloc(a)       malloc(a)
-   #define TA_Realloc(a,b)    realloc((a),(b))
-   #define TA_Free(a)         free(a)
+   #define TA_Malloc(a)       TA_PrivMalloc(a)
+   #define TA_Realloc(a,b)    TA_PrivRealloc((a),(b))
+   #define TA_Free(a)         TA_PrivFree(a)
 
    #define FREE_IF_NOT_NULL(x) { if((x)!=NULL) {TA_Free((void *)(x)); (x)=NULL;} }
 
@@ -48,11 +59,11 @@
 #else
    #define ARRAY_VTYPE_REF(type,name)             type *name
    #define ARRAY_VTYPE_LOCAL(type,name,size)      type name[size]
-   #define ARRAY_VTYPE_ALLOC(type,name,size)      name = (type *)TA_Malloc( sizeof(type)*(size))
+   #define ARRAY_VTYPE_ALLOC(type,name,size)      name = (type *)TA_PrivArrayAlloc( sizeof(type)*(size))
    #define ARRAY_VTYPE_COPY(type,dest,src,size)   memcpy(dest,src,sizeof(type)*(size))
    #define ARRAY_VTYPE_MEMMOVE(type,dest,destIdx,src,srcIdx,size) memmove( &dest[destIdx], &src[srcIdx], (size)*sizeof(type) )
-   #define ARRAY_VTYPE_FREE(type,name)            TA_Free(name)
-   #define ARRAY_VTYPE_FREE_COND(type,cond,name)  if( cond ){ TA_Free(name); }
+   #define ARRAY_VTYPE_FREE(type,name)            TA_PrivArrayFree(name)
+   #define ARRAY_VTYPE_FREE_COND(type,cond,name)  if( cond ){ TA_PrivArrayFree(name); }
 #endif
 
 /* ARRAY : Macros to manipulate arrays of double. */
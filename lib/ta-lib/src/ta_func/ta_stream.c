@@ -0,0 +1,5474 @@
+/* TA-LIB Copyright (c) 1999-2007, Mario Fortier
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in
+ *   the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * - Neither name of author nor the names of its contributors
+ *   may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Description:
+ *    Streaming version of some TA functions (see ta_stream.h).
+ *
+ *    Each state reproduces, one bar at a time, the arithmetic of the
+ *    corresponding batch function when called from the first bar. The
+ *    operations are done in the same order so the outputs are identical.
+ *
+ *    The kernels below are shared by the functions built on the same
+ *    calculation (the MA types, BBANDS, MACD, the HT functions...). The
+ *    circular windows are allocated in the same block as the state.
+ */
+
+/**** Headers ****/
+#include <string.h>
+#include <math.h>
+#include "ta_func.h"
+#include "ta_stream.h"
+#include "ta_utility.h"
+#include "../ta_common/ta_memory.h"
+
+/**** Local declarations.              ****/
+
+/* The last 'size' values, in a circular buffer. Values not yet
+ * pushed are 0.0, which the rolling sums can subtract without effect.
+ */
+typedef struct
+{
+   double *value;
+   int     size;
+   int     next;
+} TA_StreamWindow;
+
+/* EMA as done by TA_INT_EMA. The first 'skip' values are ignored, like
+ * the bars before the seed of the fast EMA of the MACD.
+ */
+typedef struct
+{
+   int    period;
+   double k;
+   int    lookback;
+   int    skip;
+   int    metastock;
+   int    nbValue;
+   double periodTotal;
+   double prevMA;
+} TA_StreamEMA;
+
+/* Variance as done by TA_INT_VAR. */
+typedef struct
+{
+   int             period;
+   int             skip;
+   int             nbValue;
+   TA_StreamWindow window;
+   double          periodTotal1;
+   double          periodTotal2;
+} TA_StreamVAR;
+
+/* The Wilder's smoothing of the true range as done by TA_ATR. */
+typedef struct
+{
+   int    period;
+   int    lookback;
+   int    nbBar;
+   double prevClose;
+   double periodTotal;
+   double prevATR;
+} TA_StreamATR;
+
+/* The Hilbert transform shared by the HT_* functions, as done by
+ * TA_HT_TRENDMODE. Only the parts in 'flags' are computed past the
+ * dominant cycle period and the phasor components.
+ *
+ * TA_HT_DCPERIOD and TA_HT_PHASOR start the transform after a shorter
+ * smoothing than the other HT functions, so they have their own
+ * kernel when the outputs must be the same as the batch ones.
+ */
+#define HT_PHASE     0x1 /* Dominant cycle phase and sine wave. */
+#define HT_TRENDLINE 0x2
+#define HT_TRENDMODE 0x4 /* Needs the phase and the trendline.  */
+
+#define HT_SIZE 50 /* Longest dominant cycle period. */
+
+typedef struct
+{
+   double value;
+   double buffer[2][3];  /* Even and odd bars. */
+   double prev[2];
+   double prevInput[2];
+} TA_StreamHilbert;
+
+typedef struct
+{
+   int    flags;
+   int    warmup;
+   int    lookback;
+   int    nbBar;
+   double rad2Deg;
+   double deg2Rad;
+   double constDeg2RadBy360;
+
+   /* Price smoother, a 4 bars WMA. */
+   double price[HT_SIZE];
+   int    priceIdx;
+   double periodWMASub;
+   double periodWMASum;
+   double trailingWMAValue;
+
+   /* Hilbert transform and dominant cycle period. */
+   int              hilbertIdx;
+   TA_StreamHilbert detrender;
+   TA_StreamHilbert Q1;
+   TA_StreamHilbert jI;
+   TA_StreamHilbert jQ;
+   double I1ForOddPrev2, I1ForOddPrev3;
+   double I1ForEvenPrev2, I1ForEvenPrev3;
+   double prevI2, prevQ2, Re, Im;
+   double period;
+   double smoothPeriod;
+   double inPhase;
+   double quadrature;
+
+   /* Dominant cycle phase and sine wave. */
+   double smoothPrice[HT_SIZE];
+   int    smoothPriceIdx;
+   double DCPhase, prevDCPhase;
+   double sine, prevSine;
+   double leadSine, prevLeadSine;
+
+   /* Trendline and trend mode. */
+   double iTrend1, iTrend2, iTrend3;
+   double trendline;
+   int    daysInTrend;
+   int    trend;
+} TA_StreamHT;
+
+/* TA_MA, for all the MA types. */
+typedef struct
+{
+   TA_MAType       type;
+   int             period;
+   int             lookback;
+   int             nbValue;
+   TA_StreamWindow window;      /* SMA, WMA, TRIMA and KAMA. */
+   double          periodTotal; /* SMA and T3. */
+   double          periodSub;   /* WMA. */
+   double          periodSum;   /* WMA. */
+   TA_StreamEMA    ema[3];      /* EMA, DEMA and TEMA. */
+
+   /* TRIMA. */
+   int    middle;
+   double factor;
+   double numerator;
+   double numeratorSub;
+   double numeratorAdd;
+
+   /* KAMA. */
+   double sumROC1;
+   double prevKAMA;
+
+   /* T3, six EMAs seeded one after the other. */
+   int    nbEMA;
+   double e[6];
+   double k, oneMinusK;
+   double c1, c2, c3, c4;
+
+   /* MAMA, its Hilbert transform is in the same block. */
+   TA_StreamHT *ht;
+   double fastLimit, slowLimit;
+   double prevPhase;
+   double mama, fama;
+} TA_StreamMA;
+
+/* The highest (or lowest) of the last 'size' values, kept in a monotonic
+ * deque of bar indexes. Each bar is pushed and popped at most once. On
+ * ties the latest bar is kept, like TA_AROON does.
+ */
+typedef struct
+{
+   double *value;
+   int    *idx;
+   int     size;
+   int     highest;
+   int     first;
+   int     count;
+} TA_StreamExtreme;
+
+/* RSI as done by TA_RSI, also the gains and losses of TA_CMO. */
+typedef struct
+{
+   int    period;
+   int    lookback;
+   int    metastockFirst; /* Metastock without unstable period. */
+   int    nbBar;
+   double prevValue;
+   double prevGain;
+   double prevLoss;
+} TA_StreamRSI;
+
+/* The directional movements and the true range as done by TA_ADX and
+ * the DI and DM functions: summed over the first 'period-1' bars, then
+ * smoothed. The differences of the last bar are kept for a period of 1.
+ */
+typedef struct
+{
+   int    period;
+   int    nbBar;
+   double prevHigh;
+   double prevLow;
+   double prevClose;
+   double diffP;
+   double diffM;
+   double tr;
+   double prevPlusDM;
+   double prevMinusDM;
+   double prevTR;
+} TA_StreamDM;
+
+/* ADX as done by TA_ADX. */
+typedef struct
+{
+   TA_StreamDM dm;
+   int         lookback;
+   double      sumDX;
+   double      prevADX;
+} TA_StreamADX;
+
+/* Parabolic SAR as done by TA_SAREXT. TA_SAR is the same with one
+ * acceleration factor for both positions and no sign on the outputs.
+ */
+typedef struct
+{
+   int    nbBar;
+   int    isLong;
+   int    signedOutput;
+   double startValue;
+   double offsetOnReverse;
+   double accelerationInitLong, accelerationLong, accelerationMaxLong, afLong;
+   double accelerationInitShort, accelerationShort, accelerationMaxShort, afShort;
+   double ep;
+   double sar;
+   double newHigh;
+   double newLow;
+} TA_StreamSAR;
+
+struct TA_SMA_State    { TA_StreamMA ma; };
+struct TA_EMA_State    { TA_StreamMA ma; };
+struct TA_WMA_State    { TA_StreamMA ma; };
+struct TA_DEMA_State   { TA_StreamMA ma; };
+struct TA_TEMA_State   { TA_StreamMA ma; };
+struct TA_MA_State     { TA_StreamMA ma; };
+struct TA_TRIMA_State  { TA_StreamMA ma; };
+struct TA_KAMA_State   { TA_StreamMA ma; };
+struct TA_T3_State     { TA_StreamMA ma; };
+struct TA_MAMA_State   { TA_StreamMA ma; };
+struct TA_STDDEV_State { TA_StreamVAR var; double nbDev; };
+struct TA_VAR_State    { TA_StreamVAR var; };
+struct TA_ATR_State    { TA_StreamATR atr; };
+struct TA_NATR_State   { TA_StreamATR atr; };
+
+struct TA_HT_DCPERIOD_State  { TA_StreamHT ht; };
+struct TA_HT_DCPHASE_State   { TA_StreamHT ht; };
+struct TA_HT_PHASOR_State    { TA_StreamHT ht; };
+struct TA_HT_SINE_State      { TA_StreamHT ht; };
+struct TA_HT_TRENDLINE_State { TA_StreamHT ht; };
+struct TA_HT_TRENDMODE_State { TA_StreamHT ht; };
+struct TA_HT_State           { TA_StreamHT ht; };
+
+struct TA_BBANDS_State
+{
+   TA_StreamMA  ma;
+   TA_StreamVAR var;
+   double       nbDevUp;
+   double       nbDevDn;
+};
+
+struct TA_MACD_State
+{
+   TA_StreamEMA slow;
+   TA_StreamEMA fast;
+   TA_StreamEMA signal;
+};
+
+struct TA_APO_State { TA_StreamMA fast; TA_StreamMA slow; };
+struct TA_PPO_State { TA_StreamMA fast; TA_StreamMA slow; };
+
+struct TA_RSI_State { TA_StreamRSI rsi; };
+struct TA_CMO_State { TA_StreamRSI rsi; };
+
+struct TA_TRIX_State
+{
+   TA_StreamEMA ema[3];
+   int          nbEMA;
+   double       prevEMA;
+};
+
+struct TA_MACDFIX_State { TA_MACD_State macd; };
+
+/* The MAs of TA_MACDEXT do not start on the same bar: each one skips the
+ * first bars until its lookback ends with the longest one.
+ */
+struct TA_MACDEXT_State
+{
+   int         nbBar;
+   int         skipFast;
+   int         skipSlow;
+   TA_StreamMA fast;
+   TA_StreamMA slow;
+   TA_StreamMA signal;
+};
+
+struct TA_MOM_State     { TA_StreamWindow window; int nbBar; };
+struct TA_ROC_State     { TA_StreamWindow window; int nbBar; };
+struct TA_ROCP_State    { TA_StreamWindow window; int nbBar; };
+struct TA_ROCR_State    { TA_StreamWindow window; int nbBar; };
+struct TA_ROCR100_State { TA_StreamWindow window; int nbBar; };
+struct TA_SUM_State     { TA_StreamWindow window; int nbBar; double periodTotal; };
+
+/* The sums of the last 'period' pairs. BETA sums the returns, so it
+ * keeps the last prices to compute them.
+ */
+struct TA_CORREL_State
+{
+   int             nbBar;
+   TA_StreamWindow windowX;
+   TA_StreamWindow windowY;
+   double          sumX, sumY, sumX2, sumY2, sumXY;
+};
+
+struct TA_BETA_State
+{
+   int             nbBar;
+   TA_StreamWindow windowX;
+   TA_StreamWindow windowY;
+   double          lastPriceX, lastPriceY;
+   double          S_xx, S_xy, S_x, S_y;
+};
+
+/* The positive and negative money flows of the last 'period' bars. */
+struct TA_MFI_State
+{
+   int             lookback;
+   int             nbBar;
+   double          prevValue;
+   double          posSumMF;
+   double          negSumMF;
+   TA_StreamWindow positive;
+   TA_StreamWindow negative;
+};
+
+/* The Chaikin A/D line, and its two EMAs seeded with its first value. */
+struct TA_AD_State { double ad; };
+
+struct TA_ADOSC_State
+{
+   int    lookback;
+   int    nbBar;
+   double fastK, oneMinusFastK;
+   double slowK, oneMinusSlowK;
+   double ad;
+   double fastEMA;
+   double slowEMA;
+};
+
+struct TA_OBV_State { int nbBar; double prevReal; double prevOBV; };
+
+/* The terms of the last bars, for the sums of the three periods. The
+ * periods are sorted, the shortest first.
+ */
+struct TA_ULTOSC_State
+{
+   int             period[3];
+   int             lookback;
+   int             nbBar;
+   double          prevClose;
+   double          aTotal[3];
+   double          bTotal[3];
+   TA_StreamWindow closeMinusTrueLow;
+   TA_StreamWindow trueRange;
+};
+
+struct TA_TRANGE_State { int nbBar; double prevClose; };
+
+/* The typical prices of the last 'period' bars, at the index of their
+ * bar modulo 'period' like in TA_CCI.
+ */
+struct TA_CCI_State { TA_StreamWindow window; int nbBar; };
+
+struct TA_ADX_State      { TA_StreamADX adx; };
+struct TA_ADXR_State     { TA_StreamADX adx; TA_StreamWindow window; int nbADX; };
+struct TA_DX_State       { TA_StreamDM dm; int lookback; double prevDX; };
+struct TA_PLUS_DI_State  { TA_StreamDM dm; int lookback; };
+struct TA_MINUS_DI_State { TA_StreamDM dm; int lookback; };
+struct TA_PLUS_DM_State  { TA_StreamDM dm; int lookback; };
+struct TA_MINUS_DM_State { TA_StreamDM dm; int lookback; };
+
+/* The functions on the highest and lowest of the last bars. */
+struct TA_WILLR_State
+{
+   int              period;
+   int              nbBar;
+   TA_StreamExtreme highest;
+   TA_StreamExtreme lowest;
+};
+
+struct TA_MAX_State      { int nbBar; TA_StreamExtreme highest; };
+struct TA_MIN_State      { int nbBar; TA_StreamExtreme lowest; };
+struct TA_MIDPOINT_State { int nbBar; TA_StreamExtreme highest; TA_StreamExtreme lowest; };
+struct TA_MIDPRICE_State { int nbBar; TA_StreamExtreme highest; TA_StreamExtreme lowest; };
+struct TA_AROON_State    { int nbBar; TA_StreamExtreme highest; TA_StreamExtreme lowest; };
+struct TA_AROONOSC_State { int nbBar; TA_StreamExtreme highest; TA_StreamExtreme lowest; };
+
+struct TA_STOCH_State
+{
+   int              fastKPeriod;
+   int              nbBar;
+   TA_StreamExtreme highest;
+   TA_StreamExtreme lowest;
+   TA_StreamMA      slowK;
+   TA_StreamMA      slowD;
+};
+
+struct TA_STOCHF_State
+{
+   int              fastKPeriod;
+   int              nbBar;
+   TA_StreamExtreme highest;
+   TA_StreamExtreme lowest;
+   TA_StreamMA      fastD;
+};
+
+/* TA_STOCHF over the outputs of TA_RSI. */
+struct TA_STOCHRSI_State { TA_RSI_State rsi; TA_STOCHF_State stochf; };
+
+struct TA_SAR_State    { TA_StreamSAR sar; };
+struct TA_SAREXT_State { TA_StreamSAR sar; };
+
+/**** Local functions declarations.    ****/
+static void *stateAlloc( size_t stateSize, int nbDouble, double **doubleArray );
+static double windowPush( TA_StreamWindow *window, double value );
+
+static void emaInit( TA_StreamEMA *ema, int period, double k, int skip );
+static int emaUpdate( TA_StreamEMA *ema, double value );
+
+static void macdInit( TA_MACD_State *macd, int fastPeriod, double fastK,
+                      int slowPeriod, double slowK, int signalPeriod );
+
+static int maNbDouble( int period, TA_MAType type );
+static void maInit( TA_StreamMA *ma, double *array, int period, TA_MAType type );
+static TA_StreamMA *maAlloc( size_t stateSize, int nbExtraDouble, int period,
+                             TA_MAType type, double **extraArray );
+static int maUpdate( TA_StreamMA *ma, double value, double *out );
+static int trimaUpdate( TA_StreamMA *ma, double value, double *out );
+static int kamaUpdate( TA_StreamMA *ma, double value, double *out );
+static void t3SetVFactor( TA_StreamMA *ma, double vFactor );
+static int t3Update( TA_StreamMA *ma, double value, double *out );
+static int mamaUpdate( TA_StreamMA *ma, double value, double *out );
+
+static void varInit( TA_StreamVAR *var, double *window, int period, int skip );
+static int varUpdate( TA_StreamVAR *var, double value, double *out );
+
+static void adUpdate( double *ad, double high, double low, double close, double volume );
+
+static void atrInit( TA_StreamATR *atr, int period, int lookback );
+static int atrUpdate( TA_StreamATR *atr, double high, double low, double close );
+static double trueRange( double high, double low, double prevClose );
+
+static void htInit( TA_StreamHT *ht, int flags, int lookback );
+static TA_RetCode htAlloc( TA_StreamHT **ht, size_t stateSize, int flags, int lookback );
+static double hilbertTransform( TA_StreamHilbert *hilbert, double input, int odd,
+                                int hilbertIdx, double adjustedPrevPeriod );
+static int htUpdate( TA_StreamHT *ht, double value );
+
+static void extremeInit( TA_StreamExtreme *extreme, double *array, int size, int highest );
+static double extremePush( TA_StreamExtreme *extreme, double value, int today );
+
+static void rsiInit( TA_StreamRSI *rsi, int period, int lookback, int unstablePeriod );
+static int rsiUpdate( TA_StreamRSI *rsi, double value, double *gain, double *loss );
+
+static void stochfInit( TA_STOCHF_State *stochf, double *array, int fastKPeriod,
+                        int fastDPeriod, TA_MAType fastDMAType );
+
+static void dmInit( TA_StreamDM *dm, int period );
+static int dmUpdate( TA_StreamDM *dm, double high, double low, double close );
+static int adxUpdate( TA_StreamADX *adx, double high, double low, double close );
+
+static void sarInit( TA_StreamSAR *sar, int signedOutput, double startValue,
+                     double offsetOnReverse, double accelerationInitLong,
+                     double accelerationLong, double accelerationMaxLong,
+                     double accelerationInitShort, double accelerationShort,
+                     double accelerationMaxShort );
+static int sarUpdate( TA_StreamSAR *sar, double high, double low, double *out );
+
+/**** Local functions.    ****/
+
+/* One allocation for the state followed by its circular windows. */
+static void *stateAlloc( size_t stateSize, int nbDouble, double **doubleArray )
+{
+   size_t size;
+   char *state;
+
+   /* Keep the doubles aligned after the state. */
+   size = (stateSize + sizeof(double) - 1) & ~(sizeof(double) - 1);
+
+   state = (char *)TA_Malloc( size + nbDouble*sizeof(double) );
+   if( !state )
+      return NULL;
+
+   memset( state, 0, size + nbDouble*sizeof(double) );
+   if( doubleArray )
+      *doubleArray = (double *)(state + size);
+
+   return state;
+}
+
+/* Returns the value pushed 'size' calls ago (or 0.0). */
+static double windowPush( TA_StreamWindow *window, double value )
+{
+   double oldest;
+
+   oldest = window->value[window->next];
+   window->value[window->next] = value;
+   if( ++window->next == window->size )
+      window->next = 0;
+
+   return oldest;
+}
+
+/**** EMA ****/
+static void emaInit( TA_StreamEMA *ema, int period, double k, int skip )
+{
+   ema->period      = period;
+   ema->k           = k;
+   ema->lookback    = period - 1 + TA_GLOBALS_UNSTABLE_PERIOD(TA_FUNC_UNST_EMA,Ema);
+   ema->skip        = skip;
+   ema->metastock   = TA_GLOBALS_COMPATIBILITY == TA_COMPATIBILITY_METASTOCK;
+   ema->nbValue     = 0;
+   ema->periodTotal = 0.0;
+   ema->prevMA      = 0.0;
+}
+
+/* Returns 1 once 'prevMA' is an output of the EMA. */
+static int emaUpdate( TA_StreamEMA *ema, double value )
+{
+   if( ema->skip > 0 )
+   {
+      ema->skip--;
+      return 0;
+   }
+
+   if( ema->metastock )
+   {
+      /* Seeded with the first value. */
+      if( ema->nbValue == 0 )
+         ema->prevMA = value;
+      else
+         ema->prevMA = ((value-ema->prevMA)*ema->k) + ema->prevMA;
+   }
+   else if( ema->nbValue < ema->period )
+   {
+      /* Seeded with the simple average of the first 'period' values. */
+      ema->periodTotal += value;
+      if( ema->nbValue == ema->period-1 )
+         ema->prevMA = ema->periodTotal / ema->period;
+   }
+   else
+      ema->prevMA = ((value-ema->prevMA)*ema->k) + ema->prevMA;
+
+   ema->nbValue++;
+   return ema->nbValue > ema->lookback;
+}
+
+/**** MACD ****/
+
+/* The periods are sorted like in TA_INT_MACD. */
+static void macdInit( TA_MACD_State *macd, int fastPeriod, double fastK,
+                      int slowPeriod, double slowK, int signalPeriod )
+{
+   int skip;
+
+   /* Both EMA produce their first output on the same bar. In the
+    * default compatibility, the seed of the fast EMA is the average
+    * of the bars just before (see TA_INT_MACD).
+    */
+   if( TA_GLOBALS_COMPATIBILITY == TA_COMPATIBILITY_DEFAULT )
+      skip = slowPeriod - fastPeriod;
+   else
+      skip = 0;
+
+   emaInit( &macd->slow, slowPeriod, slowK, 0 );
+   emaInit( &macd->fast, fastPeriod, fastK, skip );
+   emaInit( &macd->signal, signalPeriod, PER_TO_K(signalPeriod), 0 );
+}
+
+/**** MA ****/
+
+/* The doubles needed after the state: the window of the MA, or the
+ * Hilbert transform of the MAMA.
+ */
+static int maNbDouble( int period, TA_MAType type )
+{
+   switch( type )
+   {
+   case TA_MAType_SMA:
+   case TA_MAType_WMA:
+   case TA_MAType_TRIMA:
+      return period;
+   case TA_MAType_KAMA:
+      return period+1;
+   case TA_MAType_MAMA:
+      return (int)((sizeof(TA_StreamHT)+sizeof(double)-1)/sizeof(double));
+   default:
+      return 0;
+   }
+}
+
+/* 'array' has the maNbDouble() doubles of the MA, zeroed. */
+static void maInit( TA_StreamMA *ma, double *array, int period, TA_MAType type )
+{
+   int i;
+
+   ma->type     = type;
+   ma->period   = period;
+   ma->lookback = TA_MA_Lookback( period, type );
+   ma->window.value = array;
+   ma->window.size  = 0;
+   for( i=0; i < 3; i++ )
+      emaInit( &ma->ema[i], period, PER_TO_K(period), 0 );
+
+   switch( type )
+   {
+   case TA_MAType_SMA:
+   case TA_MAType_WMA:
+   case TA_MAType_KAMA:
+      ma->window.size = maNbDouble( period, type );
+      break;
+
+   case TA_MAType_TRIMA:
+      /* The weights go up to the middle of the window, then down. */
+      ma->window.size = period;
+      i = period>>1;
+      if( (period % 2) == 1 )
+      {
+         ma->middle = i;
+         ma->factor = 1.0/(double)((i+1)*(i+1));
+      }
+      else
+      {
+         ma->middle = i-1;
+         ma->factor = 1.0/(double)(i*(i+1));
+      }
+      break;
+
+   case TA_MAType_T3:
+      t3SetVFactor( ma, 0.7 );
+      break;
+
+   case TA_MAType_MAMA:
+      ma->ht = (TA_StreamHT *)array;
+      htInit( ma->ht, 0, 12 );
+      ma->fastLimit = 0.5;
+      ma->slowLimit = 0.05;
+      break;
+
+   default:
+      break;
+   }
+}
+
+/* The TA_StreamMA must be the first member of the state. 'nbExtraDouble'
+ * are left after the doubles of the MA, at 'extraArray'.
+ */
+static TA_StreamMA *maAlloc( size_t stateSize, int nbExtraDouble, int period,
+                             TA_MAType type, double **extraArray )
+{
+   TA_StreamMA *ma;
+   double *array;
+   int nbDouble;
+
+   nbDouble = maNbDouble( period, type );
+   ma = (TA_StreamMA *)stateAlloc( stateSize, nbDouble+nbExtraDouble, &array );
+   if( !ma )
+      return NULL;
+
+   maInit( ma, array, period, type );
+   if( extraArray )
+      *extraArray = array + nbDouble;
+
+   return ma;
+}
+
+/* Returns 1 when 'out' is set. */
+static int maUpdate( TA_StreamMA *ma, double value, double *out )
+{
+   double trailingValue;
+   TA_StreamEMA *ema;
+
+   if( ma->period == 1 )
+   {
+      *out = value;
+      return 1;
+   }
+
+   ema = ma->ema;
+
+   switch( ma->type )
+   {
+   case TA_MAType_SMA:
+      /* Remove the value out of the window before adding the new one,
+       * the same sequence of operations than TA_INT_SMA.
+       */
+      ma->periodTotal -= windowPush( &ma->window, value );
+      ma->periodTotal += value;
+      if( ++ma->nbValue < ma->period )
+         return 0;
+      *out = ma->periodTotal / ma->period;
+      return 1;
+
+   case TA_MAType_WMA:
+      trailingValue = windowPush( &ma->window, value );
+      if( ++ma->nbValue < ma->period )
+      {
+         ma->periodSub += value;
+         ma->periodSum += value*ma->nbValue;
+         return 0;
+      }
+      ma->periodSub += value;
+      ma->periodSub -= trailingValue;
+      ma->periodSum += value*ma->period;
+      *out = ma->periodSum / ((ma->period*(ma->period+1))>>1);
+      ma->periodSum -= ma->periodSub;
+      return 1;
+
+   case TA_MAType_EMA:
+      if( !emaUpdate( &ema[0], value ) )
+         return 0;
+      *out = ema[0].prevMA;
+      return 1;
+
+   case TA_MAType_DEMA:
+      /* Each EMA is fed with the outputs of the previous one. */
+      if( !emaUpdate( &ema[0], value ) || !emaUpdate( &ema[1], ema[0].prevMA ) )
+         return 0;
+      *out = (2.0*ema[0].prevMA) - ema[1].prevMA;
+      return 1;
+
+   case TA_MAType_TEMA:
+      if( !emaUpdate( &ema[0], value ) ||
+          !emaUpdate( &ema[1], ema[0].prevMA ) ||
+          !emaUpdate( &ema[2], ema[1].prevMA ) )
+         return 0;
+      *out  = ema[2].prevMA;
+      *out += (3.0*ema[0].prevMA) - (3.0*ema[1].prevMA);
+      return 1;
+
+   case TA_MAType_TRIMA:
+      return trimaUpdate( ma, value, out );
+
+   case TA_MAType_KAMA:
+      return kamaUpdate( ma, value, out );
+
+   case TA_MAType_T3:
+      return t3Update( ma, value, out );
+
+   case TA_MAType_MAMA:
+      return mamaUpdate( ma, value, out );
+
+   default:
+      return 0;
+   }
+}
+
+/* TRIMA as done by TA_TRIMA. The numerator is the sum of the values
+ * weighted 1, 2, ... up to the middle of the window, and back down to 1.
+ * 'numeratorSub' is the sum of the values up to the middle and
+ * 'numeratorAdd' the sum of the ones after.
+ */
+static int trimaUpdate( TA_StreamMA *ma, double value, double *out )
+{
+   TA_StreamWindow *window;
+   double tempReal, trailingValue;
+   int i, period;
+
+   window = &ma->window;
+   period = ma->period;
+
+   if( ma->nbValue < period-1 )
+   {
+      windowPush( window, value );
+      ma->nbValue++;
+      return 0;
+   }
+
+   if( ma->nbValue++ == period-1 )
+   {
+      /* The first 'period' values, oldest first from 'next'. */
+      windowPush( window, value );
+      ma->numerator    = 0.0;
+      ma->numeratorSub = 0.0;
+      for( i=ma->middle; i >= 0; i-- )
+      {
+         tempReal = window->value[(window->next+i)%period];
+         ma->numeratorSub += tempReal;
+         ma->numerator    += ma->numeratorSub;
+      }
+      ma->numeratorAdd = 0.0;
+      for( i=ma->middle+1; i < period; i++ )
+      {
+         tempReal = window->value[(window->next+i)%period];
+         ma->numeratorAdd += tempReal;
+         ma->numerator    += ma->numeratorAdd;
+      }
+      *out = ma->numerator * ma->factor;
+      return 1;
+   }
+
+   /* The value crossing the middle, and the one leaving the window. */
+   tempReal      = window->value[(window->next+ma->middle+1)%period];
+   trailingValue = windowPush( window, value );
+
+   ma->numerator    -= ma->numeratorSub;
+   ma->numeratorSub -= trailingValue;
+   ma->numeratorSub += tempReal;
+   if( (period % 2) == 1 )
+   {
+      ma->numerator    += ma->numeratorAdd;
+      ma->numeratorAdd -= tempReal;
+   }
+   else
+   {
+      ma->numeratorAdd -= tempReal;
+      ma->numerator    += ma->numeratorAdd;
+   }
+   ma->numeratorAdd += value;
+   ma->numerator    += value;
+
+   *out = ma->numerator * ma->factor;
+   return 1;
+}
+
+/* KAMA as done by TA_KAMA. The window holds the last 'period+1' values
+ * for the efficiency ratio.
+ */
+static int kamaUpdate( TA_StreamMA *ma, double value, double *out )
+{
+   const double constMax  = 2.0/(30.0+1.0);
+   const double constDiff = 2.0/(2.0+1.0) - constMax;
+   TA_StreamWindow *window;
+   double tempReal, periodROC, prevValue, trailingValue, oldestValue;
+   int today, size;
+
+   window = &ma->window;
+   size   = window->size;
+   today  = ma->nbValue++;
+
+   /* The values of the bars today-1, today-period and today-period-1. */
+   prevValue     = window->value[(window->next+size-1)%size];
+   trailingValue = window->value[(window->next+1)%size];
+   oldestValue   = windowPush( window, value );
+
+   if( today == 0 )
+      return 0;
+
+   if( today <= ma->period )
+   {
+      /* Sum of the absolute changes of the first 'period' bars. */
+      ma->sumROC1 += std_fabs(prevValue-value);
+      if( today < ma->period )
+         return 0;
+      ma->prevKAMA = prevValue;
+   }
+   else
+   {
+      ma->sumROC1 -= std_fabs(oldestValue-trailingValue);
+      ma->sumROC1 += std_fabs(value-prevValue);
+   }
+
+   periodROC = value-trailingValue;
+   if( (ma->sumROC1 <= periodROC) || TA_IS_ZERO(ma->sumROC1) )
+      tempReal = 1.0;
+   else
+      tempReal = std_fabs(periodROC/ma->sumROC1);
+   tempReal  = (tempReal*constDiff)+constMax;
+   tempReal *= tempReal;
+   ma->prevKAMA = ((value-ma->prevKAMA)*tempReal) + ma->prevKAMA;
+
+   if( today < ma->lookback )
+      return 0;
+
+   *out = ma->prevKAMA;
+   return 1;
+}
+
+static void t3SetVFactor( TA_StreamMA *ma, double vFactor )
+{
+   double tempReal;
+
+   ma->k = 2.0/(ma->period+1.0);
+   ma->oneMinusK = 1.0-ma->k;
+
+   tempReal = vFactor * vFactor;
+   ma->c1 = -(tempReal * vFactor);
+   ma->c2 = 3.0 * (tempReal - ma->c1);
+   ma->c3 = -6.0 * tempReal - 3.0 * (vFactor-ma->c1);
+   ma->c4 = 1.0 + 3.0 * vFactor - ma->c1 + 3.0 * tempReal;
+}
+
+/* T3 as done by TA_T3: six EMAs in a row, each one seeded with the
+ * average of the first 'period' values of the one before.
+ */
+static int t3Update( TA_StreamMA *ma, double value, double *out )
+{
+   double *e;
+   int i, today;
+
+   e = ma->e;
+   today = ma->nbValue++;
+
+   if( today < ma->period )
+   {
+      ma->periodTotal += value;
+      if( today < ma->period-1 )
+         return 0;
+      e[0] = ma->periodTotal / ma->period;
+      ma->periodTotal = e[0];
+      ma->nbEMA = 1;
+   }
+   else
+   {
+      e[0] = (ma->k*value)+(ma->oneMinusK*e[0]);
+      for( i=1; i < ma->nbEMA; i++ )
+         e[i] = (ma->k*e[i-1])+(ma->oneMinusK*e[i]);
+
+      /* The next EMA is seeded every 'period-1' bars. */
+      if( ma->nbEMA < 6 )
+      {
+         ma->periodTotal += e[ma->nbEMA-1];
+         if( ((today-(ma->period-1)) % (ma->period-1)) == 0 )
+         {
+            e[ma->nbEMA] = ma->periodTotal / ma->period;
+            ma->periodTotal = e[ma->nbEMA];
+            ma->nbEMA++;
+         }
+      }
+   }
+
+   if( today < ma->lookback )
+      return 0;
+
+   *out = ma->c1*e[5]+ma->c2*e[4]+ma->c3*e[3]+ma->c4*e[2];
+   return 1;
+}
+
+/* MAMA as done by TA_MAMA, from the phase of the Hilbert transform.
+ * The FAMA is left in 'fama'.
+ */
+static int mamaUpdate( TA_StreamMA *ma, double value, double *out )
+{
+   TA_StreamHT *ht;
+   double tempReal, tempReal2;
+   int today;
+
+   ht = ma->ht;
+   today = ma->nbValue++;
+   if( !htUpdate( ht, value ) )
+      return 0;
+
+   if( ht->inPhase != 0.0 )
+      tempReal2 = (std_atan(ht->quadrature/ht->inPhase)*ht->rad2Deg);
+   else
+      tempReal2 = 0.0;
+
+   tempReal      = ma->prevPhase - tempReal2;
+   ma->prevPhase = tempReal2;
+   if( tempReal < 1.0 )
+      tempReal = 1.0;
+   if( tempReal > 1.0 )
+   {
+      tempReal = ma->fastLimit/tempReal;
+      if( tempReal < ma->slowLimit )
+         tempReal = ma->slowLimit;
+   }
+   else
+      tempReal = ma->fastLimit;
+
+   ma->mama = (tempReal*value)+((1-tempReal)*ma->mama);
+   tempReal *= 0.5;
+   ma->fama = (tempReal*ma->mama)+((1-tempReal)*ma->fama);
+
+   if( today < ma->lookback )
+      return 0;
+
+   *out = ma->mama;
+   return 1;
+}
+
+/**** VAR ****/
+static void varInit( TA_StreamVAR *var, double *window, int period, int skip )
+{
+   var->period       = period;
+   var->skip         = skip;
+   var->nbValue      = 0;
+   var->window.value = window;
+   var->window.size  = period;
+   var->window.next  = 0;
+   var->periodTotal1 = 0.0;
+   var->periodTotal2 = 0.0;
+}
+
+static int varUpdate( TA_StreamVAR *var, double value, double *out )
+{
+   double tempReal, meanValue1, meanValue2;
+
+   if( var->skip > 0 )
+   {
+      var->skip--;
+      return 0;
+   }
+
+   tempReal = windowPush( &var->window, value );
+   var->periodTotal1 -= tempReal;
+   tempReal *= tempReal;
+   var->periodTotal2 -= tempReal;
+
+   var->periodTotal1 += value;
+   tempReal = value*value;
+   var->periodTotal2 += tempReal;
+
+   if( ++var->nbValue < var->period )
+      return 0;
+
+   meanValue1 = var->periodTotal1 / var->period;
+   meanValue2 = var->periodTotal2 / var->period;
+   *out = meanValue2-meanValue1*meanValue1;
+   return 1;
+}
+
+/**** AD ****/
+static void adUpdate( double *ad, double high, double low, double close, double volume )
+{
+   double tmp;
+
+   tmp = high-low;
+   if( tmp > 0.0 )
+      *ad += (((close-low)-(high-close))/tmp)*volume;
+}
+
+/**** ATR ****/
+static void atrInit( TA_StreamATR *atr, int period, int lookback )
+{
+   atr->period      = period;
+   atr->lookback    = lookback;
+   atr->nbBar       = 0;
+   atr->prevClose   = 0.0;
+   atr->periodTotal = 0.0;
+   atr->prevATR     = 0.0;
+}
+
+static double trueRange( double high, double low, double prevClose )
+{
+   double greatest, val2, val3;
+
+   greatest = high - low;
+   val2 = std_fabs( prevClose - high );
+   if( val2 > greatest )
+      greatest = val2;
+   val3 = std_fabs( prevClose - low );
+   if( val3 > greatest )
+      greatest = val3;
+
+   return greatest;
+}
+
+/* Returns 1 when 'prevATR' is an output. With a period of 1,
+ * 'prevATR' is the true range.
+ */
+static int atrUpdate( TA_StreamATR *atr, double high, double low, double close )
+{
+   double tempReal;
+   int today;
+
+   today = atr->nbBar++;
+   if( today == 0 )
+   {
+      atr->prevClose = close;
+      return 0;
+   }
+
+   tempReal = trueRange( high, low, atr->prevClose );
+   atr->prevClose = close;
+
+   if( atr->period <= 1 )
+      atr->prevATR = tempReal;
+   else if( today <= atr->period )
+   {
+      /* Seeded with the simple average of the first true ranges. */
+      atr->periodTotal += tempReal;
+      if( today == atr->period )
+         atr->prevATR = atr->periodTotal / atr->period;
+   }
+   else
+   {
+      atr->prevATR *= atr->period - 1;
+      atr->prevATR += tempReal;
+      atr->prevATR /= atr->period;
+   }
+
+   return today >= atr->lookback;
+}
+
+/**** HT ****/
+
+/* 'ht' is zeroed. */
+static void htInit( TA_StreamHT *ht, int flags, int lookback )
+{
+   double tempReal;
+
+   ht->flags    = flags;
+   ht->lookback = lookback;
+
+   /* Same constants as the batch functions. */
+   if( flags )
+   {
+      tempReal = std_atan(1);
+      ht->rad2Deg = 45.0/tempReal;
+      ht->deg2Rad = 1.0/ht->rad2Deg;
+      ht->constDeg2RadBy360 = tempReal*8.0;
+      ht->warmup = 34;
+   }
+   else
+   {
+      ht->rad2Deg = 180.0 / (4.0 * std_atan(1));
+      ht->warmup = 9;
+   }
+}
+
+/* The TA_StreamHT must be the first member of the state. */
+static TA_RetCode htAlloc( TA_StreamHT **ht, size_t stateSize, int flags, int lookback )
+{
+   TA_StreamHT *newHT;
+
+   if( !ht )
+      return TA_BAD_PARAM;
+
+   newHT = (TA_StreamHT *)stateAlloc( stateSize, 0, NULL );
+   if( !newHT )
+      return TA_ALLOC_ERR;
+
+   htInit( newHT, flags, lookback );
+
+   *ht = newHT;
+   return TA_SUCCESS;
+}
+
+/* DO_HILBERT_TRANSFORM of ta_utility.h. */
+static double hilbertTransform( TA_StreamHilbert *hilbert, double input, int odd,
+                                int hilbertIdx, double adjustedPrevPeriod )
+{
+   const double a = 0.0962;
+   const double b = 0.5769;
+   double hilbertTempReal;
+
+   hilbertTempReal = a * input;
+   hilbert->value = -hilbert->buffer[odd][hilbertIdx];
+   hilbert->buffer[odd][hilbertIdx] = hilbertTempReal;
+   hilbert->value += hilbertTempReal;
+   hilbert->value -= hilbert->prev[odd];
+   hilbert->prev[odd] = b * hilbert->prevInput[odd];
+   hilbert->value += hilbert->prev[odd];
+   hilbert->prevInput[odd] = input;
+   hilbert->value *= adjustedPrevPeriod;
+
+   return hilbert->value;
+}
+
+/* Returns 1 once the bars consumed are past the lookback. */
+static int htUpdate( TA_StreamHT *ht, double value )
+{
+   int today, odd, i, idx, DCPeriodInt;
+   double adjustedPrevPeriod, smoothedValue;
+   double I1, Q2, I2, tempReal, tempReal2;
+   double realPart, imagPart;
+
+   today = ht->nbBar++;
+   ht->price[ht->priceIdx] = value;
+   idx = ht->priceIdx;
+   if( ++ht->priceIdx == HT_SIZE )
+      ht->priceIdx = 0;
+
+   /* The first 3 bars initialize the WMA. */
+   if( today < 3 )
+   {
+      ht->periodWMASub += value;
+      ht->periodWMASum += value*(double)(today+1);
+      return 0;
+   }
+
+   adjustedPrevPeriod = (0.075*ht->period)+0.54;
+
+   ht->periodWMASub     += value;
+   ht->periodWMASub     -= ht->trailingWMAValue;
+   ht->periodWMASum     += value*4.0;
+   ht->trailingWMAValue  = ht->price[(idx+HT_SIZE-3)%HT_SIZE];
+   smoothedValue = ht->periodWMASum*0.1;
+   ht->periodWMASum -= ht->periodWMASub;
+
+   if( today < 3+ht->warmup )
+      return 0;
+
+   /* Hilbert transform, with a buffer for the even bars
+    * and another for the odd bars.
+    */
+   odd = today%2;
+   I1  = odd ? ht->I1ForOddPrev3 : ht->I1ForEvenPrev3;
+
+   hilbertTransform( &ht->detrender, smoothedValue, odd, ht->hilbertIdx, adjustedPrevPeriod );
+   hilbertTransform( &ht->Q1, ht->detrender.value, odd, ht->hilbertIdx, adjustedPrevPeriod );
+   hilbertTransform( &ht->jI, I1, odd, ht->hilbertIdx, adjustedPrevPeriod );
+   hilbertTransform( &ht->jQ, ht->Q1.value, odd, ht->hilbertIdx, adjustedPrevPeriod );
+   if( !odd && (++ht->hilbertIdx == 3) )
+      ht->hilbertIdx = 0;
+
+   Q2 = (0.2*(ht->Q1.value + ht->jI.value)) + (0.8*ht->prevQ2);
+   I2 = (0.2*(I1 - ht->jQ.value)) + (0.8*ht->prevI2);
+
+   ht->inPhase    = I1;
+   ht->quadrature = ht->Q1.value;
+
+   /* I1 is the detrender delayed by 3 bars. */
+   if( odd )
+   {
+      ht->I1ForEvenPrev3 = ht->I1ForEvenPrev2;
+      ht->I1ForEvenPrev2 = ht->detrender.value;
+   }
+   else
+   {
+      ht->I1ForOddPrev3 = ht->I1ForOddPrev2;
+      ht->I1ForOddPrev2 = ht->detrender.value;
+   }
+
+   /* Adjust the period for the next bar. */
+   ht->Re = (0.2*((I2*ht->prevI2)+(Q2*ht->prevQ2)))+(0.8*ht->Re);
+   ht->Im = (0.2*((I2*ht->prevQ2)-(Q2*ht->prevI2)))+(0.8*ht->Im);
+   ht->prevQ2 = Q2;
+   ht->prevI2 = I2;
+   tempReal = ht->period;
+   if( (ht->Im != 0.0) && (ht->Re != 0.0) )
+      ht->period = 360.0 / (std_atan(ht->Im/ht->Re)*ht->rad2Deg);
+   tempReal2 = 1.5*tempReal;
+   if( ht->period > tempReal2)
+      ht->period = tempReal2;
+   tempReal2 = 0.67*tempReal;
+   if( ht->period < tempReal2 )
+      ht->period = tempReal2;
+   if( ht->period < 6 )
+      ht->period = 6;
+   else if( ht->period > 50 )
+      ht->period = 50;
+   ht->period = (0.2*ht->period) + (0.8 * tempReal);
+
+   ht->smoothPeriod = (0.33*ht->period)+(0.67*ht->smoothPeriod);
+
+   if( ht->flags & (HT_PHASE|HT_TRENDMODE) )
+   {
+      ht->smoothPrice[ht->smoothPriceIdx] = smoothedValue;
+
+      /* Dominant cycle phase, over up to the last 50 smoothed prices. */
+      ht->prevDCPhase = ht->DCPhase;
+      DCPeriodInt = (int)(ht->smoothPeriod+0.5);
+      realPart = 0.0;
+      imagPart = 0.0;
+
+      idx = ht->smoothPriceIdx;
+      for( i=0; i < DCPeriodInt; i++ )
+      {
+         tempReal  = ((double)i*ht->constDeg2RadBy360)/(double)DCPeriodInt;
+         tempReal2 = ht->smoothPrice[idx];
+         realPart += std_sin(tempReal)*tempReal2;
+         imagPart += std_cos(tempReal)*tempReal2;
+         if( idx == 0 )
+            idx = HT_SIZE-1;
+         else
+            idx--;
+      }
+
+      tempReal = std_fabs(imagPart);
+      if( tempReal > 0.0 )
+         ht->DCPhase = std_atan(realPart/imagPart)*ht->rad2Deg;
+      else if( tempReal <= 0.01 )
+      {
+         if( realPart < 0.0 )
+            ht->DCPhase -= 90.0;
+         else if( realPart > 0.0 )
+            ht->DCPhase += 90.0;
+      }
+      ht->DCPhase += 90.0;
+
+      /* Compensate for one bar lag of the weighted moving average */
+      ht->DCPhase += 360.0 / ht->smoothPeriod;
+      if( imagPart < 0.0 )
+         ht->DCPhase += 180.0;
+      if( ht->DCPhase > 315.0 )
+         ht->DCPhase -= 360.0;
+
+      ht->prevSine     = ht->sine;
+      ht->prevLeadSine = ht->leadSine;
+      ht->sine     = std_sin(ht->DCPhase*ht->deg2Rad);
+      ht->leadSine = std_sin((ht->DCPhase+45)*ht->deg2Rad);
+   }
+
+   if( ht->flags & (HT_TRENDLINE|HT_TRENDMODE) )
+   {
+      /* Average of the prices over the dominant cycle, then smoothed. */
+      DCPeriodInt = (int)(ht->smoothPeriod+0.5);
+
+      idx = ht->priceIdx;
+      tempReal = 0.0;
+      for( i=0; i < DCPeriodInt; i++ )
+      {
+         if( idx == 0 )
+            idx = HT_SIZE-1;
+         else
+            idx--;
+         tempReal += ht->price[idx];
+      }
+
+      if( DCPeriodInt > 0 )
+         tempReal = tempReal/(double)DCPeriodInt;
+
+      ht->trendline = (4.0*tempReal + 3.0*ht->iTrend1 + 2.0*ht->iTrend2 + ht->iTrend3) / 10.0;
+      ht->iTrend3   = ht->iTrend2;
+      ht->iTrend2   = ht->iTrend1;
+      ht->iTrend1   = tempReal;
+   }
+
+   if( ht->flags & HT_TRENDMODE )
+   {
+      /* Trend by default, cycle when the sine wave lines cross or
+       * the phase advances at the rate of the dominant cycle.
+       */
+      ht->trend = 1;
+
+      if( ((ht->sine > ht->leadSine) && (ht->prevSine <= ht->prevLeadSine)) ||
+          ((ht->sine < ht->leadSine) && (ht->prevSine >= ht->prevLeadSine)) )
+      {
+         ht->daysInTrend = 0;
+         ht->trend = 0;
+      }
+
+      ht->daysInTrend++;
+
+      if( ht->daysInTrend < (0.5*ht->smoothPeriod) )
+         ht->trend = 0;
+
+      tempReal = ht->DCPhase - ht->prevDCPhase;
+      if( (ht->smoothPeriod != 0.0) &&
+          ((tempReal > (0.67*360.0/ht->smoothPeriod)) && (tempReal < (1.5*360.0/ht->smoothPeriod))) )
+      {
+         ht->trend = 0;
+      }
+
+      tempReal = ht->smoothPrice[ht->smoothPriceIdx];
+      if( (ht->trendline != 0.0) && (std_fabs( (tempReal - ht->trendline)/ht->trendline ) >= 0.015) )
+         ht->trend = 1;
+   }
+
+   if( ++ht->smoothPriceIdx == HT_SIZE )
+      ht->smoothPriceIdx = 0;
+
+   return today >= ht->lookback;
+}
+
+/**** Highest and lowest ****/
+
+/* 'array' has 2*size doubles: the values, then the bar indexes. */
+static void extremeInit( TA_StreamExtreme *extreme, double *array, int size, int highest )
+{
+   extreme->value   = array;
+   extreme->idx     = (int *)(array + size);
+   extreme->size    = size;
+   extreme->highest = highest;
+   extreme->first   = 0;
+   extreme->count   = 0;
+}
+
+/* Returns the highest (lowest) of the last 'size' values, its bar
+ * index is idx[first].
+ */
+static double extremePush( TA_StreamExtreme *extreme, double value, int today )
+{
+   int last;
+
+   /* Drop the bar out of the window, then the ones that can no longer
+    * be the highest (lowest) before adding today.
+    */
+   if( extreme->count && (extreme->idx[extreme->first] <= today-extreme->size) )
+   {
+      extreme->first = (extreme->first+1) % extreme->size;
+      extreme->count--;
+   }
+   while( extreme->count )
+   {
+      last = (extreme->first+extreme->count-1) % extreme->size;
+      if( extreme->highest ? (extreme->value[last] > value) : (extreme->value[last] < value) )
+         break;
+      extreme->count--;
+   }
+   last = (extreme->first+extreme->count) % extreme->size;
+   extreme->value[last] = value;
+   extreme->idx[last]   = today;
+   extreme->count++;
+
+   return extreme->value[extreme->first];
+}
+
+/**** RSI ****/
+static void rsiInit( TA_StreamRSI *rsi, int period, int lookback, int unstablePeriod )
+{
+   rsi->period   = period;
+   rsi->lookback = lookback;
+   rsi->metastockFirst = (unstablePeriod == 0) &&
+                         (TA_GLOBALS_COMPATIBILITY == TA_COMPATIBILITY_METASTOCK);
+}
+
+/* Returns 1 when 'gain' and 'loss' are the averages of an output bar. */
+static int rsiUpdate( TA_StreamRSI *rsi, double value, double *gain, double *loss )
+{
+   double tempValue2;
+   int today, period;
+
+   period = rsi->period;
+   today  = rsi->nbBar++;
+   if( today == 0 )
+   {
+      rsi->prevValue = value;
+      return 0;
+   }
+
+   tempValue2 = value - rsi->prevValue;
+   rsi->prevValue = value;
+
+   if( today <= period )
+   {
+      /* Sum of the gains and losses of the first 'period' bars. */
+      if( tempValue2 < 0 )
+         rsi->prevLoss -= tempValue2;
+      else
+         rsi->prevGain += tempValue2;
+
+      if( today < period )
+      {
+         /* Metastock also outputs the bar before, from the
+          * first 'period-1' differences.
+          */
+         if( (today == period-1) && rsi->metastockFirst )
+         {
+            *loss = rsi->prevLoss/period;
+            *gain = rsi->prevGain/period;
+            return 1;
+         }
+         return 0;
+      }
+
+      rsi->prevLoss /= period;
+      rsi->prevGain /= period;
+   }
+   else
+   {
+      rsi->prevLoss *= (period-1);
+      rsi->prevGain *= (period-1);
+      if( tempValue2 < 0 )
+         rsi->prevLoss -= tempValue2;
+      else
+         rsi->prevGain += tempValue2;
+      rsi->prevLoss /= period;
+      rsi->prevGain /= period;
+   }
+
+   if( today < rsi->lookback )
+      return 0;
+
+   *gain = rsi->prevGain;
+   *loss = rsi->prevLoss;
+   return 1;
+}
+
+/**** STOCHF ****/
+
+/* 'array' holds the doubles of the MA followed by 4*fastKPeriod. */
+static void stochfInit( TA_STOCHF_State *stochf, double *array, int fastKPeriod,
+                        int fastDPeriod, TA_MAType fastDMAType )
+{
+   stochf->fastKPeriod = fastKPeriod;
+   stochf->nbBar       = 0;
+   maInit( &stochf->fastD, array, fastDPeriod, fastDMAType );
+   array += maNbDouble( fastDPeriod, fastDMAType );
+   extremeInit( &stochf->highest, array, fastKPeriod, 1 );
+   extremeInit( &stochf->lowest, array + 2*fastKPeriod, fastKPeriod, 0 );
+}
+
+/**** DM and ADX ****/
+static void dmInit( TA_StreamDM *dm, int period )
+{
+   dm->period = period;
+}
+
+/* Returns the index of the bar. */
+static int dmUpdate( TA_StreamDM *dm, double high, double low, double close )
+{
+   int today, period;
+
+   period = dm->period;
+   today  = dm->nbBar++;
+   if( today == 0 )
+   {
+      dm->prevHigh  = high;
+      dm->prevLow   = low;
+      dm->prevClose = close;
+      return today;
+   }
+
+   dm->diffP = high - dm->prevHigh;
+   dm->prevHigh = high;
+   dm->diffM = dm->prevLow - low;
+   dm->prevLow = low;
+   dm->tr = trueRange( high, low, dm->prevClose );
+   dm->prevClose = close;
+
+   /* Past the first sum, the old movements decay. */
+   if( today >= period )
+   {
+      dm->prevMinusDM -= dm->prevMinusDM/period;
+      dm->prevPlusDM  -= dm->prevPlusDM/period;
+   }
+
+   if( (dm->diffM > 0) && (dm->diffP < dm->diffM) )
+      dm->prevMinusDM += dm->diffM;
+   else if( (dm->diffP > 0) && (dm->diffP > dm->diffM) )
+      dm->prevPlusDM += dm->diffP;
+
+   if( today < period )
+      dm->prevTR += dm->tr;
+   else
+      dm->prevTR = dm->prevTR - (dm->prevTR/period) + dm->tr;
+
+   return today;
+}
+
+/* Returns 1 when 'prevADX' is an output. */
+static int adxUpdate( TA_StreamADX *adx, double high, double low, double close )
+{
+   TA_StreamDM *dm;
+   double minusDI, plusDI, tempReal;
+   int today, period;
+
+   dm = &adx->dm;
+   period = dm->period;
+   today = dmUpdate( dm, high, low, close );
+   if( today < period )
+      return 0;
+
+   /* The DX of the bar, skipped when the DI are undefined or zero. */
+   if( !TA_IS_ZERO(dm->prevTR) )
+   {
+      minusDI  = 100.0*(dm->prevMinusDM/dm->prevTR);
+      plusDI   = 100.0*(dm->prevPlusDM/dm->prevTR);
+      tempReal = minusDI+plusDI;
+      if( !TA_IS_ZERO(tempReal) )
+      {
+         tempReal = 100.0*(std_fabs(minusDI-plusDI)/tempReal);
+         if( today < 2*period )
+            adx->sumDX += tempReal;
+         else
+            adx->prevADX = ((adx->prevADX*(period-1))+tempReal)/period;
+      }
+   }
+
+   /* Seeded with the simple average of the first DX. */
+   if( today == 2*period-1 )
+      adx->prevADX = adx->sumDX / period;
+
+   return today >= adx->lookback;
+}
+
+/**** SAR ****/
+static void sarInit( TA_StreamSAR *sar, int signedOutput, double startValue,
+                     double offsetOnReverse, double accelerationInitLong,
+                     double accelerationLong, double accelerationMaxLong,
+                     double accelerationInitShort, double accelerationShort,
+                     double accelerationMaxShort )
+{
+   sar->signedOutput    = signedOutput;
+   sar->startValue      = startValue;
+   sar->offsetOnReverse = offsetOnReverse;
+
+   /* The factors are clipped to their maximum like in TA_SAREXT. */
+   sar->afLong  = accelerationInitLong;
+   sar->afShort = accelerationInitShort;
+   if( sar->afLong > accelerationMaxLong )
+      sar->afLong = accelerationInitLong = accelerationMaxLong;
+   if( accelerationLong > accelerationMaxLong )
+      accelerationLong = accelerationMaxLong;
+   if( sar->afShort > accelerationMaxShort )
+      sar->afShort = accelerationInitShort = accelerationMaxShort;
+   if( accelerationShort > accelerationMaxShort )
+      accelerationShort = accelerationMaxShort;
+
+   sar->accelerationInitLong  = accelerationInitLong;
+   sar->accelerationLong      = accelerationLong;
+   sar->accelerationMaxLong   = accelerationMaxLong;
+   sar->accelerationInitShort = accelerationInitShort;
+   sar->accelerationShort     = accelerationShort;
+   sar->accelerationMaxShort  = accelerationMaxShort;
+}
+
+/* Returns 1 when 'out' is set, from the second bar. */
+static int sarUpdate( TA_StreamSAR *sar, double high, double low, double *out )
+{
+   double prevHigh, prevLow, diffP, diffM;
+   int today;
+
+   today = sar->nbBar++;
+   if( today == 0 )
+   {
+      sar->newHigh = high;
+      sar->newLow  = low;
+      return 0;
+   }
+
+   if( today == 1 )
+   {
+      /* The first position is the one of the -DM of the first two
+       * bars, unless a start value is given.
+       */
+      if( sar->startValue == 0 )
+      {
+         diffP = high - sar->newHigh;
+         diffM = sar->newLow - low;
+         sar->isLong = !((diffM > 0) && (diffP < diffM));
+         if( sar->isLong )
+         {
+            sar->ep  = high;
+            sar->sar = sar->newLow;
+         }
+         else
+         {
+            sar->ep  = low;
+            sar->sar = sar->newHigh;
+         }
+      }
+      else if( sar->startValue > 0 )
+      {
+         sar->isLong = 1;
+         sar->ep  = high;
+         sar->sar = sar->startValue;
+      }
+      else
+      {
+         sar->isLong = 0;
+         sar->ep  = low;
+         sar->sar = std_fabs(sar->startValue);
+      }
+      sar->newLow  = low;
+      sar->newHigh = high;
+   }
+
+   prevLow  = sar->newLow;
+   prevHigh = sar->newHigh;
+   sar->newLow  = low;
+   sar->newHigh = high;
+
+   if( sar->isLong )
+   {
+      if( low <= sar->sar )
+      {
+         /* Switch to short, the SAR is the highest of the position. */
+         sar->isLong = 0;
+         sar->sar = sar->ep;
+         if( sar->sar < prevHigh )
+            sar->sar = prevHigh;
+         if( sar->sar < high )
+            sar->sar = high;
+         if( sar->offsetOnReverse != 0.0 )
+            sar->sar += sar->sar * sar->offsetOnReverse;
+         *out = sar->signedOutput ? -sar->sar : sar->sar;
+         sar->afShort = sar->accelerationInitShort;
+         sar->ep = low;
+         sar->sar = sar->sar + sar->afShort * (sar->ep - sar->sar);
+         if( sar->sar < prevHigh )
+            sar->sar = prevHigh;
+         if( sar->sar < high )
+            sar->sar = high;
+      }
+      else
+      {
+         *out = sar->sar;
+         if( high > sar->ep )
+         {
+            sar->ep = high;
+            sar->afLong += sar->accelerationLong;
+            if( sar->afLong > sar->accelerationMaxLong )
+               sar->afLong = sar->accelerationMaxLong;
+         }
+         sar->sar = sar->sar + sar->afLong * (sar->ep - sar->sar);
+         if( sar->sar > prevLow )
+            sar->sar = prevLow;
+         if( sar->sar > low )
+            sar->sar = low;
+      }
+   }
+   else
+   {
+      if( high >= sar->sar )
+      {
+         /* Switch to long, the SAR is the lowest of the position. */
+         sar->isLong = 1;
+         sar->sar = sar->ep;
+         if( sar->sar > prevLow )
+            sar->sar = prevLow;
+         if( sar->sar > low )
+            sar->sar = low;
+         if( sar->offsetOnReverse != 0.0 )
+            sar->sar -= sar->sar * sar->offsetOnReverse;
+         *out = sar->sar;
+         sar->afLong = sar->accelerationInitLong;
+         sar->ep = high;
+         sar->sar = sar->sar + sar->afLong * (sar->ep - sar->sar);
+         if( sar->sar > prevLow )
+            sar->sar = prevLow;
+         if( sar->sar > low )
+            sar->sar = low;
+      }
+      else
+      {
+         *out = sar->signedOutput ? -sar->sar : sar->sar;
+         if( low < sar->ep )
+         {
+            sar->ep = low;
+            sar->afShort += sar->accelerationShort;
+            if( sar->afShort > sar->accelerationMaxShort )
+               sar->afShort = sar->accelerationMaxShort;
+         }
+         sar->sar = sar->sar + sar->afShort * (sar->ep - sar->sar);
+         if( sar->sar < prevHigh )
+            sar->sar = prevHigh;
+         if( sar->sar < high )
+            sar->sar = high;
+      }
+   }
+
+   return 1;
+}
+
+/**** Moving averages ****/
+TA_RetCode TA_SMA_StateInit( TA_SMA_State **state,
+                             int           optInTimePeriod )
+{
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 30;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   *state = (TA_SMA_State *)maAlloc( sizeof(TA_SMA_State), 0, optInTimePeriod, TA_MAType_SMA, NULL );
+   if( !*state )
+      return TA_ALLOC_ERR;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_SMA_StateUpdate( TA_SMA_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = maUpdate( &state->ma, inReal, outReal );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_SMA_StateFree( TA_SMA_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_EMA_StateInit( TA_EMA_State **state,
+                             int           optInTimePeriod )
+{
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 30;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   *state = (TA_EMA_State *)maAlloc( sizeof(TA_EMA_State), 0, optInTimePeriod, TA_MAType_EMA, NULL );
+   if( !*state )
+      return TA_ALLOC_ERR;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_EMA_StateUpdate( TA_EMA_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = maUpdate( &state->ma, inReal, outReal );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_EMA_StateFree( TA_EMA_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_WMA_StateInit( TA_WMA_State **state,
+                             int           optInTimePeriod )
+{
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 30;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   *state = (TA_WMA_State *)maAlloc( sizeof(TA_WMA_State), 0, optInTimePeriod, TA_MAType_WMA, NULL );
+   if( !*state )
+      return TA_ALLOC_ERR;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_WMA_StateUpdate( TA_WMA_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = maUpdate( &state->ma, inReal, outReal );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_WMA_StateFree( TA_WMA_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_DEMA_StateInit( TA_DEMA_State **state,
+                              int           optInTimePeriod )
+{
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 30;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   *state = (TA_DEMA_State *)maAlloc( sizeof(TA_DEMA_State), 0, optInTimePeriod, TA_MAType_DEMA, NULL );
+   if( !*state )
+      return TA_ALLOC_ERR;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_DEMA_StateUpdate( TA_DEMA_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = maUpdate( &state->ma, inReal, outReal );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_DEMA_StateFree( TA_DEMA_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_TEMA_StateInit( TA_TEMA_State **state,
+                              int           optInTimePeriod )
+{
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 30;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   *state = (TA_TEMA_State *)maAlloc( sizeof(TA_TEMA_State), 0, optInTimePeriod, TA_MAType_TEMA, NULL );
+   if( !*state )
+      return TA_ALLOC_ERR;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_TEMA_StateUpdate( TA_TEMA_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = maUpdate( &state->ma, inReal, outReal );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_TEMA_StateFree( TA_TEMA_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_TRIMA_StateInit( TA_TRIMA_State **state,
+                              int           optInTimePeriod )
+{
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 30;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   *state = (TA_TRIMA_State *)maAlloc( sizeof(TA_TRIMA_State), 0, optInTimePeriod, TA_MAType_TRIMA, NULL );
+   if( !*state )
+      return TA_ALLOC_ERR;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_TRIMA_StateUpdate( TA_TRIMA_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = maUpdate( &state->ma, inReal, outReal );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_TRIMA_StateFree( TA_TRIMA_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_KAMA_StateInit( TA_KAMA_State **state,
+                             int           optInTimePeriod )
+{
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 30;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   *state = (TA_KAMA_State *)maAlloc( sizeof(TA_KAMA_State), 0, optInTimePeriod, TA_MAType_KAMA, NULL );
+   if( !*state )
+      return TA_ALLOC_ERR;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_KAMA_StateUpdate( TA_KAMA_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = maUpdate( &state->ma, inReal, outReal );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_KAMA_StateFree( TA_KAMA_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_T3_StateInit( TA_T3_State **state,
+                            int           optInTimePeriod,
+                            double        optInVFactor )
+{
+   TA_T3_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 5;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( optInVFactor == TA_REAL_DEFAULT )
+      optInVFactor = 7.000000e-1;
+   else if( (optInVFactor < 0.000000e+0) || (optInVFactor > 1.000000e+0) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_T3_State *)maAlloc( sizeof(TA_T3_State), 0, optInTimePeriod, TA_MAType_T3, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   t3SetVFactor( &newState->ma, optInVFactor );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_T3_StateUpdate( TA_T3_State *state,
+                              double        inReal,
+                              int          *outNBElement,
+                              double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = maUpdate( &state->ma, inReal, outReal );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_T3_StateFree( TA_T3_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MAMA_StateInit( TA_MAMA_State **state,
+                              double        optInFastLimit,
+                              double        optInSlowLimit )
+{
+   TA_MAMA_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( optInFastLimit == TA_REAL_DEFAULT )
+      optInFastLimit = 5.000000e-1;
+   else if( (optInFastLimit < 1.000000e-2) || (optInFastLimit > 9.900000e-1) )
+      return TA_BAD_PARAM;
+
+   if( optInSlowLimit == TA_REAL_DEFAULT )
+      optInSlowLimit = 5.000000e-2;
+   else if( (optInSlowLimit < 1.000000e-2) || (optInSlowLimit > 9.900000e-1) )
+      return TA_BAD_PARAM;
+
+   /* MAMA has no period, its lookback is the one of TA_MAMA. */
+   newState = (TA_MAMA_State *)maAlloc( sizeof(TA_MAMA_State), 0, 0, TA_MAType_MAMA, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   newState->ma.fastLimit = optInFastLimit;
+   newState->ma.slowLimit = optInSlowLimit;
+   newState->ma.lookback  = TA_MAMA_Lookback( optInFastLimit, optInSlowLimit );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MAMA_StateUpdate( TA_MAMA_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outMAMA,
+                                double       *outFAMA )
+{
+   if( !state || !outNBElement || !outMAMA || !outFAMA )
+      return TA_BAD_PARAM;
+
+   *outNBElement = maUpdate( &state->ma, inReal, outMAMA );
+   if( *outNBElement )
+      *outFAMA = state->ma.fama;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MAMA_StateFree( TA_MAMA_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MA_StateInit( TA_MA_State **state,
+                            int           optInTimePeriod,
+                            TA_MAType     optInMAType )
+{
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 30;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInMAType == TA_INTEGER_DEFAULT )
+      optInMAType = (TA_MAType)0;
+   else if( ((int)optInMAType < 0) || ((int)optInMAType > 8) )
+      return TA_BAD_PARAM;
+
+   *state = (TA_MA_State *)maAlloc( sizeof(TA_MA_State), 0, optInTimePeriod, optInMAType, NULL );
+   if( !*state )
+      return TA_ALLOC_ERR;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MA_StateUpdate( TA_MA_State *state,
+                              double        inReal,
+                              int          *outNBElement,
+                              double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = maUpdate( &state->ma, inReal, outReal );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MA_StateFree( TA_MA_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** BBANDS ****/
+TA_RetCode TA_BBANDS_StateInit( TA_BBANDS_State **state,
+                                int           optInTimePeriod,
+                                double        optInNbDevUp,
+                                double        optInNbDevDn,
+                                TA_MAType     optInMAType )
+{
+   TA_BBANDS_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 5;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( optInNbDevUp == TA_REAL_DEFAULT )
+      optInNbDevUp = 2.000000e+0;
+   else if( (optInNbDevUp < -3.000000e+37) || (optInNbDevUp > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   if( optInNbDevDn == TA_REAL_DEFAULT )
+      optInNbDevDn = 2.000000e+0;
+   else if( (optInNbDevDn < -3.000000e+37) || (optInNbDevDn > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInMAType == TA_INTEGER_DEFAULT )
+      optInMAType = (TA_MAType)0;
+   else if( ((int)optInMAType < 0) || ((int)optInMAType > 8) )
+      return TA_BAD_PARAM;
+
+   /* The window of the deviation follows the doubles of the MA. */
+   newState = (TA_BBANDS_State *)maAlloc( sizeof(TA_BBANDS_State), optInTimePeriod,
+                                          optInTimePeriod, optInMAType, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   /* The deviation is the one of TA_STDDEV started at the first output of
+    * the MA. For the SMA, it starts at the first bar and gives the same
+    * results as the deviation from the SMA done by TA_BBANDS.
+    */
+   varInit( &newState->var, window, optInTimePeriod,
+            newState->ma.lookback - (optInTimePeriod-1) );
+   newState->nbDevUp = optInNbDevUp;
+   newState->nbDevDn = optInNbDevDn;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_BBANDS_StateUpdate( TA_BBANDS_State *state,
+                                  double        inReal,
+                                  int          *outNBElement,
+                                  double       *outRealUpperBand,
+                                  double       *outRealMiddleBand,
+                                  double       *outRealLowerBand )
+{
+   double middle, variance, stdDev;
+   int ready;
+
+   if( !state || !outNBElement || !outRealUpperBand || !outRealMiddleBand || !outRealLowerBand )
+      return TA_BAD_PARAM;
+
+   *outNBElement = 0;
+
+   ready = maUpdate( &state->ma, inReal, &middle );
+   if( !varUpdate( &state->var, inReal, &variance ) || !ready )
+      return TA_SUCCESS;
+
+   if( !TA_IS_ZERO_OR_NEG(variance) )
+      stdDev = std_sqrt(variance);
+   else
+      stdDev = (double)0.0;
+
+   /* A factor of 1.0 leaves the deviation unchanged. */
+   *outRealUpperBand  = middle + (stdDev * state->nbDevUp);
+   *outRealMiddleBand = middle;
+   *outRealLowerBand  = middle - (stdDev * state->nbDevDn);
+   *outNBElement = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_BBANDS_StateFree( TA_BBANDS_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** STDDEV ****/
+TA_RetCode TA_STDDEV_StateInit( TA_STDDEV_State **state,
+                                int           optInTimePeriod,
+                                double        optInNbDev )
+{
+   TA_STDDEV_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 5;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( optInNbDev == TA_REAL_DEFAULT )
+      optInNbDev = 1.000000e+0;
+   else if( (optInNbDev < -3.000000e+37) || (optInNbDev > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_STDDEV_State *)stateAlloc( sizeof(TA_STDDEV_State), optInTimePeriod, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   varInit( &newState->var, window, optInTimePeriod, 0 );
+   newState->nbDev = optInNbDev;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_STDDEV_StateUpdate( TA_STDDEV_State *state,
+                                  double        inReal,
+                                  int          *outNBElement,
+                                  double       *outReal )
+{
+   double variance;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = varUpdate( &state->var, inReal, &variance );
+   if( *outNBElement )
+   {
+      if( !TA_IS_ZERO_OR_NEG(variance) )
+         *outReal = std_sqrt(variance) * state->nbDev;
+      else
+         *outReal = (double)0.0;
+   }
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_STDDEV_StateFree( TA_STDDEV_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** VAR and SUM ****/
+TA_RetCode TA_VAR_StateInit( TA_VAR_State **state,
+                             int           optInTimePeriod,
+                             double        optInNbDev )
+{
+   TA_VAR_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 5;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   /* Like TA_VAR, the deviation factor is not used. */
+   if( optInNbDev == TA_REAL_DEFAULT )
+      optInNbDev = 1.000000e+0;
+   else if( (optInNbDev < -3.000000e+37) || (optInNbDev > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_VAR_State *)stateAlloc( sizeof(TA_VAR_State), optInTimePeriod, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   varInit( &newState->var, window, optInTimePeriod, 0 );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_VAR_StateUpdate( TA_VAR_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = varUpdate( &state->var, inReal, outReal );
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_VAR_StateFree( TA_VAR_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_SUM_StateInit( TA_SUM_State **state,
+                             int           optInTimePeriod )
+{
+   TA_SUM_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 30;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_SUM_State *)stateAlloc( sizeof(TA_SUM_State), optInTimePeriod, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   newState->window.value = window;
+   newState->window.size  = optInTimePeriod;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_SUM_StateUpdate( TA_SUM_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   /* TA_SUM subtracts the trailing value after the output. */
+   state->periodTotal -= windowPush( &state->window, inReal );
+   state->periodTotal += inReal;
+
+   *outNBElement = ++state->nbBar >= state->window.size;
+   if( *outNBElement )
+      *outReal = state->periodTotal;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_SUM_StateFree( TA_SUM_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** CORREL and BETA ****/
+TA_RetCode TA_CORREL_StateInit( TA_CORREL_State **state,
+                                int              optInTimePeriod )
+{
+   TA_CORREL_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 30;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_CORREL_State *)stateAlloc( sizeof(TA_CORREL_State), 2*optInTimePeriod, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   newState->windowX.value = window;
+   newState->windowX.size  = optInTimePeriod;
+   newState->windowY.value = window+optInTimePeriod;
+   newState->windowY.size  = optInTimePeriod;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_CORREL_StateUpdate( TA_CORREL_State *state,
+                                  double           inReal0,
+                                  double           inReal1,
+                                  int             *outNBElement,
+                                  double          *outReal )
+{
+   double trailingX, trailingY, tempReal;
+   int period;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   /* Same order as TA_CORREL: remove the trailing pair, then add today. */
+   trailingX = windowPush( &state->windowX, inReal0 );
+   trailingY = windowPush( &state->windowY, inReal1 );
+   state->sumX  -= trailingX;
+   state->sumX2 -= trailingX*trailingX;
+   state->sumXY -= trailingX*trailingY;
+   state->sumY  -= trailingY;
+   state->sumY2 -= trailingY*trailingY;
+   state->sumX  += inReal0;
+   state->sumX2 += inReal0*inReal0;
+   state->sumXY += inReal0*inReal1;
+   state->sumY  += inReal1;
+   state->sumY2 += inReal1*inReal1;
+
+   period = state->windowX.size;
+   *outNBElement = ++state->nbBar >= period;
+   if( !*outNBElement )
+      return TA_SUCCESS;
+
+   tempReal = (state->sumX2-((state->sumX*state->sumX)/period)) *
+              (state->sumY2-((state->sumY*state->sumY)/period));
+   if( !TA_IS_ZERO_OR_NEG(tempReal) )
+      *outReal = (state->sumXY-((state->sumX*state->sumY)/period)) / std_sqrt(tempReal);
+   else
+      *outReal = 0.0;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_CORREL_StateFree( TA_CORREL_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_BETA_StateInit( TA_BETA_State **state,
+                              int            optInTimePeriod )
+{
+   TA_BETA_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 5;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_BETA_State *)stateAlloc( sizeof(TA_BETA_State), 2*optInTimePeriod, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   newState->windowX.value = window;
+   newState->windowX.size  = optInTimePeriod;
+   newState->windowY.value = window+optInTimePeriod;
+   newState->windowY.size  = optInTimePeriod;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_BETA_StateUpdate( TA_BETA_State *state,
+                                double         inReal0,
+                                double         inReal1,
+                                int           *outNBElement,
+                                double        *outReal )
+{
+   double x, y, trailingX, trailingY, n, tempReal;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = 0;
+
+   /* The first bar only gives the price the first returns are
+    * computed from.
+    */
+   if( state->nbBar++ == 0 )
+   {
+      state->lastPriceX = inReal0;
+      state->lastPriceY = inReal1;
+      return TA_SUCCESS;
+   }
+
+   if( !TA_IS_ZERO(state->lastPriceX) )
+      x = (inReal0-state->lastPriceX)/state->lastPriceX;
+   else
+      x = 0.0;
+   state->lastPriceX = inReal0;
+   if( !TA_IS_ZERO(state->lastPriceY) )
+      y = (inReal1-state->lastPriceY)/state->lastPriceY;
+   else
+      y = 0.0;
+   state->lastPriceY = inReal1;
+
+   /* TA_BETA removes the trailing return after the output, which is
+    * the same as removing it before adding today's.
+    */
+   trailingX = windowPush( &state->windowX, x );
+   trailingY = windowPush( &state->windowY, y );
+   state->S_xx -= trailingX*trailingX;
+   state->S_xy -= trailingX*trailingY;
+   state->S_x  -= trailingX;
+   state->S_y  -= trailingY;
+   state->S_xx += x*x;
+   state->S_xy += x*y;
+   state->S_x  += x;
+   state->S_y  += y;
+
+   if( state->nbBar <= state->windowX.size )
+      return TA_SUCCESS;
+
+   n = (double)state->windowX.size;
+   tempReal = (n * state->S_xx) - (state->S_x * state->S_x);
+   if( !TA_IS_ZERO(tempReal) )
+      *outReal = ((n * state->S_xy) - (state->S_x * state->S_y)) / tempReal;
+   else
+      *outReal = 0.0;
+   *outNBElement = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_BETA_StateFree( TA_BETA_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** MACD ****/
+TA_RetCode TA_MACD_StateInit( TA_MACD_State **state,
+                              int           optInFastPeriod,
+                              int           optInSlowPeriod,
+                              int           optInSignalPeriod )
+{
+   TA_MACD_State *newState;
+   int tempInteger;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInFastPeriod == TA_INTEGER_DEFAULT )
+      optInFastPeriod = 12;
+   else if( ((int)optInFastPeriod < 2) || ((int)optInFastPeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSlowPeriod == TA_INTEGER_DEFAULT )
+      optInSlowPeriod = 26;
+   else if( ((int)optInSlowPeriod < 2) || ((int)optInSlowPeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSignalPeriod == TA_INTEGER_DEFAULT )
+      optInSignalPeriod = 9;
+   else if( ((int)optInSignalPeriod < 1) || ((int)optInSignalPeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   /* Make sure slow is really slower than the fast period. */
+   if( optInSlowPeriod < optInFastPeriod )
+   {
+       tempInteger     = optInSlowPeriod;
+       optInSlowPeriod = optInFastPeriod;
+       optInFastPeriod = tempInteger;
+   }
+
+   newState = (TA_MACD_State *)stateAlloc( sizeof(TA_MACD_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   macdInit( newState, optInFastPeriod, PER_TO_K(optInFastPeriod),
+             optInSlowPeriod, PER_TO_K(optInSlowPeriod), optInSignalPeriod );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MACD_StateUpdate( TA_MACD_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outMACD,
+                                double       *outMACDSignal,
+                                double       *outMACDHist )
+{
+   double macd;
+   int ready;
+
+   if( !state || !outNBElement || !outMACD || !outMACDSignal || !outMACDHist )
+      return TA_BAD_PARAM;
+
+   *outNBElement = 0;
+
+   ready = emaUpdate( &state->slow, inReal );
+   emaUpdate( &state->fast, inReal );
+   if( !ready )
+      return TA_SUCCESS;
+
+   macd = state->fast.prevMA - state->slow.prevMA;
+   if( !emaUpdate( &state->signal, macd ) )
+      return TA_SUCCESS;
+
+   *outMACD       = macd;
+   *outMACDSignal = state->signal.prevMA;
+   *outMACDHist   = macd-state->signal.prevMA;
+   *outNBElement  = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MACD_StateFree( TA_MACD_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/* The fixed 12/26 MACD, with the constants of TA_INT_MACD. */
+TA_RetCode TA_MACDFIX_StateInit( TA_MACDFIX_State **state,
+                                 int           optInSignalPeriod )
+{
+   TA_MACDFIX_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSignalPeriod == TA_INTEGER_DEFAULT )
+      optInSignalPeriod = 9;
+   else if( ((int)optInSignalPeriod < 1) || ((int)optInSignalPeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_MACDFIX_State *)stateAlloc( sizeof(TA_MACDFIX_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   macdInit( &newState->macd, 12, (double)0.15, 26, (double)0.075, optInSignalPeriod );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MACDFIX_StateUpdate( TA_MACDFIX_State *state,
+                                   double        inReal,
+                                   int          *outNBElement,
+                                   double       *outMACD,
+                                   double       *outMACDSignal,
+                                   double       *outMACDHist )
+{
+   if( !state )
+      return TA_BAD_PARAM;
+
+   return TA_MACD_StateUpdate( &state->macd, inReal, outNBElement,
+                               outMACD, outMACDSignal, outMACDHist );
+}
+
+TA_RetCode TA_MACDFIX_StateFree( TA_MACDFIX_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** MACDEXT ****/
+TA_RetCode TA_MACDEXT_StateInit( TA_MACDEXT_State **state,
+                                 int           optInFastPeriod,
+                                 TA_MAType     optInFastMAType,
+                                 int           optInSlowPeriod,
+                                 TA_MAType     optInSlowMAType,
+                                 int           optInSignalPeriod,
+                                 TA_MAType     optInSignalMAType )
+{
+   TA_MACDEXT_State *newState;
+   double *array;
+   int tempInteger, nbFast, nbSlow, lookbackLargest;
+   TA_MAType tempMAType;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInFastPeriod == TA_INTEGER_DEFAULT )
+      optInFastPeriod = 12;
+   else if( ((int)optInFastPeriod < 2) || ((int)optInFastPeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInFastMAType == TA_INTEGER_DEFAULT )
+      optInFastMAType = (TA_MAType)0;
+   else if( ((int)optInFastMAType < 0) || ((int)optInFastMAType > 8) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSlowPeriod == TA_INTEGER_DEFAULT )
+      optInSlowPeriod = 26;
+   else if( ((int)optInSlowPeriod < 2) || ((int)optInSlowPeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSlowMAType == TA_INTEGER_DEFAULT )
+      optInSlowMAType = (TA_MAType)0;
+   else if( ((int)optInSlowMAType < 0) || ((int)optInSlowMAType > 8) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSignalPeriod == TA_INTEGER_DEFAULT )
+      optInSignalPeriod = 9;
+   else if( ((int)optInSignalPeriod < 1) || ((int)optInSignalPeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSignalMAType == TA_INTEGER_DEFAULT )
+      optInSignalMAType = (TA_MAType)0;
+   else if( ((int)optInSignalMAType < 0) || ((int)optInSignalMAType > 8) )
+      return TA_BAD_PARAM;
+
+   /* Make sure slow is really slower than the fast period. */
+   if( optInSlowPeriod < optInFastPeriod )
+   {
+       tempInteger     = optInSlowPeriod;
+       optInSlowPeriod = optInFastPeriod;
+       optInFastPeriod = tempInteger;
+       tempMAType      = optInSlowMAType;
+       optInSlowMAType = optInFastMAType;
+       optInFastMAType = tempMAType;
+   }
+
+   nbFast = maNbDouble( optInFastPeriod, optInFastMAType );
+   nbSlow = maNbDouble( optInSlowPeriod, optInSlowMAType );
+   newState = (TA_MACDEXT_State *)stateAlloc( sizeof(TA_MACDEXT_State),
+                                              nbFast + nbSlow +
+                                              maNbDouble( optInSignalPeriod, optInSignalMAType ),
+                                              &array );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   maInit( &newState->fast, array, optInFastPeriod, optInFastMAType );
+   maInit( &newState->slow, array + nbFast, optInSlowPeriod, optInSlowMAType );
+   maInit( &newState->signal, array + nbFast + nbSlow, optInSignalPeriod, optInSignalMAType );
+
+   lookbackLargest = newState->fast.lookback;
+   if( newState->slow.lookback > lookbackLargest )
+      lookbackLargest = newState->slow.lookback;
+   newState->skipFast = lookbackLargest - newState->fast.lookback;
+   newState->skipSlow = lookbackLargest - newState->slow.lookback;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MACDEXT_StateUpdate( TA_MACDEXT_State *state,
+                                   double        inReal,
+                                   int          *outNBElement,
+                                   double       *outMACD,
+                                   double       *outMACDSignal,
+                                   double       *outMACDHist )
+{
+   double fast, slow, macd, signal;
+   int today, ready;
+
+   if( !state || !outNBElement || !outMACD || !outMACDSignal || !outMACDHist )
+      return TA_BAD_PARAM;
+
+   *outNBElement = 0;
+
+   today = state->nbBar++;
+   ready = 1;
+   if( (today < state->skipFast) || !maUpdate( &state->fast, inReal, &fast ) )
+      ready = 0;
+   if( (today < state->skipSlow) || !maUpdate( &state->slow, inReal, &slow ) )
+      ready = 0;
+   if( !ready )
+      return TA_SUCCESS;
+
+   macd = fast - slow;
+   if( !maUpdate( &state->signal, macd, &signal ) )
+      return TA_SUCCESS;
+
+   *outMACD       = macd;
+   *outMACDSignal = signal;
+   *outMACDHist   = macd-signal;
+   *outNBElement  = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MACDEXT_StateFree( TA_MACDEXT_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** APO and PPO ****/
+TA_RetCode TA_APO_StateInit( TA_APO_State **state,
+                             int           optInFastPeriod,
+                             int           optInSlowPeriod,
+                             TA_MAType     optInMAType )
+{
+   TA_APO_State *newState;
+   double *array;
+   int tempInteger, nbDouble;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInFastPeriod == TA_INTEGER_DEFAULT )
+      optInFastPeriod = 12;
+   else if( ((int)optInFastPeriod < 2) || ((int)optInFastPeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSlowPeriod == TA_INTEGER_DEFAULT )
+      optInSlowPeriod = 26;
+   else if( ((int)optInSlowPeriod < 2) || ((int)optInSlowPeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInMAType == TA_INTEGER_DEFAULT )
+      optInMAType = (TA_MAType)0;
+   else if( ((int)optInMAType < 0) || ((int)optInMAType > 8) )
+      return TA_BAD_PARAM;
+
+   /* Make sure slow is really slower than the fast period. */
+   if( optInSlowPeriod < optInFastPeriod )
+   {
+       tempInteger     = optInSlowPeriod;
+       optInSlowPeriod = optInFastPeriod;
+       optInFastPeriod = tempInteger;
+   }
+
+   nbDouble = maNbDouble( optInFastPeriod, optInMAType );
+   newState = (TA_APO_State *)stateAlloc( sizeof(TA_APO_State),
+                                          nbDouble + maNbDouble( optInSlowPeriod, optInMAType ),
+                                          &array );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   /* Both MA start at the first bar, like in TA_INT_PO. */
+   maInit( &newState->fast, array, optInFastPeriod, optInMAType );
+   maInit( &newState->slow, array + nbDouble, optInSlowPeriod, optInMAType );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_APO_StateUpdate( TA_APO_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   double fast, slow;
+   int ready;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = 0;
+
+   ready = maUpdate( &state->fast, inReal, &fast );
+   if( !maUpdate( &state->slow, inReal, &slow ) || !ready )
+      return TA_SUCCESS;
+
+   *outReal = fast-slow;
+   *outNBElement = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_APO_StateFree( TA_APO_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_PPO_StateInit( TA_PPO_State **state,
+                             int           optInFastPeriod,
+                             int           optInSlowPeriod,
+                             TA_MAType     optInMAType )
+{
+   TA_PPO_State *newState;
+   double *array;
+   int tempInteger, nbDouble;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInFastPeriod == TA_INTEGER_DEFAULT )
+      optInFastPeriod = 12;
+   else if( ((int)optInFastPeriod < 2) || ((int)optInFastPeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSlowPeriod == TA_INTEGER_DEFAULT )
+      optInSlowPeriod = 26;
+   else if( ((int)optInSlowPeriod < 2) || ((int)optInSlowPeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInMAType == TA_INTEGER_DEFAULT )
+      optInMAType = (TA_MAType)0;
+   else if( ((int)optInMAType < 0) || ((int)optInMAType > 8) )
+      return TA_BAD_PARAM;
+
+   /* Make sure slow is really slower than the fast period. */
+   if( optInSlowPeriod < optInFastPeriod )
+   {
+       tempInteger     = optInSlowPeriod;
+       optInSlowPeriod = optInFastPeriod;
+       optInFastPeriod = tempInteger;
+   }
+
+   nbDouble = maNbDouble( optInFastPeriod, optInMAType );
+   newState = (TA_PPO_State *)stateAlloc( sizeof(TA_PPO_State),
+                                          nbDouble + maNbDouble( optInSlowPeriod, optInMAType ),
+                                          &array );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   /* Both MA start at the first bar, like in TA_INT_PO. */
+   maInit( &newState->fast, array, optInFastPeriod, optInMAType );
+   maInit( &newState->slow, array + nbDouble, optInSlowPeriod, optInMAType );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_PPO_StateUpdate( TA_PPO_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   double fast, slow;
+   int ready;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = 0;
+
+   ready = maUpdate( &state->fast, inReal, &fast );
+   if( !maUpdate( &state->slow, inReal, &slow ) || !ready )
+      return TA_SUCCESS;
+
+   if( !TA_IS_ZERO(slow) )
+      *outReal = ((fast-slow)/slow)*100.0;
+   else
+      *outReal = 0.0;
+   *outNBElement = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_PPO_StateFree( TA_PPO_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** RSI and CMO ****/
+TA_RetCode TA_RSI_StateInit( TA_RSI_State **state,
+                             int           optInTimePeriod )
+{
+   TA_RSI_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_RSI_State *)stateAlloc( sizeof(TA_RSI_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   rsiInit( &newState->rsi, optInTimePeriod, TA_RSI_Lookback( optInTimePeriod ),
+            TA_GLOBALS_UNSTABLE_PERIOD(TA_FUNC_UNST_RSI,Rsi) );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_RSI_StateUpdate( TA_RSI_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   double gain, loss, tempValue1;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = rsiUpdate( &state->rsi, inReal, &gain, &loss );
+   if( *outNBElement )
+   {
+      tempValue1 = gain+loss;
+      if( !TA_IS_ZERO(tempValue1) )
+         *outReal = 100.0*(gain/tempValue1);
+      else
+         *outReal = 0.0;
+   }
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_RSI_StateFree( TA_RSI_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_CMO_StateInit( TA_CMO_State **state,
+                             int           optInTimePeriod )
+{
+   TA_CMO_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_CMO_State *)stateAlloc( sizeof(TA_CMO_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   rsiInit( &newState->rsi, optInTimePeriod, TA_CMO_Lookback( optInTimePeriod ),
+            TA_GLOBALS_UNSTABLE_PERIOD(TA_FUNC_UNST_CMO,Cmo) );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_CMO_StateUpdate( TA_CMO_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   double gain, loss, tempValue1;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = rsiUpdate( &state->rsi, inReal, &gain, &loss );
+   if( *outNBElement )
+   {
+      tempValue1 = gain+loss;
+      if( !TA_IS_ZERO(tempValue1) )
+         *outReal = 100.0*((gain-loss)/tempValue1);
+      else
+         *outReal = 0.0;
+   }
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_CMO_StateFree( TA_CMO_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** MOM, ROC, ROCP, ROCR and ROCR100 ****/
+TA_RetCode TA_MOM_StateInit( TA_MOM_State **state,
+                             int           optInTimePeriod )
+{
+   TA_MOM_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 10;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_MOM_State *)stateAlloc( sizeof(TA_MOM_State), optInTimePeriod, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   newState->window.value = window;
+   newState->window.size  = optInTimePeriod;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MOM_StateUpdate( TA_MOM_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   double trailingValue;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   trailingValue = windowPush( &state->window, inReal );
+   *outNBElement = state->nbBar++ >= state->window.size;
+   if( *outNBElement )
+      *outReal = inReal - trailingValue;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MOM_StateFree( TA_MOM_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ROC_StateInit( TA_ROC_State **state,
+                             int           optInTimePeriod )
+{
+   TA_ROC_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 10;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_ROC_State *)stateAlloc( sizeof(TA_ROC_State), optInTimePeriod, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   newState->window.value = window;
+   newState->window.size  = optInTimePeriod;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ROC_StateUpdate( TA_ROC_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   double tempReal;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   tempReal = windowPush( &state->window, inReal );
+   *outNBElement = state->nbBar++ >= state->window.size;
+   if( *outNBElement )
+   {
+      if( tempReal != 0.0 )
+         *outReal = ((inReal / tempReal)-1.0)*100.0;
+      else
+         *outReal = 0.0;
+   }
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ROC_StateFree( TA_ROC_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ROCP_StateInit( TA_ROCP_State **state,
+                              int           optInTimePeriod )
+{
+   TA_ROCP_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 10;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_ROCP_State *)stateAlloc( sizeof(TA_ROCP_State), optInTimePeriod, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   newState->window.value = window;
+   newState->window.size  = optInTimePeriod;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ROCP_StateUpdate( TA_ROCP_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outReal )
+{
+   double tempReal;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   tempReal = windowPush( &state->window, inReal );
+   *outNBElement = state->nbBar++ >= state->window.size;
+   if( *outNBElement )
+   {
+      if( tempReal != 0.0 )
+         *outReal = (inReal-tempReal)/tempReal;
+      else
+         *outReal = 0.0;
+   }
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ROCP_StateFree( TA_ROCP_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ROCR_StateInit( TA_ROCR_State **state,
+                              int           optInTimePeriod )
+{
+   TA_ROCR_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 10;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_ROCR_State *)stateAlloc( sizeof(TA_ROCR_State), optInTimePeriod, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   newState->window.value = window;
+   newState->window.size  = optInTimePeriod;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ROCR_StateUpdate( TA_ROCR_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outReal )
+{
+   double tempReal;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   tempReal = windowPush( &state->window, inReal );
+   *outNBElement = state->nbBar++ >= state->window.size;
+   if( *outNBElement )
+   {
+      if( tempReal != 0.0 )
+         *outReal = (inReal / tempReal);
+      else
+         *outReal = 0.0;
+   }
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ROCR_StateFree( TA_ROCR_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ROCR100_StateInit( TA_ROCR100_State **state,
+                                 int           optInTimePeriod )
+{
+   TA_ROCR100_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 10;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_ROCR100_State *)stateAlloc( sizeof(TA_ROCR100_State), optInTimePeriod, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   newState->window.value = window;
+   newState->window.size  = optInTimePeriod;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ROCR100_StateUpdate( TA_ROCR100_State *state,
+                                   double        inReal,
+                                   int          *outNBElement,
+                                   double       *outReal )
+{
+   double tempReal;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   tempReal = windowPush( &state->window, inReal );
+   *outNBElement = state->nbBar++ >= state->window.size;
+   if( *outNBElement )
+   {
+      if( tempReal != 0.0 )
+         *outReal = (inReal / tempReal)*100.0;
+      else
+         *outReal = 0.0;
+   }
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ROCR100_StateFree( TA_ROCR100_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** TRIX ****/
+TA_RetCode TA_TRIX_StateInit( TA_TRIX_State **state,
+                              int           optInTimePeriod )
+{
+   TA_TRIX_State *newState;
+   int i;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 30;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_TRIX_State *)stateAlloc( sizeof(TA_TRIX_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   for( i=0; i < 3; i++ )
+      emaInit( &newState->ema[i], optInTimePeriod, PER_TO_K(optInTimePeriod), 0 );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_TRIX_StateUpdate( TA_TRIX_State *state,
+                                double        inReal,
+                                int          *outNBElement,
+                                double       *outReal )
+{
+   double tempReal;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = 0;
+
+   if( !emaUpdate( &state->ema[0], inReal ) ||
+       !emaUpdate( &state->ema[1], state->ema[0].prevMA ) ||
+       !emaUpdate( &state->ema[2], state->ema[1].prevMA ) )
+      return TA_SUCCESS;
+
+   /* The 1-day rate of change of the triple EMA. */
+   tempReal = state->prevEMA;
+   state->prevEMA = state->ema[2].prevMA;
+   if( state->nbEMA++ == 0 )
+      return TA_SUCCESS;
+
+   if( tempReal != 0.0 )
+      *outReal = ((state->prevEMA/tempReal)-1.0)*100.0;
+   else
+      *outReal = 0.0;
+   *outNBElement = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_TRIX_StateFree( TA_TRIX_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** MFI ****/
+TA_RetCode TA_MFI_StateInit( TA_MFI_State **state,
+                             int           optInTimePeriod )
+{
+   TA_MFI_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_MFI_State *)stateAlloc( sizeof(TA_MFI_State), 2*optInTimePeriod, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   newState->lookback       = TA_MFI_Lookback( optInTimePeriod );
+   newState->positive.value = window;
+   newState->positive.size  = optInTimePeriod;
+   newState->negative.value = window + optInTimePeriod;
+   newState->negative.size  = optInTimePeriod;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MFI_StateUpdate( TA_MFI_State *state,
+                               double        inHigh,
+                               double        inLow,
+                               double        inClose,
+                               double        inVolume,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   double tempValue1, tempValue2;
+   int today;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = 0;
+
+   today = state->nbBar++;
+   tempValue1 = (inHigh+inLow+inClose)/3.0;
+   if( today == 0 )
+   {
+      state->prevValue = tempValue1;
+      return TA_SUCCESS;
+   }
+
+   tempValue2 = tempValue1 - state->prevValue;
+   state->prevValue = tempValue1;
+   tempValue1 *= inVolume;
+
+   /* The flows of the bar leaving the window, 0.0 at first. */
+   state->posSumMF -= state->positive.value[state->positive.next];
+   state->negSumMF -= state->negative.value[state->negative.next];
+   if( tempValue2 < 0 )
+   {
+      windowPush( &state->negative, tempValue1 );
+      state->negSumMF += tempValue1;
+      windowPush( &state->positive, 0.0 );
+   }
+   else if( tempValue2 > 0 )
+   {
+      windowPush( &state->positive, tempValue1 );
+      state->posSumMF += tempValue1;
+      windowPush( &state->negative, 0.0 );
+   }
+   else
+   {
+      windowPush( &state->positive, 0.0 );
+      windowPush( &state->negative, 0.0 );
+   }
+
+   if( today < state->lookback )
+      return TA_SUCCESS;
+
+   tempValue1 = state->posSumMF+state->negSumMF;
+   if( tempValue1 < 1.0 )
+      *outReal = 0.0;
+   else
+      *outReal = 100.0*(state->posSumMF/tempValue1);
+   *outNBElement = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MFI_StateFree( TA_MFI_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** AD, ADOSC and OBV ****/
+TA_RetCode TA_AD_StateInit( TA_AD_State **state )
+{
+   if( !state )
+      return TA_BAD_PARAM;
+
+   *state = (TA_AD_State *)stateAlloc( sizeof(TA_AD_State), 0, NULL );
+   if( !*state )
+      return TA_ALLOC_ERR;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_AD_StateUpdate( TA_AD_State *state,
+                              double        inHigh,
+                              double        inLow,
+                              double        inClose,
+                              double        inVolume,
+                              int          *outNBElement,
+                              double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   adUpdate( &state->ad, inHigh, inLow, inClose, inVolume );
+   *outReal = state->ad;
+   *outNBElement = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_AD_StateFree( TA_AD_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ADOSC_StateInit( TA_ADOSC_State **state,
+                               int           optInFastPeriod,
+                               int           optInSlowPeriod )
+{
+   TA_ADOSC_State *newState;
+   int slowestPeriod;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInFastPeriod == TA_INTEGER_DEFAULT )
+      optInFastPeriod = 3;
+   else if( ((int)optInFastPeriod < 2) || ((int)optInFastPeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSlowPeriod == TA_INTEGER_DEFAULT )
+      optInSlowPeriod = 10;
+   else if( ((int)optInSlowPeriod < 2) || ((int)optInSlowPeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_ADOSC_State *)stateAlloc( sizeof(TA_ADOSC_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   if( optInFastPeriod < optInSlowPeriod )
+      slowestPeriod = optInSlowPeriod;
+   else
+      slowestPeriod = optInFastPeriod;
+
+   newState->lookback      = TA_EMA_Lookback( slowestPeriod );
+   newState->fastK         = PER_TO_K( optInFastPeriod );
+   newState->oneMinusFastK = 1.0 - newState->fastK;
+   newState->slowK         = PER_TO_K( optInSlowPeriod );
+   newState->oneMinusSlowK = 1.0 - newState->slowK;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ADOSC_StateUpdate( TA_ADOSC_State *state,
+                                 double        inHigh,
+                                 double        inLow,
+                                 double        inClose,
+                                 double        inVolume,
+                                 int          *outNBElement,
+                                 double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   adUpdate( &state->ad, inHigh, inLow, inClose, inVolume );
+   if( state->nbBar == 0 )
+   {
+      state->fastEMA = state->ad;
+      state->slowEMA = state->ad;
+   }
+   else
+   {
+      state->fastEMA = (state->fastK*state->ad)+(state->oneMinusFastK*state->fastEMA);
+      state->slowEMA = (state->slowK*state->ad)+(state->oneMinusSlowK*state->slowEMA);
+   }
+
+   *outNBElement = state->nbBar++ >= state->lookback;
+   if( *outNBElement )
+      *outReal = state->fastEMA - state->slowEMA;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ADOSC_StateFree( TA_ADOSC_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_OBV_StateInit( TA_OBV_State **state )
+{
+   if( !state )
+      return TA_BAD_PARAM;
+
+   *state = (TA_OBV_State *)stateAlloc( sizeof(TA_OBV_State), 0, NULL );
+   if( !*state )
+      return TA_ALLOC_ERR;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_OBV_StateUpdate( TA_OBV_State *state,
+                               double        inReal,
+                               double        inVolume,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   /* Started with the volume of the first bar. */
+   if( state->nbBar++ == 0 )
+      state->prevOBV = inVolume;
+   else if( inReal > state->prevReal )
+      state->prevOBV += inVolume;
+   else if( inReal < state->prevReal )
+      state->prevOBV -= inVolume;
+
+   state->prevReal = inReal;
+   *outReal = state->prevOBV;
+   *outNBElement = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_OBV_StateFree( TA_OBV_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** WILLR, STOCH and STOCHF ****/
+TA_RetCode TA_WILLR_StateInit( TA_WILLR_State **state,
+                               int           optInTimePeriod )
+{
+   TA_WILLR_State *newState;
+   double *array;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_WILLR_State *)stateAlloc( sizeof(TA_WILLR_State), 4*optInTimePeriod, &array );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   newState->period = optInTimePeriod;
+   extremeInit( &newState->highest, array, optInTimePeriod, 1 );
+   extremeInit( &newState->lowest, array + 2*optInTimePeriod, optInTimePeriod, 0 );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_WILLR_StateUpdate( TA_WILLR_State *state,
+                                 double        inHigh,
+                                 double        inLow,
+                                 double        inClose,
+                                 int          *outNBElement,
+                                 double       *outReal )
+{
+   double highest, lowest, diff;
+   int today;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   today   = state->nbBar++;
+   highest = extremePush( &state->highest, inHigh, today );
+   lowest  = extremePush( &state->lowest, inLow, today );
+
+   *outNBElement = today >= state->period-1;
+   if( *outNBElement )
+   {
+      diff = (highest - lowest)/(-100.0);
+      if( diff != 0.0 )
+         *outReal = (highest-inClose)/diff;
+      else
+         *outReal = 0.0;
+   }
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_WILLR_StateFree( TA_WILLR_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_STOCH_StateInit( TA_STOCH_State **state,
+                               int           optInFastK_Period,
+                               int           optInSlowK_Period,
+                               TA_MAType     optInSlowK_MAType,
+                               int           optInSlowD_Period,
+                               TA_MAType     optInSlowD_MAType )
+{
+   TA_STOCH_State *newState;
+   double *array;
+   int nbDouble;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInFastK_Period == TA_INTEGER_DEFAULT )
+      optInFastK_Period = 5;
+   else if( ((int)optInFastK_Period < 1) || ((int)optInFastK_Period > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSlowK_Period == TA_INTEGER_DEFAULT )
+      optInSlowK_Period = 3;
+   else if( ((int)optInSlowK_Period < 1) || ((int)optInSlowK_Period > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSlowK_MAType == TA_INTEGER_DEFAULT )
+      optInSlowK_MAType = (TA_MAType)0;
+   else if( ((int)optInSlowK_MAType < 0) || ((int)optInSlowK_MAType > 8) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSlowD_Period == TA_INTEGER_DEFAULT )
+      optInSlowD_Period = 3;
+   else if( ((int)optInSlowD_Period < 1) || ((int)optInSlowD_Period > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInSlowD_MAType == TA_INTEGER_DEFAULT )
+      optInSlowD_MAType = (TA_MAType)0;
+   else if( ((int)optInSlowD_MAType < 0) || ((int)optInSlowD_MAType > 8) )
+      return TA_BAD_PARAM;
+
+   nbDouble = maNbDouble( optInSlowK_Period, optInSlowK_MAType );
+   newState = (TA_STOCH_State *)stateAlloc( sizeof(TA_STOCH_State),
+                                            nbDouble + maNbDouble( optInSlowD_Period, optInSlowD_MAType ) +
+                                            4*optInFastK_Period, &array );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   newState->fastKPeriod = optInFastK_Period;
+   maInit( &newState->slowK, array, optInSlowK_Period, optInSlowK_MAType );
+   array += nbDouble;
+   maInit( &newState->slowD, array, optInSlowD_Period, optInSlowD_MAType );
+   array += maNbDouble( optInSlowD_Period, optInSlowD_MAType );
+   extremeInit( &newState->highest, array, optInFastK_Period, 1 );
+   extremeInit( &newState->lowest, array + 2*optInFastK_Period, optInFastK_Period, 0 );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_STOCH_StateUpdate( TA_STOCH_State *state,
+                                 double        inHigh,
+                                 double        inLow,
+                                 double        inClose,
+                                 int          *outNBElement,
+                                 double       *outSlowK,
+                                 double       *outSlowD )
+{
+   double highest, lowest, diff, fastK, slowK;
+   int today;
+
+   if( !state || !outNBElement || !outSlowK || !outSlowD )
+      return TA_BAD_PARAM;
+
+   *outNBElement = 0;
+
+   today   = state->nbBar++;
+   highest = extremePush( &state->highest, inHigh, today );
+   lowest  = extremePush( &state->lowest, inLow, today );
+   if( today < state->fastKPeriod-1 )
+      return TA_SUCCESS;
+
+   diff = (highest - lowest)/100.0;
+   if( diff != 0.0 )
+      fastK = (inClose-lowest)/diff;
+   else
+      fastK = 0.0;
+
+   /* The slow K is the MA of the fast K, the slow D the MA of the slow K. */
+   if( !maUpdate( &state->slowK, fastK, &slowK ) ||
+       !maUpdate( &state->slowD, slowK, outSlowD ) )
+      return TA_SUCCESS;
+
+   *outSlowK = slowK;
+   *outNBElement = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_STOCH_StateFree( TA_STOCH_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_STOCHF_StateInit( TA_STOCHF_State **state,
+                                int           optInFastK_Period,
+                                int           optInFastD_Period,
+                                TA_MAType     optInFastD_MAType )
+{
+   TA_STOCHF_State *newState;
+   double *array;
+   int nbDouble;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInFastK_Period == TA_INTEGER_DEFAULT )
+      optInFastK_Period = 5;
+   else if( ((int)optInFastK_Period < 1) || ((int)optInFastK_Period > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInFastD_Period == TA_INTEGER_DEFAULT )
+      optInFastD_Period = 3;
+   else if( ((int)optInFastD_Period < 1) || ((int)optInFastD_Period > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInFastD_MAType == TA_INTEGER_DEFAULT )
+      optInFastD_MAType = (TA_MAType)0;
+   else if( ((int)optInFastD_MAType < 0) || ((int)optInFastD_MAType > 8) )
+      return TA_BAD_PARAM;
+
+   nbDouble = maNbDouble( optInFastD_Period, optInFastD_MAType );
+   newState = (TA_STOCHF_State *)stateAlloc( sizeof(TA_STOCHF_State),
+                                             nbDouble + 4*optInFastK_Period, &array );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   stochfInit( newState, array, optInFastK_Period, optInFastD_Period, optInFastD_MAType );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_STOCHF_StateUpdate( TA_STOCHF_State *state,
+                                  double        inHigh,
+                                  double        inLow,
+                                  double        inClose,
+                                  int          *outNBElement,
+                                  double       *outFastK,
+                                  double       *outFastD )
+{
+   double highest, lowest, diff, fastK;
+   int today;
+
+   if( !state || !outNBElement || !outFastK || !outFastD )
+      return TA_BAD_PARAM;
+
+   *outNBElement = 0;
+
+   today   = state->nbBar++;
+   highest = extremePush( &state->highest, inHigh, today );
+   lowest  = extremePush( &state->lowest, inLow, today );
+   if( today < state->fastKPeriod-1 )
+      return TA_SUCCESS;
+
+   diff = (highest - lowest)/100.0;
+   if( diff != 0.0 )
+      fastK = (inClose-lowest)/diff;
+   else
+      fastK = 0.0;
+
+   if( !maUpdate( &state->fastD, fastK, outFastD ) )
+      return TA_SUCCESS;
+
+   *outFastK = fastK;
+   *outNBElement = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_STOCHF_StateFree( TA_STOCHF_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** STOCHRSI ****/
+TA_RetCode TA_STOCHRSI_StateInit( TA_STOCHRSI_State **state,
+                                  int           optInTimePeriod,
+                                  int           optInFastK_Period,
+                                  int           optInFastD_Period,
+                                  TA_MAType     optInFastD_MAType )
+{
+   TA_STOCHRSI_State *newState;
+   double *array;
+   int nbDouble;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInFastK_Period == TA_INTEGER_DEFAULT )
+      optInFastK_Period = 5;
+   else if( ((int)optInFastK_Period < 1) || ((int)optInFastK_Period > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInFastD_Period == TA_INTEGER_DEFAULT )
+      optInFastD_Period = 3;
+   else if( ((int)optInFastD_Period < 1) || ((int)optInFastD_Period > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInFastD_MAType == TA_INTEGER_DEFAULT )
+      optInFastD_MAType = (TA_MAType)0;
+   else if( ((int)optInFastD_MAType < 0) || ((int)optInFastD_MAType > 8) )
+      return TA_BAD_PARAM;
+
+   nbDouble = maNbDouble( optInFastD_Period, optInFastD_MAType );
+   newState = (TA_STOCHRSI_State *)stateAlloc( sizeof(TA_STOCHRSI_State),
+                                               nbDouble + 4*optInFastK_Period, &array );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   /* The RSI starts at the first bar, like the one of TA_STOCHRSI. */
+   rsiInit( &newState->rsi.rsi, optInTimePeriod, TA_RSI_Lookback( optInTimePeriod ),
+            TA_GLOBALS_UNSTABLE_PERIOD(TA_FUNC_UNST_RSI,Rsi) );
+   stochfInit( &newState->stochf, array, optInFastK_Period, optInFastD_Period, optInFastD_MAType );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_STOCHRSI_StateUpdate( TA_STOCHRSI_State *state,
+                                    double        inReal,
+                                    int          *outNBElement,
+                                    double       *outFastK,
+                                    double       *outFastD )
+{
+   TA_RetCode retCode;
+   double rsi;
+
+   if( !state || !outNBElement || !outFastK || !outFastD )
+      return TA_BAD_PARAM;
+
+   retCode = TA_RSI_StateUpdate( &state->rsi, inReal, outNBElement, &rsi );
+   if( (retCode != TA_SUCCESS) || !*outNBElement )
+      return retCode;
+
+   return TA_STOCHF_StateUpdate( &state->stochf, rsi, rsi, rsi,
+                                 outNBElement, outFastK, outFastD );
+}
+
+TA_RetCode TA_STOCHRSI_StateFree( TA_STOCHRSI_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** MAX, MIN, MIDPOINT and MIDPRICE ****/
+TA_RetCode TA_MAX_StateInit( TA_MAX_State **state,
+                             int           optInTimePeriod )
+{
+   TA_MAX_State *newState;
+   double *array;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 30;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_MAX_State *)stateAlloc( sizeof(TA_MAX_State), 2*optInTimePeriod, &array );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   extremeInit( &newState->highest, array, optInTimePeriod, 1 );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MAX_StateUpdate( TA_MAX_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   double highest;
+   int today;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   today = state->nbBar++;
+   highest = extremePush( &state->highest, inReal, today );
+
+   *outNBElement = today >= state->highest.size-1;
+   if( *outNBElement )
+      *outReal = highest;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MAX_StateFree( TA_MAX_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MIN_StateInit( TA_MIN_State **state,
+                             int           optInTimePeriod )
+{
+   TA_MIN_State *newState;
+   double *array;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 30;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_MIN_State *)stateAlloc( sizeof(TA_MIN_State), 2*optInTimePeriod, &array );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   extremeInit( &newState->lowest, array, optInTimePeriod, 0 );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MIN_StateUpdate( TA_MIN_State *state,
+                               double        inReal,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   double lowest;
+   int today;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   today = state->nbBar++;
+   lowest = extremePush( &state->lowest, inReal, today );
+
+   *outNBElement = today >= state->lowest.size-1;
+   if( *outNBElement )
+      *outReal = lowest;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MIN_StateFree( TA_MIN_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MIDPOINT_StateInit( TA_MIDPOINT_State **state,
+                                  int           optInTimePeriod )
+{
+   TA_MIDPOINT_State *newState;
+   double *array;
+   int size;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   size = optInTimePeriod;
+   newState = (TA_MIDPOINT_State *)stateAlloc( sizeof(TA_MIDPOINT_State), 4*size, &array );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   extremeInit( &newState->highest, array, size, 1 );
+   extremeInit( &newState->lowest, array + 2*size, size, 0 );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MIDPOINT_StateUpdate( TA_MIDPOINT_State *state,
+                                    double        inReal,
+                                    int          *outNBElement,
+                                    double       *outReal )
+{
+   double highest, lowest;
+   int today;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   today   = state->nbBar++;
+   highest = extremePush( &state->highest, inReal, today );
+   lowest  = extremePush( &state->lowest, inReal, today );
+
+   *outNBElement = today >= state->highest.size-1;
+   if( *outNBElement )
+      *outReal = (highest+lowest)/2.0;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MIDPOINT_StateFree( TA_MIDPOINT_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MIDPRICE_StateInit( TA_MIDPRICE_State **state,
+                                  int           optInTimePeriod )
+{
+   TA_MIDPRICE_State *newState;
+   double *array;
+   int size;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   size = optInTimePeriod;
+   newState = (TA_MIDPRICE_State *)stateAlloc( sizeof(TA_MIDPRICE_State), 4*size, &array );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   extremeInit( &newState->highest, array, size, 1 );
+   extremeInit( &newState->lowest, array + 2*size, size, 0 );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MIDPRICE_StateUpdate( TA_MIDPRICE_State *state,
+                                    double        inHigh,
+                                    double        inLow,
+                                    int          *outNBElement,
+                                    double       *outReal )
+{
+   double highest, lowest;
+   int today;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   today   = state->nbBar++;
+   highest = extremePush( &state->highest, inHigh, today );
+   lowest  = extremePush( &state->lowest, inLow, today );
+
+   *outNBElement = today >= state->highest.size-1;
+   if( *outNBElement )
+      *outReal = (highest+lowest)/2.0;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MIDPRICE_StateFree( TA_MIDPRICE_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** AROON and AROONOSC ****/
+/* The window is the last 'period+1' bars, like in TA_AROON. */
+TA_RetCode TA_AROON_StateInit( TA_AROON_State **state,
+                               int           optInTimePeriod )
+{
+   TA_AROON_State *newState;
+   double *array;
+   int size;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   size = optInTimePeriod+1;
+   newState = (TA_AROON_State *)stateAlloc( sizeof(TA_AROON_State), 4*size, &array );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   extremeInit( &newState->highest, array, size, 1 );
+   extremeInit( &newState->lowest, array + 2*size, size, 0 );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_AROON_StateUpdate( TA_AROON_State *state,
+                                 double        inHigh,
+                                 double        inLow,
+                                 int          *outNBElement,
+                                 double       *outAroonDown,
+                                 double       *outAroonUp )
+{
+   double factor;
+   int today, period;
+
+   if( !state || !outNBElement || !outAroonDown || !outAroonUp )
+      return TA_BAD_PARAM;
+
+   today = state->nbBar++;
+   extremePush( &state->highest, inHigh, today );
+   extremePush( &state->lowest, inLow, today );
+
+   period = state->highest.size-1;
+   *outNBElement = today >= period;
+   if( *outNBElement )
+   {
+      factor = (double)100.0/(double)period;
+      *outAroonUp   = factor*(period-(today-state->highest.idx[state->highest.first]));
+      *outAroonDown = factor*(period-(today-state->lowest.idx[state->lowest.first]));
+   }
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_AROON_StateFree( TA_AROON_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_AROONOSC_StateInit( TA_AROONOSC_State **state,
+                                  int           optInTimePeriod )
+{
+   TA_AROONOSC_State *newState;
+   double *array;
+   int size;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   size = optInTimePeriod+1;
+   newState = (TA_AROONOSC_State *)stateAlloc( sizeof(TA_AROONOSC_State), 4*size, &array );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   extremeInit( &newState->highest, array, size, 1 );
+   extremeInit( &newState->lowest, array + 2*size, size, 0 );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_AROONOSC_StateUpdate( TA_AROONOSC_State *state,
+                                    double        inHigh,
+                                    double        inLow,
+                                    int          *outNBElement,
+                                    double       *outReal )
+{
+   double factor;
+   int today, period;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   today = state->nbBar++;
+   extremePush( &state->highest, inHigh, today );
+   extremePush( &state->lowest, inLow, today );
+
+   period = state->highest.size-1;
+   *outNBElement = today >= period;
+   if( *outNBElement )
+   {
+      factor = (double)100.0/(double)period;
+      *outReal = factor*(state->highest.idx[state->highest.first]-state->lowest.idx[state->lowest.first]);
+   }
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_AROONOSC_StateFree( TA_AROONOSC_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** TRANGE, ATR and NATR ****/
+TA_RetCode TA_TRANGE_StateInit( TA_TRANGE_State **state )
+{
+   if( !state )
+      return TA_BAD_PARAM;
+
+   *state = (TA_TRANGE_State *)stateAlloc( sizeof(TA_TRANGE_State), 0, NULL );
+   if( !*state )
+      return TA_ALLOC_ERR;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_TRANGE_StateUpdate( TA_TRANGE_State *state,
+                                  double        inHigh,
+                                  double        inLow,
+                                  double        inClose,
+                                  int          *outNBElement,
+                                  double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = state->nbBar++ >= 1;
+   if( *outNBElement )
+      *outReal = trueRange( inHigh, inLow, state->prevClose );
+   state->prevClose = inClose;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_TRANGE_StateFree( TA_TRANGE_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ATR_StateInit( TA_ATR_State **state,
+                             int           optInTimePeriod )
+{
+   TA_ATR_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_ATR_State *)stateAlloc( sizeof(TA_ATR_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   atrInit( &newState->atr, optInTimePeriod, TA_ATR_Lookback( optInTimePeriod ) );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ATR_StateUpdate( TA_ATR_State *state,
+                               double        inHigh,
+                               double        inLow,
+                               double        inClose,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = atrUpdate( &state->atr, inHigh, inLow, inClose );
+   if( *outNBElement )
+      *outReal = state->atr.prevATR;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ATR_StateFree( TA_ATR_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_NATR_StateInit( TA_NATR_State **state,
+                              int           optInTimePeriod )
+{
+   TA_NATR_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_NATR_State *)stateAlloc( sizeof(TA_NATR_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   atrInit( &newState->atr, optInTimePeriod, TA_NATR_Lookback( optInTimePeriod ) );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_NATR_StateUpdate( TA_NATR_State *state,
+                                double        inHigh,
+                                double        inLow,
+                                double        inClose,
+                                int          *outNBElement,
+                                double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = atrUpdate( &state->atr, inHigh, inLow, inClose );
+   if( !*outNBElement )
+      return TA_SUCCESS;
+
+   /* Like TA_NATR, a period of 1 is the true range, not normalized. */
+   if( state->atr.period <= 1 )
+      *outReal = state->atr.prevATR;
+   else if( !TA_IS_ZERO(inClose) )
+      *outReal = (state->atr.prevATR/inClose)*100.0;
+   else
+      *outReal = 0.0;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_NATR_StateFree( TA_NATR_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** CCI ****/
+TA_RetCode TA_CCI_StateInit( TA_CCI_State **state,
+                             int           optInTimePeriod )
+{
+   TA_CCI_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_CCI_State *)stateAlloc( sizeof(TA_CCI_State), optInTimePeriod, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   newState->window.value = window;
+   newState->window.size  = optInTimePeriod;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_CCI_StateUpdate( TA_CCI_State *state,
+                               double        inHigh,
+                               double        inLow,
+                               double        inClose,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   double lastValue, theAverage, tempReal, tempReal2;
+   int j, period;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   period = state->window.size;
+   lastValue = (inHigh+inLow+inClose)/3;
+   windowPush( &state->window, lastValue );
+
+   *outNBElement = state->nbBar++ >= period-1;
+   if( !*outNBElement )
+      return TA_SUCCESS;
+
+   /* The mean deviation needs the whole window, so each bar costs
+    * O(period) like in TA_CCI.
+    */
+   theAverage = 0;
+   for( j=0; j < period; j++ )
+      theAverage += state->window.value[j];
+   theAverage /= period;
+
+   tempReal2 = 0;
+   for( j=0; j < period; j++ )
+      tempReal2 += std_fabs(state->window.value[j]-theAverage);
+
+   tempReal = lastValue-theAverage;
+   if( (tempReal != 0.0) && (tempReal2 != 0.0) )
+      *outReal = tempReal/(0.015*(tempReal2/period));
+   else
+      *outReal = 0.0;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_CCI_StateFree( TA_CCI_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** ULTOSC ****/
+TA_RetCode TA_ULTOSC_StateInit( TA_ULTOSC_State **state,
+                                int           optInTimePeriod1,
+                                int           optInTimePeriod2,
+                                int           optInTimePeriod3 )
+{
+   TA_ULTOSC_State *newState;
+   double *window;
+   int i, j, tempInteger, longest;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod1 == TA_INTEGER_DEFAULT )
+      optInTimePeriod1 = 7;
+   else if( ((int)optInTimePeriod1 < 1) || ((int)optInTimePeriod1 > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod2 == TA_INTEGER_DEFAULT )
+      optInTimePeriod2 = 14;
+   else if( ((int)optInTimePeriod2 < 1) || ((int)optInTimePeriod2 > 100000) )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod3 == TA_INTEGER_DEFAULT )
+      optInTimePeriod3 = 28;
+   else if( ((int)optInTimePeriod3 < 1) || ((int)optInTimePeriod3 > 100000) )
+      return TA_BAD_PARAM;
+
+   longest = max( max(optInTimePeriod1, optInTimePeriod2), optInTimePeriod3 );
+   newState = (TA_ULTOSC_State *)stateAlloc( sizeof(TA_ULTOSC_State), 2*longest, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   /* The shortest period gets the largest weight, like in TA_ULTOSC. */
+   newState->period[0] = optInTimePeriod1;
+   newState->period[1] = optInTimePeriod2;
+   newState->period[2] = optInTimePeriod3;
+   for( i=0; i < 2; i++ )
+   {
+      for( j=i+1; j < 3; j++ )
+      {
+         if( newState->period[j] < newState->period[i] )
+         {
+            tempInteger = newState->period[i];
+            newState->period[i] = newState->period[j];
+            newState->period[j] = tempInteger;
+         }
+      }
+   }
+
+   newState->lookback = TA_ULTOSC_Lookback( optInTimePeriod1, optInTimePeriod2, optInTimePeriod3 );
+   newState->closeMinusTrueLow.value = window;
+   newState->closeMinusTrueLow.size  = longest;
+   newState->trueRange.value = window + longest;
+   newState->trueRange.size  = longest;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ULTOSC_StateUpdate( TA_ULTOSC_State *state,
+                                  double        inHigh,
+                                  double        inLow,
+                                  double        inClose,
+                                  int          *outNBElement,
+                                  double       *outReal )
+{
+   double trueLow, closeMinusTrueLow, tempRange, output;
+   int i, today, idx, size;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = 0;
+
+   today = state->nbBar++;
+   if( today == 0 )
+   {
+      state->prevClose = inClose;
+      return TA_SUCCESS;
+   }
+
+   trueLow = min( inLow, state->prevClose );
+   closeMinusTrueLow = inClose - trueLow;
+   tempRange = trueRange( inHigh, inLow, state->prevClose );
+   state->prevClose = inClose;
+   windowPush( &state->closeMinusTrueLow, closeMinusTrueLow );
+   windowPush( &state->trueRange, tempRange );
+
+   /* Each sum starts with the bars of its period before the first output. */
+   for( i=0; i < 3; i++ )
+   {
+      if( today > state->lookback-state->period[i] )
+      {
+         state->aTotal[i] += closeMinusTrueLow;
+         state->bTotal[i] += tempRange;
+      }
+   }
+
+   if( today < state->lookback )
+      return TA_SUCCESS;
+
+   output = 0.0;
+   if( !TA_IS_ZERO(state->bTotal[0]) ) output += 4.0*(state->aTotal[0]/state->bTotal[0]);
+   if( !TA_IS_ZERO(state->bTotal[1]) ) output += 2.0*(state->aTotal[1]/state->bTotal[1]);
+   if( !TA_IS_ZERO(state->bTotal[2]) ) output += state->aTotal[2]/state->bTotal[2];
+
+   /* Remove the oldest bar of each period for the next output. */
+   size = state->trueRange.size;
+   for( i=0; i < 3; i++ )
+   {
+      idx = (state->trueRange.next + size - state->period[i]) % size;
+      state->aTotal[i] -= state->closeMinusTrueLow.value[idx];
+      state->bTotal[i] -= state->trueRange.value[idx];
+   }
+
+   *outReal = 100.0 * (output / 7.0);
+   *outNBElement = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ULTOSC_StateFree( TA_ULTOSC_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** ADX, ADXR, DX and the DI and DM ****/
+TA_RetCode TA_ADX_StateInit( TA_ADX_State **state,
+                             int           optInTimePeriod )
+{
+   TA_ADX_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_ADX_State *)stateAlloc( sizeof(TA_ADX_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   dmInit( &newState->adx.dm, optInTimePeriod );
+   newState->adx.lookback = TA_ADX_Lookback( optInTimePeriod );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ADX_StateUpdate( TA_ADX_State *state,
+                               double        inHigh,
+                               double        inLow,
+                               double        inClose,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = adxUpdate( &state->adx, inHigh, inLow, inClose );
+   if( *outNBElement )
+      *outReal = state->adx.prevADX;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ADX_StateFree( TA_ADX_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/* The ADX of 'period-1' bars ago is kept in a window. */
+TA_RetCode TA_ADXR_StateInit( TA_ADXR_State **state,
+                              int           optInTimePeriod )
+{
+   TA_ADXR_State *newState;
+   double *window;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_ADXR_State *)stateAlloc( sizeof(TA_ADXR_State), optInTimePeriod-1, &window );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   dmInit( &newState->adx.dm, optInTimePeriod );
+   newState->adx.lookback = TA_ADX_Lookback( optInTimePeriod );
+   newState->window.value = window;
+   newState->window.size  = optInTimePeriod-1;
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ADXR_StateUpdate( TA_ADXR_State *state,
+                                double        inHigh,
+                                double        inLow,
+                                double        inClose,
+                                int          *outNBElement,
+                                double       *outReal )
+{
+   double tempReal;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = 0;
+
+   if( !adxUpdate( &state->adx, inHigh, inLow, inClose ) )
+      return TA_SUCCESS;
+
+   tempReal = windowPush( &state->window, state->adx.prevADX );
+   if( ++state->nbADX < state->adx.dm.period )
+      return TA_SUCCESS;
+
+   *outReal = (state->adx.prevADX+tempReal)/2.0;
+   *outNBElement = 1;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_ADXR_StateFree( TA_ADXR_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_DX_StateInit( TA_DX_State **state,
+                            int           optInTimePeriod )
+{
+   TA_DX_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 2) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_DX_State *)stateAlloc( sizeof(TA_DX_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   dmInit( &newState->dm, optInTimePeriod );
+   newState->lookback = TA_DX_Lookback( optInTimePeriod );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_DX_StateUpdate( TA_DX_State *state,
+                              double        inHigh,
+                              double        inLow,
+                              double        inClose,
+                              int          *outNBElement,
+                              double       *outReal )
+{
+   TA_StreamDM *dm;
+   double minusDI, plusDI, tempReal;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   dm = &state->dm;
+   *outNBElement = dmUpdate( dm, inHigh, inLow, inClose ) >= state->lookback;
+   if( !*outNBElement )
+      return TA_SUCCESS;
+
+   /* When the DI are undefined or zero, the DX of the bar before is kept. */
+   if( !TA_IS_ZERO(dm->prevTR) )
+   {
+      minusDI  = 100.0*(dm->prevMinusDM/dm->prevTR);
+      plusDI   = 100.0*(dm->prevPlusDM/dm->prevTR);
+      tempReal = minusDI+plusDI;
+      if( !TA_IS_ZERO(tempReal) )
+         state->prevDX = 100.0*(std_fabs(minusDI-plusDI)/tempReal);
+   }
+   *outReal = state->prevDX;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_DX_StateFree( TA_DX_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_PLUS_DI_StateInit( TA_PLUS_DI_State **state,
+                                 int           optInTimePeriod )
+{
+   TA_PLUS_DI_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_PLUS_DI_State *)stateAlloc( sizeof(TA_PLUS_DI_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   dmInit( &newState->dm, optInTimePeriod );
+   newState->lookback = TA_PLUS_DI_Lookback( optInTimePeriod );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_PLUS_DI_StateUpdate( TA_PLUS_DI_State *state,
+                                   double        inHigh,
+                                   double        inLow,
+                                   double        inClose,
+                                   int          *outNBElement,
+                                   double       *outReal )
+{
+   TA_StreamDM *dm;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   dm = &state->dm;
+   *outNBElement = dmUpdate( dm, inHigh, inLow, inClose ) >= state->lookback;
+   if( !*outNBElement )
+      return TA_SUCCESS;
+
+   if( dm->period <= 1 )
+   {
+      /* The movement of the bar over its true range, not in percent. */
+      if( ((dm->diffP > 0) && (dm->diffP > dm->diffM)) && !TA_IS_ZERO(dm->tr) )
+         *outReal = dm->diffP/dm->tr;
+      else
+         *outReal = (double)0.0;
+   }
+   else if( !TA_IS_ZERO(dm->prevTR) )
+      *outReal = 100.0*(dm->prevPlusDM/dm->prevTR);
+   else
+      *outReal = 0.0;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_PLUS_DI_StateFree( TA_PLUS_DI_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MINUS_DI_StateInit( TA_MINUS_DI_State **state,
+                                  int           optInTimePeriod )
+{
+   TA_MINUS_DI_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_MINUS_DI_State *)stateAlloc( sizeof(TA_MINUS_DI_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   dmInit( &newState->dm, optInTimePeriod );
+   newState->lookback = TA_MINUS_DI_Lookback( optInTimePeriod );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MINUS_DI_StateUpdate( TA_MINUS_DI_State *state,
+                                    double        inHigh,
+                                    double        inLow,
+                                    double        inClose,
+                                    int          *outNBElement,
+                                    double       *outReal )
+{
+   TA_StreamDM *dm;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   dm = &state->dm;
+   *outNBElement = dmUpdate( dm, inHigh, inLow, inClose ) >= state->lookback;
+   if( !*outNBElement )
+      return TA_SUCCESS;
+
+   if( dm->period <= 1 )
+   {
+      /* The movement of the bar over its true range, not in percent. */
+      if( ((dm->diffM > 0) && (dm->diffP < dm->diffM)) && !TA_IS_ZERO(dm->tr) )
+         *outReal = dm->diffM/dm->tr;
+      else
+         *outReal = (double)0.0;
+   }
+   else if( !TA_IS_ZERO(dm->prevTR) )
+      *outReal = 100.0*(dm->prevMinusDM/dm->prevTR);
+   else
+      *outReal = 0.0;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MINUS_DI_StateFree( TA_MINUS_DI_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_PLUS_DM_StateInit( TA_PLUS_DM_State **state,
+                                 int           optInTimePeriod )
+{
+   TA_PLUS_DM_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_PLUS_DM_State *)stateAlloc( sizeof(TA_PLUS_DM_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   dmInit( &newState->dm, optInTimePeriod );
+   newState->lookback = TA_PLUS_DM_Lookback( optInTimePeriod );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_PLUS_DM_StateUpdate( TA_PLUS_DM_State *state,
+                                   double        inHigh,
+                                   double        inLow,
+                                   int          *outNBElement,
+                                   double       *outReal )
+{
+   TA_StreamDM *dm;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   /* No close, the true range is not used. */
+   dm = &state->dm;
+   *outNBElement = dmUpdate( dm, inHigh, inLow, inLow ) >= state->lookback;
+   if( !*outNBElement )
+      return TA_SUCCESS;
+
+   if( dm->period <= 1 )
+      *outReal = ((dm->diffP > 0) && (dm->diffP > dm->diffM)) ? dm->diffP : (double)0.0;
+   else
+      *outReal = dm->prevPlusDM;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_PLUS_DM_StateFree( TA_PLUS_DM_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MINUS_DM_StateInit( TA_MINUS_DM_State **state,
+                                  int           optInTimePeriod )
+{
+   TA_MINUS_DM_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( (int)optInTimePeriod == TA_INTEGER_DEFAULT )
+      optInTimePeriod = 14;
+   else if( ((int)optInTimePeriod < 1) || ((int)optInTimePeriod > 100000) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_MINUS_DM_State *)stateAlloc( sizeof(TA_MINUS_DM_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   dmInit( &newState->dm, optInTimePeriod );
+   newState->lookback = TA_MINUS_DM_Lookback( optInTimePeriod );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MINUS_DM_StateUpdate( TA_MINUS_DM_State *state,
+                                    double        inHigh,
+                                    double        inLow,
+                                    int          *outNBElement,
+                                    double       *outReal )
+{
+   TA_StreamDM *dm;
+
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   /* No close, the true range is not used. */
+   dm = &state->dm;
+   *outNBElement = dmUpdate( dm, inHigh, inLow, inLow ) >= state->lookback;
+   if( !*outNBElement )
+      return TA_SUCCESS;
+
+   if( dm->period <= 1 )
+      *outReal = ((dm->diffM > 0) && (dm->diffP < dm->diffM)) ? dm->diffM : (double)0.0;
+   else
+      *outReal = dm->prevMinusDM;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_MINUS_DM_StateFree( TA_MINUS_DM_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** SAR and SAREXT ****/
+TA_RetCode TA_SAR_StateInit( TA_SAR_State **state,
+                             double        optInAcceleration,
+                             double        optInMaximum )
+{
+   TA_SAR_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( optInAcceleration == TA_REAL_DEFAULT )
+      optInAcceleration = 2.000000e-2;
+   else if( (optInAcceleration < 0.000000e+0) || (optInAcceleration > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   if( optInMaximum == TA_REAL_DEFAULT )
+      optInMaximum = 2.000000e-1;
+   else if( (optInMaximum < 0.000000e+0) || (optInMaximum > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_SAR_State *)stateAlloc( sizeof(TA_SAR_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   sarInit( &newState->sar, 0, 0.0, 0.0,
+            optInAcceleration, optInAcceleration, optInMaximum,
+            optInAcceleration, optInAcceleration, optInMaximum );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_SAR_StateUpdate( TA_SAR_State *state,
+                               double        inHigh,
+                               double        inLow,
+                               int          *outNBElement,
+                               double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = sarUpdate( &state->sar, inHigh, inLow, outReal );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_SAR_StateFree( TA_SAR_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_SAREXT_StateInit( TA_SAREXT_State **state,
+                                double        optInStartValue,
+                                double        optInOffsetOnReverse,
+                                double        optInAccelerationInitLong,
+                                double        optInAccelerationLong,
+                                double        optInAccelerationMaxLong,
+                                double        optInAccelerationInitShort,
+                                double        optInAccelerationShort,
+                                double        optInAccelerationMaxShort )
+{
+   TA_SAREXT_State *newState;
+
+   if( !state )
+      return TA_BAD_PARAM;
+
+   if( optInStartValue == TA_REAL_DEFAULT )
+      optInStartValue = 0.000000e+0;
+   else if( (optInStartValue < -3.000000e+37) || (optInStartValue > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   if( optInOffsetOnReverse == TA_REAL_DEFAULT )
+      optInOffsetOnReverse = 0.000000e+0;
+   else if( (optInOffsetOnReverse < 0.000000e+0) || (optInOffsetOnReverse > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   if( optInAccelerationInitLong == TA_REAL_DEFAULT )
+      optInAccelerationInitLong = 2.000000e-2;
+   else if( (optInAccelerationInitLong < 0.000000e+0) || (optInAccelerationInitLong > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   if( optInAccelerationLong == TA_REAL_DEFAULT )
+      optInAccelerationLong = 2.000000e-2;
+   else if( (optInAccelerationLong < 0.000000e+0) || (optInAccelerationLong > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   if( optInAccelerationMaxLong == TA_REAL_DEFAULT )
+      optInAccelerationMaxLong = 2.000000e-1;
+   else if( (optInAccelerationMaxLong < 0.000000e+0) || (optInAccelerationMaxLong > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   if( optInAccelerationInitShort == TA_REAL_DEFAULT )
+      optInAccelerationInitShort = 2.000000e-2;
+   else if( (optInAccelerationInitShort < 0.000000e+0) || (optInAccelerationInitShort > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   if( optInAccelerationShort == TA_REAL_DEFAULT )
+      optInAccelerationShort = 2.000000e-2;
+   else if( (optInAccelerationShort < 0.000000e+0) || (optInAccelerationShort > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   if( optInAccelerationMaxShort == TA_REAL_DEFAULT )
+      optInAccelerationMaxShort = 2.000000e-1;
+   else if( (optInAccelerationMaxShort < 0.000000e+0) || (optInAccelerationMaxShort > 3.000000e+37) )
+      return TA_BAD_PARAM;
+
+   newState = (TA_SAREXT_State *)stateAlloc( sizeof(TA_SAREXT_State), 0, NULL );
+   if( !newState )
+      return TA_ALLOC_ERR;
+
+   /* The short positions are output as negative values. */
+   sarInit( &newState->sar, 1, optInStartValue, optInOffsetOnReverse,
+            optInAccelerationInitLong, optInAccelerationLong, optInAccelerationMaxLong,
+            optInAccelerationInitShort, optInAccelerationShort, optInAccelerationMaxShort );
+
+   *state = newState;
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_SAREXT_StateUpdate( TA_SAREXT_State *state,
+                                  double        inHigh,
+                                  double        inLow,
+                                  int          *outNBElement,
+                                  double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = sarUpdate( &state->sar, inHigh, inLow, outReal );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_SAREXT_StateFree( TA_SAREXT_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** HT_DCPERIOD, HT_DCPHASE, HT_PHASOR, HT_SINE, HT_TRENDLINE and HT_TRENDMODE ****/
+TA_RetCode TA_HT_DCPERIOD_StateInit( TA_HT_DCPERIOD_State **state )
+{
+   return htAlloc( (TA_StreamHT **)state, sizeof(TA_HT_DCPERIOD_State),
+                   0, TA_HT_DCPERIOD_Lookback() );
+}
+
+TA_RetCode TA_HT_DCPERIOD_StateUpdate( TA_HT_DCPERIOD_State *state,
+                                       double        inReal,
+                                       int          *outNBElement,
+                                       double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = htUpdate( &state->ht, inReal );
+   if( *outNBElement )
+      *outReal = state->ht.smoothPeriod;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_HT_DCPERIOD_StateFree( TA_HT_DCPERIOD_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_HT_DCPHASE_StateInit( TA_HT_DCPHASE_State **state )
+{
+   return htAlloc( (TA_StreamHT **)state, sizeof(TA_HT_DCPHASE_State),
+                   HT_PHASE, TA_HT_DCPHASE_Lookback() );
+}
+
+TA_RetCode TA_HT_DCPHASE_StateUpdate( TA_HT_DCPHASE_State *state,
+                                      double        inReal,
+                                      int          *outNBElement,
+                                      double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = htUpdate( &state->ht, inReal );
+   if( *outNBElement )
+      *outReal = state->ht.DCPhase;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_HT_DCPHASE_StateFree( TA_HT_DCPHASE_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_HT_PHASOR_StateInit( TA_HT_PHASOR_State **state )
+{
+   return htAlloc( (TA_StreamHT **)state, sizeof(TA_HT_PHASOR_State),
+                   0, TA_HT_PHASOR_Lookback() );
+}
+
+TA_RetCode TA_HT_PHASOR_StateUpdate( TA_HT_PHASOR_State *state,
+                                     double        inReal,
+                                     int          *outNBElement,
+                                     double       *outInPhase,
+                                     double       *outQuadrature )
+{
+   if( !state || !outNBElement || !outInPhase || !outQuadrature )
+      return TA_BAD_PARAM;
+
+   *outNBElement = htUpdate( &state->ht, inReal );
+   if( *outNBElement )
+   {
+      *outInPhase    = state->ht.inPhase;
+      *outQuadrature = state->ht.quadrature;
+   }
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_HT_PHASOR_StateFree( TA_HT_PHASOR_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_HT_SINE_StateInit( TA_HT_SINE_State **state )
+{
+   return htAlloc( (TA_StreamHT **)state, sizeof(TA_HT_SINE_State),
+                   HT_PHASE, TA_HT_SINE_Lookback() );
+}
+
+TA_RetCode TA_HT_SINE_StateUpdate( TA_HT_SINE_State *state,
+                                   double        inReal,
+                                   int          *outNBElement,
+                                   double       *outSine,
+                                   double       *outLeadSine )
+{
+   if( !state || !outNBElement || !outSine || !outLeadSine )
+      return TA_BAD_PARAM;
+
+   *outNBElement = htUpdate( &state->ht, inReal );
+   if( *outNBElement )
+   {
+      *outSine     = state->ht.sine;
+      *outLeadSine = state->ht.leadSine;
+   }
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_HT_SINE_StateFree( TA_HT_SINE_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_HT_TRENDLINE_StateInit( TA_HT_TRENDLINE_State **state )
+{
+   return htAlloc( (TA_StreamHT **)state, sizeof(TA_HT_TRENDLINE_State),
+                   HT_TRENDLINE, TA_HT_TRENDLINE_Lookback() );
+}
+
+TA_RetCode TA_HT_TRENDLINE_StateUpdate( TA_HT_TRENDLINE_State *state,
+                                        double        inReal,
+                                        int          *outNBElement,
+                                        double       *outReal )
+{
+   if( !state || !outNBElement || !outReal )
+      return TA_BAD_PARAM;
+
+   *outNBElement = htUpdate( &state->ht, inReal );
+   if( *outNBElement )
+      *outReal = state->ht.trendline;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_HT_TRENDLINE_StateFree( TA_HT_TRENDLINE_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_HT_TRENDMODE_StateInit( TA_HT_TRENDMODE_State **state )
+{
+   return htAlloc( (TA_StreamHT **)state, sizeof(TA_HT_TRENDMODE_State),
+                   HT_PHASE|HT_TRENDLINE|HT_TRENDMODE, TA_HT_TRENDMODE_Lookback() );
+}
+
+TA_RetCode TA_HT_TRENDMODE_StateUpdate( TA_HT_TRENDMODE_State *state,
+                                        double        inReal,
+                                        int          *outNBElement,
+                                        int          *outInteger )
+{
+   if( !state || !outNBElement || !outInteger )
+      return TA_BAD_PARAM;
+
+   *outNBElement = htUpdate( &state->ht, inReal );
+   if( *outNBElement )
+      *outInteger = state->ht.trend;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_HT_TRENDMODE_StateFree( TA_HT_TRENDMODE_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
+
+/**** All the HT outputs from one transform ****/
+TA_RetCode TA_HT_StateInit( TA_HT_State **state )
+{
+   int lookback;
+
+   lookback = TA_HT_DCPERIOD_Lookback();
+   lookback = max( lookback, TA_HT_DCPHASE_Lookback() );
+   lookback = max( lookback, TA_HT_PHASOR_Lookback() );
+   lookback = max( lookback, TA_HT_SINE_Lookback() );
+   lookback = max( lookback, TA_HT_TRENDLINE_Lookback() );
+   lookback = max( lookback, TA_HT_TRENDMODE_Lookback() );
+
+   return htAlloc( (TA_StreamHT **)state, sizeof(TA_HT_State),
+                   HT_PHASE|HT_TRENDLINE|HT_TRENDMODE, lookback );
+}
+
+TA_RetCode TA_HT_StateUpdate( TA_HT_State *state,
+                              double       inReal,
+                              int         *outNBElement,
+                              double      *outDCPeriod,
+                              double      *outDCPhase,
+                              double      *outInPhase,
+                              double      *outQuadrature,
+                              double      *outSine,
+                              double      *outLeadSine,
+                              double      *outTrendline,
+                              int         *outTrendMode )
+{
+   if( !state || !outNBElement )
+      return TA_BAD_PARAM;
+
+   *outNBElement = htUpdate( &state->ht, inReal );
+   if( !*outNBElement )
+      return TA_SUCCESS;
+
+   /* Outputs not wanted can be NULL. */
+   if( outDCPeriod )   *outDCPeriod   = state->ht.smoothPeriod;
+   if( outDCPhase )    *outDCPhase    = state->ht.DCPhase;
+   if( outInPhase )    *outInPhase    = state->ht.inPhase;
+   if( outQuadrature ) *outQuadrature = state->ht.quadrature;
+   if( outSine )       *outSine       = state->ht.sine;
+   if( outLeadSine )   *outLeadSine   = state->ht.leadSine;
+   if( outTrendline )  *outTrendline  = state->ht.trendline;
+   if( outTrendMode )  *outTrendMode  = state->ht.trend;
+
+   return TA_SUCCESS;
+}
+
+TA_RetCode TA_HT_StateFree( TA_HT_State *state )
+{
+   TA_Free( state );
+   return TA_SUCCESS;
+}
@@ -107,6 +107,7 @@
 #include "../../ta_common/ta_memory.h"
 
 extern int mcpp_main(int argc, char **argv);
+extern unsigned int TA_FuncNameHash(const char *name, unsigned int seed);
 
 #define BUFFER_SIZE 16000
 
@@ -136,6 +137,7 @@ typedef struct
 } FileHandle;
 
 FileHandle *gOutFunc_H;       /* For "ta_func.h"  */
+FileHandle *gOutStream_H;     /* For "ta_stream.h" */
 FileHandle *gOutFrame_H;      /* For "ta_frame.h" */
 FileHandle *gOutFrame_C;      /* For "ta_frame.c" */
 FileHandle *gOutGroupIdx_C;   /* For "ta_group_idx.c" */
@@ -224,6 +226,9 @@ static void printFunc(FILE *out,
 );
 
 static void printCallFrame(FILE *out, const TA_FuncInfo *funcInfo);
+static int isStreamFunc(const TA_FuncInfo *funcInfo);
+static void printStreamRange(FILE *out, const TA_OptInputParameterInfo *optInputParamInfo);
+static void printStreamFunc(FILE *out, const TA_FuncInfo *funcInfo);
 static void printFrameHeader(FILE *out, const TA_FuncInfo *funcInfo, unsigned int lookbackSignature);
 
 static void printExternReferenceForEachFunction(const TA_FuncInfo *info,
@@ -250,6 +255,11 @@ static void printGroupSizeAddition(const char *groupName,
                                    unsigned int isFirst,
                                    unsigned int isLast);
 
+static void addFuncHashName(const TA_FuncInfo *info,
+                            void *opaqueData);
+
+static int printFuncHash(FILE *out);
+
 static int addUnstablePeriodEnum(FILE *out);
 
 static int createTemplate(FileHandle *in, FileHandle *out);
@@ -394,6 +404,7 @@ int main(int argc, char *argv[])
       printf("    14) ta-lib/java/src/com/tictactec/ta/lib/CoreAnnotated.java (Win32 only)\n");
       printf("    15) ta-lib/ta_func_api.xml\n");
       printf("    16) ta-lib/c/src/ta_abstract/ta_func_api.c\n");
+      printf("    17) ta-lib/c/include/ta_stream.h\n");
       printf("\n");
       printf("  The function header, parameters and validation code of all TA\n");
       printf("  function in c/src/ta_func are also updated.\n");
@@ -816,6 +827,17 @@ static int genCode(int argc, char *argv[])
       return -1;
    }
 
+   /* Create "ta_stream.h" */
+   gOutStream_H = fileOpen("..\\include\\ta_stream.h",
+                           "..\\src\\ta_abstract\\templates\\ta_stream.h.template",
+                           FILE_WRITE | WRITE_ON_CHANGE_ONLY);
+
+   if (gOutStream_H == NULL)
+   {
+      printf("\nCannot access [%s]\n", gToOpen);
+      return -1;
+   }
+
    gOutFunc_XML = fileOpen("..\\..\\ta_func_api.xml", NULL, FILE_WRITE | WRITE_ON_CHANGE_ONLY);
    if (gOutFunc_XML == NULL)
    {
@@ -976,6 +998,7 @@ static int genCode(int argc, char *argv[])
    /* Close all files who were updated with the list of TA functions. */
    fileClose(gOutFuncList_TXT);
    fileClose(gOutFunc_H);
+   fileClose(gOutStream_H);
    fileClose(gOutFunc_SWG);
    fileClose(gOutFrame_H);
    fileClose(gOutFrame_C);
@@ -1032,6 +1055,15 @@ static int genCode(int argc, char *argv[])
    print(gOutGroupIdx_C->file, "const unsigned int TA_TotalNbFunction =\n");
    forEachGroup(printGroupSizeAddition, NULL);
 
+   /* Perfect hash used by TA_GetFuncHandle. */
+   TA_ForEachFunc(addFuncHashName, NULL);
+   if (!printFuncHash(gOutGroupIdx_C->file))
+   {
+      printf("\nFailed to build the function name hash\n");
+      fileClose(gOutGroupIdx_C);
+      return -1;
+   }
+
    fileClose(gOutGroupIdx_C);
    genPrefix = 0;
 
@@ -1569,6 +1601,10 @@ static void doForEachFunctionPhase2(const TA_FuncInfo *funcInfo,
    printFunc(gOutFunc_H->file, NULL, funcInfo, 1, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0);
    printFunc(gOutFunc_SWG->file, NULL, funcInfo, 1, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0);
 
+   /* Generate the streaming prototypes (ta_stream.h) */
+   if (isStreamFunc(funcInfo))
+      printStreamFunc(gOutStream_H->file, funcInfo);
+
    /* Create the frame definition (ta_frame.c) and declaration (ta_frame.h) */
    genPrefix = 1;
    printFrameHeader(gOutFrame_H->file, funcInfo, 0);
@@ -2612,6 +2648,192 @@ static void printFunc(FILE *out,
    }
 }
 
+/* Functions having a streaming implementation in ta_func/ta_stream.c.
+ *
+ * Only their prototypes in "ta_stream.h" are generated. Add a
+ * function here once its TA_<FUNC>_StateInit/StateUpdate/StateFree
+ * are implemented.
+ */
+static const char *gStreamFuncList[] =
+{
+   "AD", "ADOSC", "ADX", "ADXR", "APO", "AROON", "AROONOSC", "ATR", "BBANDS",
+   "BETA", "CCI", "CMO", "CORREL", "DEMA", "DX", "EMA", "HT_DCPERIOD",
+   "HT_DCPHASE", "HT_PHASOR", "HT_SINE", "HT_TRENDLINE", "HT_TRENDMODE",
+   "KAMA", "MA", "MACD", "MACDEXT", "MACDFIX", "MAMA", "MAX", "MFI",
+   "MIDPOINT", "MIDPRICE", "MIN", "MINUS_DI", "MINUS_DM", "MOM", "NATR", "OBV",
+   "PLUS_DI", "PLUS_DM", "PPO", "ROC", "ROCP", "ROCR", "ROCR100", "RSI", "SAR",
+   "SAREXT", "SMA", "STDDEV", "STOCH", "STOCHF", "STOCHRSI", "SUM", "T3",
+   "TEMA", "TRANGE", "TRIMA", "TRIX", "ULTOSC", "VAR", "WILLR", "WMA",
+   NULL
+};
+
+static int isStreamFunc(const TA_FuncInfo *funcInfo)
+{
+   unsigned int i;
+
+   for (i = 0; gStreamFuncList[i] != NULL; i++)
+   {
+      if (strcmp(gStreamFuncList[i], funcInfo->name) == 0)
+         return 1;
+   }
+
+   return 0;
+}
+
+static void printStreamRange(FILE *out, const TA_OptInputParameterInfo *optInputParamInfo)
+{
+   const TA_RealRange *realRange;
+   const TA_IntegerRange *integerRange;
+
+   switch (optInputParamInfo->type)
+   {
+   case TA_OptInput_RealRange:
+      realRange = (const TA_RealRange *)optInputParamInfo->dataSet;
+      if (realRange->min == TA_REAL_MIN)
+         fprintf(out, " /* From TA_REAL_MIN");
+      else
+         fprintf(out, " /* From %.*g", realRange->precision, realRange->min);
+
+      if (realRange->max == TA_REAL_MAX)
+         fprintf(out, " to TA_REAL_MAX */");
+      else
+         fprintf(out, " to %.*g%s */", realRange->precision, realRange->max,
+                 optInputParamInfo->flags & TA_OPTIN_IS_PERCENT ? " %" : "");
+      break;
+   case TA_OptInput_IntegerRange:
+      integerRange = (const TA_IntegerRange *)optInputParamInfo->dataSet;
+      if (integerRange->min == TA_INTEGER_MIN)
+         fprintf(out, " /* From TA_INTEGER_MIN");
+      else
+         fprintf(out, " /* From %d", integerRange->min);
+
+      if (integerRange->max == TA_INTEGER_MAX)
+         fprintf(out, " to TA_INTEGER_MAX */");
+      else
+         fprintf(out, " to %d */", integerRange->max);
+      break;
+   default:
+      break;
+   }
+}
+
+static void printStreamFunc(FILE *out, const TA_FuncInfo *funcInfo)
+{
+   static const int priceFlag[] = { TA_IN_PRICE_OPEN, TA_IN_PRICE_HIGH,
+                                    TA_IN_PRICE_LOW, TA_IN_PRICE_CLOSE,
+                                    TA_IN_PRICE_VOLUME, TA_IN_PRICE_OPENINTEREST };
+   static const char *priceName[] = { "inOpen", "inHigh", "inLow", "inClose",
+                                      "inVolume", "inOpenInterest" };
+
+   const TA_InputParameterInfo *inputParamInfo;
+   const TA_OptInputParameterInfo *optInputParamInfo;
+   const TA_OutputParameterInfo *outputParamInfo;
+   const char *name;
+   const char *typeString;
+   unsigned int i, j;
+   int indent;
+
+   name = funcInfo->name;
+
+   fprintf(out, "\n");
+   fprintf(out, "/*\n");
+   fprintf(out, " * TA_%s - %s\n", name, funcInfo->hint);
+   fprintf(out, " */\n");
+   fprintf(out, "typedef struct TA_%s_State TA_%s_State;\n", name, name);
+   fprintf(out, "\n");
+
+   /* Init: the optional inputs of the batch function. */
+   indent = fprintf(out, "TA_RetCode TA_%s_StateInit( ", name);
+   fprintf(out, "TA_%s_State **state%s\n", name,
+           funcInfo->nbOptInput == 0 ? " );" : ",");
+
+   for (i = 0; i < funcInfo->nbOptInput; i++)
+   {
+      if (TA_GetOptInputParameterInfo(funcInfo->handle, i, &optInputParamInfo) != TA_SUCCESS)
+      {
+         printf("[%s] invalid 'optional input' information\n", name);
+         return;
+      }
+
+      switch (optInputParamInfo->type)
+      {
+      case TA_OptInput_RealRange:
+      case TA_OptInput_RealList:
+         typeString = "double";
+         break;
+      case TA_OptInput_IntegerList:
+         if (optInputParamInfo->dataSet == TA_DEF_UI_MA_Method.dataSet)
+            typeString = "TA_MAType";
+         else
+            typeString = "int";
+         break;
+      default:
+         typeString = "int";
+         break;
+      }
+
+      printIndent(out, indent);
+      fprintf(out, "%-13s %s%s", typeString, optInputParamInfo->paramName,
+              i == funcInfo->nbOptInput - 1 ? " );" : ",");
+      printStreamRange(out, optInputParamInfo);
+      fprintf(out, "\n");
+   }
+   fprintf(out, "\n");
+
+   /* Update: one value per input, one per output. */
+   indent = fprintf(out, "TA_RetCode TA_%s_StateUpdate( ", name);
+   fprintf(out, "TA_%s_State *state,\n", name);
+
+   for (i = 0; i < funcInfo->nbInput; i++)
+   {
+      if (TA_GetInputParameterInfo(funcInfo->handle, i, &inputParamInfo) != TA_SUCCESS)
+      {
+         printf("[%s] invalid 'input' information\n", name);
+         return;
+      }
+
+      if (inputParamInfo->type == TA_Input_Price)
+      {
+         for (j = 0; j < sizeof(priceFlag) / sizeof(int); j++)
+         {
+            if (inputParamInfo->flags & priceFlag[j])
+            {
+               printIndent(out, indent);
+               fprintf(out, "%-13s %s,\n", "double", priceName[j]);
+            }
+         }
+      }
+      else
+      {
+         printIndent(out, indent);
+         fprintf(out, "%-13s %s,\n",
+                 inputParamInfo->type == TA_Input_Integer ? "int" : "double",
+                 inputParamInfo->paramName);
+      }
+   }
+
+   printIndent(out, indent);
+   fprintf(out, "%-12s *outNBElement%s\n", "int", funcInfo->nbOutput == 0 ? " );" : ",");
+
+   for (i = 0; i < funcInfo->nbOutput; i++)
+   {
+      if (TA_GetOutputParameterInfo(funcInfo->handle, i, &outputParamInfo) != TA_SUCCESS)
+      {
+         printf("[%s] invalid 'output' information\n", name);
+         return;
+      }
+
+      printIndent(out, indent);
+      fprintf(out, "%-12s *%s%s\n",
+              outputParamInfo->type == TA_Output_Integer ? "int" : "double",
+              outputParamInfo->paramName,
+              i == funcInfo->nbOutput - 1 ? " );" : ",");
+   }
+   fprintf(out, "\n");
+
+   fprintf(out, "TA_RetCode TA_%s_StateFree( TA_%s_State *state );\n", name, name);
+}
+
 static void printCallFrame(FILE *out, const TA_FuncInfo *funcInfo)
 {
    genPrefix = 1;
@@ -2722,6 +2944,142 @@ static void printGroupSizeAddition(const char *groupName,
            index, isLast ? ";" : "+\n");
 }
 
+/* The function name hash is built in two levels:
+ *   - TA_FuncNameHash(name,0) selects a bucket.
+ *   - Each bucket has a displacement (a seed) chosen so that
+ *     TA_FuncNameHash(name,displacement) gives each of its
+ *     names a slot not used by any other name.
+ * So a lookup costs two hash and a single strcmp.
+ */
+#define MAX_FUNC_HASH_NAME 1024
+#define MAX_FUNC_HASH_DISPLACE 0xFFFF
+
+static const char *gFuncHashName[MAX_FUNC_HASH_NAME];
+static unsigned int gFuncHashNbName = 0;
+
+static void addFuncHashName(const TA_FuncInfo *info,
+                            void *opaqueData)
+{
+   (void)opaqueData; /* Get ride of compiler warning. */
+
+   if (gFuncHashNbName < MAX_FUNC_HASH_NAME)
+      gFuncHashName[gFuncHashNbName] = info->name;
+   gFuncHashNbName++;
+}
+
+static int printFuncHash(FILE *out)
+{
+   static int slotName[MAX_FUNC_HASH_NAME * 4];
+   static unsigned int bucketOfName[MAX_FUNC_HASH_NAME];
+   static unsigned int bucketSize[MAX_FUNC_HASH_NAME];
+   static unsigned int bucketDone[MAX_FUNC_HASH_NAME];
+   static unsigned int displace[MAX_FUNC_HASH_NAME];
+   static unsigned int trySlot[MAX_FUNC_HASH_NAME];
+   unsigned int tableSize, nbBucket, bucket, largest;
+   unsigned int i, j, k, d, nbTry, isFree;
+
+   if ((gFuncHashNbName == 0) || (gFuncHashNbName > MAX_FUNC_HASH_NAME))
+      return 0;
+
+   /* Keep the table at most 2/3 full, nbBucket is a fourth of it. */
+   tableSize = 4;
+   while (tableSize < gFuncHashNbName + (gFuncHashNbName / 2))
+      tableSize <<= 1;
+   nbBucket = tableSize / 4;
+
+   for (i = 0; i < tableSize; i++)
+      slotName[i] = -1;
+
+   for (i = 0; i < nbBucket; i++)
+   {
+      bucketSize[i] = 0;
+      bucketDone[i] = 0;
+      displace[i] = 0;
+   }
+
+   for (i = 0; i < gFuncHashNbName; i++)
+   {
+      bucketOfName[i] = TA_FuncNameHash(gFuncHashName[i], 0) & (nbBucket - 1);
+      bucketSize[bucketOfName[i]]++;
+   }
+
+   /* Place the largest buckets first, while most slots are free. */
+   for (i = 0; i < nbBucket; i++)
+   {
+      largest = 0;
+      bucket = 0;
+      for (j = 0; j < nbBucket; j++)
+      {
+         if (!bucketDone[j] && (bucketSize[j] > largest))
+         {
+            largest = bucketSize[j];
+            bucket = j;
+         }
+      }
+
+      if (largest == 0)
+         break;
+
+      bucketDone[bucket] = 1;
+
+      for (d = 1; d <= MAX_FUNC_HASH_DISPLACE; d++)
+      {
+         isFree = 1;
+         nbTry = 0;
+         for (j = 0; (j < gFuncHashNbName) && isFree; j++)
+         {
+            if (bucketOfName[j] != bucket)
+               continue;
+
+            trySlot[nbTry] = TA_FuncNameHash(gFuncHashName[j], d) & (tableSize - 1);
+            if (slotName[trySlot[nbTry]] != -1)
+               isFree = 0;
+            for (k = 0; (k < nbTry) && isFree; k++)
+            {
+               if (trySlot[k] == trySlot[nbTry])
+                  isFree = 0;
+            }
+            nbTry++;
+         }
+
+         if (isFree)
+            break;
+      }
+
+      if (d > MAX_FUNC_HASH_DISPLACE)
+         return 0;
+
+      displace[bucket] = d;
+      nbTry = 0;
+      for (j = 0; j < gFuncHashNbName; j++)
+      {
+         if (bucketOfName[j] == bucket)
+            slotName[trySlot[nbTry++]] = (int)j;
+      }
+   }
+
+   fprintf(out, "\n");
+   print(out, "const unsigned int TA_FuncHashSize = %d;\n", tableSize);
+   print(out, "const unsigned int TA_FuncHashNbBucket = %d;\n\n", nbBucket);
+
+   print(out, "const unsigned short TA_FuncHashDisplace[%d] = {\n", nbBucket);
+   for (i = 0; i < nbBucket; i++)
+      fprintf(out, "%d%s", displace[i], (i == nbBucket - 1) ? "\n" : ((i % 16) == 15 ? ",\n" : ","));
+   print(out, "};\n\n");
+
+   print(out, "const TA_FuncDef *TA_FuncHashTable[%d] = {\n", tableSize);
+   for (i = 0; i < tableSize; i++)
+   {
+      if (slotName[i] == -1)
+         fprintf(out, "NULL%s\n", (i == tableSize - 1) ? "" : ",");
+      else
+         fprintf(out, "&TA_DEF_%s%s\n", gFuncHashName[slotName[i]], (i == tableSize - 1) ? "" : ",");
+   }
+   print(out, "};\n");
+
+   return 1;
+}
+
 static void doFuncFile(const TA_FuncInfo *funcInfo)
 {
 
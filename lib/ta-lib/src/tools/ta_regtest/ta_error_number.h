@@ -237,6 +237,14 @@ typedef enum
   TA_INTERNAL_TIMESTAMP_TEST_FAILED = 709,
   TA_INTERNAL_PSEUDORANDOM_UINT32   = 710,
   TA_INTERNAL_PSEUDORANDOM_DOUBLE   = 711,
+  TA_INTERNAL_WORKSPACE_FAIL_0      = 712,
+  TA_INTERNAL_WORKSPACE_FAIL_1      = 713,
+  TA_INTERNAL_WORKSPACE_FAIL_2      = 714,
+  TA_INTERNAL_CONTEXT_FAIL_0        = 715,
+  TA_INTERNAL_CONTEXT_FAIL_1        = 716,
+  TA_INTERNAL_CONTEXT_FAIL_2        = 717,
+  TA_INTERNAL_CONTEXT_FAIL_3        = 718,
+  TA_INTERNAL_CONTEXT_FAIL_4        = 719,
 
   /* Error code related to CSI data source tests. */
   TA_CSI_ADDDATASOURCE_FAILED    = 800,
@@ -285,6 +293,14 @@ typedef enum
   TA_TSTMERGE_ASCII_BAD_PATTERN_CLOSE = 1018,
   TA_TSTMERGE_ASCII_BAD_PATTERN_TS    = 1019,  
 
+  /* Error code related to test_stream */
+  TA_TSTSTREAM_BATCH_FAIL         = 1100,
+  TA_TSTSTREAM_INIT_FAIL          = 1101,
+  TA_TSTSTREAM_UPDATE_FAIL        = 1102,
+  TA_TSTSTREAM_NBELEMENT_WRONG    = 1103,
+  TA_TSTSTREAM_VALUE_DIFF         = 1104,
+  TA_TSTSTREAM_FREE_FAIL          = 1105,
+
   /* Error code related to bug fix documentented on SourceForge. */
   TA_TEST_FAIL_BUG1359452_1  = 2000,
   TA_TEST_FAIL_BUG1359452_2  = 2001,
@@ -0,0 +1,468 @@
+/* TA-LIB Copyright (c) 1999-2007, Mario Fortier
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in
+ *   the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * - Neither name of author nor the names of its contributors
+ *   may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Description:
+ *    Time every TA function through the abstract interface over
+ *    synthetic datasets and emit one CSV line per function and size:
+ *
+ *       function,bars,lookback,outputs,ns_per_bar,checksum
+ *
+ *    ns_per_bar is the median of several trials, each repeating the call
+ *    for at least MIN_TRIAL_TIME, and the checksum is the sum of all
+ *    finite outputs. A report saved before a change to the compilation
+ *    flags or the code can be passed back with -b to flag accuracy
+ *    (checksum) and speed regressions. Only sizes from MIN_GATED_BARS up
+ *    are held to the speed tolerance: smaller ones stay in cache and
+ *    swing with whatever else runs. Timings still vary from run to run
+ *    with the load and the clock of the machine, so compare reports from
+ *    the same idle machine and widen -t (or add trials with -n) where
+ *    they prove noisy.
+ *
+ *    Each call is also checked for a successful return code and for
+ *    producing exactly bars - lookback outputs. The numerical tests
+ *    against known values remain in ta_regtest.
+ */
+
+/**** Headers ****/
+#ifdef WIN32
+#include "windows.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "ta_libc.h"
+
+/**** Local declarations.              ****/
+#define MAX_SIZES      8
+#define MAX_BASELINE   4096
+#define MIN_TRIAL_TIME 0.01   /* Seconds. */
+#define MIN_GATED_BARS 100000
+#define NB_TRIAL       9
+#define MAX_TRIAL      99
+
+typedef struct
+{
+   char   name[32];
+   int    bars;
+   double nsPerBar;
+   double checksum;
+} Measure;
+
+typedef struct
+{
+   int     bars;
+   TA_Real *open;
+   TA_Real *high;
+   TA_Real *low;
+   TA_Real *close;
+   TA_Real *volume;
+   void    *out[3];
+
+   const Measure *baseline;
+   int     nbBaseline;
+   int     nbTrial;
+   double  speedTolerance;
+   double  checksumTolerance;
+   int     nbFailure;
+} Context;
+
+/**** Local functions declarations.    ****/
+static void printUsage( void );
+static double now( void );
+static int compareDouble( const void *a, const void *b );
+static int makeDataset( Context *context, int bars );
+static void freeDataset( Context *context );
+static int loadBaseline( const char *filename, Measure *baseline );
+static const Measure *findBaseline( const Context *context, const char *name, int bars );
+static void perfFunction( const TA_FuncInfo *funcInfo, void *opaqueData );
+
+/**** Global functions definitions.   ****/
+int main( int argc, char **argv )
+{
+   static Measure baseline[MAX_BASELINE];
+   int sizes[MAX_SIZES];
+   int nbSizes, i;
+   Context context;
+   TA_RetCode retCode;
+
+   memset( &context, 0, sizeof(context) );
+   context.nbTrial = NB_TRIAL;
+   context.speedTolerance = 0.25;
+   context.checksumTolerance = 1e-9;
+   nbSizes = 0;
+
+   for( i=1; i < argc; i++ )
+   {
+      if( (strcmp(argv[i],"-b") == 0) && (i+1 < argc) )
+      {
+         context.nbBaseline = loadBaseline( argv[++i], baseline );
+         if( context.nbBaseline < 0 )
+         {
+            fprintf( stderr, "Cannot read baseline [%s]\n", argv[i] );
+            return 2;
+         }
+         context.baseline = baseline;
+      }
+      else if( (strcmp(argv[i],"-t") == 0) && (i+1 < argc) )
+         context.speedTolerance = atof( argv[++i] );
+      else if( (strcmp(argv[i],"-n") == 0) && (i+1 < argc) )
+      {
+         context.nbTrial = atoi( argv[++i] );
+         if( (context.nbTrial < 1) || (context.nbTrial > MAX_TRIAL) )
+         {
+            printUsage();
+            return 2;
+         }
+      }
+      else if( (argv[i][0] >= '0') && (argv[i][0] <= '9') && (nbSizes < MAX_SIZES) )
+         sizes[nbSizes++] = atoi( argv[i] );
+      else
+      {
+         printUsage();
+         return 2;
+      }
+   }
+
+   if( nbSizes == 0 )
+   {
+      sizes[nbSizes++] = 1000;
+      sizes[nbSizes++] = 100000;
+      sizes[nbSizes++] = 10000000;
+   }
+
+   retCode = TA_Initialize();
+   if( retCode != TA_SUCCESS )
+   {
+      fprintf( stderr, "TA_Initialize failed [%d]\n", retCode );
+      return 2;
+   }
+
+   printf( "function,bars,lookback,outputs,ns_per_bar,checksum\n" );
+   for( i=0; i < nbSizes; i++ )
+   {
+      if( !makeDataset( &context, sizes[i] ) )
+      {
+         fprintf( stderr, "Cannot allocate %d bars\n", sizes[i] );
+         freeDataset( &context );
+         TA_Shutdown();
+         return 2;
+      }
+      TA_ForEachFunc( perfFunction, &context );
+      freeDataset( &context );
+   }
+
+   TA_Shutdown();
+
+   if( context.nbFailure != 0 )
+   {
+      fprintf( stderr, "%d regression(s)\n", context.nbFailure );
+      return 1;
+   }
+   return 0;
+}
+
+/**** Local functions definitions.     ****/
+static void printUsage( void )
+{
+   printf( "Usage: ta_perftest [-b baseline.csv] [-t speedTolerance] [-n trials] [bars ...]\n" );
+   printf( "\n" );
+   printf( "   Writes a CSV report to stdout. Default sizes are 1000, 100000\n" );
+   printf( "   and 10000000 bars, each timed as the median of %d trials\n", NB_TRIAL );
+   printf( "   (1 to %d with -n). With -b, functions whose checksum moved or\n", MAX_TRIAL );
+   printf( "   that got slower than the baseline by more than speedTolerance\n" );
+   printf( "   (default 0.25) are reported on stderr and the exit code is 1.\n" );
+   printf( "   Speed is only compared from %d bars up.\n", MIN_GATED_BARS );
+}
+
+static double now( void )
+{
+#ifdef WIN32
+   LARGE_INTEGER frequency, counter;
+   QueryPerformanceFrequency( &frequency );
+   QueryPerformanceCounter( &counter );
+   return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+   struct timespec ts;
+   clock_gettime( CLOCK_MONOTONIC, &ts );
+   return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+static int compareDouble( const void *a, const void *b )
+{
+   double x, y;
+
+   x = *(const double *)a;
+   y = *(const double *)b;
+   return (x > y) - (x < y);
+}
+
+static int makeDataset( Context *context, int bars )
+{
+   unsigned int seed;
+   double price, move, range;
+   int i;
+
+   context->bars   = bars;
+   context->open   = (TA_Real *)malloc( bars * sizeof(TA_Real) );
+   context->high   = (TA_Real *)malloc( bars * sizeof(TA_Real) );
+   context->low    = (TA_Real *)malloc( bars * sizeof(TA_Real) );
+   context->close  = (TA_Real *)malloc( bars * sizeof(TA_Real) );
+   context->volume = (TA_Real *)malloc( bars * sizeof(TA_Real) );
+   for( i=0; i < 3; i++ )
+      context->out[i] = malloc( bars * sizeof(TA_Real) );
+
+   if( !context->open || !context->high || !context->low || !context->close ||
+       !context->volume || !context->out[0] || !context->out[1] || !context->out[2] )
+      return 0;
+
+   /* Same random walk on every run, so checksums are comparable. */
+   seed = 12345;
+   price = 100.0;
+   for( i=0; i < bars; i++ )
+   {
+      seed = seed * 1103515245 + 12345;
+      move = ((double)((seed >> 8) % 2001) - 1000.0) / 1000.0;
+      seed = seed * 1103515245 + 12345;
+      range = 0.2 + (double)((seed >> 8) % 1000) / 500.0;
+
+      context->open[i]  = price;
+      price += move;
+      if( price < 1.0 )
+         price = 1.0 + fabs(move);
+      context->close[i] = price;
+      context->high[i]  = (price > context->open[i] ? price : context->open[i]) + range;
+      context->low[i]   = (price < context->open[i] ? price : context->open[i]) - range * 0.5;
+      if( context->low[i] <= 0.0 )
+         context->low[i] = 0.01;
+      context->volume[i] = 1000.0 + (double)((seed >> 4) % 100000);
+   }
+
+   return 1;
+}
+
+static void freeDataset( Context *context )
+{
+   int i;
+
+   free( context->open );
+   free( context->high );
+   free( context->low );
+   free( context->close );
+   free( context->volume );
+   for( i=0; i < 3; i++ )
+      free( context->out[i] );
+
+   context->open = context->high = context->low = context->close = context->volume = NULL;
+   context->out[0] = context->out[1] = context->out[2] = NULL;
+}
+
+static int loadBaseline( const char *filename, Measure *baseline )
+{
+   FILE *file;
+   char line[256];
+   int nb, lookback, outputs;
+
+   file = fopen( filename, "r" );
+   if( !file )
+      return -1;
+
+   nb = 0;
+   while( (nb < MAX_BASELINE) && fgets( line, sizeof(line), file ) )
+   {
+      if( sscanf( line, "%31[^,],%d,%d,%d,%lf,%lf",
+                  baseline[nb].name, &baseline[nb].bars, &lookback, &outputs,
+                  &baseline[nb].nsPerBar, &baseline[nb].checksum ) == 6 )
+         nb++;
+   }
+
+   fclose( file );
+   return nb;
+}
+
+static const Measure *findBaseline( const Context *context, const char *name, int bars )
+{
+   int i;
+
+   for( i=0; i < context->nbBaseline; i++ )
+   {
+      if( (context->baseline[i].bars == bars) && (strcmp(context->baseline[i].name,name) == 0) )
+         return &context->baseline[i];
+   }
+   return NULL;
+}
+
+static void perfFunction( const TA_FuncInfo *funcInfo, void *opaqueData )
+{
+   Context *context;
+   const TA_FuncHandle *handle;
+   TA_ParamHolder *params;
+   const TA_InputParameterInfo *inputInfo;
+   const TA_OutputParameterInfo *outputInfo;
+   const Measure *base;
+   TA_RetCode retCode;
+   TA_Integer outBegIdx, outNbElement, lookback;
+   double trials[MAX_TRIAL];
+   double start, nsPerBar, checksum, scale, value;
+   int i, j, repeat, trial;
+
+   context = (Context *)opaqueData;
+
+   if( (TA_GetFuncHandle( funcInfo->name, &handle ) != TA_SUCCESS) ||
+       (TA_ParamHolderAlloc( handle, &params ) != TA_SUCCESS) )
+   {
+      fprintf( stderr, "%s: cannot allocate parameters\n", funcInfo->name );
+      context->nbFailure++;
+      return;
+   }
+
+   /* Inputs are the dataset, optional inputs keep their defaults. */
+   for( i=0; i < (int)funcInfo->nbInput; i++ )
+   {
+      TA_GetInputParameterInfo( handle, i, &inputInfo );
+      switch( inputInfo->type )
+      {
+      case TA_Input_Price:
+         TA_SetInputParamPricePtr( params, i, context->open, context->high, context->low,
+                                   context->close, context->volume, context->volume );
+         break;
+      case TA_Input_Real:
+         TA_SetInputParamRealPtr( params, i, i == 0 ? context->close : context->high );
+         break;
+      case TA_Input_Integer:
+         /* Not used by any function in this version. */
+         break;
+      }
+   }
+
+   for( i=0; i < (int)funcInfo->nbOutput; i++ )
+   {
+      TA_GetOutputParameterInfo( handle, i, &outputInfo );
+      if( outputInfo->type == TA_Output_Integer )
+         TA_SetOutputParamIntegerPtr( params, i, (TA_Integer *)context->out[i] );
+      else
+         TA_SetOutputParamRealPtr( params, i, (TA_Real *)context->out[i] );
+   }
+
+   TA_GetLookback( params, &lookback );
+
+   /* Each trial repeats the call until it lasts at least MIN_TRIAL_TIME:
+    * one call on a small dataset takes a few microseconds, where the clock
+    * and the scheduler decide the measure. Doubling until then also warms
+    * up the caches before the first trial.
+    */
+   retCode = TA_SUCCESS;
+   outBegIdx = outNbElement = 0;
+   repeat = 1;
+   while( retCode == TA_SUCCESS )
+   {
+      start = now();
+      for( j=0; (j < repeat) && (retCode == TA_SUCCESS); j++ )
+         retCode = TA_CallFunc( params, 0, context->bars-1, &outBegIdx, &outNbElement );
+      if( now() - start >= MIN_TRIAL_TIME )
+         break;
+      repeat *= 2;
+   }
+
+   for( trial=0; (trial < context->nbTrial) && (retCode == TA_SUCCESS); trial++ )
+   {
+      start = now();
+      for( j=0; (j < repeat) && (retCode == TA_SUCCESS); j++ )
+         retCode = TA_CallFunc( params, 0, context->bars-1, &outBegIdx, &outNbElement );
+      trials[trial] = (now() - start) * 1e9 / ((double)repeat * (double)context->bars);
+   }
+
+   /* The median, unlike the best trial, is not pulled by a single lucky
+    * or preempted run, in the report or in the baseline.
+    */
+   qsort( trials, trial, sizeof(double), compareDouble );
+   nsPerBar = trials[trial/2];
+
+   if( retCode != TA_SUCCESS )
+   {
+      fprintf( stderr, "%s: TA_CallFunc failed [%d] on %d bars\n", funcInfo->name, retCode, context->bars );
+      context->nbFailure++;
+      TA_ParamHolderFree( params );
+      return;
+   }
+
+   if( (lookback < context->bars) && (outNbElement != context->bars - lookback) )
+   {
+      fprintf( stderr, "%s: %d outputs for %d bars with lookback %d\n",
+               funcInfo->name, outNbElement, context->bars, lookback );
+      context->nbFailure++;
+   }
+
+   checksum = 0.0;
+   for( i=0; i < (int)funcInfo->nbOutput; i++ )
+   {
+      TA_GetOutputParameterInfo( handle, i, &outputInfo );
+      for( j=0; j < outNbElement; j++ )
+      {
+         if( outputInfo->type == TA_Output_Integer )
+            value = ((TA_Integer *)context->out[i])[j];
+         else
+            value = ((TA_Real *)context->out[i])[j];
+         if( value - value == 0.0 )
+            checksum += value;
+      }
+   }
+
+   printf( "%s,%d,%d,%d,%.3f,%.17g\n", funcInfo->name, context->bars, lookback,
+           outNbElement, nsPerBar, checksum );
+
+   base = findBaseline( context, funcInfo->name, context->bars );
+   if( base )
+   {
+      scale = fabs(base->checksum) > 1.0 ? fabs(base->checksum) : 1.0;
+      if( fabs(checksum - base->checksum) > context->checksumTolerance * scale )
+      {
+         fprintf( stderr, "%s: checksum %.17g, baseline %.17g (%d bars)\n",
+                  funcInfo->name, checksum, base->checksum, context->bars );
+         context->nbFailure++;
+      }
+      if( (context->bars >= MIN_GATED_BARS) &&
+          (nsPerBar > base->nsPerBar * (1.0 + context->speedTolerance)) )
+      {
+         fprintf( stderr, "%s: %.3f ns/bar, baseline %.3f (%d bars)\n",
+                  funcInfo->name, nsPerBar, base->nsPerBar, context->bars );
+         context->nbFailure++;
+      }
+   }
+
+   TA_ParamHolderFree( params );
+}
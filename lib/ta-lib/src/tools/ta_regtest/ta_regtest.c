@@ -144,6 +144,14 @@ int main(int argc, char **argv)
       return retValue;
    }
 
+   /* Test the per-thread contexts. */
+   retValue = test_context();
+   if (retValue != TA_TEST_PASS)
+   {
+      printf("\nFailed a context test with code=%d\n", retValue);
+      return retValue;
+   }
+
    /* Test abstract interface. */
    retValue = test_abstract();
    if (retValue != TA_TEST_PASS)
@@ -267,6 +275,7 @@ static ErrorNumber testTAFunction_ALL(void)
    DO_TEST(test_func_trange, "TRANGE,ATR");
    DO_TEST(test_func_stddev, "STDDEV,VAR");
    DO_TEST(test_func_bbands, "BBANDS");
+   DO_TEST(test_func_stream, "Streaming (StateInit/StateUpdate)");
    DO_TEST(test_candlestick, "All Candlesticks");
 
    return TA_TEST_PASS; /* All tests succeeded. */
@@ -0,0 +1,1281 @@
+/* TA-LIB Copyright (c) 1999-2007, Mario Fortier
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in
+ *   the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * - Neither name of author nor the names of its contributors
+ *   may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Description:
+ *     Stream all the bars through the TA_<FUNC>_StateUpdate functions
+ *     and verify that the outputs are identical to the ones of the
+ *     batch function, with and without unstable period and with the
+ *     Metastock compatibility.
+ */
+
+/**** Headers ****/
+#include <stdio.h>
+#include <string.h>
+
+#include "../ta_test_priv.h"
+#include "../ta_test_func.h"
+#include "ta_stream.h"
+
+/**** External functions declarations. ****/
+/* None */
+
+/**** External variables declarations. ****/
+/* None */
+
+/**** Global variables definitions.    ****/
+/* None */
+
+/**** Local declarations.              ****/
+typedef enum
+{
+   STREAM_SMA,
+   STREAM_EMA,
+   STREAM_WMA,
+   STREAM_DEMA,
+   STREAM_TEMA,
+   STREAM_TRIMA,
+   STREAM_KAMA,
+   STREAM_T3,
+   STREAM_MAMA,
+   STREAM_MA,
+   STREAM_BBANDS,
+   STREAM_STDDEV,
+   STREAM_VAR,
+   STREAM_SUM,
+   STREAM_CORREL,
+   STREAM_BETA,
+   STREAM_MACD,
+   STREAM_MACDFIX,
+   STREAM_MACDEXT,
+   STREAM_APO,
+   STREAM_PPO,
+   STREAM_RSI,
+   STREAM_CMO,
+   STREAM_MOM,
+   STREAM_ROC,
+   STREAM_ROCP,
+   STREAM_ROCR,
+   STREAM_ROCR100,
+   STREAM_TRIX,
+   STREAM_MFI,
+   STREAM_AD,
+   STREAM_ADOSC,
+   STREAM_OBV,
+   STREAM_WILLR,
+   STREAM_STOCH,
+   STREAM_STOCHF,
+   STREAM_STOCHRSI,
+   STREAM_MAX,
+   STREAM_MIN,
+   STREAM_MIDPOINT,
+   STREAM_MIDPRICE,
+   STREAM_AROON,
+   STREAM_AROONOSC,
+   STREAM_TRANGE,
+   STREAM_ATR,
+   STREAM_NATR,
+   STREAM_CCI,
+   STREAM_ULTOSC,
+   STREAM_ADX,
+   STREAM_ADXR,
+   STREAM_DX,
+   STREAM_PLUS_DI,
+   STREAM_MINUS_DI,
+   STREAM_PLUS_DM,
+   STREAM_MINUS_DM,
+   STREAM_SAR,
+   STREAM_SAREXT,
+   STREAM_HT_DCPERIOD,
+   STREAM_HT_DCPHASE,
+   STREAM_HT_PHASOR,
+   STREAM_HT_SINE,
+   STREAM_HT_TRENDLINE,
+   STREAM_HT_TRENDMODE
+} StreamFunc;
+
+typedef struct
+{
+   StreamFunc       func;
+   const char      *name;
+
+   /* The optional inputs, in the order of TA_<FUNC>. The integers
+    * (MA types included) and the reals are kept apart.
+    */
+   TA_Integer       optInInteger[6];
+   TA_Real          optInReal[8];
+
+   TA_Integer       unstablePeriod;
+   TA_Compatibility compatibility;
+} TA_Test;
+
+typedef union
+{
+   TA_SMA_State      *sma;
+   TA_EMA_State      *ema;
+   TA_WMA_State      *wma;
+   TA_DEMA_State     *dema;
+   TA_TEMA_State     *tema;
+   TA_TRIMA_State    *trima;
+   TA_KAMA_State     *kama;
+   TA_T3_State       *t3;
+   TA_MAMA_State     *mama;
+   TA_MA_State       *ma;
+   TA_BBANDS_State   *bbands;
+   TA_STDDEV_State   *stddev;
+   TA_VAR_State      *var;
+   TA_SUM_State      *sum;
+   TA_CORREL_State   *correl;
+   TA_BETA_State     *beta;
+   TA_MACD_State     *macd;
+   TA_MACDFIX_State  *macdfix;
+   TA_MACDEXT_State  *macdext;
+   TA_APO_State      *apo;
+   TA_PPO_State      *ppo;
+   TA_RSI_State      *rsi;
+   TA_CMO_State      *cmo;
+   TA_MOM_State      *mom;
+   TA_ROC_State      *roc;
+   TA_ROCP_State     *rocp;
+   TA_ROCR_State     *rocr;
+   TA_ROCR100_State  *rocr100;
+   TA_TRIX_State     *trix;
+   TA_MFI_State      *mfi;
+   TA_AD_State       *ad;
+   TA_ADOSC_State    *adosc;
+   TA_OBV_State      *obv;
+   TA_WILLR_State    *willr;
+   TA_STOCH_State    *stoch;
+   TA_STOCHF_State   *stochf;
+   TA_STOCHRSI_State *stochrsi;
+   TA_MAX_State      *max;
+   TA_MIN_State      *min;
+   TA_MIDPOINT_State *midpoint;
+   TA_MIDPRICE_State *midprice;
+   TA_AROON_State    *aroon;
+   TA_AROONOSC_State *aroonosc;
+   TA_TRANGE_State   *trange;
+   TA_ATR_State      *atr;
+   TA_NATR_State     *natr;
+   TA_CCI_State      *cci;
+   TA_ULTOSC_State   *ultosc;
+   TA_ADX_State      *adx;
+   TA_ADXR_State     *adxr;
+   TA_DX_State       *dx;
+   TA_PLUS_DI_State  *plusDI;
+   TA_MINUS_DI_State *minusDI;
+   TA_PLUS_DM_State  *plusDM;
+   TA_MINUS_DM_State *minusDM;
+   TA_SAR_State      *sar;
+   TA_SAREXT_State   *sarext;
+   TA_HT_DCPERIOD_State  *htDCPeriod;
+   TA_HT_DCPHASE_State   *htDCPhase;
+   TA_HT_PHASOR_State    *htPhasor;
+   TA_HT_SINE_State      *htSine;
+   TA_HT_TRENDLINE_State *htTrendline;
+   TA_HT_TRENDMODE_State *htTrendMode;
+} TA_AnyState;
+
+#define META TA_COMPATIBILITY_METASTOCK
+#define DFLT TA_COMPATIBILITY_DEFAULT
+
+#define NONE { 0.0 }
+
+/**** Local functions declarations.    ****/
+static ErrorNumber do_test( const TA_History *history,
+                            const TA_Test *test );
+static ErrorNumber do_test_ht( const TA_History *history,
+                               unsigned int unstablePeriod );
+
+static int nbOutput( StreamFunc func );
+static TA_RetCode callBatch( const TA_History *history,
+                             const TA_Test *test,
+                             TA_Integer *outBegIdx,
+                             TA_Integer *outNbElement );
+
+static TA_RetCode stateInit( const TA_Test *test, TA_AnyState *state );
+static TA_RetCode stateUpdate( const TA_History *history,
+                               const TA_Test *test,
+                               TA_AnyState *state,
+                               int bar,
+                               int *outNBElement,
+                               TA_Real out[3] );
+static TA_RetCode stateFree( const TA_Test *test, TA_AnyState *state );
+
+/**** Local variables definitions.     ****/
+static TA_Real batchOut[3][2000];
+static TA_Integer batchOutInteger[2000];
+
+static TA_Test tableTest[] =
+{
+   { STREAM_SMA,    "SMA",    {  2 }, NONE,  0, DFLT },
+   { STREAM_SMA,    "SMA",    { 30 }, NONE,  0, DFLT },
+   { STREAM_EMA,    "EMA",    {  2 }, NONE,  0, DFLT },
+   { STREAM_EMA,    "EMA",    { 14 }, NONE,  0, DFLT },
+   { STREAM_EMA,    "EMA",    { 14 }, NONE, 10, DFLT },
+   { STREAM_EMA,    "EMA",    { 14 }, NONE,  0, META },
+   { STREAM_EMA,    "EMA",    { 14 }, NONE,  5, META },
+   { STREAM_WMA,    "WMA",    {  2 }, NONE,  0, DFLT },
+   { STREAM_WMA,    "WMA",    { 14 }, NONE,  0, DFLT },
+   { STREAM_DEMA,   "DEMA",   { 10 }, NONE,  0, DFLT },
+   { STREAM_DEMA,   "DEMA",   { 10 }, NONE,  3, DFLT },
+   { STREAM_DEMA,   "DEMA",   { 10 }, NONE,  0, META },
+   { STREAM_TEMA,   "TEMA",   { 10 }, NONE,  0, DFLT },
+   { STREAM_TEMA,   "TEMA",   { 10 }, NONE,  3, DFLT },
+   { STREAM_TEMA,   "TEMA",   { 10 }, NONE,  3, META },
+   { STREAM_TRIMA,  "TRIMA",  {  2 }, NONE,  0, DFLT },
+   { STREAM_TRIMA,  "TRIMA",  { 11 }, NONE,  0, DFLT },
+   { STREAM_TRIMA,  "TRIMA",  { 30 }, NONE,  0, DFLT },
+   { STREAM_KAMA,   "KAMA",   {  2 }, NONE,  0, DFLT },
+   { STREAM_KAMA,   "KAMA",   { 30 }, NONE,  0, DFLT },
+   { STREAM_KAMA,   "KAMA",   { 10 }, NONE,  7, DFLT },
+   { STREAM_T3,     "T3",     {  5 }, { 0.7 }, 0, DFLT },
+   { STREAM_T3,     "T3",     {  5 }, { 0.7 }, 4, DFLT },
+   { STREAM_T3,     "T3",     {  2 }, { 0.0 }, 0, DFLT },
+   { STREAM_T3,     "T3",     { 10 }, { 1.0 }, 0, META },
+   { STREAM_MAMA,   "MAMA",   {  0 }, { 0.5, 0.05 },  0, DFLT },
+   { STREAM_MAMA,   "MAMA",   {  0 }, { 0.5, 0.05 }, 10, DFLT },
+   { STREAM_MAMA,   "MAMA",   {  0 }, { 0.9, 0.2 },   0, DFLT },
+
+   { STREAM_MA,     "MA",     {  1, TA_MAType_SMA   }, NONE, 0, DFLT },
+   { STREAM_MA,     "MA",     { 20, TA_MAType_SMA   }, NONE, 0, DFLT },
+   { STREAM_MA,     "MA",     { 20, TA_MAType_EMA   }, NONE, 2, DFLT },
+   { STREAM_MA,     "MA",     { 20, TA_MAType_WMA   }, NONE, 0, DFLT },
+   { STREAM_MA,     "MA",     { 20, TA_MAType_DEMA  }, NONE, 0, META },
+   { STREAM_MA,     "MA",     { 20, TA_MAType_TEMA  }, NONE, 0, DFLT },
+   { STREAM_MA,     "MA",     { 20, TA_MAType_TRIMA }, NONE, 0, DFLT },
+   { STREAM_MA,     "MA",     { 20, TA_MAType_KAMA  }, NONE, 3, DFLT },
+   { STREAM_MA,     "MA",     { 20, TA_MAType_T3    }, NONE, 0, DFLT },
+   { STREAM_MA,     "MA",     { 20, TA_MAType_MAMA  }, NONE, 0, DFLT },
+
+   { STREAM_BBANDS, "BBANDS", { 20, TA_MAType_SMA   }, { 2.0, 2.0 }, 0, DFLT },
+   { STREAM_BBANDS, "BBANDS", { 20, TA_MAType_SMA   }, { 1.0, 1.5 }, 0, DFLT },
+   { STREAM_BBANDS, "BBANDS", { 20, TA_MAType_EMA   }, { 2.0, 2.0 }, 0, DFLT },
+   { STREAM_BBANDS, "BBANDS", { 20, TA_MAType_EMA   }, { 1.5, 1.0 }, 4, DFLT },
+   { STREAM_BBANDS, "BBANDS", { 20, TA_MAType_EMA   }, { 2.0, 2.0 }, 0, META },
+   { STREAM_BBANDS, "BBANDS", { 10, TA_MAType_WMA   }, { 2.0, 2.0 }, 0, DFLT },
+   { STREAM_BBANDS, "BBANDS", { 10, TA_MAType_DEMA  }, { 2.0, 2.0 }, 0, DFLT },
+   { STREAM_BBANDS, "BBANDS", { 10, TA_MAType_TEMA  }, { 2.0, 2.0 }, 2, DFLT },
+   { STREAM_BBANDS, "BBANDS", { 10, TA_MAType_TRIMA }, { 2.0, 2.0 }, 0, DFLT },
+   { STREAM_BBANDS, "BBANDS", { 10, TA_MAType_KAMA  }, { 2.0, 2.0 }, 0, DFLT },
+   { STREAM_BBANDS, "BBANDS", { 10, TA_MAType_T3    }, { 2.0, 2.0 }, 0, DFLT },
+   { STREAM_BBANDS, "BBANDS", { 20, TA_MAType_MAMA  }, { 2.0, 2.0 }, 0, DFLT },
+
+   { STREAM_STDDEV, "STDDEV", { 10 }, { 1.0 }, 0, DFLT },
+   { STREAM_STDDEV, "STDDEV", {  5 }, { 2.0 }, 0, DFLT },
+   { STREAM_VAR,    "VAR",    {  1 }, { 1.0 }, 0, DFLT },
+   { STREAM_VAR,    "VAR",    { 10 }, { 1.0 }, 0, DFLT },
+   { STREAM_SUM,    "SUM",    {  2 }, NONE,    0, DFLT },
+   { STREAM_SUM,    "SUM",    { 30 }, NONE,    0, DFLT },
+   { STREAM_CORREL, "CORREL", {  1 }, NONE,    0, DFLT },
+   { STREAM_CORREL, "CORREL", { 30 }, NONE,    0, DFLT },
+   { STREAM_BETA,   "BETA",   {  1 }, NONE,    0, DFLT },
+   { STREAM_BETA,   "BETA",   {  5 }, NONE,    0, DFLT },
+
+   { STREAM_MACD,    "MACD",    { 12, 26, 9 }, NONE, 0, DFLT },
+   { STREAM_MACD,    "MACD",    { 12, 26, 9 }, NONE, 5, DFLT },
+   { STREAM_MACD,    "MACD",    { 12, 26, 9 }, NONE, 0, META },
+   { STREAM_MACD,    "MACD",    { 26, 12, 9 }, NONE, 0, DFLT },
+   { STREAM_MACD,    "MACD",    {  3,  5, 2 }, NONE, 2, META },
+   { STREAM_MACDFIX, "MACDFIX", {  9 }, NONE, 0, DFLT },
+   { STREAM_MACDFIX, "MACDFIX", {  9 }, NONE, 5, DFLT },
+   { STREAM_MACDFIX, "MACDFIX", {  3 }, NONE, 2, META },
+   { STREAM_MACDEXT, "MACDEXT", { 12, TA_MAType_EMA, 26, TA_MAType_EMA, 9, TA_MAType_EMA }, NONE, 0, DFLT },
+   { STREAM_MACDEXT, "MACDEXT", { 12, TA_MAType_SMA, 26, TA_MAType_SMA, 9, TA_MAType_SMA }, NONE, 0, DFLT },
+   { STREAM_MACDEXT, "MACDEXT", { 26, TA_MAType_KAMA, 12, TA_MAType_WMA, 1, TA_MAType_SMA }, NONE, 3, DFLT },
+   { STREAM_MACDEXT, "MACDEXT", {  5, TA_MAType_T3, 20, TA_MAType_TEMA, 4, TA_MAType_DEMA }, NONE, 0, META },
+   { STREAM_MACDEXT, "MACDEXT", { 10, TA_MAType_MAMA, 20, TA_MAType_TRIMA, 3, TA_MAType_EMA }, NONE, 0, DFLT },
+
+   { STREAM_APO,    "APO",    { 12, 26, TA_MAType_SMA  }, NONE, 0, DFLT },
+   { STREAM_APO,    "APO",    { 12, 26, TA_MAType_EMA  }, NONE, 3, DFLT },
+   { STREAM_APO,    "APO",    { 26, 12, TA_MAType_EMA  }, NONE, 0, META },
+   { STREAM_APO,    "APO",    {  5, 10, TA_MAType_KAMA }, NONE, 0, DFLT },
+   { STREAM_PPO,    "PPO",    { 12, 26, TA_MAType_SMA  }, NONE, 0, DFLT },
+   { STREAM_PPO,    "PPO",    { 26, 12, TA_MAType_EMA  }, NONE, 3, DFLT },
+   { STREAM_PPO,    "PPO",    {  5, 10, TA_MAType_T3   }, NONE, 0, DFLT },
+
+   { STREAM_RSI,    "RSI",    { 14 }, NONE,  0, DFLT },
+   { STREAM_RSI,    "RSI",    { 14 }, NONE,  5, DFLT },
+   { STREAM_RSI,    "RSI",    { 14 }, NONE,  0, META },
+   { STREAM_RSI,    "RSI",    { 14 }, NONE,  1, META },
+   { STREAM_RSI,    "RSI",    { 14 }, NONE,  5, META },
+   { STREAM_RSI,    "RSI",    {  2 }, NONE,  0, DFLT },
+   { STREAM_CMO,    "CMO",    { 14 }, NONE,  0, DFLT },
+   { STREAM_CMO,    "CMO",    { 14 }, NONE,  5, DFLT },
+   { STREAM_CMO,    "CMO",    { 14 }, NONE,  0, META },
+   { STREAM_CMO,    "CMO",    { 14 }, NONE,  5, META },
+
+   { STREAM_MOM,     "MOM",     {  1 }, NONE,  0, DFLT },
+   { STREAM_MOM,     "MOM",     { 10 }, NONE,  0, DFLT },
+   { STREAM_ROC,     "ROC",     {  1 }, NONE,  0, DFLT },
+   { STREAM_ROC,     "ROC",     { 10 }, NONE,  0, DFLT },
+   { STREAM_ROCP,    "ROCP",    { 10 }, NONE,  0, DFLT },
+   { STREAM_ROCR,    "ROCR",    { 10 }, NONE,  0, DFLT },
+   { STREAM_ROCR100, "ROCR100", { 10 }, NONE,  0, DFLT },
+   { STREAM_TRIX,    "TRIX",    {  2 }, NONE,  0, DFLT },
+   { STREAM_TRIX,    "TRIX",    { 15 }, NONE,  0, DFLT },
+   { STREAM_TRIX,    "TRIX",    { 15 }, NONE,  5, META },
+   { STREAM_MFI,     "MFI",     {  2 }, NONE,  0, DFLT },
+   { STREAM_MFI,     "MFI",     { 14 }, NONE,  0, DFLT },
+   { STREAM_MFI,     "MFI",     { 14 }, NONE,  5, DFLT },
+   { STREAM_AD,      "AD",      {  0 }, NONE,  0, DFLT },
+   { STREAM_ADOSC,   "ADOSC",   {  3, 10 }, NONE, 0, DFLT },
+   { STREAM_ADOSC,   "ADOSC",   { 10,  3 }, NONE, 5, DFLT },
+   { STREAM_OBV,     "OBV",     {  0 }, NONE,  0, DFLT },
+
+   { STREAM_WILLR,  "WILLR",  {  2 }, NONE,  0, DFLT },
+   { STREAM_WILLR,  "WILLR",  { 14 }, NONE,  0, DFLT },
+   { STREAM_STOCH,  "STOCH",  {  5, 3, TA_MAType_SMA, 3, TA_MAType_SMA  }, NONE, 0, DFLT },
+   { STREAM_STOCH,  "STOCH",  { 14, 3, TA_MAType_EMA, 3, TA_MAType_EMA  }, NONE, 5, DFLT },
+   { STREAM_STOCH,  "STOCH",  {  5, 1, TA_MAType_SMA, 1, TA_MAType_SMA  }, NONE, 0, DFLT },
+   { STREAM_STOCH,  "STOCH",  {  5, 3, TA_MAType_WMA, 4, TA_MAType_DEMA }, NONE, 0, META },
+   { STREAM_STOCHF, "STOCHF", {  5, 3, TA_MAType_SMA }, NONE, 0, DFLT },
+   { STREAM_STOCHF, "STOCHF", { 14, 3, TA_MAType_EMA }, NONE, 5, DFLT },
+   { STREAM_STOCHF, "STOCHF", {  1, 1, TA_MAType_SMA }, NONE, 0, DFLT },
+   { STREAM_STOCHRSI, "STOCHRSI", { 14, 5, 3, TA_MAType_SMA }, NONE, 0, DFLT },
+   { STREAM_STOCHRSI, "STOCHRSI", { 14, 5, 3, TA_MAType_EMA }, NONE, 5, DFLT },
+   { STREAM_STOCHRSI, "STOCHRSI", { 14, 5, 3, TA_MAType_SMA }, NONE, 0, META },
+
+   { STREAM_MAX,      "MAX",      {  2 }, NONE, 0, DFLT },
+   { STREAM_MAX,      "MAX",      { 30 }, NONE, 0, DFLT },
+   { STREAM_MIN,      "MIN",      {  2 }, NONE, 0, DFLT },
+   { STREAM_MIN,      "MIN",      { 30 }, NONE, 0, DFLT },
+   { STREAM_MIDPOINT, "MIDPOINT", { 14 }, NONE, 0, DFLT },
+   { STREAM_MIDPRICE, "MIDPRICE", { 14 }, NONE, 0, DFLT },
+   { STREAM_AROON,    "AROON",    {  2 }, NONE, 0, DFLT },
+   { STREAM_AROON,    "AROON",    { 14 }, NONE, 0, DFLT },
+   { STREAM_AROONOSC, "AROONOSC", {  2 }, NONE, 0, DFLT },
+   { STREAM_AROONOSC, "AROONOSC", { 14 }, NONE, 0, DFLT },
+
+   { STREAM_TRANGE, "TRANGE", {  0 }, NONE,  0, DFLT },
+   { STREAM_ATR,    "ATR",    {  1 }, NONE,  0, DFLT },
+   { STREAM_ATR,    "ATR",    { 14 }, NONE,  0, DFLT },
+   { STREAM_ATR,    "ATR",    { 14 }, NONE,  5, DFLT },
+   { STREAM_NATR,   "NATR",   {  1 }, NONE,  0, DFLT },
+   { STREAM_NATR,   "NATR",   { 14 }, NONE,  0, DFLT },
+   { STREAM_NATR,   "NATR",   { 14 }, NONE,  5, DFLT },
+   { STREAM_CCI,    "CCI",    {  2 }, NONE,  0, DFLT },
+   { STREAM_CCI,    "CCI",    { 14 }, NONE,  0, DFLT },
+   { STREAM_ULTOSC, "ULTOSC", {  7, 14, 28 }, NONE, 0, DFLT },
+   { STREAM_ULTOSC, "ULTOSC", { 28,  7, 14 }, NONE, 0, DFLT },
+   { STREAM_ULTOSC, "ULTOSC", {  1,  2,  3 }, NONE, 0, DFLT },
+
+   { STREAM_ADX,      "ADX",      {  2 }, NONE, 0, DFLT },
+   { STREAM_ADX,      "ADX",      { 14 }, NONE, 0, DFLT },
+   { STREAM_ADX,      "ADX",      { 14 }, NONE, 5, DFLT },
+   { STREAM_ADXR,     "ADXR",     { 14 }, NONE, 0, DFLT },
+   { STREAM_ADXR,     "ADXR",     { 14 }, NONE, 5, DFLT },
+   { STREAM_DX,       "DX",       {  2 }, NONE, 0, DFLT },
+   { STREAM_DX,       "DX",       { 14 }, NONE, 0, DFLT },
+   { STREAM_DX,       "DX",       { 14 }, NONE, 5, DFLT },
+   { STREAM_PLUS_DI,  "PLUS_DI",  {  1 }, NONE, 0, DFLT },
+   { STREAM_PLUS_DI,  "PLUS_DI",  { 14 }, NONE, 0, DFLT },
+   { STREAM_PLUS_DI,  "PLUS_DI",  { 14 }, NONE, 5, DFLT },
+   { STREAM_MINUS_DI, "MINUS_DI", {  1 }, NONE, 0, DFLT },
+   { STREAM_MINUS_DI, "MINUS_DI", { 14 }, NONE, 0, DFLT },
+   { STREAM_MINUS_DI, "MINUS_DI", { 14 }, NONE, 5, DFLT },
+   { STREAM_PLUS_DM,  "PLUS_DM",  {  1 }, NONE, 0, DFLT },
+   { STREAM_PLUS_DM,  "PLUS_DM",  { 14 }, NONE, 0, DFLT },
+   { STREAM_PLUS_DM,  "PLUS_DM",  { 14 }, NONE, 5, DFLT },
+   { STREAM_MINUS_DM, "MINUS_DM", {  1 }, NONE, 0, DFLT },
+   { STREAM_MINUS_DM, "MINUS_DM", { 14 }, NONE, 0, DFLT },
+   { STREAM_MINUS_DM, "MINUS_DM", { 14 }, NONE, 5, DFLT },
+
+   { STREAM_SAR,    "SAR",    { 0 }, { 0.02, 0.2 }, 0, DFLT },
+   { STREAM_SAR,    "SAR",    { 0 }, { 0.05, 0.1 }, 0, DFLT },
+   { STREAM_SAREXT, "SAREXT", { 0 }, { 0.0, 0.0, 0.02, 0.02, 0.2, 0.02, 0.02, 0.2 }, 0, DFLT },
+   { STREAM_SAREXT, "SAREXT", { 0 }, { 0.0, 0.01, 0.01, 0.02, 0.1, 0.03, 0.01, 0.3 }, 0, DFLT },
+   { STREAM_SAREXT, "SAREXT", { 0 }, { 90.0, 0.0, 0.02, 0.02, 0.2, 0.02, 0.02, 0.2 }, 0, DFLT },
+   { STREAM_SAREXT, "SAREXT", { 0 }, { -110.0, 0.5, 0.02, 0.02, 0.2, 0.02, 0.02, 0.2 }, 0, DFLT },
+
+   { STREAM_HT_DCPERIOD,  "HT_DCPERIOD",  { 0 }, NONE,  0, DFLT },
+   { STREAM_HT_DCPERIOD,  "HT_DCPERIOD",  { 0 }, NONE, 40, DFLT },
+   { STREAM_HT_DCPHASE,   "HT_DCPHASE",   { 0 }, NONE,  0, DFLT },
+   { STREAM_HT_PHASOR,    "HT_PHASOR",    { 0 }, NONE,  0, DFLT },
+   { STREAM_HT_PHASOR,    "HT_PHASOR",    { 0 }, NONE,  7, DFLT },
+   { STREAM_HT_SINE,      "HT_SINE",      { 0 }, NONE,  0, DFLT },
+   { STREAM_HT_SINE,      "HT_SINE",      { 0 }, NONE, 10, DFLT },
+   { STREAM_HT_TRENDLINE, "HT_TRENDLINE", { 0 }, NONE,  0, DFLT },
+   { STREAM_HT_TRENDMODE, "HT_TRENDMODE", { 0 }, NONE,  0, DFLT },
+   { STREAM_HT_TRENDMODE, "HT_TRENDMODE", { 0 }, NONE, 10, DFLT }
+};
+
+#define NB_TEST (sizeof(tableTest)/sizeof(TA_Test))
+
+/**** Global functions definitions.   ****/
+ErrorNumber test_func_stream( TA_History *history )
+{
+   unsigned int i;
+   ErrorNumber retValue;
+   TA_MA_State *state;
+
+   if( history->nbBars > 2000 )
+      return TA_TESTUTIL_TFRR_BAD_PARAM;
+
+   for( i=0; i < NB_TEST; i++ )
+   {
+      retValue = do_test( history, &tableTest[i] );
+
+      TA_SetUnstablePeriod( TA_FUNC_UNST_ALL, 0 );
+      TA_SetCompatibility( TA_COMPATIBILITY_DEFAULT );
+
+      if( retValue != 0 )
+      {
+         printf( "TA_%s_StateUpdate Failed Test #%d (Code=%d)\n",
+                 tableTest[i].name, i, retValue );
+         return retValue;
+      }
+   }
+
+   /* All the HT outputs from one state. */
+   retValue = do_test_ht( history, 0 );
+   if( retValue == 0 )
+      retValue = do_test_ht( history, 5 );
+   TA_SetUnstablePeriod( TA_FUNC_UNST_ALL, 0 );
+   if( retValue != 0 )
+   {
+      printf( "TA_HT_StateUpdate Failed (Code=%d)\n", retValue );
+      return retValue;
+   }
+
+   /* An unknown MA type is rejected. */
+   if( TA_MA_StateInit( &state, 20, (TA_MAType)(TA_MAType_T3+1) ) != TA_BAD_PARAM )
+   {
+      printf( "TA_MA_StateInit Failed to reject an unknown MA type\n" );
+      return TA_TSTSTREAM_INIT_FAIL;
+   }
+
+   /* All test succeed. */
+   return TA_TEST_PASS;
+}
+
+/**** Local functions definitions.     ****/
+static ErrorNumber do_test( const TA_History *history,
+                            const TA_Test *test )
+{
+   TA_RetCode retCode;
+   TA_AnyState state;
+   TA_Integer outBegIdx, outNbElement;
+   TA_Real out[3];
+   int bar, nbOut, outNBElement, i;
+
+   retCode = TA_SetUnstablePeriod( TA_FUNC_UNST_ALL, test->unstablePeriod );
+   if( retCode != TA_SUCCESS )
+      return TA_TEST_TFRR_SETUNSTABLE_PERIOD_FAIL;
+
+   retCode = TA_SetCompatibility( test->compatibility );
+   if( retCode != TA_SUCCESS )
+      return TA_TSTSTREAM_BATCH_FAIL;
+
+   retCode = callBatch( history, test, &outBegIdx, &outNbElement );
+   if( (retCode != TA_SUCCESS) || (outNbElement == 0) )
+   {
+      reportError( "callBatch", retCode );
+      return TA_TSTSTREAM_BATCH_FAIL;
+   }
+
+   nbOut = nbOutput( test->func );
+
+   /* The integer output is compared as a double. */
+   if( test->func == STREAM_HT_TRENDMODE )
+   {
+      for( i=0; i < outNbElement; i++ )
+         batchOut[0][i] = (TA_Real)batchOutInteger[i];
+   }
+
+   retCode = stateInit( test, &state );
+   if( retCode != TA_SUCCESS )
+   {
+      reportError( "stateInit", retCode );
+      return TA_TSTSTREAM_INIT_FAIL;
+   }
+
+   for( bar=0; bar < (int)history->nbBars; bar++ )
+   {
+      retCode = stateUpdate( history, test, &state, bar, &outNBElement, out );
+      if( retCode != TA_SUCCESS )
+      {
+         reportError( "stateUpdate", retCode );
+         stateFree( test, &state );
+         return TA_TSTSTREAM_UPDATE_FAIL;
+      }
+
+      /* Outputs are expected from the first bar of the batch function. */
+      if( outNBElement != (bar >= outBegIdx) )
+      {
+         printf( "Fail: bar %d outNBElement %d (outBegIdx=%d)\n", bar, outNBElement, outBegIdx );
+         stateFree( test, &state );
+         return TA_TSTSTREAM_NBELEMENT_WRONG;
+      }
+
+      for( i=0; outNBElement && (i < nbOut); i++ )
+      {
+         if( out[i] != batchOut[i][bar-outBegIdx] )
+         {
+            printf( "Fail: bar %d output %d stream %.17g batch %.17g\n",
+                    bar, i, out[i], batchOut[i][bar-outBegIdx] );
+            stateFree( test, &state );
+            return TA_TSTSTREAM_VALUE_DIFF;
+         }
+      }
+   }
+
+   if( (int)history->nbBars - outBegIdx != outNbElement )
+   {
+      stateFree( test, &state );
+      return TA_TSTSTREAM_NBELEMENT_WRONG;
+   }
+
+   retCode = stateFree( test, &state );
+   if( retCode != TA_SUCCESS )
+      return TA_TSTSTREAM_FREE_FAIL;
+
+   return TA_TEST_PASS;
+}
+
+/* The phase, sine, trendline and trend mode of the shared state must
+ * be the ones of the batch functions.
+ */
+static ErrorNumber do_test_ht( const TA_History *history,
+                               unsigned int unstablePeriod )
+{
+   static TA_Real phase[2000], sine[2000], leadSine[2000], trendline[2000];
+   static TA_Integer trendMode[2000];
+   TA_HT_State *state;
+   TA_RetCode retCode;
+   TA_Integer outBegIdx[4], outNbElement;
+   TA_Real outDCPhase, outSine, outLeadSine, outTrendline;
+   int outNBElement, outTrendMode, bar, endIdx, i;
+
+   retCode = TA_SetUnstablePeriod( TA_FUNC_UNST_ALL, unstablePeriod );
+   if( retCode != TA_SUCCESS )
+      return TA_TEST_TFRR_SETUNSTABLE_PERIOD_FAIL;
+
+   endIdx = history->nbBars-1;
+   retCode = TA_HT_DCPHASE( 0, endIdx, history->close, &outBegIdx[0], &outNbElement, phase );
+   if( retCode == TA_SUCCESS )
+      retCode = TA_HT_SINE( 0, endIdx, history->close, &outBegIdx[1], &outNbElement, sine, leadSine );
+   if( retCode == TA_SUCCESS )
+      retCode = TA_HT_TRENDLINE( 0, endIdx, history->close, &outBegIdx[2], &outNbElement, trendline );
+   if( retCode == TA_SUCCESS )
+      retCode = TA_HT_TRENDMODE( 0, endIdx, history->close, &outBegIdx[3], &outNbElement, trendMode );
+   if( retCode != TA_SUCCESS )
+      return TA_TSTSTREAM_BATCH_FAIL;
+
+   /* All start on the same bar when their unstable periods are equal. */
+   for( i=1; i < 4; i++ )
+   {
+      if( outBegIdx[i] != outBegIdx[0] )
+         return TA_TSTSTREAM_BATCH_FAIL;
+   }
+
+   retCode = TA_HT_StateInit( &state );
+   if( retCode != TA_SUCCESS )
+      return TA_TSTSTREAM_INIT_FAIL;
+
+   for( bar=0; bar <= endIdx; bar++ )
+   {
+      retCode = TA_HT_StateUpdate( state, history->close[bar], &outNBElement,
+                                   NULL, &outDCPhase, NULL, NULL,
+                                   &outSine, &outLeadSine, &outTrendline,
+                                   &outTrendMode );
+      if( retCode != TA_SUCCESS )
+      {
+         TA_HT_StateFree( state );
+         return TA_TSTSTREAM_UPDATE_FAIL;
+      }
+
+      if( outNBElement != (bar >= outBegIdx[0]) )
+      {
+         TA_HT_StateFree( state );
+         return TA_TSTSTREAM_NBELEMENT_WRONG;
+      }
+
+      i = bar-outBegIdx[0];
+      if( outNBElement &&
+          ((outDCPhase   != phase[i])     ||
+           (outSine      != sine[i])      ||
+           (outLeadSine  != leadSine[i])  ||
+           (outTrendline != trendline[i]) ||
+           (outTrendMode != trendMode[i])) )
+      {
+         printf( "Fail: bar %d differs from the HT functions\n", bar );
+         TA_HT_StateFree( state );
+         return TA_TSTSTREAM_VALUE_DIFF;
+      }
+   }
+
+   retCode = TA_HT_StateFree( state );
+   if( retCode != TA_SUCCESS )
+      return TA_TSTSTREAM_FREE_FAIL;
+
+   return TA_TEST_PASS;
+}
+
+static int nbOutput( StreamFunc func )
+{
+   switch( func )
+   {
+   case STREAM_BBANDS:
+   case STREAM_MACD:
+   case STREAM_MACDFIX:
+   case STREAM_MACDEXT:
+      return 3;
+   case STREAM_MAMA:
+   case STREAM_STOCH:
+   case STREAM_STOCHF:
+   case STREAM_STOCHRSI:
+   case STREAM_AROON:
+   case STREAM_HT_PHASOR:
+   case STREAM_HT_SINE:
+      return 2;
+   default:
+      return 1;
+   }
+}
+
+static TA_RetCode callBatch( const TA_History *history,
+                             const TA_Test *test,
+                             TA_Integer *outBegIdx,
+                             TA_Integer *outNbElement )
+{
+   const TA_Integer *optInt;
+   const TA_Real *optReal;
+   const TA_Real *high, *low, *close;
+   int endIdx;
+
+   endIdx  = history->nbBars-1;
+   optInt  = test->optInInteger;
+   optReal = test->optInReal;
+   high    = history->high;
+   low     = history->low;
+   close   = history->close;
+
+   switch( test->func )
+   {
+   case STREAM_SMA:
+      return TA_SMA( 0, endIdx, close, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_EMA:
+      return TA_EMA( 0, endIdx, close, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_WMA:
+      return TA_WMA( 0, endIdx, close, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_DEMA:
+      return TA_DEMA( 0, endIdx, close, optInt[0],
+                      outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_TEMA:
+      return TA_TEMA( 0, endIdx, close, optInt[0],
+                      outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_TRIMA:
+      return TA_TRIMA( 0, endIdx, close, optInt[0],
+                       outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_KAMA:
+      return TA_KAMA( 0, endIdx, close, optInt[0],
+                      outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_T3:
+      return TA_T3( 0, endIdx, close, optInt[0], optReal[0],
+                    outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_MAMA:
+      return TA_MAMA( 0, endIdx, close, optReal[0], optReal[1],
+                      outBegIdx, outNbElement, batchOut[0], batchOut[1] );
+   case STREAM_MA:
+      return TA_MA( 0, endIdx, close, optInt[0], (TA_MAType)optInt[1],
+                    outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_BBANDS:
+      return TA_BBANDS( 0, endIdx, close, optInt[0],
+                        optReal[0], optReal[1], (TA_MAType)optInt[1],
+                        outBegIdx, outNbElement,
+                        batchOut[0], batchOut[1], batchOut[2] );
+   case STREAM_STDDEV:
+      return TA_STDDEV( 0, endIdx, close, optInt[0], optReal[0],
+                        outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_VAR:
+      return TA_VAR( 0, endIdx, close, optInt[0], optReal[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_SUM:
+      return TA_SUM( 0, endIdx, close, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_CORREL:
+      return TA_CORREL( 0, endIdx, high, low, optInt[0],
+                        outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_BETA:
+      return TA_BETA( 0, endIdx, high, low, optInt[0],
+                      outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_MACD:
+      return TA_MACD( 0, endIdx, close, optInt[0], optInt[1], optInt[2],
+                      outBegIdx, outNbElement,
+                      batchOut[0], batchOut[1], batchOut[2] );
+   case STREAM_MACDFIX:
+      return TA_MACDFIX( 0, endIdx, close, optInt[0],
+                         outBegIdx, outNbElement,
+                         batchOut[0], batchOut[1], batchOut[2] );
+   case STREAM_MACDEXT:
+      return TA_MACDEXT( 0, endIdx, close,
+                         optInt[0], (TA_MAType)optInt[1],
+                         optInt[2], (TA_MAType)optInt[3],
+                         optInt[4], (TA_MAType)optInt[5],
+                         outBegIdx, outNbElement,
+                         batchOut[0], batchOut[1], batchOut[2] );
+   case STREAM_APO:
+      return TA_APO( 0, endIdx, close, optInt[0], optInt[1], (TA_MAType)optInt[2],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_PPO:
+      return TA_PPO( 0, endIdx, close, optInt[0], optInt[1], (TA_MAType)optInt[2],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_RSI:
+      return TA_RSI( 0, endIdx, close, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_CMO:
+      return TA_CMO( 0, endIdx, close, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_MOM:
+      return TA_MOM( 0, endIdx, close, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_ROC:
+      return TA_ROC( 0, endIdx, close, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_ROCP:
+      return TA_ROCP( 0, endIdx, close, optInt[0],
+                      outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_ROCR:
+      return TA_ROCR( 0, endIdx, close, optInt[0],
+                      outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_ROCR100:
+      return TA_ROCR100( 0, endIdx, close, optInt[0],
+                         outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_TRIX:
+      return TA_TRIX( 0, endIdx, close, optInt[0],
+                      outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_MFI:
+      return TA_MFI( 0, endIdx, high, low, close, history->volume, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_AD:
+      return TA_AD( 0, endIdx, high, low, close, history->volume,
+                    outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_ADOSC:
+      return TA_ADOSC( 0, endIdx, high, low, close, history->volume,
+                       optInt[0], optInt[1],
+                       outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_OBV:
+      return TA_OBV( 0, endIdx, close, history->volume,
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_WILLR:
+      return TA_WILLR( 0, endIdx, high, low, close, optInt[0],
+                       outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_STOCH:
+      return TA_STOCH( 0, endIdx, high, low, close,
+                       optInt[0], optInt[1], (TA_MAType)optInt[2],
+                       optInt[3], (TA_MAType)optInt[4],
+                       outBegIdx, outNbElement, batchOut[0], batchOut[1] );
+   case STREAM_STOCHF:
+      return TA_STOCHF( 0, endIdx, high, low, close,
+                        optInt[0], optInt[1], (TA_MAType)optInt[2],
+                        outBegIdx, outNbElement, batchOut[0], batchOut[1] );
+   case STREAM_STOCHRSI:
+      return TA_STOCHRSI( 0, endIdx, close,
+                          optInt[0], optInt[1], optInt[2], (TA_MAType)optInt[3],
+                          outBegIdx, outNbElement, batchOut[0], batchOut[1] );
+   case STREAM_MAX:
+      return TA_MAX( 0, endIdx, close, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_MIN:
+      return TA_MIN( 0, endIdx, close, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_MIDPOINT:
+      return TA_MIDPOINT( 0, endIdx, close, optInt[0],
+                          outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_MIDPRICE:
+      return TA_MIDPRICE( 0, endIdx, high, low, optInt[0],
+                          outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_AROON:
+      return TA_AROON( 0, endIdx, high, low, optInt[0],
+                       outBegIdx, outNbElement, batchOut[0], batchOut[1] );
+   case STREAM_AROONOSC:
+      return TA_AROONOSC( 0, endIdx, high, low, optInt[0],
+                          outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_TRANGE:
+      return TA_TRANGE( 0, endIdx, high, low, close,
+                        outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_ATR:
+      return TA_ATR( 0, endIdx, high, low, close, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_NATR:
+      return TA_NATR( 0, endIdx, high, low, close, optInt[0],
+                      outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_CCI:
+      return TA_CCI( 0, endIdx, high, low, close, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_ULTOSC:
+      return TA_ULTOSC( 0, endIdx, high, low, close,
+                        optInt[0], optInt[1], optInt[2],
+                        outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_ADX:
+      return TA_ADX( 0, endIdx, high, low, close, optInt[0],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_ADXR:
+      return TA_ADXR( 0, endIdx, high, low, close, optInt[0],
+                      outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_DX:
+      return TA_DX( 0, endIdx, high, low, close, optInt[0],
+                    outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_PLUS_DI:
+      return TA_PLUS_DI( 0, endIdx, high, low, close, optInt[0],
+                         outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_MINUS_DI:
+      return TA_MINUS_DI( 0, endIdx, high, low, close, optInt[0],
+                          outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_PLUS_DM:
+      return TA_PLUS_DM( 0, endIdx, high, low, optInt[0],
+                         outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_MINUS_DM:
+      return TA_MINUS_DM( 0, endIdx, high, low, optInt[0],
+                          outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_SAR:
+      return TA_SAR( 0, endIdx, high, low, optReal[0], optReal[1],
+                     outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_SAREXT:
+      return TA_SAREXT( 0, endIdx, high, low,
+                        optReal[0], optReal[1], optReal[2], optReal[3],
+                        optReal[4], optReal[5], optReal[6], optReal[7],
+                        outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_HT_DCPERIOD:
+      return TA_HT_DCPERIOD( 0, endIdx, close,
+                             outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_HT_DCPHASE:
+      return TA_HT_DCPHASE( 0, endIdx, close,
+                            outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_HT_PHASOR:
+      return TA_HT_PHASOR( 0, endIdx, close,
+                           outBegIdx, outNbElement, batchOut[0], batchOut[1] );
+   case STREAM_HT_SINE:
+      return TA_HT_SINE( 0, endIdx, close,
+                         outBegIdx, outNbElement, batchOut[0], batchOut[1] );
+   case STREAM_HT_TRENDLINE:
+      return TA_HT_TRENDLINE( 0, endIdx, close,
+                              outBegIdx, outNbElement, batchOut[0] );
+   case STREAM_HT_TRENDMODE:
+      return TA_HT_TRENDMODE( 0, endIdx, close,
+                              outBegIdx, outNbElement, batchOutInteger );
+   }
+
+   return TA_BAD_PARAM;
+}
+
+static TA_RetCode stateInit( const TA_Test *test, TA_AnyState *state )
+{
+   const TA_Integer *optInt;
+   const TA_Real *optReal;
+
+   optInt  = test->optInInteger;
+   optReal = test->optInReal;
+
+   switch( test->func )
+   {
+   case STREAM_SMA:
+      return TA_SMA_StateInit( &state->sma, optInt[0] );
+   case STREAM_EMA:
+      return TA_EMA_StateInit( &state->ema, optInt[0] );
+   case STREAM_WMA:
+      return TA_WMA_StateInit( &state->wma, optInt[0] );
+   case STREAM_DEMA:
+      return TA_DEMA_StateInit( &state->dema, optInt[0] );
+   case STREAM_TEMA:
+      return TA_TEMA_StateInit( &state->tema, optInt[0] );
+   case STREAM_TRIMA:
+      return TA_TRIMA_StateInit( &state->trima, optInt[0] );
+   case STREAM_KAMA:
+      return TA_KAMA_StateInit( &state->kama, optInt[0] );
+   case STREAM_T3:
+      return TA_T3_StateInit( &state->t3, optInt[0], optReal[0] );
+   case STREAM_MAMA:
+      return TA_MAMA_StateInit( &state->mama, optReal[0], optReal[1] );
+   case STREAM_MA:
+      return TA_MA_StateInit( &state->ma, optInt[0], (TA_MAType)optInt[1] );
+   case STREAM_BBANDS:
+      return TA_BBANDS_StateInit( &state->bbands, optInt[0],
+                                  optReal[0], optReal[1], (TA_MAType)optInt[1] );
+   case STREAM_STDDEV:
+      return TA_STDDEV_StateInit( &state->stddev, optInt[0], optReal[0] );
+   case STREAM_VAR:
+      return TA_VAR_StateInit( &state->var, optInt[0], optReal[0] );
+   case STREAM_SUM:
+      return TA_SUM_StateInit( &state->sum, optInt[0] );
+   case STREAM_CORREL:
+      return TA_CORREL_StateInit( &state->correl, optInt[0] );
+   case STREAM_BETA:
+      return TA_BETA_StateInit( &state->beta, optInt[0] );
+   case STREAM_MACD:
+      return TA_MACD_StateInit( &state->macd, optInt[0], optInt[1], optInt[2] );
+   case STREAM_MACDFIX:
+      return TA_MACDFIX_StateInit( &state->macdfix, optInt[0] );
+   case STREAM_MACDEXT:
+      return TA_MACDEXT_StateInit( &state->macdext,
+                                   optInt[0], (TA_MAType)optInt[1],
+                                   optInt[2], (TA_MAType)optInt[3],
+                                   optInt[4], (TA_MAType)optInt[5] );
+   case STREAM_APO:
+      return TA_APO_StateInit( &state->apo, optInt[0], optInt[1], (TA_MAType)optInt[2] );
+   case STREAM_PPO:
+      return TA_PPO_StateInit( &state->ppo, optInt[0], optInt[1], (TA_MAType)optInt[2] );
+   case STREAM_RSI:
+      return TA_RSI_StateInit( &state->rsi, optInt[0] );
+   case STREAM_CMO:
+      return TA_CMO_StateInit( &state->cmo, optInt[0] );
+   case STREAM_MOM:
+      return TA_MOM_StateInit( &state->mom, optInt[0] );
+   case STREAM_ROC:
+      return TA_ROC_StateInit( &state->roc, optInt[0] );
+   case STREAM_ROCP:
+      return TA_ROCP_StateInit( &state->rocp, optInt[0] );
+   case STREAM_ROCR:
+      return TA_ROCR_StateInit( &state->rocr, optInt[0] );
+   case STREAM_ROCR100:
+      return TA_ROCR100_StateInit( &state->rocr100, optInt[0] );
+   case STREAM_TRIX:
+      return TA_TRIX_StateInit( &state->trix, optInt[0] );
+   case STREAM_MFI:
+      return TA_MFI_StateInit( &state->mfi, optInt[0] );
+   case STREAM_AD:
+      return TA_AD_StateInit( &state->ad );
+   case STREAM_ADOSC:
+      return TA_ADOSC_StateInit( &state->adosc, optInt[0], optInt[1] );
+   case STREAM_OBV:
+      return TA_OBV_StateInit( &state->obv );
+   case STREAM_WILLR:
+      return TA_WILLR_StateInit( &state->willr, optInt[0] );
+   case STREAM_STOCH:
+      return TA_STOCH_StateInit( &state->stoch, optInt[0],
+                                 optInt[1], (TA_MAType)optInt[2],
+                                 optInt[3], (TA_MAType)optInt[4] );
+   case STREAM_STOCHF:
+      return TA_STOCHF_StateInit( &state->stochf, optInt[0],
+                                  optInt[1], (TA_MAType)optInt[2] );
+   case STREAM_STOCHRSI:
+      return TA_STOCHRSI_StateInit( &state->stochrsi, optInt[0],
+                                    optInt[1], optInt[2], (TA_MAType)optInt[3] );
+   case STREAM_MAX:
+      return TA_MAX_StateInit( &state->max, optInt[0] );
+   case STREAM_MIN:
+      return TA_MIN_StateInit( &state->min, optInt[0] );
+   case STREAM_MIDPOINT:
+      return TA_MIDPOINT_StateInit( &state->midpoint, optInt[0] );
+   case STREAM_MIDPRICE:
+      return TA_MIDPRICE_StateInit( &state->midprice, optInt[0] );
+   case STREAM_AROON:
+      return TA_AROON_StateInit( &state->aroon, optInt[0] );
+   case STREAM_AROONOSC:
+      return TA_AROONOSC_StateInit( &state->aroonosc, optInt[0] );
+   case STREAM_TRANGE:
+      return TA_TRANGE_StateInit( &state->trange );
+   case STREAM_ATR:
+      return TA_ATR_StateInit( &state->atr, optInt[0] );
+   case STREAM_NATR:
+      return TA_NATR_StateInit( &state->natr, optInt[0] );
+   case STREAM_CCI:
+      return TA_CCI_StateInit( &state->cci, optInt[0] );
+   case STREAM_ULTOSC:
+      return TA_ULTOSC_StateInit( &state->ultosc, optInt[0], optInt[1], optInt[2] );
+   case STREAM_ADX:
+      return TA_ADX_StateInit( &state->adx, optInt[0] );
+   case STREAM_ADXR:
+      return TA_ADXR_StateInit( &state->adxr, optInt[0] );
+   case STREAM_DX:
+      return TA_DX_StateInit( &state->dx, optInt[0] );
+   case STREAM_PLUS_DI:
+      return TA_PLUS_DI_StateInit( &state->plusDI, optInt[0] );
+   case STREAM_MINUS_DI:
+      return TA_MINUS_DI_StateInit( &state->minusDI, optInt[0] );
+   case STREAM_PLUS_DM:
+      return TA_PLUS_DM_StateInit( &state->plusDM, optInt[0] );
+   case STREAM_MINUS_DM:
+      return TA_MINUS_DM_StateInit( &state->minusDM, optInt[0] );
+   case STREAM_SAR:
+      return TA_SAR_StateInit( &state->sar, optReal[0], optReal[1] );
+   case STREAM_SAREXT:
+      return TA_SAREXT_StateInit( &state->sarext,
+                                  optReal[0], optReal[1], optReal[2], optReal[3],
+                                  optReal[4], optReal[5], optReal[6], optReal[7] );
+   case STREAM_HT_DCPERIOD:
+      return TA_HT_DCPERIOD_StateInit( &state->htDCPeriod );
+   case STREAM_HT_DCPHASE:
+      return TA_HT_DCPHASE_StateInit( &state->htDCPhase );
+   case STREAM_HT_PHASOR:
+      return TA_HT_PHASOR_StateInit( &state->htPhasor );
+   case STREAM_HT_SINE:
+      return TA_HT_SINE_StateInit( &state->htSine );
+   case STREAM_HT_TRENDLINE:
+      return TA_HT_TRENDLINE_StateInit( &state->htTrendline );
+   case STREAM_HT_TRENDMODE:
+      return TA_HT_TRENDMODE_StateInit( &state->htTrendMode );
+   }
+
+   return TA_BAD_PARAM;
+}
+
+static TA_RetCode stateUpdate( const TA_History *history,
+                               const TA_Test *test,
+                               TA_AnyState *state,
+                               int bar,
+                               int *outNBElement,
+                               TA_Real out[3] )
+{
+   TA_Real high, low, close;
+   TA_RetCode retCode;
+   TA_Integer outInteger;
+
+   high  = history->high[bar];
+   low   = history->low[bar];
+   close = history->close[bar];
+
+   switch( test->func )
+   {
+   case STREAM_SMA:
+      return TA_SMA_StateUpdate( state->sma, close, outNBElement, &out[0] );
+   case STREAM_EMA:
+      return TA_EMA_StateUpdate( state->ema, close, outNBElement, &out[0] );
+   case STREAM_WMA:
+      return TA_WMA_StateUpdate( state->wma, close, outNBElement, &out[0] );
+   case STREAM_DEMA:
+      return TA_DEMA_StateUpdate( state->dema, close, outNBElement, &out[0] );
+   case STREAM_TEMA:
+      return TA_TEMA_StateUpdate( state->tema, close, outNBElement, &out[0] );
+   case STREAM_TRIMA:
+      return TA_TRIMA_StateUpdate( state->trima, close, outNBElement, &out[0] );
+   case STREAM_KAMA:
+      return TA_KAMA_StateUpdate( state->kama, close, outNBElement, &out[0] );
+   case STREAM_T3:
+      return TA_T3_StateUpdate( state->t3, close, outNBElement, &out[0] );
+   case STREAM_MAMA:
+      return TA_MAMA_StateUpdate( state->mama, close, outNBElement,
+                                  &out[0], &out[1] );
+   case STREAM_MA:
+      return TA_MA_StateUpdate( state->ma, close, outNBElement, &out[0] );
+   case STREAM_BBANDS:
+      return TA_BBANDS_StateUpdate( state->bbands, close, outNBElement,
+                                    &out[0], &out[1], &out[2] );
+   case STREAM_STDDEV:
+      return TA_STDDEV_StateUpdate( state->stddev, close, outNBElement, &out[0] );
+   case STREAM_VAR:
+      return TA_VAR_StateUpdate( state->var, close, outNBElement, &out[0] );
+   case STREAM_SUM:
+      return TA_SUM_StateUpdate( state->sum, close, outNBElement, &out[0] );
+   case STREAM_CORREL:
+      return TA_CORREL_StateUpdate( state->correl, high, low, outNBElement, &out[0] );
+   case STREAM_BETA:
+      return TA_BETA_StateUpdate( state->beta, high, low, outNBElement, &out[0] );
+   case STREAM_MACD:
+      return TA_MACD_StateUpdate( state->macd, close, outNBElement,
+                                  &out[0], &out[1], &out[2] );
+   case STREAM_MACDFIX:
+      return TA_MACDFIX_StateUpdate( state->macdfix, close, outNBElement,
+                                     &out[0], &out[1], &out[2] );
+   case STREAM_MACDEXT:
+      return TA_MACDEXT_StateUpdate( state->macdext, close, outNBElement,
+                                     &out[0], &out[1], &out[2] );
+   case STREAM_APO:
+      return TA_APO_StateUpdate( state->apo, close, outNBElement, &out[0] );
+   case STREAM_PPO:
+      return TA_PPO_StateUpdate( state->ppo, close, outNBElement, &out[0] );
+   case STREAM_RSI:
+      return TA_RSI_StateUpdate( state->rsi, close, outNBElement, &out[0] );
+   case STREAM_CMO:
+      return TA_CMO_StateUpdate( state->cmo, close, outNBElement, &out[0] );
+   case STREAM_MOM:
+      return TA_MOM_StateUpdate( state->mom, close, outNBElement, &out[0] );
+   case STREAM_ROC:
+      return TA_ROC_StateUpdate( state->roc, close, outNBElement, &out[0] );
+   case STREAM_ROCP:
+      return TA_ROCP_StateUpdate( state->rocp, close, outNBElement, &out[0] );
+   case STREAM_ROCR:
+      return TA_ROCR_StateUpdate( state->rocr, close, outNBElement, &out[0] );
+   case STREAM_ROCR100:
+      return TA_ROCR100_StateUpdate( state->rocr100, close, outNBElement, &out[0] );
+   case STREAM_TRIX:
+      return TA_TRIX_StateUpdate( state->trix, close, outNBElement, &out[0] );
+   case STREAM_MFI:
+      return TA_MFI_StateUpdate( state->mfi, high, low, close, history->volume[bar],
+                                 outNBElement, &out[0] );
+   case STREAM_AD:
+      return TA_AD_StateUpdate( state->ad, high, low, close, history->volume[bar],
+                                outNBElement, &out[0] );
+   case STREAM_ADOSC:
+      return TA_ADOSC_StateUpdate( state->adosc, high, low, close, history->volume[bar],
+                                   outNBElement, &out[0] );
+   case STREAM_OBV:
+      return TA_OBV_StateUpdate( state->obv, close, history->volume[bar],
+                                 outNBElement, &out[0] );
+   case STREAM_WILLR:
+      return TA_WILLR_StateUpdate( state->willr, high, low, close, outNBElement, &out[0] );
+   case STREAM_STOCH:
+      return TA_STOCH_StateUpdate( state->stoch, high, low, close, outNBElement,
+                                   &out[0], &out[1] );
+   case STREAM_STOCHF:
+      return TA_STOCHF_StateUpdate( state->stochf, high, low, close, outNBElement,
+                                    &out[0], &out[1] );
+   case STREAM_STOCHRSI:
+      return TA_STOCHRSI_StateUpdate( state->stochrsi, close, outNBElement,
+                                      &out[0], &out[1] );
+   case STREAM_MAX:
+      return TA_MAX_StateUpdate( state->max, close, outNBElement, &out[0] );
+   case STREAM_MIN:
+      return TA_MIN_StateUpdate( state->min, close, outNBElement, &out[0] );
+   case STREAM_MIDPOINT:
+      return TA_MIDPOINT_StateUpdate( state->midpoint, close, outNBElement, &out[0] );
+   case STREAM_MIDPRICE:
+      return TA_MIDPRICE_StateUpdate( state->midprice, high, low, outNBElement, &out[0] );
+   case STREAM_AROON:
+      return TA_AROON_StateUpdate( state->aroon, high, low, outNBElement,
+                                   &out[0], &out[1] );
+   case STREAM_AROONOSC:
+      return TA_AROONOSC_StateUpdate( state->aroonosc, high, low, outNBElement, &out[0] );
+   case STREAM_TRANGE:
+      return TA_TRANGE_StateUpdate( state->trange, high, low, close, outNBElement, &out[0] );
+   case STREAM_ATR:
+      return TA_ATR_StateUpdate( state->atr, high, low, close, outNBElement, &out[0] );
+   case STREAM_NATR:
+      return TA_NATR_StateUpdate( state->natr, high, low, close, outNBElement, &out[0] );
+   case STREAM_CCI:
+      return TA_CCI_StateUpdate( state->cci, high, low, close, outNBElement, &out[0] );
+   case STREAM_ULTOSC:
+      return TA_ULTOSC_StateUpdate( state->ultosc, high, low, close, outNBElement, &out[0] );
+   case STREAM_ADX:
+      return TA_ADX_StateUpdate( state->adx, high, low, close, outNBElement, &out[0] );
+   case STREAM_ADXR:
+      return TA_ADXR_StateUpdate( state->adxr, high, low, close, outNBElement, &out[0] );
+   case STREAM_DX:
+      return TA_DX_StateUpdate( state->dx, high, low, close, outNBElement, &out[0] );
+   case STREAM_PLUS_DI:
+      return TA_PLUS_DI_StateUpdate( state->plusDI, high, low, close, outNBElement, &out[0] );
+   case STREAM_MINUS_DI:
+      return TA_MINUS_DI_StateUpdate( state->minusDI, high, low, close, outNBElement, &out[0] );
+   case STREAM_PLUS_DM:
+      return TA_PLUS_DM_StateUpdate( state->plusDM, high, low, outNBElement, &out[0] );
+   case STREAM_MINUS_DM:
+      return TA_MINUS_DM_StateUpdate( state->minusDM, high, low, outNBElement, &out[0] );
+   case STREAM_SAR:
+      return TA_SAR_StateUpdate( state->sar, high, low, outNBElement, &out[0] );
+   case STREAM_SAREXT:
+      return TA_SAREXT_StateUpdate( state->sarext, high, low, outNBElement, &out[0] );
+   case STREAM_HT_DCPERIOD:
+      return TA_HT_DCPERIOD_StateUpdate( state->htDCPeriod, close, outNBElement, &out[0] );
+   case STREAM_HT_DCPHASE:
+      return TA_HT_DCPHASE_StateUpdate( state->htDCPhase, close, outNBElement, &out[0] );
+   case STREAM_HT_PHASOR:
+      return TA_HT_PHASOR_StateUpdate( state->htPhasor, close, outNBElement,
+                                       &out[0], &out[1] );
+   case STREAM_HT_SINE:
+      return TA_HT_SINE_StateUpdate( state->htSine, close, outNBElement,
+                                     &out[0], &out[1] );
+   case STREAM_HT_TRENDLINE:
+      return TA_HT_TRENDLINE_StateUpdate( state->htTrendline, close, outNBElement, &out[0] );
+   case STREAM_HT_TRENDMODE:
+      retCode = TA_HT_TRENDMODE_StateUpdate( state->htTrendMode, close, outNBElement, &outInteger );
+      out[0] = (TA_Real)outInteger;
+      return retCode;
+   }
+
+   return TA_BAD_PARAM;
+}
+
+static TA_RetCode stateFree( const TA_Test *test, TA_AnyState *state )
+{
+   switch( test->func )
+   {
+   case STREAM_SMA:      return TA_SMA_StateFree( state->sma );
+   case STREAM_EMA:      return TA_EMA_StateFree( state->ema );
+   case STREAM_WMA:      return TA_WMA_StateFree( state->wma );
+   case STREAM_DEMA:     return TA_DEMA_StateFree( state->dema );
+   case STREAM_TEMA:     return TA_TEMA_StateFree( state->tema );
+   case STREAM_TRIMA:    return TA_TRIMA_StateFree( state->trima );
+   case STREAM_KAMA:     return TA_KAMA_StateFree( state->kama );
+   case STREAM_T3:       return TA_T3_StateFree( state->t3 );
+   case STREAM_MAMA:     return TA_MAMA_StateFree( state->mama );
+   case STREAM_MA:       return TA_MA_StateFree( state->ma );
+   case STREAM_BBANDS:   return TA_BBANDS_StateFree( state->bbands );
+   case STREAM_STDDEV:   return TA_STDDEV_StateFree( state->stddev );
+   case STREAM_VAR:      return TA_VAR_StateFree( state->var );
+   case STREAM_SUM:      return TA_SUM_StateFree( state->sum );
+   case STREAM_CORREL:   return TA_CORREL_StateFree( state->correl );
+   case STREAM_BETA:     return TA_BETA_StateFree( state->beta );
+   case STREAM_MACD:     return TA_MACD_StateFree( state->macd );
+   case STREAM_MACDFIX:  return TA_MACDFIX_StateFree( state->macdfix );
+   case STREAM_MACDEXT:  return TA_MACDEXT_StateFree( state->macdext );
+   case STREAM_APO:      return TA_APO_StateFree( state->apo );
+   case STREAM_PPO:      return TA_PPO_StateFree( state->ppo );
+   case STREAM_RSI:      return TA_RSI_StateFree( state->rsi );
+   case STREAM_CMO:      return TA_CMO_StateFree( state->cmo );
+   case STREAM_MOM:      return TA_MOM_StateFree( state->mom );
+   case STREAM_ROC:      return TA_ROC_StateFree( state->roc );
+   case STREAM_ROCP:     return TA_ROCP_StateFree( state->rocp );
+   case STREAM_ROCR:     return TA_ROCR_StateFree( state->rocr );
+   case STREAM_ROCR100:  return TA_ROCR100_StateFree( state->rocr100 );
+   case STREAM_TRIX:     return TA_TRIX_StateFree( state->trix );
+   case STREAM_MFI:      return TA_MFI_StateFree( state->mfi );
+   case STREAM_AD:       return TA_AD_StateFree( state->ad );
+   case STREAM_ADOSC:    return TA_ADOSC_StateFree( state->adosc );
+   case STREAM_OBV:      return TA_OBV_StateFree( state->obv );
+   case STREAM_WILLR:    return TA_WILLR_StateFree( state->willr );
+   case STREAM_STOCH:    return TA_STOCH_StateFree( state->stoch );
+   case STREAM_STOCHF:   return TA_STOCHF_StateFree( state->stochf );
+   case STREAM_STOCHRSI: return TA_STOCHRSI_StateFree( state->stochrsi );
+   case STREAM_MAX:      return TA_MAX_StateFree( state->max );
+   case STREAM_MIN:      return TA_MIN_StateFree( state->min );
+   case STREAM_MIDPOINT: return TA_MIDPOINT_StateFree( state->midpoint );
+   case STREAM_MIDPRICE: return TA_MIDPRICE_StateFree( state->midprice );
+   case STREAM_AROON:    return TA_AROON_StateFree( state->aroon );
+   case STREAM_AROONOSC: return TA_AROONOSC_StateFree( state->aroonosc );
+   case STREAM_TRANGE:   return TA_TRANGE_StateFree( state->trange );
+   case STREAM_ATR:      return TA_ATR_StateFree( state->atr );
+   case STREAM_NATR:     return TA_NATR_StateFree( state->natr );
+   case STREAM_CCI:      return TA_CCI_StateFree( state->cci );
+   case STREAM_ULTOSC:   return TA_ULTOSC_StateFree( state->ultosc );
+   case STREAM_ADX:      return TA_ADX_StateFree( state->adx );
+   case STREAM_ADXR:     return TA_ADXR_StateFree( state->adxr );
+   case STREAM_DX:       return TA_DX_StateFree( state->dx );
+   case STREAM_PLUS_DI:  return TA_PLUS_DI_StateFree( state->plusDI );
+   case STREAM_MINUS_DI: return TA_MINUS_DI_StateFree( state->minusDI );
+   case STREAM_PLUS_DM:  return TA_PLUS_DM_StateFree( state->plusDM );
+   case STREAM_MINUS_DM: return TA_MINUS_DM_StateFree( state->minusDM );
+   case STREAM_SAR:      return TA_SAR_StateFree( state->sar );
+   case STREAM_SAREXT:   return TA_SAREXT_StateFree( state->sarext );
+   case STREAM_HT_DCPERIOD:  return TA_HT_DCPERIOD_StateFree( state->htDCPeriod );
+   case STREAM_HT_DCPHASE:   return TA_HT_DCPHASE_StateFree( state->htDCPhase );
+   case STREAM_HT_PHASOR:    return TA_HT_PHASOR_StateFree( state->htPhasor );
+   case STREAM_HT_SINE:      return TA_HT_SINE_StateFree( state->htSine );
+   case STREAM_HT_TRENDLINE: return TA_HT_TRENDLINE_StateFree( state->htTrendline );
+   case STREAM_HT_TRENDMODE: return TA_HT_TRENDMODE_StateFree( state->htTrendMode );
+   }
+
+   return TA_BAD_PARAM;
+}
@@ -23,6 +23,7 @@ typedef struct
 } TA_History;
 
 ErrorNumber test_internals( void );
+ErrorNumber test_context( void );
 ErrorNumber test_abstract( void );
 
 ErrorNumber freeLib( void );
@@ -0,0 +1,306 @@
+/* TA-LIB Copyright (c) 1999-2007, Mario Fortier
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in
+ *   the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * - Neither name of author nor the names of its contributors
+ *   may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Description:
+ *    Two threads, each on its own TA_Context with a different unstable
+ *    period, call TA_EMA and TA_RSI at the same time. Each must get the
+ *    outputs of a single-threaded call with its own unstable period.
+ *
+ *    Also verify that TA_Initialize and TA_Shutdown leave the context
+ *    bound to the calling thread alone.
+ */
+
+/**** Headers ****/
+#ifdef WIN32
+#include "windows.h"
+#else
+#include <pthread.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ta_test_priv.h"
+#include "ta_common.h"
+#include "ta_func.h"
+
+/**** External functions declarations. ****/
+/* None */
+
+/**** External variables declarations. ****/
+extern double gDataClose[];
+
+/**** Global variables definitions.    ****/
+/* None */
+
+/**** Local declarations.              ****/
+#define NB_BAR    1000
+#define NB_THREAD 2
+#define NB_REPEAT 200
+
+typedef struct
+{
+   int unstablePeriod;
+
+   /* Single-threaded outputs for this unstable period. */
+   TA_Integer expectedBegIdx[2];
+   TA_Integer expectedNbElement[2];
+   TA_Real    expected[2][NB_BAR];
+
+   TA_Context *context;
+   TA_Real     out[NB_BAR];
+   ErrorNumber result;
+} ThreadTest;
+
+/**** Local functions declarations.    ****/
+static ErrorNumber testBoundContext( void );
+static ErrorNumber testParallelContexts( void );
+static TA_RetCode callFunction( int func, TA_Integer *outBegIdx, TA_Integer *outNbElement, TA_Real *out );
+static void runThreadTest( ThreadTest *test );
+
+#ifdef WIN32
+static DWORD WINAPI threadMain( LPVOID arg );
+#else
+static void *threadMain( void *arg );
+#endif
+
+/**** Local variables definitions.     ****/
+static ThreadTest threadTest[NB_THREAD];
+
+/**** Global functions definitions.   ****/
+ErrorNumber test_context( void )
+{
+   ErrorNumber retValue;
+
+   printf( "Testing per-thread contexts\n" );
+
+   retValue = testBoundContext();
+   if( retValue != TA_TEST_PASS )
+   {
+      printf( "\nFailed: Bound context test (%d)\n", retValue );
+      return retValue;
+   }
+
+   retValue = testParallelContexts();
+   if( retValue != TA_TEST_PASS )
+   {
+      printf( "\nFailed: Parallel contexts test (%d)\n", retValue );
+      return retValue;
+   }
+
+   return TA_TEST_PASS;
+}
+
+/**** Local functions definitions.     ****/
+static ErrorNumber testBoundContext( void )
+{
+   ErrorNumber retValue;
+   TA_Context *context;
+
+   retValue = allocLib();
+   if( retValue != TA_TEST_PASS )
+      return retValue;
+
+   if( TA_ContextAlloc( &context ) != TA_SUCCESS )
+      return TA_INTERNAL_CONTEXT_FAIL_0;
+
+   TA_SetThreadContext( context );
+   TA_SetUnstablePeriod( TA_FUNC_UNST_EMA, 7 );
+
+   /* Reinitializing resets the shared settings only. */
+   freeLib();
+   retValue = allocLib();
+   if( retValue != TA_TEST_PASS )
+      return retValue;
+
+   if( TA_GetUnstablePeriod( TA_FUNC_UNST_EMA ) != 7 )
+   {
+      printf( "\nFailed: TA_Initialize unbound the thread context\n" );
+      return TA_INTERNAL_CONTEXT_FAIL_1;
+   }
+
+   TA_SetThreadContext( NULL );
+   if( TA_GetUnstablePeriod( TA_FUNC_UNST_EMA ) != 0 )
+   {
+      printf( "\nFailed: The context settings leaked in the shared ones\n" );
+      return TA_INTERNAL_CONTEXT_FAIL_1;
+   }
+
+   TA_ContextFree( context );
+
+   return freeLib();
+}
+
+static ErrorNumber testParallelContexts( void )
+{
+   ErrorNumber retValue;
+   ThreadTest *test;
+   TA_RetCode retCode;
+   int i, func;
+   #ifdef WIN32
+      HANDLE thread[NB_THREAD];
+   #else
+      pthread_t thread[NB_THREAD];
+   #endif
+
+   retValue = allocLib();
+   if( retValue != TA_TEST_PASS )
+      return retValue;
+
+   /* The expected outputs, one unstable period at a time. */
+   for( i=0; i < NB_THREAD; i++ )
+   {
+      test = &threadTest[i];
+      test->unstablePeriod = i*40;
+      TA_SetUnstablePeriod( TA_FUNC_UNST_ALL, test->unstablePeriod );
+      for( func=0; func < 2; func++ )
+      {
+         retCode = callFunction( func, &test->expectedBegIdx[func],
+                                 &test->expectedNbElement[func],
+                                 test->expected[func] );
+         if( retCode != TA_SUCCESS )
+         {
+            reportError( "callFunction", retCode );
+            return TA_INTERNAL_CONTEXT_FAIL_2;
+         }
+      }
+   }
+   TA_SetUnstablePeriod( TA_FUNC_UNST_ALL, 0 );
+
+   /* Each context is a copy of the shared settings, which are
+    * changed by its own thread only.
+    */
+   for( i=0; i < NB_THREAD; i++ )
+   {
+      test = &threadTest[i];
+      test->result = TA_TEST_PASS;
+      if( TA_ContextAlloc( &test->context ) != TA_SUCCESS )
+         return TA_INTERNAL_CONTEXT_FAIL_0;
+   }
+
+   for( i=0; i < NB_THREAD; i++ )
+   {
+      #ifdef WIN32
+         thread[i] = CreateThread( NULL, 0, threadMain, &threadTest[i], 0, NULL );
+         if( !thread[i] )
+            return TA_INTERNAL_CONTEXT_FAIL_3;
+      #else
+         if( pthread_create( &thread[i], NULL, threadMain, &threadTest[i] ) != 0 )
+            return TA_INTERNAL_CONTEXT_FAIL_3;
+      #endif
+   }
+
+   retValue = TA_TEST_PASS;
+   for( i=0; i < NB_THREAD; i++ )
+   {
+      #ifdef WIN32
+         WaitForSingleObject( thread[i], INFINITE );
+         CloseHandle( thread[i] );
+      #else
+         pthread_join( thread[i], NULL );
+      #endif
+
+      test = &threadTest[i];
+      TA_ContextFree( test->context );
+      if( test->result != TA_TEST_PASS )
+      {
+         printf( "\nFailed: Thread with unstable period %d (%d)\n",
+                 test->unstablePeriod, test->result );
+         retValue = test->result;
+      }
+   }
+
+   if( retValue != TA_TEST_PASS )
+      return retValue;
+
+   /* The threads never touched the shared settings. */
+   if( TA_GetUnstablePeriod( TA_FUNC_UNST_EMA ) != 0 )
+      return TA_INTERNAL_CONTEXT_FAIL_1;
+
+   return freeLib();
+}
+
+static TA_RetCode callFunction( int func, TA_Integer *outBegIdx, TA_Integer *outNbElement, TA_Real *out )
+{
+   if( func == 0 )
+      return TA_EMA( 0, NB_BAR-1, gDataClose, 30, outBegIdx, outNbElement, out );
+
+   return TA_RSI( 0, NB_BAR-1, gDataClose, 14, outBegIdx, outNbElement, out );
+}
+
+static void runThreadTest( ThreadTest *test )
+{
+   TA_Integer outBegIdx, outNbElement;
+   TA_RetCode retCode;
+   int i, func;
+
+   if( TA_SetThreadContext( test->context ) != TA_SUCCESS )
+   {
+      test->result = TA_INTERNAL_CONTEXT_FAIL_3;
+      return;
+   }
+   TA_SetUnstablePeriod( TA_FUNC_UNST_ALL, test->unstablePeriod );
+
+   for( i=0; i < NB_REPEAT; i++ )
+   {
+      for( func=0; func < 2; func++ )
+      {
+         retCode = callFunction( func, &outBegIdx, &outNbElement, test->out );
+         if( (retCode != TA_SUCCESS) ||
+             (outBegIdx != test->expectedBegIdx[func]) ||
+             (outNbElement != test->expectedNbElement[func]) ||
+             memcmp( test->out, test->expected[func], outNbElement*sizeof(TA_Real) ) )
+         {
+            test->result = TA_INTERNAL_CONTEXT_FAIL_4;
+            TA_SetThreadContext( NULL );
+            return;
+         }
+      }
+   }
+
+   TA_SetThreadContext( NULL );
+}
+
+#ifdef WIN32
+static DWORD WINAPI threadMain( LPVOID arg )
+{
+   runThreadTest( (ThreadTest *)arg );
+   return 0;
+}
+#else
+static void *threadMain( void *arg )
+{
+   runThreadTest( (ThreadTest *)arg );
+   return NULL;
+}
+#endif
@@ -58,18 +58,22 @@
 
 /**** Headers ****/
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "ta_test_priv.h"
 #include "../../ta_common/ta_memory.h"
 #include "ta_defs.h"
 #include "ta_common.h"
+#include "ta_func.h"
 
 /**** External functions declarations. ****/
 /* None */
 
 /**** External variables declarations. ****/
-/* None */
+extern double gDataHigh[];
+extern double gDataLow[];
+extern double gDataClose[];
 
 /**** Global variables definitions.    ****/
 /* None */
@@ -79,11 +83,14 @@
 
 /**** Local functions declarations.    ****/
 static ErrorNumber testCircularBuffer(void);
+static ErrorNumber testWorkspace(void);
 
 static TA_RetCode circBufferFillFrom0ToSize(int size, int *buffer);
 
 /**** Local variables definitions.     ****/
-/* None */
+
+/* Number of calls to the counting allocator. */
+static int nbAlloc;
 
 /**** Global functions definitions.   ****/
 /* None */
@@ -102,6 +109,13 @@ ErrorNumber test_internals(void)
       return retValue;
    }
 
+   retValue = testWorkspace();
+   if (retValue != TA_TEST_PASS)
+   {
+      printf("\nFailed: Workspace tests (%d)\n", retValue);
+      return retValue;
+   }
+
    return TA_TEST_PASS; /* Success. */
 }
 
@@ -227,6 +241,116 @@ static ErrorNumber testCircularBuffer(void)
    return TA_TEST_PASS; /* Success. */
 }
 
+static void *countingAlloc(size_t size, void *opaque)
+{
+   (void)opaque;
+   nbAlloc++;
+   return malloc(size);
+}
+
+static void *countingRealloc(void *ptr, size_t size, void *opaque)
+{
+   (void)opaque;
+   nbAlloc++;
+   return realloc(ptr, size);
+}
+
+static void countingFree(void *ptr, void *opaque)
+{
+   (void)opaque;
+   free(ptr);
+}
+
+/* Calls the functions using ARRAY_ALLOC temporaries. */
+static TA_RetCode callWorkspaceFunctions(TA_Real *out0, TA_Real *out1, TA_Real *out2, TA_Integer nbBar)
+{
+   TA_RetCode retCode;
+   TA_Integer outBegIdx, outNbElement;
+   TA_Integer endIdx = nbBar - 1;
+   static TA_Real periods[1000];
+   TA_Integer i;
+
+   for (i = 0; i < nbBar; i++)
+      periods[i] = 2 + (i % 20);
+
+#define CALL(x) { retCode = x; if (retCode != TA_SUCCESS) return retCode; }
+   CALL(TA_MACD(0, endIdx, gDataClose, 12, 26, 9, &outBegIdx, &outNbElement, out0, out1, out2));
+   CALL(TA_MACDEXT(0, endIdx, gDataClose, 12, TA_MAType_EMA, 26, TA_MAType_EMA, 9, TA_MAType_SMA, &outBegIdx, &outNbElement, out0, out1, out2));
+   CALL(TA_APO(0, endIdx, gDataClose, 12, 26, TA_MAType_SMA, &outBegIdx, &outNbElement, out0));
+   CALL(TA_PPO(0, endIdx, gDataClose, 12, 26, TA_MAType_EMA, &outBegIdx, &outNbElement, out0));
+   CALL(TA_DEMA(0, endIdx, gDataClose, 30, &outBegIdx, &outNbElement, out0));
+   CALL(TA_TEMA(0, endIdx, gDataClose, 30, &outBegIdx, &outNbElement, out0));
+   CALL(TA_TRIX(0, endIdx, gDataClose, 30, &outBegIdx, &outNbElement, out0));
+   CALL(TA_MA(0, endIdx, gDataClose, 30, TA_MAType_MAMA, &outBegIdx, &outNbElement, out0));
+   CALL(TA_MAVP(0, endIdx, gDataClose, periods, 2, 30, TA_MAType_SMA, &outBegIdx, &outNbElement, out0));
+   CALL(TA_ATR(0, endIdx, gDataHigh, gDataLow, gDataClose, 14, &outBegIdx, &outNbElement, out0));
+   CALL(TA_NATR(0, endIdx, gDataHigh, gDataLow, gDataClose, 14, &outBegIdx, &outNbElement, out0));
+   CALL(TA_ADXR(0, endIdx, gDataHigh, gDataLow, gDataClose, 14, &outBegIdx, &outNbElement, out0));
+   CALL(TA_STOCH(0, endIdx, gDataHigh, gDataLow, gDataClose, 5, 3, TA_MAType_SMA, 3, TA_MAType_SMA, &outBegIdx, &outNbElement, out0, out1));
+   CALL(TA_STOCHF(0, endIdx, gDataHigh, gDataLow, gDataClose, 5, 3, TA_MAType_SMA, &outBegIdx, &outNbElement, out0, out1));
+   CALL(TA_STOCHRSI(0, endIdx, gDataClose, 14, 5, 3, TA_MAType_SMA, &outBegIdx, &outNbElement, out0, out1));
+#undef CALL
+
+   return TA_SUCCESS;
+}
+
+/* Once the workspace is large enough, none of the functions
+ * using temporary arrays should allocate anything.
+ */
+static ErrorNumber testWorkspace(void)
+{
+   TA_RetCode retCode;
+   ErrorNumber retValue;
+   static TA_Real out0[1000], out1[1000], out2[1000];
+   static double workspace[8000];
+   size_t peak;
+
+   retValue = allocLib();
+   if (retValue != TA_TEST_PASS)
+   {
+      printf("\nFailed: Can't initialize the library\n");
+      return retValue;
+   }
+
+   retCode = TA_SetAllocator(countingAlloc, countingRealloc, countingFree, NULL);
+   if (retCode != TA_SUCCESS)
+   {
+      printf("\nFailed TA_SetAllocator RetCode = %d\n", retCode);
+      return TA_INTERNAL_WORKSPACE_FAIL_0;
+   }
+
+   /* Without a workspace, temporaries come from the allocator. */
+   nbAlloc = 0;
+   retCode = callWorkspaceFunctions(out0, out1, out2, 1000);
+   if ((retCode != TA_SUCCESS) || (nbAlloc == 0))
+   {
+      printf("\nFailed allocator test RetCode = %d nbAlloc = %d\n", retCode, nbAlloc);
+      return TA_INTERNAL_WORKSPACE_FAIL_1;
+   }
+
+   TA_SetWorkspace(workspace, sizeof(workspace));
+
+   /* Warm-up, then no allocation at all. */
+   callWorkspaceFunctions(out0, out1, out2, 1000);
+   nbAlloc = 0;
+   retCode = callWorkspaceFunctions(out0, out1, out2, 1000);
+   TA_GetWorkspacePeak(&peak);
+   if ((retCode != TA_SUCCESS) || (nbAlloc != 0) || (peak == 0))
+   {
+      printf("\nFailed workspace test RetCode = %d nbAlloc = %d peak = %d\n", retCode, nbAlloc, (int)peak);
+      return TA_INTERNAL_WORKSPACE_FAIL_2;
+   }
+
+   TA_SetWorkspace(NULL, 0);
+   TA_SetAllocator(NULL, NULL, NULL, NULL);
+
+   retValue = freeLib();
+   if (retValue != TA_TEST_PASS)
+      return retValue;
+
+   return TA_TEST_PASS; /* Success. */
+}
+
 /* This function is suppose to fill the buffer
  * with values going from 0 to 'size'.
  * The filling is done using the CIRCBUF macros.
@@ -0,0 +1,172 @@
+"""Registry-driven ta-lib build for PlatformIO.
+
+The project lists the ta-lib functions it calls in platformio.ini:
+
+    custom_ta_registry = EMA RSI MACD
+
+Only the ta_func sources of those functions, and of the functions they call in
+turn, are then compiled. ta_abstract.c is built with TA_REGISTRY against a
+generated ta_registry.h whose tables hold only the registered functions. Nothing
+then refers to the other functions' frames and metadata, so the linker's
+--gc-sections drops them too.
+
+After each link the firmware's flash and RAM use is printed, together with what
+the registry saved against the last build without one. Leave custom_ta_registry
+empty to build everything again; that also records the baseline.
+"""
+
+import json
+import os
+import re
+import subprocess
+
+Import("env")
+
+# PlatformIO runs library scripts from the library's directory.
+LIB_DIR = os.path.realpath(".")
+FUNC_DIR = os.path.join(LIB_DIR, "src", "ta_func")
+TABLES_DIR = os.path.join(LIB_DIR, "src", "ta_abstract", "tables")
+
+# Always built: settings, unstable periods, candle settings and the streaming
+# states, whose unused functions the linker drops like any other.
+SUPPORT_SOURCES = ["ta_utility.c", "ta_stream.c"]
+
+CALL_RE = re.compile(r"\b(?:FUNCTION_CALL|FUNCTION_CALL_DOUBLE|LOOKBACK_CALL)\(\s*(\w+)\s*\)"
+                     r"|\bTA_(INT_\w+)"
+                     r"|\bTA_(\w+?)_Lookback\b")
+INT_DEF_RE = re.compile(r"^(?:/\* Generated \*/)?\s*(?:TA_RetCode|void)\s+TA_PREFIX\((INT_\w+)\)\s*\(", re.M)
+TABLE_ENTRY_RE = re.compile(r"^\s*ADD_TO_TABLE\((\w+)\)", re.M)
+
+
+def scan_sources():
+    """Maps each function and internal helper to its source, and each source to
+    the names it calls."""
+    defined = {}
+    calls = {}
+    for source in sorted(os.listdir(FUNC_DIR)):
+        if not (source.startswith("ta_") and source.endswith(".c")) or source in SUPPORT_SOURCES:
+            continue
+        with open(os.path.join(FUNC_DIR, source)) as f:
+            text = f.read()
+        defined[source[3:-2]] = source
+        for helper in INT_DEF_RE.findall(text):
+            defined[helper] = source
+        calls[source] = set(name for match in CALL_RE.findall(text) for name in match if name)
+    return defined, calls
+
+
+def scan_tables():
+    """Functions listed in the abstract tables. A few ta_func sources (NVI, PVI)
+    have no abstract definition and can't be registered."""
+    names = set()
+    for table in os.listdir(TABLES_DIR):
+        with open(os.path.join(TABLES_DIR, table)) as f:
+            names.update(TABLE_ENTRY_RE.findall(f.read()))
+    return names
+
+
+def closure(names, defined, calls):
+    """Sources needed by the registered names, following calls between them."""
+    sources = set()
+    pending = [defined[name] for name in names]
+    while pending:
+        source = pending.pop()
+        if source in sources:
+            continue
+        sources.add(source)
+        pending.extend(defined[name] for name in calls[source] if name in defined)
+    return sorted(sources)
+
+
+def write_registry_header(names, path):
+    lines = ["/* Generated by ta_registry.py from custom_ta_registry. Do not modify. */",
+             "#ifndef TA_REGISTRY_H",
+             "#define TA_REGISTRY_H",
+             ""]
+    for name in names:
+        lines.append("extern const TA_FuncDef TA_DEF_%s;" % name)
+    lines.append("")
+    for letter in "ABCDEFGHIJKLMNOPQRSTUVWXYZ":
+        entries = ["&TA_DEF_%s, " % name for name in names if name[0] == letter]
+        lines.append("static const TA_FuncDef *TA_REG_Table%s[] = { %sNULL };" % (letter, "".join(entries)))
+        lines.append("static const unsigned int TA_REG_Table%sSize = %d;" % (letter, len(entries)))
+    lines += ["", "#endif", ""]
+
+    text = "\n".join(lines)
+    if os.path.isfile(path):
+        with open(path) as f:
+            if f.read() == text:
+                return
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def firmware_size(target_env, elf):
+    """Flash and RAM use as PlatformIO's own size check counts them."""
+    output = subprocess.check_output([target_env.subst("$SIZETOOL"), "-A", "-d", elf]).decode()
+    flash = ram = 0
+    for line in output.splitlines():
+        match = re.search(target_env.get("SIZEPROGREGEXP", r"$^"), line)
+        flash += int(match.group(1)) if match else 0
+        match = re.search(target_env.get("SIZEDATAREGEXP", r"$^"), line)
+        ram += int(match.group(1)) if match else 0
+    return flash, ram
+
+
+def report_size(target_env, elf, names, record):
+    flash, ram = firmware_size(target_env, elf)
+    sizes = {}
+    if os.path.isfile(record):
+        with open(record) as f:
+            sizes = json.load(f)
+
+    if not names:
+        sizes["full"] = {"flash": flash, "ram": ram}
+        with open(record, "w") as f:
+            json.dump(sizes, f)
+        print("ta-lib: full build, flash %d bytes, RAM %d bytes (registry baseline)" % (flash, ram))
+        return
+
+    print("ta-lib registry (%s): flash %d bytes, RAM %d bytes" % (" ".join(names), flash, ram))
+    if "full" in sizes:
+        print("ta-lib registry saved %d bytes of flash and %d bytes of RAM against the full build"
+              % (sizes["full"]["flash"] - flash, sizes["full"]["ram"] - ram))
+    else:
+        print("ta-lib registry: build once with an empty custom_ta_registry to measure the savings")
+
+
+global_env = DefaultEnvironment()
+names = sorted(set(env.GetProjectOption("custom_ta_registry", "").upper().split()))
+record = os.path.join(global_env.subst("$PROJECT_BUILD_DIR"), "ta_registry_%s.json" % global_env.subst("$PIOENV"))
+
+# Sections per function and data object let the linker drop whatever isn't
+# reachable; the ESP32 toolchains already do this, other boards may not.
+env.Append(CCFLAGS=["-ffunction-sections", "-fdata-sections"])
+global_env.Append(LINKFLAGS=["-Wl,--gc-sections"])
+
+if names:
+    defined, calls = scan_sources()
+    listed = scan_tables()
+    unknown = [name for name in names if name not in defined or name not in listed]
+    if unknown:
+        print("ta-lib registry: unknown function(s) %s in custom_ta_registry" % " ".join(unknown))
+        env.Exit(1)
+
+    sources = closure(names, defined, calls)
+    letters = sorted(set(name[0].lower() for name in names))
+    env.Replace(SRC_FILTER=["+<ta_common/*.c>", "+<ta_abstract/*.c>", "+<ta_abstract/frames/*.c>",
+                            "-<ta_abstract/ta_group_idx.c>"]
+                + ["+<ta_abstract/tables/table_%s.c>" % letter for letter in letters]
+                + ["+<ta_func/%s>" % source for source in SUPPORT_SOURCES + sources])
+
+    header_dir = os.path.join(global_env.subst("$BUILD_DIR"), "ta_registry")
+    if not os.path.isdir(header_dir):
+        os.makedirs(header_dir)
+    write_registry_header(names, os.path.join(header_dir, "ta_registry.h"))
+    env.Append(CPPDEFINES=["TA_REGISTRY"], CPPPATH=[header_dir])
+
+    print("ta-lib registry: %s compiles %d of %d ta_func sources (%s)"
+          % (" ".join(names), len(sources), len(calls), " ".join(source[3:-2] for source in sources)))
+
+global_env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf",
+                         lambda target, source, env: report_size(env, target[0].get_abspath(), names, record))
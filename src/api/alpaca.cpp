@@ -8,6 +8,7 @@
 const std::map<const char *, const char *> headers PROGMEM = {{"APCA-API-KEY-ID", ALPACA_API_KEY}, {"APCA-API-SECRET-KEY", ALPACA_API_SECRET}};
 
 const char *base_url PROGMEM = "https://paper-api.alpaca.markets";
+const char *active_base_url = base_url;
 
 namespace Alpaca
 {
@@ -46,21 +47,23 @@ namespace Alpaca
         "-----END CERTIFICATE-----\n"
         "";
 
+    const char *active_ca_cert = rootCACertificate;
+
     DynamicJsonDocument get(const char *extension)
     {
-        String url{base_url};
+        String url{active_base_url};
         url += extension;
 
         std::map<const char *, const char *> headers;
         headers["APCA-API-KEY-ID"] = ALPACA_API_KEY;
         headers["APCA-API-SECRET-KEY"] = ALPACA_API_SECRET;
 
-        return Client_::get(url.c_str(), rootCACertificate, headers);
+        return Client_::get(url.c_str(), active_ca_cert, headers);
     }
 
     int post(const char *extension, const char *body)
     {
-        String url{base_url};
+        String url{active_base_url};
         url += extension;
 
         std::map<const char *, const char *> headers;
@@ -68,15 +71,15 @@ namespace Alpaca
         headers["APCA-API-SECRET-KEY"] = ALPACA_API_SECRET;
         headers["Content-Type"] = "application/json";
 
-        return Client_::post(url.c_str(), rootCACertificate, headers, body);
+        return Client_::post(url.c_str(), active_ca_cert, headers, body);
     }
 
     int delete_(const char *extension)
     {
-        String url{base_url};
+        String url{active_base_url};
         url += extension;
 
-        return Client_::delete_(url.c_str(), rootCACertificate, headers);
+        return Client_::delete_(url.c_str(), active_ca_cert, headers);
     }
 
     DynamicJsonDocument account_info()
@@ -119,6 +122,58 @@ namespace Alpaca
         return post("/v2/orders", body);
     }
 
+    int order_bracket(const char *symbol, int qty, const char *side, float take_profit, float stop_loss)
+    {
+        StaticJsonDocument<300> doc;
+        doc[F("symbol")] = symbol;
+        doc[F("qty")] = qty;
+        doc[F("side")] = side;
+        doc[F("type")] = F("market");
+        doc[F("time_in_force")] = F("gtc");
+        doc[F("order_class")] = F("bracket");
+        doc[F("take_profit")][F("limit_price")] = String(take_profit, 2);
+        doc[F("stop_loss")][F("stop_price")] = String(stop_loss, 2);
+
+        char body[300];
+        serializeJson(doc, body);
+
+        return post("/v2/orders", body);
+    }
+
+    int order_oco(const char *symbol, int qty, const char *side, float take_profit, float stop_loss)
+    {
+        StaticJsonDocument<300> doc;
+        doc[F("symbol")] = symbol;
+        doc[F("qty")] = qty;
+        doc[F("side")] = side;
+        doc[F("type")] = F("limit");
+        doc[F("time_in_force")] = F("gtc");
+        doc[F("order_class")] = F("oco");
+        doc[F("take_profit")][F("limit_price")] = String(take_profit, 2);
+        doc[F("stop_loss")][F("stop_price")] = String(stop_loss, 2);
+
+        char body[300];
+        serializeJson(doc, body);
+
+        return post("/v2/orders", body);
+    }
+
+    int order_trailing_stop(const char *symbol, int qty, const char *side, float trail_percent)
+    {
+        StaticJsonDocument<200> doc;
+        doc[F("symbol")] = symbol;
+        doc[F("qty")] = qty;
+        doc[F("side")] = side;
+        doc[F("type")] = F("trailing_stop");
+        doc[F("time_in_force")] = F("gtc");
+        doc[F("trail_percent")] = String(trail_percent, 2);
+
+        char body[200];
+        serializeJson(doc, body);
+
+        return post("/v2/orders", body);
+    }
+
     int cancel_order(const char *id)
     {
         String extension{"/v2/orders/" + String(id)};
@@ -203,4 +258,10 @@ namespace Alpaca
 
         return 0;
     }
+
+    void set_base_url(const char *url, const char *ca_cert)
+    {
+        active_base_url = url;
+        active_ca_cert = ca_cert;
+    }
 }
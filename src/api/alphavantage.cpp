@@ -29,6 +29,7 @@ namespace AlphaVantage
 {
 
     uint8_t requests = 0;
+    const int compact_bars = 100;
 
     const char *rootCACertificate PROGMEM =
         "-----BEGIN CERTIFICATE-----\n"
@@ -106,8 +107,21 @@ namespace AlphaVantage
         return get(extension.c_str());
     }
 
-    std::vector<TimeSeries> hourly(const char *symbol)
+    // A full series is megabytes of JSON, more than the heap holds, so every series
+    // request is compact and longer histories are capped to it.
+    int cap_bars(int bars)
     {
+        if (bars > compact_bars)
+        {
+            Serial.println("AlphaVantage: " + String(bars) + " bars requested, capped at " + String(compact_bars));
+            return compact_bars;
+        }
+        return bars;
+    }
+
+    std::vector<TimeSeries> hourly(const char *symbol, int bars)
+    {
+        bars = cap_bars(bars);
         std::map<const char *, const char *> args;
         args["function"] = "TIME_SERIES_INTRADAY";
         args["symbol"] = symbol;
@@ -136,11 +150,17 @@ namespace AlphaVantage
 
         std::reverse(time_series_vector.begin(), time_series_vector.end());
 
+        if (bars > 0 && static_cast<int>(time_series_vector.size()) > bars)
+        {
+            time_series_vector.erase(time_series_vector.begin(), time_series_vector.end() - bars);
+        }
+
         return time_series_vector;
     }
 
-    std::vector<TimeSeries> daily(const char *symbol)
+    std::vector<TimeSeries> daily(const char *symbol, int bars)
     {
+        bars = cap_bars(bars);
         std::map<const char *, const char *> args;
         args["function"] = "TIME_SERIES_DAILY_ADJUSTED";
         args["symbol"] = symbol;
@@ -154,7 +174,7 @@ namespace AlphaVantage
         {
             Serial.println(F("AlphaVantage rate limit exceeded."));
             delay(60000);
-            return daily(symbol);
+            return daily(symbol, bars);
         }
 
         JsonObject time_series{response[F("Time Series (Daily)")]};
@@ -175,6 +195,11 @@ namespace AlphaVantage
 
         std::reverse(time_series_vector.begin(), time_series_vector.end());
 
+        if (bars > 0 && static_cast<int>(time_series_vector.size()) > bars)
+        {
+            time_series_vector.erase(time_series_vector.begin(), time_series_vector.end() - bars);
+        }
+
         return time_series_vector;
     }
 
@@ -2,24 +2,33 @@
 #include <ArduinoJson.h>
 #include "models/logic.h"
 #include "models/rsi.h"
+#include "models/strategy.h"
 #include "models/ta.h"
 #include "models/trade.h"
 #include "api/client.h"
 #include "SimplePgSQL.h"
 
-int lastRequest = 0;
+// Exits are bracket legs Alpaca works server-side, so the trader only has to look
+// once per hourly bar.
+const unsigned long trade_interval = 3600000;
+unsigned long lastRequest = 0;
+bool traded = false;
 void setup()
 {
   Serial.begin(115200);
   Client_::init();
   TA::init();
+  TA::set_unstable_period(Strategy::unstable_period);
+  Trade::restore("QQQ");
 }
 
 void loop()
 {
-  if (millis() - lastRequest > 60000)
+  if (!traded || millis() - lastRequest > trade_interval)
   {
+    traded = true;
     lastRequest = millis();
     Trade::swing_trade_leveraged("QQQ", "TQQQ", "SQQQ", 0.5);
+    TA::Scratch::reset();
   }
 }
\ No newline at end of file
@@ -8,7 +8,7 @@ namespace Base
         return (high + low + close) / 3;
     }
 
-    std::vector<float> typical_prices(std::vector<AlphaVantage::TimeSeries> ts)
+    std::vector<float> typical_prices(const std::vector<AlphaVantage::TimeSeries> &ts)
     {
         std::vector<float> prices;
         for (int i = 0; i < ts.size(); i++)
@@ -18,16 +18,6 @@ namespace Base
         return prices;
     }
 
-    float slope_from_prices(std::vector<float> &prices, int period)
-    {
-        float slope = 0;
-        for (int i = 0; i < period; i++)
-        {
-            slope += prices[prices.size() - 1 - i] - prices[prices.size() - 2 - i];
-        }
-        return slope / period;
-    }
-
     Logic::Decision decision_with_position(Logic::Decision decision, Logic::Position position)
     {
         if (position == Logic::Position::LONG)
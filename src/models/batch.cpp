@@ -0,0 +1,107 @@
+#include "models/batch.h"
+#include "models/kernels.h"
+
+namespace Batch
+{
+    void Matrix::resize(int symbols_, int steps_)
+    {
+        symbols = symbols_;
+        steps = steps_;
+        values.resize(symbols_ * steps_);
+    }
+
+    Matrix interleave(const std::vector<std::vector<float>> &series)
+    {
+        Matrix matrix;
+        if (series.empty())
+        {
+            return matrix;
+        }
+
+        const int symbols{static_cast<int>(series.size())};
+        int steps{static_cast<int>(series[0].size())};
+        for (int s = 1; s < symbols; s++)
+        {
+            if (static_cast<int>(series[s].size()) < steps)
+            {
+                steps = series[s].size();
+            }
+        }
+
+        matrix.resize(symbols, steps);
+        for (int s = 0; s < symbols; s++)
+        {
+            const float *values{series[s].data() + series[s].size() - steps};
+            for (int t = 0; t < steps; t++)
+            {
+                matrix.at(t, s) = values[t];
+            }
+        }
+        return matrix;
+    }
+
+    int EMA(const Matrix &prices, int period, Matrix &out)
+    {
+        out.resize(prices.symbols, prices.steps);
+        int count{Kernels::ema_many(prices.values.data(), prices.symbols, prices.steps, period, out.values.data())};
+        out.resize(prices.symbols, count);
+        return count;
+    }
+
+    int RSI(const Matrix &prices, int period, Matrix &out)
+    {
+        out.resize(prices.symbols, prices.steps);
+        int count{Kernels::rsi_many(prices.values.data(), prices.symbols, prices.steps, period, out.values.data())};
+        out.resize(prices.symbols, count);
+        return count;
+    }
+
+    int MACD(const Matrix &prices, int fastPeriod, int slowPeriod, int signalPeriod, Matrix &outMACD, Matrix &outMACDSignal, Matrix &outMACDHist)
+    {
+        if (slowPeriod < fastPeriod)
+        {
+            int swap{slowPeriod};
+            slowPeriod = fastPeriod;
+            fastPeriod = swap;
+        }
+
+        const int symbols{prices.symbols};
+        int lines{prices.steps - slowPeriod + 1};
+        int count{lines - signalPeriod + 1};
+        if (fastPeriod < 2 || signalPeriod < 1 || count < 1)
+        {
+            outMACD.resize(symbols, 0);
+            outMACDSignal.resize(symbols, 0);
+            outMACDHist.resize(symbols, 0);
+            return 0;
+        }
+
+        // Matching TA_MACD, the fast EMA is seeded from the bars just before the slow
+        // EMA's first value, so both EMA matrices start on the same row.
+        int offset{slowPeriod - fastPeriod};
+        std::vector<float> fast(symbols * lines);
+        std::vector<float> slow(symbols * lines);
+        Kernels::ema_many(prices.values.data() + offset * symbols, symbols, prices.steps - offset, fastPeriod, fast.data());
+        Kernels::ema_many(prices.values.data(), symbols, prices.steps, slowPeriod, slow.data());
+        for (int i = 0; i < symbols * lines; i++)
+        {
+            fast[i] -= slow[i];
+        }
+
+        outMACD.resize(symbols, count);
+        outMACDSignal.resize(symbols, count);
+        outMACDHist.resize(symbols, count);
+        Kernels::ema_many(fast.data(), symbols, lines, signalPeriod, outMACDSignal.values.data());
+
+        const float *line{fast.data() + (signalPeriod - 1) * symbols};
+        const float *signal{outMACDSignal.values.data()};
+        float *macd{outMACD.values.data()};
+        float *hist{outMACDHist.values.data()};
+        for (int i = 0; i < symbols * count; i++)
+        {
+            macd[i] = line[i];
+            hist[i] = line[i] - signal[i];
+        }
+        return count;
+    }
+}
@@ -0,0 +1,1146 @@
+#include "models/candles.h"
+#include <algorithm>
+#include <math.h>
+
+namespace Candles
+{
+    // ta-lib's default candle settings (TA_CandleDefaultSettings). An average is
+    // factor times the mean of the range over the period bars before the one being
+    // judged, or of that bar alone when the period is 0; Shadows ranges are halved.
+    enum Setting
+    {
+        BODY_LONG,
+        BODY_VERY_LONG,
+        BODY_SHORT,
+        BODY_DOJI,
+        SHADOW_LONG,
+        SHADOW_VERY_LONG,
+        SHADOW_SHORT,
+        SHADOW_VERY_SHORT,
+        NEAR,
+        FAR,
+        EQUAL,
+        SETTING_COUNT
+    };
+
+    enum Range
+    {
+        REAL_BODY,
+        HIGH_LOW,
+        SHADOWS
+    };
+
+    struct Average
+    {
+        Range range;
+        int period;
+        double factor;
+    };
+
+    const Average settings[SETTING_COUNT]{
+        {REAL_BODY, 10, 1.0},
+        {REAL_BODY, 10, 3.0},
+        {REAL_BODY, 10, 1.0},
+        {HIGH_LOW, 10, 0.1},
+        {REAL_BODY, 0, 1.0},
+        {REAL_BODY, 0, 2.0},
+        {SHADOWS, 10, 1.0},
+        {HIGH_LOW, 10, 0.1},
+        {HIGH_LOW, 5, 0.2},
+        {HIGH_LOW, 5, 0.6},
+        {HIGH_LOW, 5, 0.05},
+    };
+
+    // The only non-zero periods in the settings above.
+    const int long_period{10};
+    const int short_period{5};
+
+    static_assert(sizeof(Candle::average) / sizeof(double) == SETTING_COUNT, "Candle::average must hold every setting");
+
+    // TA_CDL* optInPenetration defaults.
+    const double star_penetration{0.3};
+    const double hold_penetration{0.5};
+
+    double range_of(const Candle &candle, Range range)
+    {
+        switch (range)
+        {
+        case REAL_BODY:
+            return candle.body;
+        case HIGH_LOW:
+            return candle.range;
+        default:
+            return candle.upper + candle.lower;
+        }
+    }
+
+    double top(const Candle &c) { return std::max(c.open, c.close); }
+    double bottom(const Candle &c) { return std::min(c.open, c.close); }
+
+    // later's real body entirely above / below earlier's.
+    bool body_gap_up(const Candle &later, const Candle &earlier) { return bottom(later) > top(earlier); }
+    bool body_gap_down(const Candle &later, const Candle &earlier) { return top(later) < bottom(earlier); }
+
+    bool gap_up(const Candle &later, const Candle &earlier) { return later.low > earlier.high; }
+    bool gap_down(const Candle &later, const Candle &earlier) { return later.high < earlier.low; }
+
+    // A bar's comparisons against its own averages, made once in update() and read by
+    // every pattern as a bit test.
+    enum Shape
+    {
+        LONG_BODY = 1 << 0,
+        SHORT_BODY = 1 << 1,
+        SMALL_BODY = 1 << 2,
+        DOJI_BODY = 1 << 3,
+        UPPER_VERY_SHORT = 1 << 4,
+        LOWER_VERY_SHORT = 1 << 5,
+        UPPER_NOT_VERY_SHORT = 1 << 6,
+        LOWER_NOT_VERY_SHORT = 1 << 7,
+        UPPER_SHORT = 1 << 8,
+        LOWER_SHORT = 1 << 9,
+        UPPER_NOT_SHORT = 1 << 10,
+        UPPER_LONG = 1 << 11,
+        LOWER_LONG = 1 << 12,
+        UPPER_VERY_LONG = 1 << 13,
+        LOWER_VERY_LONG = 1 << 14,
+        WHITE = 1 << 15
+    };
+
+    bool is(const Candle &c, Shape shape) { return (c.shape & shape) != 0; }
+    bool white(const Candle &c) { return is(c, WHITE); }
+
+    uint32_t shape_of(const Candle &c)
+    {
+        const double *a{c.average};
+        uint32_t shape{0};
+        shape |= c.body > a[BODY_LONG] ? LONG_BODY : 0;
+        shape |= c.body < a[BODY_SHORT] ? SHORT_BODY : 0;
+        shape |= c.body <= a[BODY_SHORT] ? SMALL_BODY : 0;
+        shape |= c.body <= a[BODY_DOJI] ? DOJI_BODY : 0;
+        shape |= c.upper < a[SHADOW_VERY_SHORT] ? UPPER_VERY_SHORT : 0;
+        shape |= c.lower < a[SHADOW_VERY_SHORT] ? LOWER_VERY_SHORT : 0;
+        shape |= c.upper > a[SHADOW_VERY_SHORT] ? UPPER_NOT_VERY_SHORT : 0;
+        shape |= c.lower > a[SHADOW_VERY_SHORT] ? LOWER_NOT_VERY_SHORT : 0;
+        shape |= c.upper < a[SHADOW_SHORT] ? UPPER_SHORT : 0;
+        shape |= c.lower < a[SHADOW_SHORT] ? LOWER_SHORT : 0;
+        shape |= c.upper > a[SHADOW_SHORT] ? UPPER_NOT_SHORT : 0;
+        shape |= c.upper > a[SHADOW_LONG] ? UPPER_LONG : 0;
+        shape |= c.lower > a[SHADOW_LONG] ? LOWER_LONG : 0;
+        shape |= c.upper > a[SHADOW_VERY_LONG] ? UPPER_VERY_LONG : 0;
+        shape |= c.lower > a[SHADOW_VERY_LONG] ? LOWER_VERY_LONG : 0;
+        shape |= c.color == 1 ? WHITE : 0;
+        return shape;
+    }
+
+    // The bars a pattern looks at, w[0] being the newest.
+    struct Window
+    {
+        const Candle *bars[5];
+        const Candle &operator[](int offset) const { return *bars[offset]; }
+    };
+
+    typedef int (*Test)(const Window &w);
+
+    // Each test opens with the shape and colour bits its bars need, combined with &
+    // rather than && so the gate compiles without branches; most bars fail it, and
+    // only the ones that pass go on to the price comparisons.
+
+    int two_crows(const Window &w)
+    {
+        if (!(white(w[2]) & is(w[2], LONG_BODY) & !white(w[1]) & !white(w[0])))
+        {
+            return 0;
+        }
+        return body_gap_up(w[1], w[2]) &&
+                       w[0].open < w[1].open && w[0].open > w[1].close &&
+                       w[0].close > w[2].open && w[0].close < w[2].close
+                   ? -100
+                   : 0;
+    }
+
+    int three_black_crows(const Window &w)
+    {
+        if (!(white(w[3]) &
+              !white(w[2]) & is(w[2], LOWER_VERY_SHORT) &
+              !white(w[1]) & is(w[1], LOWER_VERY_SHORT) &
+              !white(w[0]) & is(w[0], LOWER_VERY_SHORT)))
+        {
+            return 0;
+        }
+        return w[1].open < w[2].open && w[1].open > w[2].close &&
+                       w[0].open < w[1].open && w[0].open > w[1].close &&
+                       w[3].high > w[2].close &&
+                       w[2].close > w[1].close &&
+                       w[1].close > w[0].close
+                   ? -100
+                   : 0;
+    }
+
+    int three_inside(const Window &w)
+    {
+        if (!(is(w[2], LONG_BODY) & is(w[1], SMALL_BODY) & (w[2].color == -w[0].color)))
+        {
+            return 0;
+        }
+        if (top(w[1]) < top(w[2]) && bottom(w[1]) > bottom(w[2]) &&
+            ((w[2].color == 1 && w[0].close < w[2].open) ||
+             (w[2].color == -1 && w[0].close > w[2].open)))
+        {
+            return -w[2].color * 100;
+        }
+        return 0;
+    }
+
+    int three_line_strike(const Window &w)
+    {
+        if (!((w[3].color == w[2].color) & (w[2].color == w[1].color) & (w[0].color == -w[1].color)))
+        {
+            return 0;
+        }
+        if (w[2].open >= bottom(w[3]) - w[3].average[NEAR] && w[2].open <= top(w[3]) + w[3].average[NEAR] &&
+            w[1].open >= bottom(w[2]) - w[2].average[NEAR] && w[1].open <= top(w[2]) + w[2].average[NEAR] &&
+            ((w[1].color == 1 && w[1].close > w[2].close && w[2].close > w[3].close &&
+              w[0].open > w[1].close && w[0].close < w[3].open) ||
+             (w[1].color == -1 && w[1].close < w[2].close && w[2].close < w[3].close &&
+              w[0].open < w[1].close && w[0].close > w[3].open)))
+        {
+            return w[1].color * 100;
+        }
+        return 0;
+    }
+
+    int three_outside(const Window &w)
+    {
+        if (!(w[1].color == -w[2].color))
+        {
+            return 0;
+        }
+        if ((w[1].color == 1 && w[1].close > w[2].open && w[1].open < w[2].close && w[0].close > w[1].close) ||
+            (w[1].color == -1 && w[1].open > w[2].close && w[1].close < w[2].open && w[0].close < w[1].close))
+        {
+            return w[1].color * 100;
+        }
+        return 0;
+    }
+
+    int three_stars_in_south(const Window &w)
+    {
+        if (!(!white(w[2]) & is(w[2], LONG_BODY) & is(w[2], LOWER_LONG) &
+              !white(w[1]) & is(w[1], LOWER_NOT_VERY_SHORT) &
+              !white(w[0]) & is(w[0], SHORT_BODY) & is(w[0], LOWER_VERY_SHORT) & is(w[0], UPPER_VERY_SHORT)))
+        {
+            return 0;
+        }
+        return w[1].body < w[2].body &&
+                       w[1].open > w[2].close && w[1].open <= w[2].high &&
+                       w[1].low < w[2].close && w[1].low >= w[2].low &&
+                       w[0].low > w[1].low && w[0].high < w[1].high
+                   ? 100
+                   : 0;
+    }
+
+    int three_white_soldiers(const Window &w)
+    {
+        if (!(white(w[2]) & is(w[2], UPPER_VERY_SHORT) &
+              white(w[1]) & is(w[1], UPPER_VERY_SHORT) &
+              white(w[0]) & is(w[0], UPPER_VERY_SHORT) & !is(w[0], SMALL_BODY)))
+        {
+            return 0;
+        }
+        return w[0].close > w[1].close && w[1].close > w[2].close &&
+                       w[1].open > w[2].open && w[1].open <= w[2].close + w[2].average[NEAR] &&
+                       w[0].open > w[1].open && w[0].open <= w[1].close + w[1].average[NEAR] &&
+                       w[1].body > w[2].body - w[2].average[FAR] &&
+                       w[0].body > w[1].body - w[1].average[FAR]
+                   ? 100
+                   : 0;
+    }
+
+    int abandoned_baby(const Window &w)
+    {
+        if (!(is(w[2], LONG_BODY) & is(w[1], DOJI_BODY) & !is(w[0], SMALL_BODY) & (w[2].color == -w[0].color)))
+        {
+            return 0;
+        }
+        if ((w[2].color == 1 &&
+             w[0].close < w[2].close - w[2].body * star_penetration &&
+             gap_up(w[1], w[2]) && gap_down(w[0], w[1])) ||
+            (w[2].color == -1 &&
+             w[0].close > w[2].close + w[2].body * star_penetration &&
+             gap_down(w[1], w[2]) && gap_up(w[0], w[1])))
+        {
+            return w[0].color * 100;
+        }
+        return 0;
+    }
+
+    int advance_block(const Window &w)
+    {
+        if (!(white(w[2]) & is(w[2], LONG_BODY) & is(w[2], UPPER_SHORT) & white(w[1]) & white(w[0])))
+        {
+            return 0;
+        }
+        return w[0].close > w[1].close && w[1].close > w[2].close &&
+                       w[1].open > w[2].open && w[1].open <= w[2].close + w[2].average[NEAR] &&
+                       w[0].open > w[1].open && w[0].open <= w[1].close + w[1].average[NEAR] &&
+                       ((w[1].body < w[2].body - w[2].average[FAR] &&
+                         w[0].body < w[1].body + w[1].average[NEAR]) ||
+                        (w[0].body < w[1].body - w[1].average[FAR]) ||
+                        (w[0].body < w[1].body && w[1].body < w[2].body &&
+                         (is(w[0], UPPER_NOT_SHORT) || is(w[1], UPPER_NOT_SHORT))) ||
+                        (w[0].body < w[1].body && is(w[0], UPPER_LONG)))
+                   ? -100
+                   : 0;
+    }
+
+    int belt_hold(const Window &w)
+    {
+        if (is(w[0], LONG_BODY) &&
+            (white(w[0]) ? is(w[0], LOWER_VERY_SHORT) : is(w[0], UPPER_VERY_SHORT)))
+        {
+            return w[0].color * 100;
+        }
+        return 0;
+    }
+
+    int breakaway(const Window &w)
+    {
+        if (!(is(w[4], LONG_BODY) &
+              (w[4].color == w[3].color) & (w[3].color == w[1].color) & (w[1].color == -w[0].color)))
+        {
+            return 0;
+        }
+        if ((w[4].color == -1 && body_gap_down(w[3], w[4]) &&
+             w[2].high < w[3].high && w[2].low < w[3].low &&
+             w[1].high < w[2].high && w[1].low < w[2].low &&
+             w[0].close > w[3].open && w[0].close < w[4].close) ||
+            (w[4].color == 1 && body_gap_up(w[3], w[4]) &&
+             w[2].high > w[3].high && w[2].low > w[3].low &&
+             w[1].high > w[2].high && w[1].low > w[2].low &&
+             w[0].close < w[3].open && w[0].close > w[4].close))
+        {
+            return w[0].color * 100;
+        }
+        return 0;
+    }
+
+    int closing_marubozu(const Window &w)
+    {
+        if (is(w[0], LONG_BODY) &&
+            (white(w[0]) ? is(w[0], UPPER_VERY_SHORT) : is(w[0], LOWER_VERY_SHORT)))
+        {
+            return w[0].color * 100;
+        }
+        return 0;
+    }
+
+    int conceal_baby_swallow(const Window &w)
+    {
+        if (!(!white(w[3]) & is(w[3], LOWER_VERY_SHORT) & is(w[3], UPPER_VERY_SHORT) &
+              !white(w[2]) & is(w[2], LOWER_VERY_SHORT) & is(w[2], UPPER_VERY_SHORT) &
+              !white(w[1]) & is(w[1], UPPER_NOT_VERY_SHORT) &
+              !white(w[0])))
+        {
+            return 0;
+        }
+        return body_gap_down(w[1], w[2]) &&
+                       w[1].high > w[2].close &&
+                       w[0].high > w[1].high && w[0].low < w[1].low
+                   ? 100
+                   : 0;
+    }
+
+    int counterattack(const Window &w)
+    {
+        if (!((w[1].color == -w[0].color) & is(w[1], LONG_BODY) & is(w[0], LONG_BODY)))
+        {
+            return 0;
+        }
+        if (w[0].close <= w[1].close + w[1].average[EQUAL] &&
+            w[0].close >= w[1].close - w[1].average[EQUAL])
+        {
+            return w[0].color * 100;
+        }
+        return 0;
+    }
+
+    int dark_cloud_cover(const Window &w)
+    {
+        if (!(white(w[1]) & is(w[1], LONG_BODY) & !white(w[0])))
+        {
+            return 0;
+        }
+        return w[0].open > w[1].high &&
+                       w[0].close > w[1].open &&
+                       w[0].close < w[1].close - w[1].body * hold_penetration
+                   ? -100
+                   : 0;
+    }
+
+    int doji(const Window &w)
+    {
+        return is(w[0], DOJI_BODY) ? 100 : 0;
+    }
+
+    int doji_star(const Window &w)
+    {
+        if (!(is(w[1], LONG_BODY) & is(w[0], DOJI_BODY)))
+        {
+            return 0;
+        }
+        if (white(w[1]) ? body_gap_up(w[0], w[1]) : body_gap_down(w[0], w[1]))
+        {
+            return -w[1].color * 100;
+        }
+        return 0;
+    }
+
+    int dragonfly_doji(const Window &w)
+    {
+        return is(w[0], DOJI_BODY) & is(w[0], UPPER_VERY_SHORT) & is(w[0], LOWER_NOT_VERY_SHORT) ? 100 : 0;
+    }
+
+    int engulfing(const Window &w)
+    {
+        if (!(w[1].color == -w[0].color))
+        {
+            return 0;
+        }
+        if ((w[0].color == 1 && w[0].close > w[1].open && w[0].open < w[1].close) ||
+            (w[0].color == -1 && w[0].open > w[1].close && w[0].close < w[1].open))
+        {
+            return w[0].color * 100;
+        }
+        return 0;
+    }
+
+    int evening_doji_star(const Window &w)
+    {
+        if (!(white(w[2]) & is(w[2], LONG_BODY) & is(w[1], DOJI_BODY) & !white(w[0]) & !is(w[0], SMALL_BODY)))
+        {
+            return 0;
+        }
+        return body_gap_up(w[1], w[2]) &&
+                       w[0].close < w[2].close - w[2].body * star_penetration
+                   ? -100
+                   : 0;
+    }
+
+    int evening_star(const Window &w)
+    {
+        if (!(white(w[2]) & is(w[2], LONG_BODY) & is(w[1], SMALL_BODY) & !white(w[0]) & !is(w[0], SMALL_BODY)))
+        {
+            return 0;
+        }
+        return body_gap_up(w[1], w[2]) &&
+                       w[0].close < w[2].close - w[2].body * star_penetration
+                   ? -100
+                   : 0;
+    }
+
+    int gap_side_side_white(const Window &w)
+    {
+        if (!(white(w[1]) & white(w[0])))
+        {
+            return 0;
+        }
+        if (((body_gap_up(w[1], w[2]) && body_gap_up(w[0], w[2])) ||
+             (body_gap_down(w[1], w[2]) && body_gap_down(w[0], w[2]))) &&
+            w[0].body >= w[1].body - w[1].average[NEAR] && w[0].body <= w[1].body + w[1].average[NEAR] &&
+            w[0].open >= w[1].open - w[1].average[EQUAL] && w[0].open <= w[1].open + w[1].average[EQUAL])
+        {
+            return body_gap_up(w[1], w[2]) ? 100 : -100;
+        }
+        return 0;
+    }
+
+    int gravestone_doji(const Window &w)
+    {
+        return is(w[0], DOJI_BODY) & is(w[0], LOWER_VERY_SHORT) & is(w[0], UPPER_NOT_VERY_SHORT) ? 100 : 0;
+    }
+
+    bool hammer_shape(const Candle &c)
+    {
+        return is(c, SHORT_BODY) & is(c, LOWER_LONG) & is(c, UPPER_VERY_SHORT);
+    }
+
+    int hammer(const Window &w)
+    {
+        return hammer_shape(w[0]) && bottom(w[0]) <= w[1].low + w[1].average[NEAR] ? 100 : 0;
+    }
+
+    int hanging_man(const Window &w)
+    {
+        return hammer_shape(w[0]) && bottom(w[0]) >= w[1].high - w[1].average[NEAR] ? -100 : 0;
+    }
+
+    int harami(const Window &w)
+    {
+        if (!(is(w[1], LONG_BODY) & is(w[0], SMALL_BODY)))
+        {
+            return 0;
+        }
+        return top(w[0]) < top(w[1]) && bottom(w[0]) > bottom(w[1]) ? -w[1].color * 100 : 0;
+    }
+
+    int harami_cross(const Window &w)
+    {
+        if (!(is(w[1], LONG_BODY) & is(w[0], DOJI_BODY)))
+        {
+            return 0;
+        }
+        return top(w[0]) < top(w[1]) && bottom(w[0]) > bottom(w[1]) ? -w[1].color * 100 : 0;
+    }
+
+    int high_wave(const Window &w)
+    {
+        return is(w[0], SHORT_BODY) & is(w[0], UPPER_VERY_LONG) & is(w[0], LOWER_VERY_LONG) ? w[0].color * 100 : 0;
+    }
+
+    int homing_pigeon(const Window &w)
+    {
+        if (!(!white(w[1]) & is(w[1], LONG_BODY) & !white(w[0]) & is(w[0], SMALL_BODY)))
+        {
+            return 0;
+        }
+        return w[0].open < w[1].open && w[0].close > w[1].close ? 100 : 0;
+    }
+
+    int identical_three_crows(const Window &w)
+    {
+        if (!(!white(w[2]) & is(w[2], LOWER_VERY_SHORT) &
+              !white(w[1]) & is(w[1], LOWER_VERY_SHORT) &
+              !white(w[0]) & is(w[0], LOWER_VERY_SHORT)))
+        {
+            return 0;
+        }
+        return w[2].close > w[1].close && w[1].close > w[0].close &&
+                       w[1].open <= w[2].close + w[2].average[EQUAL] &&
+                       w[1].open >= w[2].close - w[2].average[EQUAL] &&
+                       w[0].open <= w[1].close + w[1].average[EQUAL] &&
+                       w[0].open >= w[1].close - w[1].average[EQUAL]
+                   ? -100
+                   : 0;
+    }
+
+    int in_neck(const Window &w)
+    {
+        if (!(!white(w[1]) & is(w[1], LONG_BODY) & white(w[0])))
+        {
+            return 0;
+        }
+        return w[0].open < w[1].low &&
+                       w[0].close <= w[1].close + w[1].average[EQUAL] &&
+                       w[0].close >= w[1].close
+                   ? -100
+                   : 0;
+    }
+
+    int inverted_hammer(const Window &w)
+    {
+        if (!(is(w[0], SHORT_BODY) & is(w[0], UPPER_LONG) & is(w[0], LOWER_VERY_SHORT)))
+        {
+            return 0;
+        }
+        return body_gap_down(w[0], w[1]) ? 100 : 0;
+    }
+
+    bool kicking_shape(const Window &w)
+    {
+        if (!((w[1].color == -w[0].color) &
+              is(w[1], LONG_BODY) & is(w[1], UPPER_VERY_SHORT) & is(w[1], LOWER_VERY_SHORT) &
+              is(w[0], LONG_BODY) & is(w[0], UPPER_VERY_SHORT) & is(w[0], LOWER_VERY_SHORT)))
+        {
+            return false;
+        }
+        return white(w[1]) ? gap_down(w[0], w[1]) : gap_up(w[0], w[1]);
+    }
+
+    int kicking(const Window &w)
+    {
+        return kicking_shape(w) ? w[0].color * 100 : 0;
+    }
+
+    int kicking_by_length(const Window &w)
+    {
+        return kicking_shape(w) ? (w[0].body > w[1].body ? w[0].color : w[1].color) * 100 : 0;
+    }
+
+    int ladder_bottom(const Window &w)
+    {
+        if (!(!white(w[4]) & !white(w[3]) & !white(w[2]) &
+              !white(w[1]) & is(w[1], UPPER_NOT_VERY_SHORT) & white(w[0])))
+        {
+            return 0;
+        }
+        return w[4].open > w[3].open && w[3].open > w[2].open &&
+                       w[4].close > w[3].close && w[3].close > w[2].close &&
+                       w[0].open > w[1].open && w[0].close > w[1].high
+                   ? 100
+                   : 0;
+    }
+
+    int long_legged_doji(const Window &w)
+    {
+        return is(w[0], DOJI_BODY) & (is(w[0], LOWER_LONG) | is(w[0], UPPER_LONG)) ? 100 : 0;
+    }
+
+    int long_line(const Window &w)
+    {
+        return is(w[0], LONG_BODY) & is(w[0], UPPER_SHORT) & is(w[0], LOWER_SHORT) ? w[0].color * 100 : 0;
+    }
+
+    int marubozu(const Window &w)
+    {
+        return is(w[0], LONG_BODY) & is(w[0], UPPER_VERY_SHORT) & is(w[0], LOWER_VERY_SHORT) ? w[0].color * 100 : 0;
+    }
+
+    int matching_low(const Window &w)
+    {
+        if (!(!white(w[1]) & !white(w[0])))
+        {
+            return 0;
+        }
+        return w[0].close <= w[1].close + w[1].average[EQUAL] &&
+                       w[0].close >= w[1].close - w[1].average[EQUAL]
+                   ? 100
+                   : 0;
+    }
+
+    int mat_hold(const Window &w)
+    {
+        if (!(white(w[4]) & is(w[4], LONG_BODY) &
+              !white(w[3]) & is(w[3], SHORT_BODY) &
+              is(w[2], SHORT_BODY) & is(w[1], SHORT_BODY) & white(w[0])))
+        {
+            return 0;
+        }
+        const double floor{w[4].close - w[4].body * hold_penetration};
+        return body_gap_up(w[3], w[4]) &&
+                       bottom(w[2]) < w[4].close && bottom(w[1]) < w[4].close &&
+                       bottom(w[2]) > floor && bottom(w[1]) > floor &&
+                       top(w[2]) < w[3].open && top(w[1]) < top(w[2]) &&
+                       w[0].open > w[1].close &&
+                       w[0].close > std::max(std::max(w[3].high, w[2].high), w[1].high)
+                   ? 100
+                   : 0;
+    }
+
+    int morning_doji_star(const Window &w)
+    {
+        if (!(!white(w[2]) & is(w[2], LONG_BODY) & is(w[1], DOJI_BODY) & white(w[0]) & !is(w[0], SMALL_BODY)))
+        {
+            return 0;
+        }
+        return body_gap_down(w[1], w[2]) &&
+                       w[0].close > w[2].close + w[2].body * star_penetration
+                   ? 100
+                   : 0;
+    }
+
+    int morning_star(const Window &w)
+    {
+        if (!(!white(w[2]) & is(w[2], LONG_BODY) & is(w[1], SMALL_BODY) & white(w[0]) & !is(w[0], SMALL_BODY)))
+        {
+            return 0;
+        }
+        return body_gap_down(w[1], w[2]) &&
+                       w[0].close > w[2].close + w[2].body * star_penetration
+                   ? 100
+                   : 0;
+    }
+
+    int on_neck(const Window &w)
+    {
+        if (!(!white(w[1]) & is(w[1], LONG_BODY) & white(w[0])))
+        {
+            return 0;
+        }
+        return w[0].open < w[1].low &&
+                       w[0].close <= w[1].low + w[1].average[EQUAL] &&
+                       w[0].close >= w[1].low - w[1].average[EQUAL]
+                   ? -100
+                   : 0;
+    }
+
+    int piercing(const Window &w)
+    {
+        if (!(!white(w[1]) & is(w[1], LONG_BODY) & white(w[0]) & is(w[0], LONG_BODY)))
+        {
+            return 0;
+        }
+        return w[0].open < w[1].low &&
+                       w[0].close < w[1].open &&
+                       w[0].close > w[1].close + w[1].body * 0.5
+                   ? 100
+                   : 0;
+    }
+
+    int rickshaw_man(const Window &w)
+    {
+        if (!(is(w[0], DOJI_BODY) & is(w[0], LOWER_LONG) & is(w[0], UPPER_LONG)))
+        {
+            return 0;
+        }
+        const double middle{w[0].low + w[0].range / 2};
+        return bottom(w[0]) <= middle + w[0].average[NEAR] &&
+                       top(w[0]) >= middle - w[0].average[NEAR]
+                   ? 100
+                   : 0;
+    }
+
+    int rise_fall_three_methods(const Window &w)
+    {
+        if (!(is(w[4], LONG_BODY) & is(w[3], SHORT_BODY) & is(w[2], SHORT_BODY) &
+              is(w[1], SHORT_BODY) & is(w[0], LONG_BODY) &
+              (w[4].color == -w[3].color) & (w[3].color == w[2].color) &
+              (w[2].color == w[1].color) & (w[1].color == -w[0].color)))
+        {
+            return 0;
+        }
+        const int color{w[4].color};
+        return bottom(w[3]) < w[4].high && top(w[3]) > w[4].low &&
+                       bottom(w[2]) < w[4].high && top(w[2]) > w[4].low &&
+                       bottom(w[1]) < w[4].high && top(w[1]) > w[4].low &&
+                       w[2].close * color < w[3].close * color &&
+                       w[1].close * color < w[2].close * color &&
+                       w[0].open * color > w[1].close * color &&
+                       w[0].close * color > w[4].close * color
+                   ? 100 * color
+                   : 0;
+    }
+
+    int separating_lines(const Window &w)
+    {
+        if (!((w[1].color == -w[0].color) & is(w[0], LONG_BODY) &
+              (white(w[0]) ? is(w[0], LOWER_VERY_SHORT) : is(w[0], UPPER_VERY_SHORT))))
+        {
+            return 0;
+        }
+        return w[0].open <= w[1].open + w[1].average[EQUAL] &&
+                       w[0].open >= w[1].open - w[1].average[EQUAL]
+                   ? w[0].color * 100
+                   : 0;
+    }
+
+    int shooting_star(const Window &w)
+    {
+        if (!(is(w[0], SHORT_BODY) & is(w[0], UPPER_LONG) & is(w[0], LOWER_VERY_SHORT)))
+        {
+            return 0;
+        }
+        return body_gap_up(w[0], w[1]) ? -100 : 0;
+    }
+
+    int short_line(const Window &w)
+    {
+        return is(w[0], SHORT_BODY) & is(w[0], UPPER_SHORT) & is(w[0], LOWER_SHORT) ? w[0].color * 100 : 0;
+    }
+
+    int spinning_top(const Window &w)
+    {
+        return is(w[0], SHORT_BODY) & (w[0].upper > w[0].body) & (w[0].lower > w[0].body) ? w[0].color * 100 : 0;
+    }
+
+    int stalled_pattern(const Window &w)
+    {
+        if (!(white(w[2]) & is(w[2], LONG_BODY) &
+              white(w[1]) & is(w[1], LONG_BODY) & is(w[1], UPPER_VERY_SHORT) &
+              white(w[0]) & is(w[0], SHORT_BODY)))
+        {
+            return 0;
+        }
+        return w[0].close > w[1].close && w[1].close > w[2].close &&
+                       w[1].open > w[2].open &&
+                       w[1].open <= w[2].close + w[2].average[NEAR] &&
+                       w[0].open >= w[1].close - w[0].body - w[1].average[NEAR]
+                   ? -100
+                   : 0;
+    }
+
+    int stick_sandwich(const Window &w)
+    {
+        if (!(!white(w[2]) & white(w[1]) & !white(w[0])))
+        {
+            return 0;
+        }
+        return w[1].low > w[2].close &&
+                       w[0].close <= w[2].close + w[2].average[EQUAL] &&
+                       w[0].close >= w[2].close - w[2].average[EQUAL]
+                   ? 100
+                   : 0;
+    }
+
+    int takuri(const Window &w)
+    {
+        return is(w[0], DOJI_BODY) & is(w[0], UPPER_VERY_SHORT) & is(w[0], LOWER_VERY_LONG) ? 100 : 0;
+    }
+
+    int tasuki_gap(const Window &w)
+    {
+        if (!(w[1].color == -w[0].color))
+        {
+            return 0;
+        }
+        const bool similar{fabs(w[1].body - w[0].body) < w[1].average[NEAR]};
+        if ((w[1].color == 1 && body_gap_up(w[1], w[2]) &&
+             w[0].open < w[1].close && w[0].open > w[1].open &&
+             w[0].close < w[1].open && w[0].close > top(w[2]) && similar) ||
+            (w[1].color == -1 && body_gap_down(w[1], w[2]) &&
+             w[0].open < w[1].open && w[0].open > w[1].close &&
+             w[0].close > w[1].open && w[0].close < bottom(w[2]) && similar))
+        {
+            return w[1].color * 100;
+        }
+        return 0;
+    }
+
+    int thrusting(const Window &w)
+    {
+        if (!(!white(w[1]) & is(w[1], LONG_BODY) & white(w[0])))
+        {
+            return 0;
+        }
+        return w[0].open < w[1].low &&
+                       w[0].close > w[1].close + w[1].average[EQUAL] &&
+                       w[0].close <= w[1].close + w[1].body * 0.5
+                   ? -100
+                   : 0;
+    }
+
+    // All three bodies are judged against the doji average of the first.
+    int tristar(const Window &w)
+    {
+        const double doji{w[2].average[BODY_DOJI]};
+        if (!(is(w[2], DOJI_BODY) & (w[1].body <= doji) & (w[0].body <= doji)))
+        {
+            return 0;
+        }
+        int result{0};
+        if (body_gap_up(w[1], w[2]) && top(w[0]) < top(w[1]))
+        {
+            result = -100;
+        }
+        if (body_gap_down(w[1], w[2]) && bottom(w[0]) > bottom(w[1]))
+        {
+            result = 100;
+        }
+        return result;
+    }
+
+    int unique_three_river(const Window &w)
+    {
+        if (!(!white(w[2]) & is(w[2], LONG_BODY) & !white(w[1]) & white(w[0]) & is(w[0], SHORT_BODY)))
+        {
+            return 0;
+        }
+        return w[1].close > w[2].close && w[1].open <= w[2].open && w[1].low < w[2].low &&
+                       w[0].open > w[1].low
+                   ? 100
+                   : 0;
+    }
+
+    int upside_gap_two_crows(const Window &w)
+    {
+        if (!(white(w[2]) & is(w[2], LONG_BODY) & !white(w[1]) & is(w[1], SMALL_BODY) & !white(w[0])))
+        {
+            return 0;
+        }
+        return body_gap_up(w[1], w[2]) &&
+                       w[0].open > w[1].open && w[0].close < w[1].close &&
+                       w[0].close > w[2].close
+                   ? -100
+                   : 0;
+    }
+
+    int xside_gap_three_methods(const Window &w)
+    {
+        if (!((w[2].color == w[1].color) & (w[1].color == -w[0].color)))
+        {
+            return 0;
+        }
+        if (w[0].open < top(w[1]) && w[0].open > bottom(w[1]) &&
+            w[0].close < top(w[2]) && w[0].close > bottom(w[2]) &&
+            (white(w[2]) ? body_gap_up(w[1], w[2]) : body_gap_down(w[1], w[2])))
+        {
+            return w[2].color * 100;
+        }
+        return 0;
+    }
+
+    // Hikkake and its modified form keep state across bars and are run by the
+    // Scanner itself, so they have no test here.
+    struct Rule
+    {
+        const char *name;
+        int lookback;
+        Test test;
+    };
+
+    const Rule rules[pattern_count]{
+        {"CDL2CROWS", 12, two_crows},
+        {"CDL3BLACKCROWS", 13, three_black_crows},
+        {"CDL3INSIDE", 12, three_inside},
+        {"CDL3LINESTRIKE", 8, three_line_strike},
+        {"CDL3OUTSIDE", 3, three_outside},
+        {"CDL3STARSINSOUTH", 12, three_stars_in_south},
+        {"CDL3WHITESOLDIERS", 12, three_white_soldiers},
+        {"CDLABANDONEDBABY", 12, abandoned_baby},
+        {"CDLADVANCEBLOCK", 12, advance_block},
+        {"CDLBELTHOLD", 10, belt_hold},
+        {"CDLBREAKAWAY", 14, breakaway},
+        {"CDLCLOSINGMARUBOZU", 10, closing_marubozu},
+        {"CDLCONCEALBABYSWALL", 13, conceal_baby_swallow},
+        {"CDLCOUNTERATTACK", 11, counterattack},
+        {"CDLDARKCLOUDCOVER", 11, dark_cloud_cover},
+        {"CDLDOJI", 10, doji},
+        {"CDLDOJISTAR", 11, doji_star},
+        {"CDLDRAGONFLYDOJI", 10, dragonfly_doji},
+        {"CDLENGULFING", 2, engulfing},
+        {"CDLEVENINGDOJISTAR", 12, evening_doji_star},
+        {"CDLEVENINGSTAR", 12, evening_star},
+        {"CDLGAPSIDESIDEWHITE", 7, gap_side_side_white},
+        {"CDLGRAVESTONEDOJI", 10, gravestone_doji},
+        {"CDLHAMMER", 11, hammer},
+        {"CDLHANGINGMAN", 11, hanging_man},
+        {"CDLHARAMI", 11, harami},
+        {"CDLHARAMICROSS", 11, harami_cross},
+        {"CDLHIGHWAVE", 10, high_wave},
+        {"CDLHIKKAKE", 5, nullptr},
+        {"CDLHIKKAKEMOD", 10, nullptr},
+        {"CDLHOMINGPIGEON", 11, homing_pigeon},
+        {"CDLIDENTICAL3CROWS", 12, identical_three_crows},
+        {"CDLINNECK", 11, in_neck},
+        {"CDLINVERTEDHAMMER", 11, inverted_hammer},
+        {"CDLKICKING", 11, kicking},
+        {"CDLKICKINGBYLENGTH", 11, kicking_by_length},
+        {"CDLLADDERBOTTOM", 14, ladder_bottom},
+        {"CDLLONGLEGGEDDOJI", 10, long_legged_doji},
+        {"CDLLONGLINE", 10, long_line},
+        {"CDLMARUBOZU", 10, marubozu},
+        {"CDLMATCHINGLOW", 6, matching_low},
+        {"CDLMATHOLD", 14, mat_hold},
+        {"CDLMORNINGDOJISTAR", 12, morning_doji_star},
+        {"CDLMORNINGSTAR", 12, morning_star},
+        {"CDLONNECK", 11, on_neck},
+        {"CDLPIERCING", 11, piercing},
+        {"CDLRICKSHAWMAN", 10, rickshaw_man},
+        {"CDLRISEFALL3METHODS", 14, rise_fall_three_methods},
+        {"CDLSEPARATINGLINES", 11, separating_lines},
+        {"CDLSHOOTINGSTAR", 11, shooting_star},
+        {"CDLSHORTLINE", 10, short_line},
+        {"CDLSPINNINGTOP", 10, spinning_top},
+        {"CDLSTALLEDPATTERN", 12, stalled_pattern},
+        {"CDLSTICKSANDWICH", 7, stick_sandwich},
+        {"CDLTAKURI", 10, takuri},
+        {"CDLTASUKIGAP", 7, tasuki_gap},
+        {"CDLTHRUSTING", 11, thrusting},
+        {"CDLTRISTAR", 12, tristar},
+        {"CDLUNIQUE3RIVER", 12, unique_three_river},
+        {"CDLUPSIDEGAP2CROWS", 12, upside_gap_two_crows},
+        {"CDLXSIDEGAP3METHODS", 2, xside_gap_three_methods},
+    };
+
+    // Longest window a pattern reads.
+    const int max_offset{4};
+
+    const char *name(Pattern pattern)
+    {
+        return rules[static_cast<int>(pattern)].name;
+    }
+
+    int lookback(Pattern pattern)
+    {
+        return rules[static_cast<int>(pattern)].lookback;
+    }
+
+    uint64_t bit(Pattern pattern)
+    {
+        return uint64_t{1} << static_cast<int>(pattern);
+    }
+
+    void mark(Signals &signals, Pattern pattern, int value)
+    {
+        if (value == 0)
+        {
+            return;
+        }
+        signals.found |= bit(pattern);
+        if (value > 0)
+        {
+            signals.bullish |= bit(pattern);
+        }
+        if (value >= 200 || value <= -200)
+        {
+            signals.confirmed |= bit(pattern);
+        }
+    }
+
+    bool Signals::has(Pattern pattern) const
+    {
+        return (found & bit(pattern)) != 0;
+    }
+
+    int Signals::value(Pattern pattern) const
+    {
+        if (!has(pattern))
+        {
+            return 0;
+        }
+        const int magnitude{(confirmed & bit(pattern)) ? 200 : 100};
+        return (bullish & bit(pattern)) ? magnitude : -magnitude;
+    }
+
+    void Scanner::reset()
+    {
+        seen = 0;
+        plain = Hikkake{};
+        modified = Hikkake{};
+    }
+
+    // One step of TA_CDLHIKKAKE's loop: a new inside-bar breakout replaces the
+    // pending one, otherwise a close beyond the bar before it within three bars
+    // confirms it.
+    int Scanner::hikkake(Hikkake &state, bool detected)
+    {
+        const int index{seen - 1};
+        const Candle &bar{back(0)};
+        if (detected)
+        {
+            state.result = bar.high < back(1).high ? 100 : -100;
+            state.index = index;
+            state.high = back(1).high;
+            state.low = back(1).low;
+            return state.result;
+        }
+        if (index <= state.index + 3 &&
+            ((state.result > 0 && bar.close > state.high) ||
+             (state.result < 0 && bar.close < state.low)))
+        {
+            state.index = 0;
+            return state.result + (state.result > 0 ? 100 : -100);
+        }
+        return 0;
+    }
+
+    Signals Scanner::update(float open, float high, float low, float close)
+    {
+        Candle &candle{bars[seen & (depth - 1)]};
+        candle.open = open;
+        candle.high = high;
+        candle.low = low;
+        candle.close = close;
+        candle.body = fabs(candle.close - candle.open);
+        candle.upper = candle.high - top(candle);
+        candle.lower = bottom(candle) - candle.low;
+        candle.range = candle.high - candle.low;
+        candle.color = candle.close >= candle.open ? 1 : -1;
+
+        // Every setting averages one of three ranges over the previous 10 or 5 bars (or
+        // takes the bar's own range), so one pass over the last ten bars gives all the
+        // window sums, each added oldest first like ta-lib's.
+        double long_sums[3]{};
+        double short_sums[3]{};
+        for (int k = std::min(seen, long_period); k >= 1; k--)
+        {
+            const Candle &bar{bars[(seen - k) & (depth - 1)]};
+            const double ranges[3]{bar.body, bar.range, bar.upper + bar.lower};
+            for (int r = 0; r < 3; r++)
+            {
+                long_sums[r] += ranges[r];
+                if (k <= short_period)
+                {
+                    short_sums[r] += ranges[r];
+                }
+            }
+        }
+        for (int s = 0; s < SETTING_COUNT; s++)
+        {
+            const Average &setting{settings[s]};
+            const double divisor{setting.range == SHADOWS ? 2.0 : 1.0};
+            if (setting.period == 0)
+            {
+                candle.average[s] = setting.factor * range_of(candle, setting.range) / divisor;
+            }
+            else if (seen < setting.period)
+            {
+                candle.average[s] = 0;
+            }
+            else
+            {
+                const double sum{setting.period == long_period ? long_sums[setting.range] : short_sums[setting.range]};
+                candle.average[s] = setting.factor * (sum / setting.period) / divisor;
+            }
+        }
+        candle.shape = shape_of(candle);
+
+        seen++;
+        const int index{seen - 1};
+
+        Signals signals;
+        Window w;
+        for (int k = 0; k <= max_offset; k++)
+        {
+            w.bars[k] = &back(std::min(k, index));
+        }
+        for (int p = 0; p < pattern_count; p++)
+        {
+            const Rule &rule{rules[p]};
+            if (rule.test != nullptr && index >= rule.lookback)
+            {
+                mark(signals, static_cast<Pattern>(p), rule.test(w));
+            }
+        }
+
+        // ta-lib starts each hikkake state machine three bars before its first output.
+        const int plain_lookback{lookback(Pattern::CDLHIKKAKE)};
+        if (index >= plain_lookback - 3)
+        {
+            const bool detected{w[1].high < w[2].high && w[1].low > w[2].low &&
+                                ((w[0].high < w[1].high && w[0].low < w[1].low) ||
+                                 (w[0].high > w[1].high && w[0].low > w[1].low))};
+            const int value{hikkake(plain, detected)};
+            if (index >= plain_lookback)
+            {
+                mark(signals, Pattern::CDLHIKKAKE, value);
+            }
+        }
+
+        const int modified_lookback{lookback(Pattern::CDLHIKKAKEMOD)};
+        if (index >= modified_lookback - 3)
+        {
+            const bool detected{w[2].high < w[3].high && w[2].low > w[3].low &&
+                                w[1].high < w[2].high && w[1].low > w[2].low &&
+                                ((w[0].high < w[1].high && w[0].low < w[1].low &&
+                                  w[2].close <= w[2].low + w[2].average[NEAR]) ||
+                                 (w[0].high > w[1].high && w[0].low > w[1].low &&
+                                  w[2].close >= w[2].high - w[2].average[NEAR]))};
+            const int value{hikkake(modified, detected)};
+            if (index >= modified_lookback)
+            {
+                mark(signals, Pattern::CDLHIKKAKEMOD, value);
+            }
+        }
+        return signals;
+    }
+
+    void scan(const float *open, const float *high, const float *low, const float *close, int size, std::vector<Signals> &out)
+    {
+        Scanner scanner;
+        out.resize(size);
+        for (int i = 0; i < size; i++)
+        {
+            out[i] = scanner.update(open[i], high[i], low[i], close[i]);
+        }
+    }
+
+    void scan(const std::vector<AlphaVantage::TimeSeries> &bars, std::vector<Signals> &out)
+    {
+        Scanner scanner;
+        out.resize(bars.size());
+        for (size_t i = 0; i < bars.size(); i++)
+        {
+            out[i] = scanner.update(bars[i].open, bars[i].high, bars[i].low, bars[i].close);
+        }
+    }
+}
@@ -0,0 +1,156 @@
+#include "models/fill.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Fill
+{
+    void Orders::add(int bar_, float qty_, float side_, float limit_)
+    {
+        bar.push_back(bar_);
+        qty.push_back(qty_);
+        side.push_back(side_);
+        limit.push_back(limit_);
+    }
+
+    void Fills::clear()
+    {
+        order.clear();
+        bar.clear();
+        qty.clear();
+        price.clear();
+    }
+
+    Bars columns(const std::vector<AlphaVantage::TimeSeries> &ts)
+    {
+        Bars bars;
+        bars.open.resize(ts.size());
+        bars.high.resize(ts.size());
+        bars.low.resize(ts.size());
+        bars.close.resize(ts.size());
+        bars.volume.resize(ts.size());
+        for (int i = 0; i < bars.size(); i++)
+        {
+            bars.open[i] = ts[i].open;
+            bars.high[i] = ts[i].high;
+            bars.low[i] = ts[i].low;
+            bars.close[i] = ts[i].close;
+            bars.volume[i] = ts[i].volume;
+        }
+        return bars;
+    }
+
+    namespace
+    {
+        int clamp_bar(int bar, int size)
+        {
+            return bar < size ? bar : size - 1;
+        }
+
+        void fill_limit(const Bars &bars, const Orders &orders, int i, Config config, Fills &fills)
+        {
+            const float limit{orders.limit[i]};
+            const bool buy{orders.side[i] > 0};
+            const int last{std::min(orders.bar[i] + config.limit_lifetime, bars.size() - 1)};
+            float remaining{orders.qty[i]};
+
+            for (int b = orders.bar[i] + 1; b <= last && remaining > 0; b++)
+            {
+                bool touched{buy ? bars.low[b] <= limit : bars.high[b] >= limit};
+                if (!touched)
+                {
+                    continue;
+                }
+
+                float available{config.max_participation * bars.volume[b]};
+                float qty{remaining < available ? remaining : available};
+                if (qty <= 0)
+                {
+                    continue;
+                }
+
+                float open{bars.open[b]};
+                float price{buy ? std::min(open, limit) : std::max(open, limit)};
+
+                fills.order.push_back(i);
+                fills.bar.push_back(b);
+                fills.qty.push_back(qty);
+                fills.price.push_back(price);
+                remaining -= qty;
+            }
+        }
+    }
+
+    void next_bar_open(const Bars &bars, const Orders &orders, float *out_price)
+    {
+        const int size{bars.size()};
+        const int *bar{orders.bar.data()};
+        const float *open{bars.open.data()};
+        for (int i = 0; i < orders.size(); i++)
+        {
+            out_price[i] = open[clamp_bar(bar[i] + 1, size)];
+        }
+    }
+
+    void bar_ohlc4(const Bars &bars, const Orders &orders, float *out_price)
+    {
+        const int size{bars.size()};
+        const int *bar{orders.bar.data()};
+        const float *open{bars.open.data()};
+        const float *high{bars.high.data()};
+        const float *low{bars.low.data()};
+        const float *close{bars.close.data()};
+        for (int i = 0; i < orders.size(); i++)
+        {
+            int b{clamp_bar(bar[i] + 1, size)};
+            out_price[i] = (open[b] + high[b] + low[b] + close[b]) * 0.25f;
+        }
+    }
+
+    void apply_slippage(const Bars &bars, const Orders &orders, Config config, float *inout_price)
+    {
+        const int size{bars.size()};
+        const int *bar{orders.bar.data()};
+        const float *qty{orders.qty.data()};
+        const float *side{orders.side.data()};
+        const float *volume{bars.volume.data()};
+        for (int i = 0; i < orders.size(); i++)
+        {
+            float bar_volume{volume[clamp_bar(bar[i] + 1, size)]};
+            float participation{bar_volume > 0 ? qty[i] / bar_volume : 1.0f};
+            float cost{config.half_spread + config.impact * std::sqrt(participation)};
+            inout_price[i] *= 1.0f + side[i] * cost;
+        }
+    }
+
+    void simulate(const Bars &bars, const Orders &orders, Config config, Fills &fills)
+    {
+        if (bars.size() == 0 || orders.size() == 0)
+        {
+            return;
+        }
+
+        std::vector<float> prices(orders.size());
+        config.model(bars, orders, prices.data());
+        apply_slippage(bars, orders, config, prices.data());
+
+        for (int i = 0; i < orders.size(); i++)
+        {
+            if (orders.bar[i] + 1 >= bars.size())
+            {
+                continue;
+            }
+
+            if (orders.limit[i] > 0)
+            {
+                fill_limit(bars, orders, i, config, fills);
+            }
+            else
+            {
+                fills.order.push_back(i);
+                fills.bar.push_back(orders.bar[i] + 1);
+                fills.qty.push_back(orders.qty[i]);
+                fills.price.push_back(prices[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,189 @@
+#include "models/graph.h"
+#include "models/base.h"
+#include "models/rolling.h"
+#include "models/ta.h"
+
+namespace Graph
+{
+    Node Frame::declare(Kind kind, Node input, int a, int b, int c)
+    {
+        for (int i = 0; i < definitions.size(); i++)
+        {
+            const Definition &d{definitions[i]};
+            if (d.kind == kind && d.input == input && d.a == a && d.b == b && d.c == c)
+            {
+                return i;
+            }
+        }
+
+        definitions.push_back(Definition{kind, input, a, b, c});
+        outputs.push_back(std::vector<float>());
+        fresh.push_back(false);
+        needed.push_back(0);
+        return definitions.size() - 1;
+    }
+
+    Node Frame::typical()
+    {
+        return declare(Kind::TYPICAL, -1);
+    }
+
+    Node Frame::rsi(Node input, int period)
+    {
+        return declare(Kind::RSI, input, period);
+    }
+
+    Node Frame::ema(Node input, int period)
+    {
+        return declare(Kind::EMA, input, period);
+    }
+
+    Node Frame::macd(Node input, int fast, int slow, int signal)
+    {
+        // The three MACD outputs are always declared together so they sit next to each
+        // other and can be filled by a single TA::MACD call.
+        Node line{declare(Kind::MACD, input, fast, slow, signal)};
+        declare(Kind::MACD_SIGNAL, input, fast, slow, signal);
+        declare(Kind::MACD_HIST, input, fast, slow, signal);
+        return line;
+    }
+
+    Node Frame::macd_signal(Node input, int fast, int slow, int signal)
+    {
+        return macd(input, fast, slow, signal) + 1;
+    }
+
+    Node Frame::macd_hist(Node input, int fast, int slow, int signal)
+    {
+        return macd(input, fast, slow, signal) + 2;
+    }
+
+    int Frame::lookback(Node node)
+    {
+        const Definition &d{definitions[node]};
+        switch (d.kind)
+        {
+        case Kind::RSI:
+            return TA_RSI_Lookback(d.a);
+        case Kind::EMA:
+            return TA_EMA_Lookback(d.a);
+        case Kind::MACD:
+        case Kind::MACD_SIGNAL:
+        case Kind::MACD_HIST:
+            return TA_MACD_Lookback(d.a, d.b, d.c);
+        default:
+            return 0;
+        }
+    }
+
+    void Frame::require(Node node, int count)
+    {
+        if (needed[node] >= count)
+        {
+            return;
+        }
+        needed[node] = count;
+        fresh[node] = false;
+
+        const Definition d{definitions[node]};
+        if (d.kind == Kind::MACD || d.kind == Kind::MACD_SIGNAL || d.kind == Kind::MACD_HIST)
+        {
+            Node line{node - (static_cast<int>(d.kind) - static_cast<int>(Kind::MACD))};
+            for (Node sibling = line; sibling < line + 3; sibling++)
+            {
+                if (needed[sibling] < count)
+                {
+                    needed[sibling] = count;
+                    fresh[sibling] = false;
+                }
+            }
+        }
+        if (d.input >= 0)
+        {
+            require(d.input, count + lookback(node));
+        }
+    }
+
+    void Frame::set_tail_only(bool enabled)
+    {
+        tail_only = enabled;
+        for (int i = 0; i < fresh.size(); i++)
+        {
+            fresh[i] = false;
+        }
+    }
+
+    int Frame::history()
+    {
+        return tail_only ? needed[typical()] : 0;
+    }
+
+    void Frame::evaluate(std::vector<AlphaVantage::TimeSeries> ts)
+    {
+        bars.swap(ts);
+        for (int i = 0; i < fresh.size(); i++)
+        {
+            fresh[i] = false;
+        }
+    }
+
+    const std::vector<float> &Frame::values(Node node)
+    {
+        if (!fresh[node])
+        {
+            compute(node);
+        }
+        return outputs[node];
+    }
+
+    float Frame::last(Node node)
+    {
+        const std::vector<float> &series{values(node)};
+        return series[series.size() - 1];
+    }
+
+    float Frame::slope(Node node, int period)
+    {
+        // Regression slope over the last period changes, i.e. period + 1 values.
+        const std::vector<float> &series{values(node)};
+        return Rolling::slope(series.data() + series.size() - (period + 1), period + 1);
+    }
+
+    void Frame::compute(Node node)
+    {
+        const Definition d{definitions[node]};
+        const int tail{tail_only ? needed[node] : 0};
+        outputs[node].clear();
+
+        switch (d.kind)
+        {
+        case Kind::TYPICAL:
+            outputs[node] = Base::typical_prices(bars);
+            break;
+        case Kind::RSI:
+            TA::RSI(values(d.input), d.a, outputs[node], tail);
+            break;
+        case Kind::EMA:
+            TA::EMA(values(d.input), d.a, outputs[node], tail);
+            break;
+        case Kind::MACD:
+        case Kind::MACD_SIGNAL:
+        case Kind::MACD_HIST:
+        {
+            Node line{node - (static_cast<int>(d.kind) - static_cast<int>(Kind::MACD))};
+            Node signal{line + 1};
+            Node hist{line + 2};
+            outputs[line].clear();
+            outputs[signal].clear();
+            outputs[hist].clear();
+            TA::MACD(values(d.input), d.a, d.b, d.c, outputs[line], outputs[signal], outputs[hist], tail);
+            fresh[line] = true;
+            fresh[signal] = true;
+            fresh[hist] = true;
+            break;
+        }
+        }
+
+        fresh[node] = true;
+    }
+}
@@ -0,0 +1,429 @@
+#include "models/kernels.h"
+#include "models/rolling.h"
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KERNELS_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Kernels
+{
+#ifdef KERNELS_X86
+    bool detect_avx2()
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    }
+
+    const bool avx2{detect_avx2()};
+#else
+    const bool avx2{false};
+#endif
+
+    // Cleared by set_simd(false) to run the scalar loops on any target.
+    bool simd{true};
+
+    bool has_avx2()
+    {
+        return avx2;
+    }
+
+    void set_simd(bool enabled)
+    {
+        simd = enabled;
+    }
+
+    void typical_prices_scalar(const float *high, const float *low, const float *close, int begin, int size, float *out)
+    {
+        for (int i = begin; i < size; i++)
+        {
+            out[i] = (high[i] + low[i] + close[i]) / 3;
+        }
+    }
+
+    void ema_rows_scalar(const float *row, float *state, int begin, int series, float k)
+    {
+        for (int s = begin; s < series; s++)
+        {
+            state[s] += (row[s] - state[s]) * k;
+        }
+    }
+
+    // One Wilder step of every series' average gain and loss, then its RSI, as in
+    // TA_RSI: 0 when both averages are (close to) 0.
+    void rsi_rows_scalar(const float *previous, const float *current, float *gain, float *loss, float *rsi, int begin, int series, float keep, float inverse)
+    {
+        for (int s = begin; s < series; s++)
+        {
+            float diff{current[s] - previous[s]};
+            gain[s] = (gain[s] * keep + (diff > 0 ? diff : 0.0f)) * inverse;
+            loss[s] = (loss[s] * keep + (diff < 0 ? -diff : 0.0f)) * inverse;
+            float total{gain[s] + loss[s]};
+            rsi[s] = total > 0.00000001f ? 100.0f * gain[s] / total : 0.0f;
+        }
+    }
+
+#ifdef KERNELS_X86
+    __attribute__((target("avx2,fma"))) void typical_prices_avx2(const float *high, const float *low, const float *close, int size, float *out)
+    {
+        const __m256 third{_mm256_set1_ps(1.0f / 3)};
+        int i{0};
+        for (; i + 8 <= size; i += 8)
+        {
+            __m256 sum{_mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(high + i), _mm256_loadu_ps(low + i)), _mm256_loadu_ps(close + i))};
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(sum, third));
+        }
+        typical_prices_scalar(high, low, close, i, size, out);
+    }
+
+    __attribute__((target("avx2,fma"))) void ema_rows_avx2(const float *row, float *state, int series, float k)
+    {
+        const __m256 k_{_mm256_set1_ps(k)};
+        int s{0};
+        for (; s + 8 <= series; s += 8)
+        {
+            __m256 prev{_mm256_loadu_ps(state + s)};
+            _mm256_storeu_ps(state + s, _mm256_fmadd_ps(_mm256_sub_ps(_mm256_loadu_ps(row + s), prev), k_, prev));
+        }
+        ema_rows_scalar(row, state, s, series, k);
+    }
+
+    __attribute__((target("avx2,fma"))) void rsi_rows_avx2(const float *previous, const float *current, float *gain, float *loss, float *rsi, int series, float keep, float inverse)
+    {
+        const __m256 zero{_mm256_setzero_ps()};
+        const __m256 keep_{_mm256_set1_ps(keep)};
+        const __m256 inverse_{_mm256_set1_ps(inverse)};
+        const __m256 hundred{_mm256_set1_ps(100.0f)};
+        const __m256 least{_mm256_set1_ps(0.00000001f)};
+        int s{0};
+        for (; s + 8 <= series; s += 8)
+        {
+            __m256 diff{_mm256_sub_ps(_mm256_loadu_ps(current + s), _mm256_loadu_ps(previous + s))};
+            __m256 up{_mm256_max_ps(diff, zero)};
+            __m256 down{_mm256_max_ps(_mm256_sub_ps(zero, diff), zero)};
+            __m256 g{_mm256_mul_ps(_mm256_fmadd_ps(_mm256_loadu_ps(gain + s), keep_, up), inverse_)};
+            __m256 l{_mm256_mul_ps(_mm256_fmadd_ps(_mm256_loadu_ps(loss + s), keep_, down), inverse_)};
+            _mm256_storeu_ps(gain + s, g);
+            _mm256_storeu_ps(loss + s, l);
+            __m256 total{_mm256_add_ps(g, l)};
+            __m256 value{_mm256_div_ps(_mm256_mul_ps(hundred, g), total)};
+            _mm256_storeu_ps(rsi + s, _mm256_and_ps(value, _mm256_cmp_ps(total, least, _CMP_GT_OQ)));
+        }
+        rsi_rows_scalar(previous, current, gain, loss, rsi, s, series, keep, inverse);
+    }
+#endif
+
+#ifdef KERNELS_NEON
+    void typical_prices_neon(const float *high, const float *low, const float *close, int size, float *out)
+    {
+        const float32x4_t third{vdupq_n_f32(1.0f / 3)};
+        int i{0};
+        for (; i + 4 <= size; i += 4)
+        {
+            float32x4_t sum{vaddq_f32(vaddq_f32(vld1q_f32(high + i), vld1q_f32(low + i)), vld1q_f32(close + i))};
+            vst1q_f32(out + i, vmulq_f32(sum, third));
+        }
+        typical_prices_scalar(high, low, close, i, size, out);
+    }
+
+    void ema_rows_neon(const float *row, float *state, int series, float k)
+    {
+        const float32x4_t k_{vdupq_n_f32(k)};
+        int s{0};
+        for (; s + 4 <= series; s += 4)
+        {
+            float32x4_t prev{vld1q_f32(state + s)};
+            vst1q_f32(state + s, vmlaq_f32(prev, vsubq_f32(vld1q_f32(row + s), prev), k_));
+        }
+        ema_rows_scalar(row, state, s, series, k);
+    }
+
+#ifdef __aarch64__
+    // vdivq_f32 is AArch64 only; 32-bit NEON keeps the scalar loop.
+    void rsi_rows_neon(const float *previous, const float *current, float *gain, float *loss, float *rsi, int series, float keep, float inverse)
+    {
+        const float32x4_t zero{vdupq_n_f32(0.0f)};
+        const float32x4_t keep_{vdupq_n_f32(keep)};
+        const float32x4_t inverse_{vdupq_n_f32(inverse)};
+        const float32x4_t hundred{vdupq_n_f32(100.0f)};
+        const float32x4_t least{vdupq_n_f32(0.00000001f)};
+        int s{0};
+        for (; s + 4 <= series; s += 4)
+        {
+            float32x4_t diff{vsubq_f32(vld1q_f32(current + s), vld1q_f32(previous + s))};
+            float32x4_t up{vmaxq_f32(diff, zero)};
+            float32x4_t down{vmaxq_f32(vnegq_f32(diff), zero)};
+            float32x4_t g{vmulq_f32(vmlaq_f32(up, vld1q_f32(gain + s), keep_), inverse_)};
+            float32x4_t l{vmulq_f32(vmlaq_f32(down, vld1q_f32(loss + s), keep_), inverse_)};
+            vst1q_f32(gain + s, g);
+            vst1q_f32(loss + s, l);
+            float32x4_t total{vaddq_f32(g, l)};
+            float32x4_t value{vdivq_f32(vmulq_f32(hundred, g), total)};
+            vst1q_f32(rsi + s, vbslq_f32(vcgtq_f32(total, least), value, zero));
+        }
+        rsi_rows_scalar(previous, current, gain, loss, rsi, s, series, keep, inverse);
+    }
+#endif
+#endif
+
+    void typical_prices(const float *high, const float *low, const float *close, int size, float *out)
+    {
+#if defined(KERNELS_X86)
+        if (avx2 && simd)
+        {
+            typical_prices_avx2(high, low, close, size, out);
+            return;
+        }
+#elif defined(KERNELS_NEON)
+        if (simd)
+        {
+            typical_prices_neon(high, low, close, size, out);
+            return;
+        }
+#endif
+        typical_prices_scalar(high, low, close, 0, size, out);
+    }
+
+    void ema_rows(const float *row, float *state, int series, float k)
+    {
+#if defined(KERNELS_X86)
+        if (avx2 && simd)
+        {
+            ema_rows_avx2(row, state, series, k);
+            return;
+        }
+#elif defined(KERNELS_NEON)
+        if (simd)
+        {
+            ema_rows_neon(row, state, series, k);
+            return;
+        }
+#endif
+        ema_rows_scalar(row, state, 0, series, k);
+    }
+
+    void rsi_rows(const float *previous, const float *current, float *gain, float *loss, float *rsi, int series, float keep, float inverse)
+    {
+#if defined(KERNELS_X86)
+        if (avx2 && simd)
+        {
+            rsi_rows_avx2(previous, current, gain, loss, rsi, series, keep, inverse);
+            return;
+        }
+#elif defined(KERNELS_NEON) && defined(__aarch64__)
+        if (simd)
+        {
+            rsi_rows_neon(previous, current, gain, loss, rsi, series, keep, inverse);
+            return;
+        }
+#endif
+        rsi_rows_scalar(previous, current, gain, loss, rsi, 0, series, keep, inverse);
+    }
+
+    // Rolling sums are a prefix scan over in[i + period - 1] - in[i - 1]. The scan is
+    // restarted from an exact double window sum every block so float error can't
+    // build up over long series.
+    const int rolling_block{1024};
+
+    double window_sum(const float *in, int start, int period)
+    {
+        double sum{0};
+        for (int i = 0; i < period; i++)
+        {
+            sum += in[start + i];
+        }
+        return sum;
+    }
+
+    void rolling_scalar(const float *in, int begin, int end, int period, float *out)
+    {
+        double sum{out[begin - 1]};
+        for (int i = begin; i < end; i++)
+        {
+            sum += in[i + period - 1] - in[i - 1];
+            out[i] = sum;
+        }
+    }
+
+#ifdef KERNELS_X86
+    __attribute__((target("avx2,fma"))) int rolling_block_avx2(const float *in, int begin, int end, int period, float *out)
+    {
+        const __m256 zero{_mm256_setzero_ps()};
+        const __m256i low_last{_mm256_set_epi32(3, 3, 3, 3, 0, 0, 0, 0)};
+        const __m256i last{_mm256_set1_epi32(7)};
+        __m256 carry{_mm256_set1_ps(out[begin - 1])};
+        int i{begin};
+        for (; i + 8 <= end; i += 8)
+        {
+            __m256 x{_mm256_sub_ps(_mm256_loadu_ps(in + i + period - 1), _mm256_loadu_ps(in + i - 1))};
+            x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 4)));
+            x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 8)));
+            x = _mm256_add_ps(x, _mm256_blend_ps(zero, _mm256_permutevar8x32_ps(x, low_last), 0xF0));
+            x = _mm256_add_ps(x, carry);
+            _mm256_storeu_ps(out + i, x);
+            carry = _mm256_permutevar8x32_ps(x, last);
+        }
+        return i;
+    }
+#endif
+
+#ifdef KERNELS_NEON
+    int rolling_block_neon(const float *in, int begin, int end, int period, float *out)
+    {
+        const float32x4_t zero{vdupq_n_f32(0)};
+        float32x4_t carry{vdupq_n_f32(out[begin - 1])};
+        int i{begin};
+        for (; i + 4 <= end; i += 4)
+        {
+            float32x4_t x{vsubq_f32(vld1q_f32(in + i + period - 1), vld1q_f32(in + i - 1))};
+            x = vaddq_f32(x, vextq_f32(zero, x, 3));
+            x = vaddq_f32(x, vextq_f32(zero, x, 2));
+            x = vaddq_f32(x, carry);
+            vst1q_f32(out + i, x);
+            carry = vdupq_n_f32(vgetq_lane_f32(x, 3));
+        }
+        return i;
+    }
+#endif
+
+    int rolling_sum(const float *in, int size, int period, float *out)
+    {
+        if (period < 1 || size < period)
+        {
+            return 0;
+        }
+
+        int count{size - period + 1};
+        for (int start = 0; start < count; start += rolling_block)
+        {
+            int end{start + rolling_block < count ? start + rolling_block : count};
+            out[start] = window_sum(in, start, period);
+            int i{start + 1};
+#if defined(KERNELS_X86)
+            if (avx2 && simd)
+            {
+                i = rolling_block_avx2(in, i, end, period, out);
+            }
+#elif defined(KERNELS_NEON)
+            if (simd)
+            {
+                i = rolling_block_neon(in, i, end, period, out);
+            }
+#endif
+            if (i < end)
+            {
+                rolling_scalar(in, i, end, period, out);
+            }
+        }
+        return count;
+    }
+
+    int sma(const float *in, int size, int period, float *out)
+    {
+        int count{rolling_sum(in, size, period, out)};
+        const float inverse{1.0f / period};
+        for (int i = 0; i < count; i++)
+        {
+            out[i] *= inverse;
+        }
+        return count;
+    }
+
+    int rolling_slope(const float *in, int size, int period, float *out)
+    {
+        // The regression slope the strategies use; it doesn't telescope into one
+        // difference, so it runs on the rolling moments rather than in SIMD lanes.
+        if (period < 1)
+        {
+            return 0;
+        }
+        return Rolling::slope(in, size, period + 1, out);
+    }
+
+    int ema_many(const float *in, int series, int size, int period, float *out)
+    {
+        if (period < 1 || size < period || series < 1)
+        {
+            return 0;
+        }
+
+        // Seed every series with its SMA over the first period rows, then update all
+        // series row by row so each step is a single pass over contiguous memory.
+        float *state{out};
+        for (int s = 0; s < series; s++)
+        {
+            state[s] = 0;
+        }
+        for (int t = 0; t < period; t++)
+        {
+            const float *row{in + t * series};
+            for (int s = 0; s < series; s++)
+            {
+                state[s] += row[s];
+            }
+        }
+        for (int s = 0; s < series; s++)
+        {
+            state[s] /= period;
+        }
+
+        const float k{2.0f / (period + 1)};
+        for (int t = period; t < size; t++)
+        {
+            float *next{state + series};
+            for (int s = 0; s < series; s++)
+            {
+                next[s] = state[s];
+            }
+            ema_rows(in + t * series, next, series, k);
+            state = next;
+        }
+        return size - period + 1;
+    }
+
+    int rsi_many(const float *in, int series, int size, int period, float *out)
+    {
+        if (period < 2 || size <= period || series < 1)
+        {
+            return 0;
+        }
+
+        // Seed every series with its plain average gain and loss over the first period
+        // changes, then apply Wilder's smoothing to all series row by row.
+        std::vector<float> gains(series, 0.0f);
+        std::vector<float> losses(series, 0.0f);
+        float *gain{gains.data()};
+        float *loss{losses.data()};
+        for (int t = 1; t <= period; t++)
+        {
+            const float *previous{in + (t - 1) * series};
+            const float *current{in + t * series};
+            for (int s = 0; s < series; s++)
+            {
+                float diff{current[s] - previous[s]};
+                gain[s] += diff > 0 ? diff : 0.0f;
+                loss[s] += diff < 0 ? -diff : 0.0f;
+            }
+        }
+
+        const float inverse{1.0f / period};
+        for (int s = 0; s < series; s++)
+        {
+            gain[s] *= inverse;
+            loss[s] *= inverse;
+            float total{gain[s] + loss[s]};
+            out[s] = total > 0.00000001f ? 100.0f * gain[s] / total : 0.0f;
+        }
+
+        const float keep{period - 1.0f};
+        for (int t = period + 1; t < size; t++)
+        {
+            rsi_rows(in + (t - 1) * series, in + t * series, gain, loss, out + (t - period) * series, series, keep, inverse);
+        }
+        return size - period;
+    }
+}
@@ -0,0 +1,174 @@
+#include "models/pairs.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+namespace Pairs
+{
+    // Symbols per tile side: a tile's float accumulators take 16KB, so they stay in L1
+    // with the two row slices while the steps stream past. Every chunk steps they're
+    // flushed into double totals, which bounds how many products a float sum collects.
+    const int tile{64};
+    const int chunk{256};
+
+    void returns(const Batch::Matrix &prices, Batch::Matrix &out)
+    {
+        const int symbols{prices.symbols};
+        out.resize(symbols, prices.steps > 1 ? prices.steps - 1 : 0);
+        for (int t = 0; t < out.steps; t++)
+        {
+            const float *last{prices.row(t)};
+            const float *price{prices.row(t + 1)};
+            float *change{out.row(t)};
+            for (int s = 0; s < symbols; s++)
+            {
+                change[s] = last[s] != 0 ? (price[s] - last[s]) / last[s] : 0;
+            }
+        }
+    }
+
+    void Matrix::resize(int symbols_)
+    {
+        symbols = symbols_;
+        correlations.assign(symbols_ * symbols_, 0);
+        betas.assign(symbols_ * symbols_, 0);
+    }
+
+    // Co-moments of symbols [first_i, first_i + ni) against [first_j, first_j + nj),
+    // written out as correlations and betas both ways round. partial and total are
+    // tile * tile scratch, kept off the stack for the small ESP32 task stacks.
+    void run_tile(const Batch::Matrix &centred, const std::vector<double> &sums, int first_i, int first_j, float *partial, double *total, Matrix &out)
+    {
+        const int ni{std::min(tile, centred.symbols - first_i)};
+        const int nj{std::min(tile, centred.symbols - first_j)};
+        std::fill(total, total + tile * tile, 0.0);
+
+        for (int start = 0; start < centred.steps; start += chunk)
+        {
+            const int end{std::min(start + chunk, centred.steps)};
+            std::fill(partial, partial + tile * tile, 0.0f);
+            for (int t = start; t < end; t++)
+            {
+                const float *x{centred.row(t) + first_i};
+                const float *y{centred.row(t) + first_j};
+                for (int i = 0; i < ni; i++)
+                {
+                    const float xi{x[i]};
+                    float *acc{partial + i * tile};
+                    for (int j = 0; j < nj; j++)
+                    {
+                        acc[j] += xi * y[j];
+                    }
+                }
+            }
+            for (int i = 0; i < ni; i++)
+            {
+                for (int j = 0; j < nj; j++)
+                {
+                    total[i * tile + j] += partial[i * tile + j];
+                }
+            }
+        }
+
+        const int symbols{out.symbols};
+        for (int i = 0; i < ni; i++)
+        {
+            const int a{first_i + i};
+            for (int j = 0; j < nj; j++)
+            {
+                const int b{first_j + j};
+                const double sxy{total[i * tile + j]};
+                const double sxx{sums[a]};
+                const double syy{sums[b]};
+                const float correlation{sxx > 0 && syy > 0 ? static_cast<float>(sxy / std::sqrt(sxx * syy)) : 0.0f};
+                out.correlations[a * symbols + b] = correlation;
+                out.correlations[b * symbols + a] = correlation;
+                out.betas[a * symbols + b] = sxx > 0 ? sxy / sxx : 0;
+                out.betas[b * symbols + a] = syy > 0 ? sxy / syy : 0;
+            }
+        }
+    }
+
+    bool matrix(const Batch::Matrix &returns, Matrix &out, int threads)
+    {
+        const int symbols{returns.symbols};
+        const int steps{returns.steps};
+        out.resize(symbols);
+        if (steps < 2)
+        {
+            return false;
+        }
+
+        // Deviations from each column's mean, so the sums below are the co-moments
+        // directly instead of raw sums that cancel (TA_CORREL's form).
+        std::vector<double> means(symbols, 0);
+        for (int t = 0; t < steps; t++)
+        {
+            const float *row{returns.row(t)};
+            for (int s = 0; s < symbols; s++)
+            {
+                means[s] += row[s];
+            }
+        }
+        for (int s = 0; s < symbols; s++)
+        {
+            means[s] /= steps;
+        }
+
+        Batch::Matrix centred;
+        centred.resize(symbols, steps);
+        std::vector<double> sums(symbols, 0);
+        for (int t = 0; t < steps; t++)
+        {
+            const float *row{returns.row(t)};
+            float *deviation{centred.row(t)};
+            for (int s = 0; s < symbols; s++)
+            {
+                deviation[s] = static_cast<float>(row[s] - means[s]);
+                sums[s] += static_cast<double>(deviation[s]) * deviation[s];
+            }
+        }
+
+        std::vector<std::pair<int, int>> tiles;
+        for (int i = 0; i < symbols; i += tile)
+        {
+            for (int j = i; j < symbols; j += tile)
+            {
+                tiles.emplace_back(i, j);
+            }
+        }
+
+        // Tiles never share an output element, so workers only need to agree on which
+        // tile is next.
+        std::atomic<int> next{0};
+        auto work = [&]()
+        {
+            std::vector<float> partial(tile * tile);
+            std::vector<double> total(tile * tile);
+            for (int k = next++; k < static_cast<int>(tiles.size()); k = next++)
+            {
+                run_tile(centred, sums, tiles[k].first, tiles[k].second, partial.data(), total.data(), out);
+            }
+        };
+
+        if (threads <= 0)
+        {
+            threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        }
+        threads = std::min(threads, static_cast<int>(tiles.size()));
+
+        std::vector<std::thread> workers;
+        for (int w = 1; w < threads; w++)
+        {
+            workers.emplace_back(work);
+        }
+        work();
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+        return true;
+    }
+}
@@ -0,0 +1,290 @@
+#include "models/rolling.h"
+#include <cmath>
+
+namespace Rolling
+{
+    void Moments::add(float x, float y)
+    {
+        n++;
+        float dx{x - mx};
+        float dy{y - my};
+        mx += dx / n;
+        my += dy / n;
+        sxx += dx * (x - mx);
+        syy += dy * (y - my);
+        sxy += dx * (y - my);
+    }
+
+    void Moments::remove(float x, float y)
+    {
+        if (n <= 1)
+        {
+            clear();
+            return;
+        }
+
+        // add() run backwards: the means step back first, then the deviations from the
+        // old and new means come off the sums.
+        n--;
+        float dx{x - mx};
+        float dy{y - my};
+        mx -= dx / n;
+        my -= dy / n;
+        sxx -= dx * (x - mx);
+        syy -= dy * (y - my);
+        sxy -= dy * (x - mx);
+    }
+
+    void Moments::clear()
+    {
+        n = 0;
+        mx = 0;
+        my = 0;
+        sxx = 0;
+        syy = 0;
+        sxy = 0;
+    }
+
+    float Moments::variance_x() const
+    {
+        return n > 0 && sxx > 0 ? sxx / n : 0;
+    }
+
+    float Moments::variance_y() const
+    {
+        return n > 0 && syy > 0 ? syy / n : 0;
+    }
+
+    float Moments::covariance() const
+    {
+        return n > 0 ? sxy / n : 0;
+    }
+
+    float Moments::slope() const
+    {
+        return sxx > 0 ? sxy / sxx : 0;
+    }
+
+    float Moments::intercept() const
+    {
+        return my - slope() * mx;
+    }
+
+    float Moments::correlation() const
+    {
+        return sxx > 0 && syy > 0 ? sxy / std::sqrt(sxx * syy) : 0;
+    }
+
+    Series::Series(int period) : period{period}, ring(period)
+    {
+    }
+
+    bool Series::update(float value)
+    {
+        if (filled == period)
+        {
+            // The oldest value leaves from x = 0 and the others move down one place.
+            moments.remove(0, ring[head] - origin);
+            moments.shift(-1);
+        }
+        else
+        {
+            if (filled == 0)
+            {
+                origin = value;
+            }
+            filled++;
+        }
+        moments.add(filled - 1, value - origin);
+
+        ring[head] = value;
+        head = (head + 1) % period;
+        if (++updates == rebuild_windows * period)
+        {
+            rebuild();
+        }
+        return ready();
+    }
+
+    void Series::reset()
+    {
+        head = 0;
+        filled = 0;
+        updates = 0;
+        moments.clear();
+    }
+
+    float Series::at(int i) const
+    {
+        return filled == period ? ring[(head + i) % period] : ring[i];
+    }
+
+    float Series::stddev() const
+    {
+        return std::sqrt(variance());
+    }
+
+    float Series::linearreg() const
+    {
+        return intercept() + slope() * (filled - 1);
+    }
+
+    float Series::mean() const
+    {
+        return moments.mean_y() + origin;
+    }
+
+    float Series::intercept() const
+    {
+        return moments.intercept() + origin;
+    }
+
+    void Series::rebuild()
+    {
+        origin = mean();
+        moments.clear();
+        for (int i = 0; i < filled; i++)
+        {
+            moments.add(i, at(i) - origin);
+        }
+        updates = 0;
+    }
+
+    Pair::Pair(int period) : period{period}, ring_x(period), ring_y(period)
+    {
+    }
+
+    bool Pair::update(float x, float y)
+    {
+        if (filled == period)
+        {
+            moments.remove(ring_x[head] - origin_x, ring_y[head] - origin_y);
+        }
+        else
+        {
+            if (filled == 0)
+            {
+                origin_x = x;
+                origin_y = y;
+            }
+            filled++;
+        }
+        moments.add(x - origin_x, y - origin_y);
+
+        ring_x[head] = x;
+        ring_y[head] = y;
+        head = (head + 1) % period;
+        if (++updates == rebuild_windows * period)
+        {
+            rebuild();
+        }
+        return ready();
+    }
+
+    void Pair::reset()
+    {
+        head = 0;
+        filled = 0;
+        updates = 0;
+        moments.clear();
+    }
+
+    void Pair::rebuild()
+    {
+        origin_x += moments.mean_x();
+        origin_y += moments.mean_y();
+        moments.clear();
+        const int oldest{filled == period ? head : 0};
+        for (int i = 0; i < filled; i++)
+        {
+            const int j{(oldest + i) % period};
+            moments.add(ring_x[j] - origin_x, ring_y[j] - origin_y);
+        }
+        updates = 0;
+    }
+
+    float slope(const float *values, int count)
+    {
+        Moments moments;
+        for (int i = 0; i < count; i++)
+        {
+            moments.add(i, values[i] - values[0]);
+        }
+        return moments.slope();
+    }
+
+    int series_stat(const float *in, int size, int period, float *out, float (Series::*stat)() const)
+    {
+        if (period < 1 || size < period)
+        {
+            return 0;
+        }
+
+        Series series(period);
+        int count{0};
+        for (int i = 0; i < size; i++)
+        {
+            if (series.update(in[i]))
+            {
+                out[count++] = (series.*stat)();
+            }
+        }
+        return count;
+    }
+
+    int pair_stat(const float *x, const float *y, int size, int period, float *out, float (Pair::*stat)() const)
+    {
+        if (period < 1 || size < period)
+        {
+            return 0;
+        }
+
+        Pair pair(period);
+        int count{0};
+        for (int i = 0; i < size; i++)
+        {
+            if (pair.update(x[i], y[i]))
+            {
+                out[count++] = (pair.*stat)();
+            }
+        }
+        return count;
+    }
+
+    int variance(const float *in, int size, int period, float *out)
+    {
+        return windows(in, size, period, [out](int n, float, float variance)
+                       { out[n] = variance; });
+    }
+
+    int stddev(const float *in, int size, int period, float *out)
+    {
+        return windows(in, size, period, [out](int n, float, float variance)
+                       { out[n] = std::sqrt(variance); });
+    }
+
+    int slope(const float *in, int size, int period, float *out)
+    {
+        return series_stat(in, size, period, out, &Series::slope);
+    }
+
+    int intercept(const float *in, int size, int period, float *out)
+    {
+        return series_stat(in, size, period, out, &Series::intercept);
+    }
+
+    int linearreg(const float *in, int size, int period, float *out)
+    {
+        return series_stat(in, size, period, out, &Series::linearreg);
+    }
+
+    int correlation(const float *x, const float *y, int size, int period, float *out)
+    {
+        return pair_stat(x, y, size, period, out, &Pair::correlation);
+    }
+
+    int beta(const float *x, const float *y, int size, int period, float *out)
+    {
+        return pair_stat(x, y, size, period, out, &Pair::beta);
+    }
+}
@@ -0,0 +1,80 @@
+#include "models/state.h"
+#include <Preferences.h>
+
+#define STATE_NAMESPACE "state"
+#define STATE_VERSION 3
+
+namespace State
+{
+    Mark mark(const AlphaVantage::TimeSeries &bar)
+    {
+        return Mark{bar.open, bar.high, bar.low, bar.close};
+    }
+
+    int resume_from(const std::vector<AlphaVantage::TimeSeries> &bars, const Mark &mark)
+    {
+        for (int i = bars.size() - 1; i >= 0; i--)
+        {
+            const AlphaVantage::TimeSeries &bar{bars[i]};
+            if (bar.open == mark.open && bar.high == mark.high && bar.low == mark.low && bar.close == mark.close)
+            {
+                return i + 1;
+            }
+        }
+        return -1;
+    }
+
+    bool save(const char *key, const Stream::Snapshot &snapshot, const Mark &mark)
+    {
+        Stream::Snapshot record;
+        record.put(static_cast<uint8_t>(STATE_VERSION));
+        record.put(mark);
+        record.bytes.insert(record.bytes.end(), snapshot.bytes.begin(), snapshot.bytes.end());
+
+        Preferences preferences;
+        if (!preferences.begin(STATE_NAMESPACE, false))
+        {
+            Serial.println("State: failed to open NVS");
+            return false;
+        }
+        size_t written{preferences.putBytes(key, record.bytes.data(), record.bytes.size())};
+        preferences.end();
+        return written == record.bytes.size();
+    }
+
+    bool load(const char *key, Stream::Snapshot &snapshot, Mark &mark)
+    {
+        Preferences preferences;
+        if (!preferences.begin(STATE_NAMESPACE, true))
+        {
+            return false;
+        }
+        size_t size{preferences.getBytesLength(key)};
+        Stream::Snapshot record;
+        record.bytes.resize(size);
+        if (size > 0)
+        {
+            preferences.getBytes(key, record.bytes.data(), size);
+        }
+        preferences.end();
+
+        if (!record.expect(static_cast<uint8_t>(STATE_VERSION)) || !record.get(mark))
+        {
+            return false;
+        }
+        const size_t header{sizeof(uint8_t) + sizeof(Mark)};
+        snapshot.clear();
+        snapshot.bytes.assign(record.bytes.begin() + header, record.bytes.end());
+        return true;
+    }
+
+    void forget(const char *key)
+    {
+        Preferences preferences;
+        if (preferences.begin(STATE_NAMESPACE, false))
+        {
+            preferences.remove(key);
+            preferences.end();
+        }
+    }
+}
@@ -0,0 +1,249 @@
+#include "models/stream.h"
+
+namespace Stream
+{
+    EMA::EMA(int period) : period{period}, k{2.0f / (period + 1)}
+    {
+    }
+
+    bool EMA::update(float value)
+    {
+        if (count < period)
+        {
+            sum += value;
+            count++;
+            if (count == period)
+            {
+                current = sum / period;
+            }
+            return ready();
+        }
+
+        current += (value - current) * k;
+        return true;
+    }
+
+    void EMA::save(Snapshot &snapshot) const
+    {
+        snapshot.put(period);
+        snapshot.put(count);
+        snapshot.put(sum);
+        snapshot.put(current);
+    }
+
+    // restore() reads into a copy and commits it only once the whole record was read.
+    bool EMA::restore(Snapshot &snapshot)
+    {
+        EMA restored{*this};
+        if (!(snapshot.expect(period) && snapshot.get(restored.count) && snapshot.get(restored.sum) && snapshot.get(restored.current)))
+        {
+            return false;
+        }
+        *this = restored;
+        return true;
+    }
+
+    RSI::RSI(int period) : period{period}
+    {
+    }
+
+    bool RSI::update(float price)
+    {
+        if (count == 0)
+        {
+            last_price = price;
+            count++;
+            return false;
+        }
+
+        float diff{price - last_price};
+        last_price = price;
+
+        if (count <= period)
+        {
+            if (diff < 0)
+            {
+                loss -= diff;
+            }
+            else
+            {
+                gain += diff;
+            }
+            count++;
+            if (count <= period)
+            {
+                return false;
+            }
+            gain /= period;
+            loss /= period;
+        }
+        else
+        {
+            gain *= period - 1;
+            loss *= period - 1;
+            if (diff < 0)
+            {
+                loss -= diff;
+            }
+            else
+            {
+                gain += diff;
+            }
+            gain /= period;
+            loss /= period;
+        }
+
+        float total{gain + loss};
+        current = (total > -0.00000001f && total < 0.00000001f) ? 0.0f : 100.0f * (gain / total);
+        return true;
+    }
+
+    void RSI::save(Snapshot &snapshot) const
+    {
+        snapshot.put(period);
+        snapshot.put(count);
+        snapshot.put(last_price);
+        snapshot.put(gain);
+        snapshot.put(loss);
+        snapshot.put(current);
+    }
+
+    bool RSI::restore(Snapshot &snapshot)
+    {
+        RSI restored{*this};
+        if (!(snapshot.expect(period) && snapshot.get(restored.count) && snapshot.get(restored.last_price) && snapshot.get(restored.gain) && snapshot.get(restored.loss) && snapshot.get(restored.current)))
+        {
+            return false;
+        }
+        *this = restored;
+        return true;
+    }
+
+    MACD::MACD(int fast_period, int slow_period, int signal_period)
+        : fast_period{fast_period < slow_period ? fast_period : slow_period},
+          slow_period{fast_period < slow_period ? slow_period : fast_period},
+          signal_ema{signal_period}
+    {
+        fast_k = 2.0f / (this->fast_period + 1);
+        slow_k = 2.0f / (this->slow_period + 1);
+    }
+
+    bool MACD::update(float price)
+    {
+        if (count < slow_period)
+        {
+            // Like TA_MACD, the fast EMA is seeded from the bars just before the slow
+            // EMA's first value rather than from the start of the series.
+            slow_sum += price;
+            if (count >= slow_period - fast_period)
+            {
+                fast_sum += price;
+            }
+            count++;
+            if (count < slow_period)
+            {
+                return false;
+            }
+            fast = fast_sum / fast_period;
+            slow = slow_sum / slow_period;
+        }
+        else
+        {
+            fast += (price - fast) * fast_k;
+            slow += (price - slow) * slow_k;
+        }
+
+        current_macd = fast - slow;
+        return signal_ema.update(current_macd);
+    }
+
+    void MACD::save(Snapshot &snapshot) const
+    {
+        snapshot.put(fast_period);
+        snapshot.put(slow_period);
+        snapshot.put(count);
+        snapshot.put(fast_sum);
+        snapshot.put(slow_sum);
+        snapshot.put(fast);
+        snapshot.put(slow);
+        snapshot.put(current_macd);
+        signal_ema.save(snapshot);
+    }
+
+    bool MACD::restore(Snapshot &snapshot)
+    {
+        MACD restored{*this};
+        if (!(snapshot.expect(fast_period) && snapshot.expect(slow_period) && snapshot.get(restored.count) && snapshot.get(restored.fast_sum) && snapshot.get(restored.slow_sum) && snapshot.get(restored.fast) && snapshot.get(restored.slow) && snapshot.get(restored.current_macd) && restored.signal_ema.restore(snapshot)))
+        {
+            return false;
+        }
+        *this = restored;
+        return true;
+    }
+
+    RSIEMA::RSIEMA(int rsi_period, int ema_period) : rsi_{rsi_period}, ema_{ema_period}
+    {
+    }
+
+    bool RSIEMA::update(float price)
+    {
+        if (!rsi_.update(price))
+        {
+            return false;
+        }
+        return ema_.update(rsi_.value());
+    }
+
+    void RSIEMA::save(Snapshot &snapshot) const
+    {
+        rsi_.save(snapshot);
+        ema_.save(snapshot);
+    }
+
+    bool RSIEMA::restore(Snapshot &snapshot)
+    {
+        RSIEMA restored{*this};
+        if (!(restored.rsi_.restore(snapshot) && restored.ema_.restore(snapshot)))
+        {
+            return false;
+        }
+        *this = restored;
+        return true;
+    }
+
+    Slope::Slope(int period) : period{period}, series(period + 1)
+    {
+    }
+
+    // Only the window is stored; restore() feeds it back through the series.
+    void Slope::save(Snapshot &snapshot) const
+    {
+        snapshot.put(period);
+        snapshot.put(series.size());
+        for (int i = 0; i < series.size(); i++)
+        {
+            snapshot.put(series.at(i));
+        }
+    }
+
+    bool Slope::restore(Snapshot &snapshot)
+    {
+        int size;
+        if (!snapshot.expect(period) || !snapshot.get(size) || size < 0 || size > period + 1)
+        {
+            return false;
+        }
+        Rolling::Series restored(period + 1);
+        for (int i = 0; i < size; i++)
+        {
+            float value;
+            if (!snapshot.get(value))
+            {
+                return false;
+            }
+            restored.update(value);
+        }
+        series = restored;
+        return true;
+    }
+}
@@ -0,0 +1,237 @@
+#include "models/sweep.h"
+#include <cmath>
+
+namespace Sweep
+{
+    void Matrix::resize(int sets_, int size_)
+    {
+        sets = sets_;
+        size = size_;
+        values.assign(sets_ * size_, NAN);
+    }
+
+    namespace
+    {
+        bool valid_period(int period, int min = 2)
+        {
+            return period >= min && period <= 100000;
+        }
+
+        bool valid_periods(const std::vector<int> &periods)
+        {
+            for (int period : periods)
+            {
+                if (!valid_period(period))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // prefix[i] is the sum of in[0..i-1], kept in double so any window sum (and so any
+        // period's SMA seed) comes out of one subtraction.
+        std::vector<double> prefix_sums(const float *in, int size)
+        {
+            std::vector<double> prefix(size + 1);
+            prefix[0] = 0;
+            for (int i = 0; i < size; i++)
+            {
+                prefix[i + 1] = prefix[i] + in[i];
+            }
+            return prefix;
+        }
+
+        float window_mean(const std::vector<double> &prefix, int end, int period)
+        {
+            return (prefix[end + 1] - prefix[end + 1 - period]) / period;
+        }
+    }
+
+    bool EMA(const float *in, int size, const std::vector<int> &periods, Matrix &out)
+    {
+        if (!valid_periods(periods))
+        {
+            out.resize(0, 0);
+            return false;
+        }
+
+        const int sets{static_cast<int>(periods.size())};
+        out.resize(sets, size);
+        std::vector<double> prefix{prefix_sums(in, size)};
+        std::vector<float> k(sets);
+        std::vector<float> state(sets, 0.0f);
+        for (int p = 0; p < sets; p++)
+        {
+            k[p] = 2.0f / (periods[p] + 1);
+        }
+
+        for (int t = 0; t < size; t++)
+        {
+            float *row{out.row(t)};
+            const float price{in[t]};
+            for (int p = 0; p < sets; p++)
+            {
+                int start{periods[p] - 1};
+                if (t > start)
+                {
+                    state[p] += (price - state[p]) * k[p];
+                    row[p] = state[p];
+                }
+                else if (t == start)
+                {
+                    state[p] = window_mean(prefix, t, periods[p]);
+                    row[p] = state[p];
+                }
+            }
+        }
+        return true;
+    }
+
+    bool RSI(const float *in, int size, const std::vector<int> &periods, Matrix &out)
+    {
+        if (!valid_periods(periods))
+        {
+            out.resize(0, 0);
+            return false;
+        }
+
+        const int sets{static_cast<int>(periods.size())};
+        out.resize(sets, size);
+        if (size < 2)
+        {
+            return true;
+        }
+
+        // Gains and losses are shared by every period: prefix sums give each period's
+        // seed averages, then all periods apply Wilder smoothing to the same diff.
+        std::vector<double> gain_prefix(size, 0.0);
+        std::vector<double> loss_prefix(size, 0.0);
+        for (int t = 1; t < size; t++)
+        {
+            float diff{in[t] - in[t - 1]};
+            gain_prefix[t] = gain_prefix[t - 1] + (diff > 0 ? diff : 0.0f);
+            loss_prefix[t] = loss_prefix[t - 1] + (diff < 0 ? -diff : 0.0f);
+        }
+
+        std::vector<float> gain(sets, 0.0f);
+        std::vector<float> loss(sets, 0.0f);
+        for (int t = 1; t < size; t++)
+        {
+            float *row{out.row(t)};
+            float diff{in[t] - in[t - 1]};
+            float up{diff > 0 ? diff : 0.0f};
+            float down{diff < 0 ? -diff : 0.0f};
+            for (int p = 0; p < sets; p++)
+            {
+                int period{periods[p]};
+                if (t < period)
+                {
+                    continue;
+                }
+                if (t == period)
+                {
+                    gain[p] = gain_prefix[t] / period;
+                    loss[p] = loss_prefix[t] / period;
+                }
+                else
+                {
+                    gain[p] = (gain[p] * (period - 1) + up) / period;
+                    loss[p] = (loss[p] * (period - 1) + down) / period;
+                }
+                float total{gain[p] + loss[p]};
+                row[p] = total > 0.00000001f ? 100.0f * (gain[p] / total) : 0.0f;
+            }
+        }
+        return true;
+    }
+
+    bool MACD(const float *in, int size, const std::vector<int> &fastPeriods, const std::vector<int> &slowPeriods, int signalPeriod, std::vector<std::pair<int, int>> &pairs, Matrix &outMACD, Matrix &outMACDSignal, Matrix &outMACDHist)
+    {
+        pairs.clear();
+        if (!valid_periods(fastPeriods) || !valid_periods(slowPeriods) || !valid_period(signalPeriod, 1))
+        {
+            outMACD.resize(0, 0);
+            outMACDSignal.resize(0, 0);
+            outMACDHist.resize(0, 0);
+            return false;
+        }
+
+        for (int fastPeriod : fastPeriods)
+        {
+            for (int slowPeriod : slowPeriods)
+            {
+                if (fastPeriod < slowPeriod)
+                {
+                    pairs.push_back(std::make_pair(fastPeriod, slowPeriod));
+                }
+            }
+        }
+
+        const int sets{static_cast<int>(pairs.size())};
+        outMACD.resize(sets, size);
+        outMACDSignal.resize(sets, size);
+        outMACDHist.resize(sets, size);
+
+        // The fast EMA depends on the pair because TA_MACD seeds it from the fastPeriod
+        // bars ending on the slow EMA's first bar; the seeds all come from one prefix sum.
+        std::vector<double> prefix{prefix_sums(in, size)};
+        std::vector<float> fast_k(sets);
+        std::vector<float> slow_k(sets);
+        std::vector<float> fast(sets, 0.0f);
+        std::vector<float> slow(sets, 0.0f);
+        std::vector<float> signal(sets, 0.0f);
+        const float signal_k{2.0f / (signalPeriod + 1)};
+        for (int i = 0; i < sets; i++)
+        {
+            fast_k[i] = 2.0f / (pairs[i].first + 1);
+            slow_k[i] = 2.0f / (pairs[i].second + 1);
+        }
+
+        for (int t = 0; t < size; t++)
+        {
+            const float price{in[t]};
+            float *macd_row{outMACD.row(t)};
+            float *signal_row{outMACDSignal.row(t)};
+            float *hist_row{outMACDHist.row(t)};
+            for (int i = 0; i < sets; i++)
+            {
+                int start{pairs[i].second - 1};
+                if (t < start)
+                {
+                    continue;
+                }
+                if (t == start)
+                {
+                    fast[i] = window_mean(prefix, t, pairs[i].first);
+                    slow[i] = window_mean(prefix, t, pairs[i].second);
+                }
+                else
+                {
+                    fast[i] += (price - fast[i]) * fast_k[i];
+                    slow[i] += (price - slow[i]) * slow_k[i];
+                }
+
+                float line{fast[i] - slow[i]};
+                int seen{t - start + 1};
+                if (seen < signalPeriod)
+                {
+                    signal[i] += line;
+                    continue;
+                }
+                if (seen == signalPeriod)
+                {
+                    signal[i] = (signal[i] + line) / signalPeriod;
+                }
+                else
+                {
+                    signal[i] += (line - signal[i]) * signal_k;
+                }
+                macd_row[i] = line;
+                signal_row[i] = signal[i];
+                hist_row[i] = line - signal[i];
+            }
+        }
+        return true;
+    }
+}
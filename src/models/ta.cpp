@@ -1,8 +1,92 @@
 #include "models/base.h"
 #include "models/ta.h"
+#include "models/ta_float.h"
+#include "models/ta_fixed.h"
 
 namespace TA
 {
+    namespace Scratch
+    {
+        // One arena per thread; init() and init_thread() size it for their thread.
+        thread_local double *buffer{nullptr};
+        thread_local size_t capacity{0};
+        thread_local size_t used{0};
+        thread_local size_t peak{0};
+
+        void init(size_t capacity_)
+        {
+            if (buffer != nullptr)
+            {
+                return;
+            }
+            buffer = new double[capacity_];
+            capacity = capacity_;
+        }
+
+        double *take(size_t count)
+        {
+            if (buffer == nullptr || used + count > capacity)
+            {
+                Serial.println("TA scratch exhausted");
+                return nullptr;
+            }
+            double *block{buffer + used};
+            used += count;
+            if (used > peak)
+            {
+                peak = used;
+            }
+            return block;
+        }
+
+        size_t mark()
+        {
+            return used;
+        }
+
+        void rewind(size_t mark)
+        {
+            used = mark;
+        }
+
+        void reset()
+        {
+            used = 0;
+        }
+
+        void release()
+        {
+            delete[] buffer;
+            buffer = nullptr;
+            capacity = 0;
+            used = 0;
+            peak = 0;
+        }
+
+        size_t high_water()
+        {
+            return peak;
+        }
+    }
+
+    namespace
+    {
+        thread_local TA_Context *context{nullptr};
+        thread_local double *workspace{nullptr};
+
+        // ta-lib keeps the workspace in the calling thread's settings.
+        void init_workspace()
+        {
+#ifdef TA_WORKSPACE_DOUBLES
+            if (workspace == nullptr)
+            {
+                workspace = new double[TA_WORKSPACE_DOUBLES];
+            }
+            TA_SetWorkspace(workspace, TA_WORKSPACE_DOUBLES * sizeof(double));
+#endif
+        }
+    }
+
     void init()
     {
         int retCode = TA_Initialize();
@@ -10,91 +94,257 @@ namespace TA
         {
             Serial.println("TA_Initialize failed");
         }
+#ifdef TA_SCRATCH_DOUBLES
+        Scratch::init(TA_SCRATCH_DOUBLES);
+#endif
+        init_workspace();
     }
 
-    TA_RetCode EMA(std::vector<float> &prices, int period, std::vector<float> &outReal)
+    void set_unstable_period(int period)
     {
-        int startIdx = 0;
+        TA_SetUnstablePeriod(TA_FUNC_UNST_EMA, period);
+        TA_SetUnstablePeriod(TA_FUNC_UNST_RSI, period);
+    }
+
+    void init_thread()
+    {
+        if (context == nullptr)
+        {
+            TA_Context *copy{nullptr};
+            if (TA_ContextAlloc(&copy) != TA_SUCCESS || TA_SetThreadContext(copy) != TA_SUCCESS)
+            {
+                Serial.println("TA_ContextAlloc failed");
+                TA_ContextFree(copy);
+                return;
+            }
+            context = copy;
+        }
+#ifdef TA_SCRATCH_DOUBLES
+        Scratch::init(TA_SCRATCH_DOUBLES);
+#endif
+        init_workspace();
+    }
+
+    void shutdown_thread()
+    {
+        if (context != nullptr)
+        {
+            TA_SetThreadContext(nullptr);
+            TA_ContextFree(context);
+            context = nullptr;
+        }
+        Scratch::release();
+        delete[] workspace;
+        workspace = nullptr;
+    }
+
+#ifdef TA_FIXED_POINT
+    // Q15.16 buffers carved out of the double scratch, two values per double.
+    Fixed::q16 *take_fixed(size_t count)
+    {
+        return reinterpret_cast<Fixed::q16 *>(Scratch::take((count + 1) / 2));
+    }
+
+    Fixed::q16 *to_fixed(const float *in, int size)
+    {
+        Fixed::q16 *out{take_fixed(size)};
+        if (out != nullptr)
+        {
+            for (int i = 0; i < size; i++)
+            {
+                out[i] = Fixed::from_float(in[i]);
+            }
+        }
+        return out;
+    }
+
+    void from_fixed(const Fixed::q16 *in, int size, std::vector<float> &out)
+    {
+        out.reserve(out.size() + size);
+        for (int i = 0; i < size; i++)
+        {
+            out.push_back(Fixed::to_float(in[i]));
+        }
+    }
+#endif
+
+    int tail_start(int size, int lookback, int tail)
+    {
+        if (tail <= 0 || lookback + tail >= size)
+        {
+            return 0;
+        }
+        return size - (lookback + tail);
+    }
+
+    TA_RetCode EMA(const std::vector<float> &prices, int period, std::vector<float> &outReal, int tail)
+    {
+#ifdef TA_FIXED_POINT
+        int first = tail_start(prices.size(), TA_EMA_Lookback(period), tail);
+        int size = prices.size() - first;
+        size_t mark = Scratch::mark();
+        Fixed::q16 *in = to_fixed(prices.data() + first, size);
+        Fixed::q16 *out = take_fixed(size);
+        if (in == nullptr || out == nullptr)
+        {
+            Scratch::rewind(mark);
+            return TA_ALLOC_ERR;
+        }
+        from_fixed(out, Fixed::EMA(in, size, period, out, TA_GetUnstablePeriod(TA_FUNC_UNST_EMA)), outReal);
+        Scratch::rewind(mark);
+        return TA_SUCCESS;
+#elif defined(TA_SINGLE_PRECISION)
+        int first = tail_start(prices.size(), TA_EMA_Lookback(period), tail);
+        size_t offset = outReal.size();
+        outReal.resize(offset + prices.size() - first);
+        int outNbElement = Float::EMA(prices.data() + first, prices.size() - first, period, outReal.data() + offset, TA_GetUnstablePeriod(TA_FUNC_UNST_EMA));
+        outReal.resize(offset + outNbElement);
+        return TA_SUCCESS;
+#else
         int endIdx = prices.size() - 1;
+        int startIdx = tail > 0 && endIdx - tail + 1 > 0 ? endIdx - tail + 1 : 0;
         int outBegIdx = 0;
         int outNbElement = 0;
-        double *outReal_ = new double[prices.size()];
-        double *inReal = new double[prices.size()];
-        for (int i = 0; i < prices.size(); i++)
+        size_t mark = Scratch::mark();
+        double *outReal_ = Scratch::take(endIdx - startIdx + 1);
+        if (outReal_ == nullptr)
         {
-            inReal[i] = prices[i];
+            return TA_ALLOC_ERR;
         }
 
-        TA_RetCode retCode = TA_EMA(startIdx, endIdx, inReal, period, &outBegIdx, &outNbElement, outReal_);
+        TA_RetCode retCode = TA_S_EMA(startIdx, endIdx, prices.data(), period, &outBegIdx, &outNbElement, outReal_);
 
         if (retCode != TA_SUCCESS)
         {
-            Serial.println("TA_EMA failed");
+            Serial.println("TA_S_EMA failed");
         }
         else
         {
+            outReal.reserve(outReal.size() + outNbElement);
             for (int i = 0; i < outNbElement; i++)
             {
                 outReal.push_back(outReal_[i]);
             }
         }
 
+        Scratch::rewind(mark);
         return retCode;
+#endif
     }
 
-    TA_RetCode RSI(std::vector<float> &prices, int period, std::vector<float> &outReal)
+    TA_RetCode RSI(const std::vector<float> &prices, int period, std::vector<float> &outReal, int tail)
     {
-        int startIdx = 0;
+#ifdef TA_FIXED_POINT
+        int first = tail_start(prices.size(), TA_RSI_Lookback(period), tail);
+        int size = prices.size() - first;
+        size_t mark = Scratch::mark();
+        Fixed::q16 *in = to_fixed(prices.data() + first, size);
+        Fixed::q16 *out = take_fixed(size);
+        if (in == nullptr || out == nullptr)
+        {
+            Scratch::rewind(mark);
+            return TA_ALLOC_ERR;
+        }
+        from_fixed(out, Fixed::RSI(in, size, period, out, TA_GetUnstablePeriod(TA_FUNC_UNST_RSI)), outReal);
+        Scratch::rewind(mark);
+        return TA_SUCCESS;
+#elif defined(TA_SINGLE_PRECISION)
+        int first = tail_start(prices.size(), TA_RSI_Lookback(period), tail);
+        size_t offset = outReal.size();
+        outReal.resize(offset + prices.size() - first);
+        int outNbElement = Float::RSI(prices.data() + first, prices.size() - first, period, outReal.data() + offset, TA_GetUnstablePeriod(TA_FUNC_UNST_RSI));
+        outReal.resize(offset + outNbElement);
+        return TA_SUCCESS;
+#else
         int endIdx = prices.size() - 1;
+        int startIdx = tail > 0 && endIdx - tail + 1 > 0 ? endIdx - tail + 1 : 0;
         int outBegIdx = 0;
         int outNbElement = 0;
-        double *outReal_ = new double[prices.size()];
-        double *inReal = new double[prices.size()];
-        for (int i = 0; i < prices.size(); i++)
+        size_t mark = Scratch::mark();
+        double *outReal_ = Scratch::take(endIdx - startIdx + 1);
+        if (outReal_ == nullptr)
         {
-            inReal[i] = prices[i];
+            return TA_ALLOC_ERR;
         }
 
-        TA_RetCode retCode = TA_RSI(startIdx, endIdx, inReal, period, &outBegIdx, &outNbElement, outReal_);
+        TA_RetCode retCode = TA_S_RSI(startIdx, endIdx, prices.data(), period, &outBegIdx, &outNbElement, outReal_);
 
         if (retCode != TA_SUCCESS)
         {
-            Serial.println("TA_RSI failed");
+            Serial.println("TA_S_RSI failed");
         }
         else
         {
+            outReal.reserve(outReal.size() + outNbElement);
             for (int i = 0; i < outNbElement; i++)
             {
                 outReal.push_back(outReal_[i]);
             }
         }
 
+        Scratch::rewind(mark);
         return retCode;
+#endif
     }
 
-    TA_RetCode MACD(std::vector<float> &prices, int fastPeriod, int slowPeriod, int signalPeriod, std::vector<float> &outMACD, std::vector<float> &outMACDSignal, std::vector<float> &outMACDHist)
+    TA_RetCode MACD(const std::vector<float> &prices, int fastPeriod, int slowPeriod, int signalPeriod, std::vector<float> &outMACD, std::vector<float> &outMACDSignal, std::vector<float> &outMACDHist, int tail)
     {
-        int startIdx = 0;
+#ifdef TA_FIXED_POINT
+        int first = tail_start(prices.size(), TA_MACD_Lookback(fastPeriod, slowPeriod, signalPeriod), tail);
+        int size = prices.size() - first;
+        size_t mark = Scratch::mark();
+        Fixed::q16 *in = to_fixed(prices.data() + first, size);
+        Fixed::q16 *macd = take_fixed(size);
+        Fixed::q16 *signal = take_fixed(size);
+        Fixed::q16 *hist = take_fixed(size);
+        if (in == nullptr || macd == nullptr || signal == nullptr || hist == nullptr)
+        {
+            Scratch::rewind(mark);
+            return TA_ALLOC_ERR;
+        }
+        int outNbElement = Fixed::MACD(in, size, fastPeriod, slowPeriod, signalPeriod, macd, signal, hist, TA_GetUnstablePeriod(TA_FUNC_UNST_EMA));
+        from_fixed(macd, outNbElement, outMACD);
+        from_fixed(signal, outNbElement, outMACDSignal);
+        from_fixed(hist, outNbElement, outMACDHist);
+        Scratch::rewind(mark);
+        return TA_SUCCESS;
+#elif defined(TA_SINGLE_PRECISION)
+        int first = tail_start(prices.size(), TA_MACD_Lookback(fastPeriod, slowPeriod, signalPeriod), tail);
+        size_t offset = outMACD.size();
+        outMACD.resize(offset + prices.size() - first);
+        outMACDSignal.resize(offset + prices.size() - first);
+        outMACDHist.resize(offset + prices.size() - first);
+        int outNbElement = Float::MACD(prices.data() + first, prices.size() - first, fastPeriod, slowPeriod, signalPeriod, outMACD.data() + offset, outMACDSignal.data() + offset, outMACDHist.data() + offset, TA_GetUnstablePeriod(TA_FUNC_UNST_EMA));
+        outMACD.resize(offset + outNbElement);
+        outMACDSignal.resize(offset + outNbElement);
+        outMACDHist.resize(offset + outNbElement);
+        return TA_SUCCESS;
+#else
         int endIdx = prices.size() - 1;
+        int startIdx = tail > 0 && endIdx - tail + 1 > 0 ? endIdx - tail + 1 : 0;
         int outBegIdx = 0;
         int outNbElement = 0;
-        double *outMACD_ = new double[prices.size()];
-        double *outMACDSignal_ = new double[prices.size()];
-        double *outMACDHist_ = new double[prices.size()];
-        double *inReal = new double[prices.size()];
-        for (int i = 0; i < prices.size(); i++)
+        size_t mark = Scratch::mark();
+        double *outMACD_ = Scratch::take(endIdx - startIdx + 1);
+        double *outMACDSignal_ = Scratch::take(endIdx - startIdx + 1);
+        double *outMACDHist_ = Scratch::take(endIdx - startIdx + 1);
+        if (outMACD_ == nullptr || outMACDSignal_ == nullptr || outMACDHist_ == nullptr)
         {
-            inReal[i] = prices[i];
+            Scratch::rewind(mark);
+            return TA_ALLOC_ERR;
         }
 
-        TA_RetCode retCode = TA_MACD(startIdx, endIdx, inReal, fastPeriod, slowPeriod, signalPeriod, &outBegIdx, &outNbElement, outMACD_, outMACDSignal_, outMACDHist_);
+        TA_RetCode retCode = TA_S_MACD(startIdx, endIdx, prices.data(), fastPeriod, slowPeriod, signalPeriod, &outBegIdx, &outNbElement, outMACD_, outMACDSignal_, outMACDHist_);
 
         if (retCode != TA_SUCCESS)
         {
-            Serial.println("TA_MACD failed");
+            Serial.println("TA_S_MACD failed");
         }
         else
         {
+            outMACD.reserve(outMACD.size() + outNbElement);
+            outMACDSignal.reserve(outMACDSignal.size() + outNbElement);
+            outMACDHist.reserve(outMACDHist.size() + outNbElement);
             for (int i = 0; i < outNbElement; i++)
             {
                 outMACD.push_back(outMACD_[i]);
@@ -103,6 +353,8 @@ namespace TA
             }
         }
 
+        Scratch::rewind(mark);
         return retCode;
+#endif
     }
-}
\ No newline at end of file
+}
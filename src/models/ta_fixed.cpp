@@ -0,0 +1,196 @@
+#include "models/ta_fixed.h"
+
+namespace TA
+{
+    namespace Fixed
+    {
+        const int64_t one{static_cast<int64_t>(1) << TA_FIXED_FRACTION_BITS};
+
+        q16 from_float(float value)
+        {
+            return static_cast<q16>(value * one + (value < 0 ? -0.5f : 0.5f));
+        }
+
+        float to_float(q16 value)
+        {
+            return static_cast<float>(value) / one;
+        }
+
+        // Rounds half away from zero, matching from_float.
+        int64_t divide(int64_t numerator, int64_t denominator)
+        {
+            return numerator < 0 ? (numerator - denominator / 2) / denominator : (numerator + denominator / 2) / denominator;
+        }
+
+        int64_t shift(int64_t value, int bits)
+        {
+            return (value + (static_cast<int64_t>(1) << (bits - 1))) >> bits;
+        }
+
+        // 2 / (period + 1) in Q1.30.
+        int64_t ema_k(int period)
+        {
+            return divide(static_cast<int64_t>(2) << TA_FIXED_COEFFICIENT_BITS, period + 1);
+        }
+
+        q16 ema_seed(const q16 *in, int period)
+        {
+            int64_t sum{0};
+            for (int i = 0; i < period; i++)
+            {
+                sum += in[i];
+            }
+            return divide(sum, period);
+        }
+
+        int ema_from(const q16 *in, int size, int period, int start, int unstable, q16 *out)
+        {
+            const int64_t k{ema_k(period)};
+            q16 prev{ema_seed(in + start - period + 1, period)};
+            int n{0};
+            if (unstable == 0)
+            {
+                out[n++] = prev;
+            }
+            for (int i = start + 1; i < size; i++)
+            {
+                prev += shift((static_cast<int64_t>(in[i]) - prev) * k, TA_FIXED_COEFFICIENT_BITS);
+                if (i - start >= unstable)
+                {
+                    out[n++] = prev;
+                }
+            }
+            return n;
+        }
+
+        // The averages carry 32 fraction bits, so 100 * one * gain would overflow once the
+        // average gain passes ~327. Both are first brought under 2^40, leaving 23 bits of
+        // headroom for the scale; the bits shifted out are far below the result's LSB.
+        q16 rsi_value(int64_t gain, int64_t loss)
+        {
+            int64_t total{gain + loss};
+            if (total == 0)
+            {
+                return 0;
+            }
+            while (total >= static_cast<int64_t>(1) << 40)
+            {
+                gain >>= 1;
+                total >>= 1;
+            }
+            return divide(100 * one * gain, total);
+        }
+
+        q16 typical(q16 high, q16 low, q16 close)
+        {
+            return divide(static_cast<int64_t>(high) + low + close, 3);
+        }
+
+        int EMA(const q16 *in, int size, int period, q16 *out, int unstable)
+        {
+            if (period < 1 || size < period + unstable)
+            {
+                return 0;
+            }
+            return ema_from(in, size, period, period - 1, unstable, out);
+        }
+
+        int RSI(const q16 *in, int size, int period, q16 *out, int unstable)
+        {
+            if (period < 2 || size <= period + unstable)
+            {
+                return 0;
+            }
+
+            // The averages keep 16 extra fraction bits so Wilder's repeated division
+            // by period doesn't round away the small moves.
+            int64_t gain{0};
+            int64_t loss{0};
+            for (int i = 1; i <= period; i++)
+            {
+                int64_t diff{static_cast<int64_t>(in[i]) - in[i - 1]};
+                if (diff < 0)
+                {
+                    loss -= diff;
+                }
+                else
+                {
+                    gain += diff;
+                }
+            }
+            gain = divide(gain << TA_FIXED_FRACTION_BITS, period);
+            loss = divide(loss << TA_FIXED_FRACTION_BITS, period);
+
+            int n{0};
+            if (unstable == 0)
+            {
+                out[n++] = rsi_value(gain, loss);
+            }
+            for (int i = period + 1; i < size; i++)
+            {
+                int64_t diff{static_cast<int64_t>(in[i]) - in[i - 1]};
+                gain *= period - 1;
+                loss *= period - 1;
+                if (diff < 0)
+                {
+                    loss -= diff << TA_FIXED_FRACTION_BITS;
+                }
+                else
+                {
+                    gain += diff << TA_FIXED_FRACTION_BITS;
+                }
+                gain = divide(gain, period);
+                loss = divide(loss, period);
+                if (i - period >= unstable)
+                {
+                    out[n++] = rsi_value(gain, loss);
+                }
+            }
+            return n;
+        }
+
+        int MACD(const q16 *in, int size, int fastPeriod, int slowPeriod, int signalPeriod, q16 *outMACD, q16 *outMACDSignal, q16 *outMACDHist, int unstable)
+        {
+            if (slowPeriod < fastPeriod)
+            {
+                int swap{slowPeriod};
+                slowPeriod = fastPeriod;
+                fastPeriod = swap;
+            }
+            if (fastPeriod < 2 || signalPeriod < 1 || size < slowPeriod + signalPeriod - 1 + 2 * unstable)
+            {
+                return 0;
+            }
+
+            const int64_t fast_k{ema_k(fastPeriod)};
+            const int64_t slow_k{ema_k(slowPeriod)};
+            const int start{slowPeriod - 1};
+            q16 fast{ema_seed(in + start - fastPeriod + 1, fastPeriod)};
+            q16 slow{ema_seed(in, slowPeriod)};
+
+            int n{0};
+            if (unstable == 0)
+            {
+                outMACDHist[n++] = fast - slow;
+            }
+            for (int i = start + 1; i < size; i++)
+            {
+                fast += shift((static_cast<int64_t>(in[i]) - fast) * fast_k, TA_FIXED_COEFFICIENT_BITS);
+                slow += shift((static_cast<int64_t>(in[i]) - slow) * slow_k, TA_FIXED_COEFFICIENT_BITS);
+                if (i - start >= unstable)
+                {
+                    outMACDHist[n++] = fast - slow;
+                }
+            }
+
+            int count{ema_from(outMACDHist, n, signalPeriod, signalPeriod - 1, unstable, outMACDSignal)};
+            for (int i = 0; i < count; i++)
+            {
+                q16 macd{outMACDHist[i + signalPeriod - 1 + unstable]};
+                outMACD[i] = macd;
+                outMACDHist[i] = macd - outMACDSignal[i];
+            }
+            return count;
+        }
+    }
+}
@@ -0,0 +1,234 @@
+#include "models/ta_float.h"
+#include <cmath>
+#include "models/rolling.h"
+
+namespace TA
+{
+    namespace Float
+    {
+        bool is_zero(float value)
+        {
+            return -0.00000001f < value && value < 0.00000001f;
+        }
+
+        float ema_seed(const float *in, int period)
+        {
+            float sum{0};
+            for (int i = 0; i < period; i++)
+            {
+                sum += in[i];
+            }
+            return sum / period;
+        }
+
+        int ema_from(const float *in, int size, int period, int start, int unstable, float *out)
+        {
+            const float k{2.0f / (period + 1)};
+            float prev{ema_seed(in + start - period + 1, period)};
+            int n{0};
+            if (unstable == 0)
+            {
+                out[n++] = prev;
+            }
+            for (int i = start + 1; i < size; i++)
+            {
+                prev += (in[i] - prev) * k;
+                if (i - start >= unstable)
+                {
+                    out[n++] = prev;
+                }
+            }
+            return n;
+        }
+
+        int EMA(const float *in, int size, int period, float *out, int unstable)
+        {
+            if (period < 1 || size < period + unstable)
+            {
+                return 0;
+            }
+            return ema_from(in, size, period, period - 1, unstable, out);
+        }
+
+        int RSI(const float *in, int size, int period, float *out, int unstable)
+        {
+            if (period < 2 || size <= period + unstable)
+            {
+                return 0;
+            }
+
+            float gain{0};
+            float loss{0};
+            for (int i = 1; i <= period; i++)
+            {
+                float diff{in[i] - in[i - 1]};
+                if (diff < 0)
+                {
+                    loss -= diff;
+                }
+                else
+                {
+                    gain += diff;
+                }
+            }
+            gain /= period;
+            loss /= period;
+
+            int n{0};
+            if (unstable == 0)
+            {
+                out[n++] = is_zero(gain + loss) ? 0.0f : 100.0f * (gain / (gain + loss));
+            }
+            for (int i = period + 1; i < size; i++)
+            {
+                float diff{in[i] - in[i - 1]};
+                gain *= period - 1;
+                loss *= period - 1;
+                if (diff < 0)
+                {
+                    loss -= diff;
+                }
+                else
+                {
+                    gain += diff;
+                }
+                gain /= period;
+                loss /= period;
+                if (i - period >= unstable)
+                {
+                    out[n++] = is_zero(gain + loss) ? 0.0f : 100.0f * (gain / (gain + loss));
+                }
+            }
+            return n;
+        }
+
+        int MACD(const float *in, int size, int fastPeriod, int slowPeriod, int signalPeriod, float *outMACD, float *outMACDSignal, float *outMACDHist, int unstable)
+        {
+            if (slowPeriod < fastPeriod)
+            {
+                int swap{slowPeriod};
+                slowPeriod = fastPeriod;
+                fastPeriod = swap;
+            }
+            if (fastPeriod < 2 || signalPeriod < 1 || size < slowPeriod + signalPeriod - 1 + 2 * unstable)
+            {
+                return 0;
+            }
+
+            // Both EMAs start on the slow EMA's first bar, the fast one seeded from the
+            // fastPeriod bars just before it, which is how TA_MACD aligns them.
+            const float fast_k{2.0f / (fastPeriod + 1)};
+            const float slow_k{2.0f / (slowPeriod + 1)};
+            const int start{slowPeriod - 1};
+            float fast{ema_seed(in + start - fastPeriod + 1, fastPeriod)};
+            float slow{ema_seed(in, slowPeriod)};
+
+            // The MACD line is written into outMACDHist once the EMAs are past their
+            // unstable period, then shifted so all three outputs start on the first bar
+            // with a signal value.
+            int n{0};
+            if (unstable == 0)
+            {
+                outMACDHist[n++] = fast - slow;
+            }
+            for (int i = start + 1; i < size; i++)
+            {
+                fast += (in[i] - fast) * fast_k;
+                slow += (in[i] - slow) * slow_k;
+                if (i - start >= unstable)
+                {
+                    outMACDHist[n++] = fast - slow;
+                }
+            }
+
+            int count{ema_from(outMACDHist, n, signalPeriod, signalPeriod - 1, unstable, outMACDSignal)};
+            for (int i = 0; i < count; i++)
+            {
+                float macd{outMACDHist[i + signalPeriod - 1 + unstable]};
+                outMACD[i] = macd;
+                outMACDHist[i] = macd - outMACDSignal[i];
+            }
+            return count;
+        }
+
+        int SMA(const float *in, int size, int period, float *out)
+        {
+            auto average = [out](int n, float mean, float)
+            {
+                out[n] = mean;
+            };
+            return Rolling::windows(in, size, period, average);
+        }
+
+        float true_range(const float *high, const float *low, const float *close, int i)
+        {
+            float range{high[i] - low[i]};
+            float above{std::fabs(close[i - 1] - high[i])};
+            float below{std::fabs(close[i - 1] - low[i])};
+            if (above > range)
+            {
+                range = above;
+            }
+            if (below > range)
+            {
+                range = below;
+            }
+            return range;
+        }
+
+        int ATR(const float *high, const float *low, const float *close, int size, int period, float *out, int unstable)
+        {
+            if (period < 1 || size <= period + unstable)
+            {
+                return 0;
+            }
+
+            // As TA_ATR, a period of 1 is the true range itself.
+            int n{0};
+            if (period == 1)
+            {
+                for (int i = 1 + unstable; i < size; i++)
+                {
+                    out[n++] = true_range(high, low, close, i);
+                }
+                return n;
+            }
+
+            // Seeded with the mean true range of bars 1 to period, then Wilder's smoothing.
+            float atr{0};
+            for (int i = 1; i <= period; i++)
+            {
+                atr += true_range(high, low, close, i);
+            }
+            atr /= period;
+
+            if (unstable == 0)
+            {
+                out[n++] = atr;
+            }
+            for (int i = period + 1; i < size; i++)
+            {
+                atr = (atr * (period - 1) + true_range(high, low, close, i)) / period;
+                if (i - period >= unstable)
+                {
+                    out[n++] = atr;
+                }
+            }
+            return n;
+        }
+
+        int BBANDS(const float *in, int size, int period, float nbDevUp, float nbDevDn, float *outUpper, float *outMiddle, float *outLower)
+        {
+            // Population deviation, 0 once the variance is within rounding of 0, as
+            // TA_BBANDS takes it.
+            auto bands = [=](int n, float mean, float variance)
+            {
+                float deviation{variance < 0.00000001f ? 0.0f : std::sqrt(variance)};
+                outMiddle[n] = mean;
+                outUpper[n] = mean + nbDevUp * deviation;
+                outLower[n] = mean - nbDevDn * deviation;
+            };
+            return Rolling::windows(in, size, period, bands);
+        }
+    }
+}
@@ -0,0 +1,146 @@
+#include <Arduino.h>
+#include "models/ta_function.h"
+
+namespace TA
+{
+    Function::Function(const char *name)
+    {
+        retCode = TA_GetFuncHandle(name, &handle);
+        if (retCode == TA_SUCCESS)
+        {
+            retCode = TA_GetFuncInfo(handle, &info_);
+        }
+        if (retCode == TA_SUCCESS)
+        {
+            retCode = TA_ParamHolderAlloc(handle, &params);
+        }
+        if (retCode != TA_SUCCESS)
+        {
+            Serial.print("TA function lookup failed: ");
+            Serial.println(name);
+            params = nullptr;
+        }
+    }
+
+    Function::~Function()
+    {
+        if (params != nullptr)
+        {
+            TA_ParamHolderFree(params);
+        }
+    }
+
+    void Function::check(TA_RetCode code)
+    {
+        if (code != TA_SUCCESS && retCode == TA_SUCCESS)
+        {
+            retCode = code;
+        }
+    }
+
+    Function &Function::input(unsigned int index, const double *values)
+    {
+        if (valid())
+        {
+            check(TA_SetInputParamRealPtr(params, index, values));
+        }
+        return *this;
+    }
+
+    Function &Function::input(unsigned int index, const int *values)
+    {
+        if (valid())
+        {
+            check(TA_SetInputParamIntegerPtr(params, index, values));
+        }
+        return *this;
+    }
+
+    Function &Function::price(unsigned int index, const double *open, const double *high, const double *low, const double *close, const double *volume, const double *openInterest)
+    {
+        if (valid())
+        {
+            check(TA_SetInputParamPricePtr(params, index, open, high, low, close, volume, openInterest));
+        }
+        return *this;
+    }
+
+    Function &Function::option(unsigned int index, double value)
+    {
+        if (!valid())
+        {
+            return *this;
+        }
+
+        const TA_OptInputParameterInfo *option{nullptr};
+        TA_RetCode code{TA_GetOptInputParameterInfo(handle, index, &option)};
+        if (code != TA_SUCCESS)
+        {
+            check(code);
+        }
+        else if (option->type == TA_OptInput_RealRange || option->type == TA_OptInput_RealList)
+        {
+            check(TA_SetOptInputParamReal(params, index, value));
+        }
+        else if (value != static_cast<int>(value))
+        {
+            check(TA_BAD_PARAM);
+        }
+        else
+        {
+            check(TA_SetOptInputParamInteger(params, index, static_cast<int>(value)));
+        }
+        return *this;
+    }
+
+    Function &Function::output(unsigned int index, double *values)
+    {
+        if (valid())
+        {
+            check(TA_SetOutputParamRealPtr(params, index, values));
+        }
+        return *this;
+    }
+
+    Function &Function::output(unsigned int index, int *values)
+    {
+        if (valid())
+        {
+            check(TA_SetOutputParamIntegerPtr(params, index, values));
+        }
+        return *this;
+    }
+
+    int Function::lookback() const
+    {
+        TA_Integer lookback{0};
+        if (valid())
+        {
+            TA_GetLookback(params, &lookback);
+        }
+        return lookback;
+    }
+
+    TA_RetCode Function::call(int startIdx, int endIdx, int *outBegIdx, int *outNbElement)
+    {
+        if (!valid())
+        {
+            return retCode;
+        }
+        if (retCode != TA_SUCCESS)
+        {
+            // A bad binding since the last call; report it once and start clean.
+            TA_RetCode failed{retCode};
+            retCode = TA_SUCCESS;
+            return failed;
+        }
+
+        TA_RetCode result{TA_CallFunc(params, startIdx, endIdx, outBegIdx, outNbElement)};
+        if (result != TA_SUCCESS)
+        {
+            Serial.print("TA_CallFunc failed: ");
+            Serial.println(info_->name);
+        }
+        return result;
+    }
+}
@@ -1,13 +1,218 @@
 #include "models/rsi.h"
 #include "models/macd.h"
+#include "models/base.h"
+#include "models/state.h"
+#include "models/stream.h"
+#include "models/strategy.h"
 #include "api/alpaca.h"
+#include "api/alphavantage.h"
+#include <stdio.h>
+#include <string.h>
 
 namespace Trade
 {
+    namespace
+    {
+        // The default looks' indicators for one timeframe, kept as streams: RSI and
+        // EMA(RSI), MACD, and the slope windows the looks read. They are saved to NVS
+        // whenever a bar completes and restored at boot, so after a reset only the bars
+        // since the last saved one are folded in before the looks decide again.
+        struct Warm
+        {
+            explicit Warm(int macd_slope_period)
+                : rsi{Strategy::DefaultRSI::period, Strategy::DefaultRSI::period},
+                  rsi_slope{Strategy::DefaultRSI::slope_period},
+                  rsi_ema_slope{Strategy::DefaultRSI::slope_period},
+                  macd{Strategy::DefaultMACD::fast_period, Strategy::DefaultMACD::slow_period, Strategy::DefaultMACD::signal_period},
+                  macd_slope{macd_slope_period},
+                  signal_slope{macd_slope_period},
+                  hist_slope{macd_slope_period},
+                  macd_slope_period{macd_slope_period}
+            {
+            }
+
+            void update(const AlphaVantage::TimeSeries &bar)
+            {
+                float price{Base::typical_price(bar.high, bar.low, bar.close)};
+                // The slopes cover the tail of each series, so they only need the
+                // values from the point the whole chain is ready.
+                if (rsi.update(price))
+                {
+                    rsi_slope.update(rsi.rsi());
+                    rsi_ema_slope.update(rsi.ema());
+                }
+                if (macd.update(price))
+                {
+                    macd_slope.update(macd.macd());
+                    signal_slope.update(macd.signal());
+                    hist_slope.update(macd.hist());
+                }
+            }
+
+            RSI::Reading rsi_reading() const
+            {
+                return RSI::Reading{rsi_ema_slope.ready(), rsi.rsi(), rsi.ema(), rsi_slope.value(), rsi_ema_slope.value()};
+            }
+
+            MACD::Reading macd_reading() const
+            {
+                return MACD::Reading{hist_slope.ready(), macd.macd(), macd.signal(), macd.hist(), macd_slope.value(), signal_slope.value(), hist_slope.value()};
+            }
+
+            void save(Stream::Snapshot &snapshot) const
+            {
+                rsi.save(snapshot);
+                rsi_slope.save(snapshot);
+                rsi_ema_slope.save(snapshot);
+                macd.save(snapshot);
+                macd_slope.save(snapshot);
+                signal_slope.save(snapshot);
+                hist_slope.save(snapshot);
+            }
+
+            // All or nothing: on failure this is left as it was.
+            bool restore(Stream::Snapshot &snapshot)
+            {
+                Warm restored{*this};
+                if (!(restored.rsi.restore(snapshot) && restored.rsi_slope.restore(snapshot) && restored.rsi_ema_slope.restore(snapshot) &&
+                      restored.macd.restore(snapshot) && restored.macd_slope.restore(snapshot) && restored.signal_slope.restore(snapshot) && restored.hist_slope.restore(snapshot)))
+                {
+                    return false;
+                }
+                *this = restored;
+                return true;
+            }
+
+            Stream::RSIEMA rsi;
+            Stream::Slope rsi_slope;
+            Stream::Slope rsi_ema_slope;
+            Stream::MACD macd;
+            Stream::Slope macd_slope;
+            Stream::Slope signal_slope;
+            Stream::Slope hist_slope;
+            int macd_slope_period;
+            State::Mark mark{};
+            bool marked{false};
+        };
+
+        Warm hourly_warm{Strategy::DefaultMACD::hourly_slope_period};
+        Warm daily_warm{Strategy::DefaultMACD::daily_slope_period};
+
+        // NVS keys are at most 15 characters: the symbol plus a timeframe suffix.
+        void state_key(char (&key)[16], const char *symbol, const char *timeframe)
+        {
+            snprintf(key, sizeof(key), "%.12s.%s", symbol, timeframe);
+        }
+
+        bool restore_warm(const char *key, Warm &warm)
+        {
+            Stream::Snapshot snapshot;
+            State::Mark mark;
+            if (!State::load(key, snapshot, mark) || !warm.restore(snapshot))
+            {
+                return false;
+            }
+            warm.mark = mark;
+            warm.marked = true;
+            return true;
+        }
+
+        // Folds the bars after the saved mark into warm, or rebuilds it from bars when
+        // the mark isn't among them, and saves it when anything was folded. The newest
+        // bar may still be forming, so it is left out of warm and only folded into the
+        // copy that is returned for the looks to read.
+        Warm advance_warm(const char *key, Warm &warm, const std::vector<AlphaVantage::TimeSeries> &bars)
+        {
+            const int complete{static_cast<int>(bars.size()) - 1};
+            if (complete < 0)
+            {
+                return warm;
+            }
+
+            int start{warm.marked ? State::resume_from(bars, warm.mark) : -1};
+            if (start < 0)
+            {
+                warm = Warm{warm.macd_slope_period};
+                start = 0;
+            }
+            if (start > complete)
+            {
+                return warm;
+            }
+            if (start < complete)
+            {
+                for (int i = start; i < complete; i++)
+                {
+                    warm.update(bars[i]);
+                }
+                warm.mark = State::mark(bars[complete - 1]);
+                warm.marked = true;
+
+                Stream::Snapshot snapshot;
+                warm.save(snapshot);
+                if (!State::save(key, snapshot, warm.mark))
+                {
+                    Serial.println("State: failed to save " + String(key));
+                }
+            }
+
+            Warm current{warm};
+            current.update(bars[complete]);
+            return current;
+        }
+
+        // Enters with a bracket order at price, its take-profit and stop-loss legs worked
+        // by Alpaca between runs. Without a price to size it, falls back to a notional
+        // market order with no exits.
+        void enter(const char *symbol, float amount, const char *side, float price)
+        {
+            int qty{price > 0 ? static_cast<int>(amount / price) : 0};
+            if (qty < 1)
+            {
+                Serial.println(F("Can't size a bracket order, entering without exits"));
+                Alpaca::order_market(symbol, amount, side);
+                return;
+            }
+
+            bool buy{strcmp(side, "buy") == 0};
+            float take_profit{price * (buy ? 1 + Strategy::take_profit : 1 - Strategy::take_profit)};
+            float stop_loss{price * (buy ? 1 - Strategy::stop_loss : 1 + Strategy::stop_loss)};
+            Alpaca::order_bracket(symbol, qty, side, take_profit, stop_loss);
+        }
+    }
+
+    void restore(const char *symbol)
+    {
+        char key[16];
+        state_key(key, symbol, "h");
+        Serial.println(restore_warm(key, hourly_warm) ? "State: restored hourly indicators" : "State: no hourly indicators saved");
+        state_key(key, symbol, "d");
+        Serial.println(restore_warm(key, daily_warm) ? "State: restored daily indicators" : "State: no daily indicators saved");
+    }
+
     void swing_trade_leveraged(const char *symbol, const char *up_stock, const char *down_stock, float percentage)
     {
-        Logic::Trend rsi_trend{RSI::trend(symbol)};
-        Logic::Trend macd_trend{MACD::trend(symbol)};
+        // A compact request is the smallest AlphaVantage serves; once the indicators
+        // are warm only the bars in it after the saved mark are folded in.
+        std::vector<AlphaVantage::TimeSeries> hourly_bars{AlphaVantage::hourly(symbol)};
+        std::vector<AlphaVantage::TimeSeries> daily_bars{AlphaVantage::daily(symbol)};
+
+        char key[16];
+        state_key(key, symbol, "h");
+        Warm hourly{advance_warm(key, hourly_warm, hourly_bars)};
+        state_key(key, symbol, "d");
+        Warm daily{advance_warm(key, daily_warm, daily_bars)};
+
+        // The bars already fetched price the entry, so it costs no quote request. They
+        // are symbol's own, so they only price an order for symbol itself.
+        float last_close{hourly_bars.empty() ? 0.0f : hourly_bars.back().close};
+        auto price_of = [&](const char *stock)
+        {
+            return strcmp(stock, symbol) == 0 ? last_close : 0.0f;
+        };
+
+        Logic::Trend rsi_trend{RSI::trend(hourly.rsi_reading(), daily.rsi_reading())};
+        Logic::Trend macd_trend{MACD::trend(hourly.macd_reading(), daily.macd_reading())};
 
         Logic::Trend final_trend{Logic::combine_trends(std::vector<Logic::Trend>{rsi_trend, macd_trend})};
 
@@ -33,8 +238,8 @@ namespace Trade
             if (Alpaca::has_position_in(down_stock) || Alpaca::has_order_for(down_stock))
             {
                 Serial.println(F("Selling short position..."));
-                Alpaca::close_position(down_stock);
                 Alpaca::cancel_orders_for(down_stock);
+                Alpaca::close_position(down_stock);
             }
             else
             {
@@ -46,7 +251,7 @@ namespace Trade
                 Serial.println(F("Buying long position..."));
                 float buying_power{Alpaca::buying_power()};
                 float buying_amount{buying_power * percentage};
-                Alpaca::order_market(up_stock, buying_amount, "buy");
+                enter(up_stock, buying_amount, "buy", price_of(up_stock));
                 Serial.println(F("Long position bought!"));
             }
             else
@@ -59,6 +264,7 @@ namespace Trade
             if (Alpaca::has_position_in(up_stock) || Alpaca::has_order_for(up_stock))
             {
                 Serial.println(F("Closing long position..."));
+                Alpaca::cancel_orders_for(up_stock);
                 Alpaca::close_position(up_stock);
             }
             else
@@ -71,7 +277,7 @@ namespace Trade
                 Serial.println(F("Opening short position..."));
                 float buying_power{Alpaca::buying_power()};
                 float buying_amount{buying_power * (percentage / 100)};
-                Alpaca::order_market(down_stock, buying_amount, "sell");
+                enter(down_stock, buying_amount, "sell", price_of(down_stock));
                 Serial.println(F("Short position opened!"));
             }
             else
@@ -84,8 +290,8 @@ namespace Trade
             if (Alpaca::has_position_in(up_stock) || Alpaca::has_order_for(up_stock))
             {
                 Serial.println(F("Closing long position..."));
-                Alpaca::close_position(up_stock);
                 Alpaca::cancel_orders_for(up_stock);
+                Alpaca::close_position(up_stock);
             }
             else
             {
@@ -95,8 +301,8 @@ namespace Trade
             if (Alpaca::has_position_in(down_stock) || Alpaca::has_order_for(down_stock))
             {
                 Serial.println(F("Closing short position..."));
-                Alpaca::close_position(down_stock);
                 Alpaca::cancel_orders_for(down_stock);
+                Alpaca::close_position(down_stock);
             }
             else
             {
@@ -1,36 +1,65 @@
 #include "models/logic.h"
 #include "models/base.h"
-#include "models/ta.h"
-#include "api/alphavantage.h";
-
-#define MACD_FLAT_BUFFER 0.2
-#define MACD_FAST_PERIOD 12
-#define MACD_FAST_SLOPE_PERIOD 6
-#define MACD_SLOW_PERIOD 26
-#define MACD_SLOW_SLOPE_PERIOD 13
-#define MACD_SIGNAL_PERIOD 9
-#define MACD_SIGNAL_SLOPE_PERIOD 4
-#define MACD_OVERBOUGHT 2
+#include "models/graph.h"
+#include "models/macd.h"
+#include "models/strategy.h"
 
 namespace MACD
 {
-    Logic::Trend hourly_macd_look(const char *symbol)
+    template <typename Config>
+    Reading hourly_macd_reading(Graph::Frame &frame)
     {
-        std::vector<AlphaVantage::TimeSeries> ts = AlphaVantage::hourly(symbol);
-        std::vector<float> prices{Base::typical_prices(ts)};
+        Graph::Node prices{frame.typical()};
+        Graph::Node MACD{frame.macd(prices, Config::fast_period, Config::slow_period, Config::signal_period)};
+        Graph::Node MACD_SIGNAL{frame.macd_signal(prices, Config::fast_period, Config::slow_period, Config::signal_period)};
+        Graph::Node MACD_HISTOGRAM{frame.macd_hist(prices, Config::fast_period, Config::slow_period, Config::signal_period)};
+        frame.require(MACD, Config::hourly_slope_period + 1);
 
-        std::vector<float> MACD;
-        std::vector<float> MACD_SIGNAL;
-        std::vector<float> MACD_HISTOGRAM;
+        Strategy::Window<Config::hourly_slope_period + 1> macd;
+        Strategy::Window<Config::hourly_slope_period + 1> macd_signal;
+        Strategy::Window<Config::hourly_slope_period + 1> macd_histogram;
+        if (!macd.fill(frame.values(MACD)) || !macd_signal.fill(frame.values(MACD_SIGNAL)) || !macd_histogram.fill(frame.values(MACD_HISTOGRAM)))
+        {
+            return Reading{false, 0, 0, 0, 0, 0, 0};
+        }
+        return Reading{true, macd.last(), macd_signal.last(), macd_histogram.last(), macd.slope(), macd_signal.slope(), macd_histogram.slope()};
+    }
+
+    template <typename Config>
+    Reading daily_macd_reading(Graph::Frame &frame)
+    {
+        Graph::Node prices{frame.typical()};
+        Graph::Node MACD{frame.macd(prices, Config::fast_period, Config::slow_period, Config::signal_period)};
+        Graph::Node MACD_SIGNAL{frame.macd_signal(prices, Config::fast_period, Config::slow_period, Config::signal_period)};
+        Graph::Node MACD_HISTOGRAM{frame.macd_hist(prices, Config::fast_period, Config::slow_period, Config::signal_period)};
+        frame.require(MACD, Config::daily_slope_period + 1);
+
+        Strategy::Window<Config::daily_slope_period + 1> macd;
+        Strategy::Window<Config::daily_slope_period + 1> macd_signal;
+        Strategy::Window<Config::daily_slope_period + 1> macd_histogram;
+        if (!macd.fill(frame.values(MACD)) || !macd_signal.fill(frame.values(MACD_SIGNAL)) || !macd_histogram.fill(frame.values(MACD_HISTOGRAM)))
+        {
+            return Reading{false, 0, 0, 0, 0, 0, 0};
+        }
+        return Reading{true, macd.last(), macd_signal.last(), macd_histogram.last(), macd.slope(), macd_signal.slope(), macd_histogram.slope()};
+    }
 
-        TA::MACD(prices, MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD, MACD, MACD_SIGNAL, MACD_HISTOGRAM);
-        float macd_slope{Base::slope_from_prices(MACD, MACD_FAST_SLOPE_PERIOD)};
-        float macd_signal_slope{Base::slope_from_prices(MACD_SIGNAL, MACD_FAST_SLOPE_PERIOD)};
-        float macd_histogram_slope{Base::slope_from_prices(MACD_HISTOGRAM, MACD_FAST_SLOPE_PERIOD)};
+    template <typename Config>
+    Logic::Trend hourly_macd_look(const Reading &reading)
+    {
+        if (!reading.ready)
+        {
+            Serial.println("Hourly MACD: not enough bars");
+            return Logic::Trend::FLAT;
+        }
+
+        float macd_slope{reading.macd_slope};
+        float macd_signal_slope{reading.signal_slope};
+        float macd_histogram_slope{reading.hist_slope};
 
-        float current_macd{MACD[MACD.size() - 1]};
-        float current_macd_signal{MACD_SIGNAL[MACD_SIGNAL.size() - 1]};
-        float current_macd_histogram{MACD_HISTOGRAM[MACD_HISTOGRAM.size() - 1]};
+        float current_macd{reading.macd};
+        float current_macd_signal{reading.signal};
+        float current_macd_histogram{reading.hist};
         Serial.println("Hourly MACD:");
         Serial.print("MACD: ");
         Serial.println(current_macd);
@@ -44,9 +73,9 @@ namespace MACD
         Serial.println(macd_signal_slope);
         Serial.print("MACD Histogram Slope: ");
         Serial.println(macd_histogram_slope);
-        if (macd_histogram_slope > MACD_FLAT_BUFFER)
+        if (macd_histogram_slope > Config::flat_buffer)
         {
-            if (current_macd >= MACD_OVERBOUGHT)
+            if (current_macd >= Config::overbought)
             {
                 return Logic::Trend::FLAT;
             }
@@ -55,9 +84,9 @@ namespace MACD
                 return Logic::Trend::UP;
             }
         }
-        else if (macd_histogram_slope < -MACD_FLAT_BUFFER)
+        else if (macd_histogram_slope < -Config::flat_buffer)
         {
-            if (current_macd <= -MACD_OVERBOUGHT)
+            if (current_macd <= -Config::overbought)
             {
                 return Logic::Trend::FLAT;
             }
@@ -83,23 +112,22 @@ namespace MACD
         }
     }
 
-    Logic::Trend daily_macd_look(const char *symbol)
+    template <typename Config>
+    Logic::Trend daily_macd_look(const Reading &reading)
     {
-        std::vector<AlphaVantage::TimeSeries> ts = AlphaVantage::daily(symbol);
-        std::vector<float> prices{Base::typical_prices(ts)};
-
-        std::vector<float> MACD;
-        std::vector<float> MACD_SIGNAL;
-        std::vector<float> MACD_HISTOGRAM;
+        if (!reading.ready)
+        {
+            Serial.println("Daily MACD: not enough bars");
+            return Logic::Trend::FLAT;
+        }
 
-        TA::MACD(prices, MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD, MACD, MACD_SIGNAL, MACD_HISTOGRAM);
-        float macd_slope{Base::slope_from_prices(MACD, 12)};
-        float macd_signal_slope{Base::slope_from_prices(MACD_SIGNAL, 12)};
-        float macd_histogram_slope{Base::slope_from_prices(MACD_HISTOGRAM, 12)};
+        float macd_slope{reading.macd_slope};
+        float macd_signal_slope{reading.signal_slope};
+        float macd_histogram_slope{reading.hist_slope};
 
-        float current_macd{MACD[MACD.size() - 1]};
-        float current_macd_signal{MACD_SIGNAL[MACD_SIGNAL.size() - 1]};
-        float current_macd_histogram{MACD_HISTOGRAM[MACD_HISTOGRAM.size() - 1]};
+        float current_macd{reading.macd};
+        float current_macd_signal{reading.signal};
+        float current_macd_histogram{reading.hist};
 
         Serial.println("Daily MACD:");
         Serial.print("MACD: ");
@@ -115,9 +143,9 @@ namespace MACD
         Serial.print("MACD Histogram Slope: ");
         Serial.println(macd_histogram_slope);
 
-        if (macd_histogram_slope > MACD_FLAT_BUFFER)
+        if (macd_histogram_slope > Config::flat_buffer)
         {
-            if (current_macd >= MACD_OVERBOUGHT)
+            if (current_macd >= Config::overbought)
             {
                 return Logic::Trend::FLAT;
             }
@@ -126,9 +154,9 @@ namespace MACD
                 return Logic::Trend::UP;
             }
         }
-        else if (macd_histogram_slope < -MACD_FLAT_BUFFER)
+        else if (macd_histogram_slope < -Config::flat_buffer)
         {
-            if (current_macd <= -MACD_OVERBOUGHT)
+            if (current_macd <= -Config::overbought)
             {
                 return Logic::Trend::FLAT;
             }
@@ -154,12 +182,39 @@ namespace MACD
         }
     }
 
-    Logic::Trend trend(const char *symbol)
+    template <typename Config>
+    Logic::Trend hourly_macd_look(Graph::Frame &frame)
+    {
+        return hourly_macd_look<Config>(hourly_macd_reading<Config>(frame));
+    }
+
+    template <typename Config>
+    Logic::Trend daily_macd_look(Graph::Frame &frame)
+    {
+        return daily_macd_look<Config>(daily_macd_reading<Config>(frame));
+    }
+
+    template <typename Config>
+    Logic::Trend trend(const Reading &hourly, const Reading &daily)
     {
-        Logic::Trend hourly_trend{hourly_macd_look(symbol)};
-        Logic::Trend daily_trend{daily_macd_look(symbol)};
+        Logic::Trend hourly_trend{hourly_macd_look<Config>(hourly)};
+        Logic::Trend daily_trend{daily_macd_look<Config>(daily)};
 
         return Logic::combine_trends(std::vector<Logic::Trend>{hourly_trend, daily_trend});
     }
 
+    template <typename Config>
+    Logic::Trend trend(Graph::Frame &hourly_frame, Graph::Frame &daily_frame)
+    {
+        Logic::Trend hourly_trend{hourly_macd_look<Config>(hourly_frame)};
+        Logic::Trend daily_trend{daily_macd_look<Config>(daily_frame)};
+
+        return Logic::combine_trends(std::vector<Logic::Trend>{hourly_trend, daily_trend});
+    }
+
+    template Logic::Trend trend<Strategy::DefaultMACD>(const Reading &hourly, const Reading &daily);
+    template Logic::Trend trend<Strategy::FastMACD>(const Reading &hourly, const Reading &daily);
+    template Logic::Trend trend<Strategy::DefaultMACD>(Graph::Frame &hourly_frame, Graph::Frame &daily_frame);
+    template Logic::Trend trend<Strategy::FastMACD>(Graph::Frame &hourly_frame, Graph::Frame &daily_frame);
+
 }
\ No newline at end of file
@@ -1,45 +1,53 @@
 #include "models/logic.h"
 #include "models/base.h"
-#include "models/ta.h"
-#include "api/alphavantage.h"
+#include "models/graph.h"
 #include "models/rsi.h"
-
-#define RSI_FLAT_BUFFER 0.25
-#define RSI_PERIOD 14
-#define RSI_SLOPE_PERIOD 7
-#define RSI_OVERSOLD 30
-#define RSI_OVERBOUGHT 70
+#include "models/strategy.h"
 
 namespace RSI
 {
 
-    Logic::Trend hourly_rsi_look(const char *symbol)
+    template <typename Config>
+    Reading rsi_reading(Graph::Frame &frame)
     {
-        std::vector<AlphaVantage::TimeSeries> ts = AlphaVantage::hourly(symbol);
-
-        std::vector<float> prices{Base::typical_prices(ts)};
-
-        std::vector<float> RSI;
-        TA::RSI(prices, RSI_PERIOD, RSI);
+        Graph::Node RSI{frame.rsi(frame.typical(), Config::period)};
+        Graph::Node RSI_EMA{frame.ema(RSI, Config::period)};
+        frame.require(RSI, Config::slope_period + 1);
+        frame.require(RSI_EMA, Config::slope_period + 1);
+
+        Strategy::Window<Config::slope_period + 1> rsi;
+        Strategy::Window<Config::slope_period + 1> rsi_ema;
+        if (!rsi.fill(frame.values(RSI)) || !rsi_ema.fill(frame.values(RSI_EMA)))
+        {
+            return Reading{false, 0, 0, 0, 0};
+        }
+        return Reading{true, rsi.last(), rsi_ema.last(), rsi.slope(), rsi_ema.slope()};
+    }
 
-        std::vector<float> RSI_EMA;
-        TA::EMA(RSI, RSI_PERIOD, RSI_EMA);
+    template <typename Config>
+    Logic::Trend hourly_rsi_look(const Reading &reading)
+    {
+        if (!reading.ready)
+        {
+            Serial.println("Hourly RSI: not enough bars");
+            return Logic::Trend::FLAT;
+        }
 
-        float rsi_slope{Base::slope_from_prices(RSI, RSI_SLOPE_PERIOD)};
-        float rsi_ema_slope{Base::slope_from_prices(RSI_EMA, RSI_SLOPE_PERIOD)};
+        float rsi_slope{reading.rsi_slope};
+        float rsi_ema_slope{reading.rsi_ema_slope};
 
-        float current_rsi{RSI[RSI.size() - 1]};
-        float current_rsi_ema{RSI_EMA[RSI_EMA.size() - 1]};
+        float current_rsi{reading.rsi};
+        float current_rsi_ema{reading.rsi_ema};
         Serial.println("Hourly RSI");
         Serial.println("RSI: " + String(current_rsi));
         Serial.println("RSI EMA: " + String(current_rsi_ema));
         Serial.println("RSI Slope: " + String(rsi_slope));
         Serial.println("RSI EMA Slope: " + String(rsi_ema_slope));
-        bool rsi_overbought{current_rsi >= RSI_OVERBOUGHT};
-        bool rsi_oversold{current_rsi < RSI_OVERSOLD};
+        bool rsi_overbought{current_rsi >= Config::overbought};
+        bool rsi_oversold{current_rsi < Config::oversold};
 
-        bool rsi_ema_overbought{current_rsi_ema >= RSI_OVERBOUGHT};
-        bool rsi_ema_oversold{current_rsi_ema < RSI_OVERSOLD};
+        bool rsi_ema_overbought{current_rsi_ema >= Config::overbought};
+        bool rsi_ema_oversold{current_rsi_ema < Config::oversold};
 
         if (rsi_overbought && rsi_ema_overbought)
         {
@@ -51,11 +59,11 @@ namespace RSI
         }
         else if (current_rsi > current_rsi_ema)
         {
-            if (rsi_slope > rsi_ema_slope + RSI_FLAT_BUFFER)
+            if (rsi_slope > rsi_ema_slope + Config::flat_buffer)
             {
                 return Logic::Trend::UP;
             }
-            else if (rsi_slope < rsi_ema_slope - RSI_FLAT_BUFFER)
+            else if (rsi_slope < rsi_ema_slope - Config::flat_buffer)
             {
                 return Logic::Trend::FLAT;
             }
@@ -66,11 +74,11 @@ namespace RSI
         }
         else if (current_rsi < current_rsi_ema)
         {
-            if (rsi_slope > rsi_ema_slope + RSI_FLAT_BUFFER)
+            if (rsi_slope > rsi_ema_slope + Config::flat_buffer)
             {
                 return Logic::Trend::FLAT;
             }
-            else if (rsi_slope < rsi_ema_slope - RSI_FLAT_BUFFER)
+            else if (rsi_slope < rsi_ema_slope - Config::flat_buffer)
             {
                 return Logic::Trend::DOWN;
             }
@@ -81,11 +89,11 @@ namespace RSI
         }
         else if (current_rsi == current_rsi_ema)
         {
-            if (rsi_slope > rsi_ema_slope + RSI_FLAT_BUFFER)
+            if (rsi_slope > rsi_ema_slope + Config::flat_buffer)
             {
                 return Logic::Trend::UP;
             }
-            else if (rsi_slope < rsi_ema_slope - RSI_FLAT_BUFFER)
+            else if (rsi_slope < rsi_ema_slope - Config::flat_buffer)
             {
                 return Logic::Trend::DOWN;
             }
@@ -100,23 +108,20 @@ namespace RSI
         }
     }
 
-    Logic::Trend daily_rsi_look(const char *symbol)
+    template <typename Config>
+    Logic::Trend daily_rsi_look(const Reading &reading)
     {
-        std::vector<AlphaVantage::TimeSeries> ts = AlphaVantage::daily(symbol);
-
-        std::vector<float> prices{Base::typical_prices(ts)};
-
-        std::vector<float> RSI;
-        TA::RSI(prices, RSI_PERIOD, RSI);
-
-        std::vector<float> RSI_EMA;
-        TA::EMA(RSI, RSI_PERIOD, RSI_EMA);
+        if (!reading.ready)
+        {
+            Serial.println("Daily RSI: not enough bars");
+            return Logic::Trend::FLAT;
+        }
 
-        float rsi_slope{Base::slope_from_prices(RSI, RSI_SLOPE_PERIOD)};
-        float rsi_ema_slope{Base::slope_from_prices(RSI_EMA, RSI_SLOPE_PERIOD)};
+        float rsi_slope{reading.rsi_slope};
+        float rsi_ema_slope{reading.rsi_ema_slope};
 
-        float current_rsi{RSI[RSI.size() - 1]};
-        float current_rsi_ema{RSI_EMA[RSI_EMA.size() - 1]};
+        float current_rsi{reading.rsi};
+        float current_rsi_ema{reading.rsi_ema};
 
         Serial.println("Daily RSI");
         Serial.println("RSI: " + String(current_rsi));
@@ -124,11 +129,11 @@ namespace RSI
         Serial.println("RSI Slope: " + String(rsi_slope));
         Serial.println("RSI EMA Slope: " + String(rsi_ema_slope));
 
-        bool rsi_overbought{current_rsi >= RSI_OVERBOUGHT};
-        bool rsi_oversold{current_rsi <= RSI_OVERSOLD};
+        bool rsi_overbought{current_rsi >= Config::overbought};
+        bool rsi_oversold{current_rsi <= Config::oversold};
 
-        bool rsi_ema_overbought{current_rsi_ema > RSI_OVERBOUGHT};
-        bool rsi_ema_oversold{current_rsi_ema < RSI_OVERSOLD};
+        bool rsi_ema_overbought{current_rsi_ema > Config::overbought};
+        bool rsi_ema_oversold{current_rsi_ema < Config::oversold};
 
         if (rsi_overbought && rsi_ema_overbought)
         {
@@ -140,11 +145,11 @@ namespace RSI
         }
         else if (current_rsi > current_rsi_ema)
         {
-            if (rsi_slope > rsi_ema_slope + RSI_FLAT_BUFFER)
+            if (rsi_slope > rsi_ema_slope + Config::flat_buffer)
             {
                 return Logic::Trend::UP;
             }
-            else if (rsi_slope < rsi_ema_slope - RSI_FLAT_BUFFER)
+            else if (rsi_slope < rsi_ema_slope - Config::flat_buffer)
             {
                 return Logic::Trend::FLAT;
             }
@@ -155,11 +160,11 @@ namespace RSI
         }
         else if (current_rsi < current_rsi_ema)
         {
-            if (rsi_slope > rsi_ema_slope + RSI_FLAT_BUFFER)
+            if (rsi_slope > rsi_ema_slope + Config::flat_buffer)
             {
                 return Logic::Trend::FLAT;
             }
-            else if (rsi_slope < rsi_ema_slope - RSI_FLAT_BUFFER)
+            else if (rsi_slope < rsi_ema_slope - Config::flat_buffer)
             {
                 return Logic::Trend::DOWN;
             }
@@ -170,11 +175,11 @@ namespace RSI
         }
         else if (current_rsi == current_rsi_ema)
         {
-            if (rsi_slope > rsi_ema_slope + RSI_FLAT_BUFFER)
+            if (rsi_slope > rsi_ema_slope + Config::flat_buffer)
             {
                 return Logic::Trend::UP;
             }
-            else if (rsi_slope < rsi_ema_slope - RSI_FLAT_BUFFER)
+            else if (rsi_slope < rsi_ema_slope - Config::flat_buffer)
             {
                 return Logic::Trend::DOWN;
             }
@@ -189,11 +194,38 @@ namespace RSI
         }
     }
 
-    Logic::Trend trend(const char *symbol)
+    template <typename Config>
+    Logic::Trend hourly_rsi_look(Graph::Frame &frame)
+    {
+        return hourly_rsi_look<Config>(rsi_reading<Config>(frame));
+    }
+
+    template <typename Config>
+    Logic::Trend daily_rsi_look(Graph::Frame &frame)
+    {
+        return daily_rsi_look<Config>(rsi_reading<Config>(frame));
+    }
+
+    template <typename Config>
+    Logic::Trend trend(const Reading &hourly_reading, const Reading &daily_reading)
     {
-        Logic::Trend hourly{hourly_rsi_look(symbol)};
-        Logic::Trend daily{daily_rsi_look(symbol)};
+        Logic::Trend hourly{hourly_rsi_look<Config>(hourly_reading)};
+        Logic::Trend daily{daily_rsi_look<Config>(daily_reading)};
 
         return Logic::combine_trends(std::vector<Logic::Trend>{hourly, daily});
     }
+
+    template <typename Config>
+    Logic::Trend trend(Graph::Frame &hourly_frame, Graph::Frame &daily_frame)
+    {
+        Logic::Trend hourly{hourly_rsi_look<Config>(hourly_frame)};
+        Logic::Trend daily{daily_rsi_look<Config>(daily_frame)};
+
+        return Logic::combine_trends(std::vector<Logic::Trend>{hourly, daily});
+    }
+
+    template Logic::Trend trend<Strategy::DefaultRSI>(const Reading &hourly, const Reading &daily);
+    template Logic::Trend trend<Strategy::FastRSI>(const Reading &hourly, const Reading &daily);
+    template Logic::Trend trend<Strategy::DefaultRSI>(Graph::Frame &hourly_frame, Graph::Frame &daily_frame);
+    template Logic::Trend trend<Strategy::FastRSI>(Graph::Frame &hourly_frame, Graph::Frame &daily_frame);
 }
\ No newline at end of file
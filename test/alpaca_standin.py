@@ -0,0 +1,352 @@
+"""Local Alpaca stand-in for testing the trader without a paper account.
+
+Serves the parts of the Alpaca v2 trading API that src/api/alpaca.cpp calls, over
+plain HTTP:
+
+    python test/alpaca_standin.py --port 8080 --buying-power 100000
+
+and point the firmware (or a host build) at it before trading:
+
+    Alpaca::set_base_url("http://<host>:8080", nullptr);
+
+Orders are checked the way Alpaca checks them, including bracket, OCO and
+trailing-stop orders, and are worked against prices posted to the stand-in:
+
+    curl -X POST localhost:8080/standin/prices -d '{"TQQQ": 41.2}'
+
+Market orders fill at the last posted price. Limit, stop and trailing-stop orders
+fill when a posted price crosses them. A filled bracket entry activates its
+take-profit and stop-loss legs; when either leg fills the other is canceled.
+GET /standin/fills lists every fill so a test can check which exit ran.
+"""
+
+import argparse
+import itertools
+import json
+import re
+import threading
+from http.server import BaseHTTPRequestHandler, HTTPServer
+
+SIDES = ("buy", "sell")
+TYPES = ("market", "limit", "stop", "stop_limit", "trailing_stop")
+TIME_IN_FORCE = ("day", "gtc", "opg", "cls", "ioc", "fok")
+ORDER_CLASSES = ("simple", "bracket", "oco", "oto")
+OPEN_STATUSES = ("new", "held", "accepted")
+
+
+class Rejected(Exception):
+    """An order Alpaca would refuse with 422 and this message."""
+
+
+def number(value, name):
+    try:
+        return float(value)
+    except (TypeError, ValueError):
+        raise Rejected("invalid %s" % name)
+
+
+def opposite(side):
+    return "sell" if side == "buy" else "buy"
+
+
+class Broker:
+    """Orders, positions and cash, moved forward by posted prices."""
+
+    def __init__(self, buying_power):
+        self.lock = threading.Lock()
+        self.cash = buying_power
+        self.prices = {}
+        self.orders = {}
+        self.positions = {}
+        self.fills = []
+        self.groups = {}
+        self.ids = itertools.count(1)
+
+    # Order entry
+
+    def submit(self, body):
+        symbol = body.get("symbol")
+        side = body.get("side")
+        order_type = body.get("type", "market")
+        order_class = body.get("order_class") or "simple"
+        if not symbol:
+            raise Rejected("symbol is required")
+        if side not in SIDES:
+            raise Rejected("invalid side")
+        if order_type not in TYPES:
+            raise Rejected("invalid order type")
+        if body.get("time_in_force", "day") not in TIME_IN_FORCE:
+            raise Rejected("invalid time_in_force")
+        if order_class not in ORDER_CLASSES:
+            raise Rejected("invalid order_class")
+
+        qty = body.get("qty")
+        notional = body.get("notional")
+        if (qty is None) == (notional is None):
+            raise Rejected("exactly one of qty or notional is required")
+        if notional is not None and (order_type != "market" or order_class != "simple"):
+            raise Rejected("notional orders must be simple market orders")
+        qty = number(qty, "qty") if qty is not None else None
+        notional = number(notional, "notional") if notional is not None else None
+        if (qty is not None and qty <= 0) or (notional is not None and notional <= 0):
+            raise Rejected("qty and notional must be positive")
+
+        if order_class == "bracket":
+            return self.submit_bracket(symbol, side, order_type, qty, body)
+        if order_class == "oco":
+            return self.submit_oco(symbol, side, order_type, qty, body)
+        if order_class == "oto":
+            raise Rejected("oto orders are not supported by the stand-in")
+
+        order = self.new_order(symbol, side, order_type, qty, body)
+        order["notional"] = notional
+        self.work(symbol)
+        return order
+
+    def submit_bracket(self, symbol, side, order_type, qty, body):
+        if order_type not in ("market", "limit"):
+            raise Rejected("bracket orders must be market or limit orders")
+        take_profit, stop_loss = self.exit_prices(body)
+        if side == "buy" and not take_profit > stop_loss:
+            raise Rejected("take_profit.limit_price must be above stop_loss.stop_price for a buy")
+        if side == "sell" and not take_profit < stop_loss:
+            raise Rejected("take_profit.limit_price must be below stop_loss.stop_price for a sell")
+
+        entry = self.new_order(symbol, side, order_type, qty, body)
+        entry["order_class"] = "bracket"
+        entry["legs"] = self.exit_group(
+            self.new_order(symbol, opposite(side), "limit", qty, {"limit_price": take_profit}, "held", entry),
+            self.new_order(symbol, opposite(side), "stop", qty, {"stop_price": stop_loss}, "held", entry))
+        self.work(symbol)
+        return entry
+
+    def submit_oco(self, symbol, side, order_type, qty, body):
+        if order_type != "limit":
+            raise Rejected("oco orders must be limit orders")
+        take_profit, stop_loss = self.exit_prices(body)
+        held = self.positions.get(symbol, 0.0)
+        if (side == "sell" and held < qty) or (side == "buy" and -held < qty):
+            raise Rejected("oco orders exit an existing position of at least qty")
+
+        first = self.new_order(symbol, side, "limit", qty, {"limit_price": take_profit})
+        first["order_class"] = "oco"
+        first["legs"] = [self.new_order(symbol, side, "stop", qty, {"stop_price": stop_loss}, "new", first)]
+        self.exit_group(first, first["legs"][0])
+        self.work(symbol)
+        return first
+
+    def exit_group(self, *orders):
+        """Exits of which only one may fill."""
+        group = "group-%d" % next(self.ids)
+        self.groups[group] = list(orders)
+        for order in orders:
+            order["group"] = group
+        return list(orders)
+
+    def exit_prices(self, body):
+        take_profit = (body.get("take_profit") or {}).get("limit_price")
+        stop_loss = (body.get("stop_loss") or {}).get("stop_price")
+        if take_profit is None or stop_loss is None:
+            raise Rejected("take_profit.limit_price and stop_loss.stop_price are required")
+        return number(take_profit, "take_profit.limit_price"), number(stop_loss, "stop_loss.stop_price")
+
+    def new_order(self, symbol, side, order_type, qty, body, status="new", parent=None):
+        order = {
+            "id": "standin-%d" % next(self.ids),
+            "symbol": symbol,
+            "side": side,
+            "type": order_type,
+            "qty": qty,
+            "order_class": "simple",
+            "time_in_force": body.get("time_in_force", "gtc"),
+            "status": status,
+            "legs": None,
+            "parent": parent["id"] if parent else None,
+        }
+        for key in ("limit_price", "stop_price"):
+            if key in body:
+                order[key] = number(body[key], key)
+        if order_type in ("limit", "stop_limit") and "limit_price" not in order:
+            raise Rejected("limit_price is required")
+        if order_type in ("stop", "stop_limit") and "stop_price" not in order:
+            raise Rejected("stop_price is required")
+        if order_type == "trailing_stop":
+            trail = [key for key in ("trail_price", "trail_percent") if key in body]
+            if len(trail) != 1:
+                raise Rejected("exactly one of trail_price or trail_percent is required")
+            order[trail[0]] = number(body[trail[0]], trail[0])
+            order["hwm"] = self.prices.get(symbol)
+        self.orders[order["id"]] = order
+        return order
+
+    # Matching
+
+    def post_prices(self, prices):
+        for symbol, price in prices.items():
+            self.prices[symbol] = number(price, "price")
+            self.work(symbol)
+
+    def work(self, symbol):
+        """Fills every open order on symbol that the last price crosses."""
+        price = self.prices.get(symbol)
+        if price is None:
+            return
+        for order in list(self.orders.values()):
+            if order["symbol"] == symbol and order["status"] == "new" and self.crosses(order, price):
+                self.fill(order, price)
+
+    def crosses(self, order, price):
+        buy = order["side"] == "buy"
+        kind = order["type"]
+        if kind == "market":
+            return True
+        if kind == "limit":
+            return price <= order["limit_price"] if buy else price >= order["limit_price"]
+        if kind in ("stop", "stop_limit"):
+            return price >= order["stop_price"] if buy else price <= order["stop_price"]
+
+        # Trailing stop: follow the best price since submission, trigger on the pullback.
+        hwm = order["hwm"]
+        if hwm is None or (price < hwm if buy else price > hwm):
+            order["hwm"] = hwm = price
+        trail = order.get("trail_price")
+        if trail is None:
+            trail = hwm * order["trail_percent"] / 100.0
+        order["stop_price"] = hwm + trail if buy else hwm - trail
+        return price >= order["stop_price"] if buy else price <= order["stop_price"]
+
+    def fill(self, order, price):
+        qty = order["qty"] if order["qty"] is not None else order["notional"] / price
+        signed = qty if order["side"] == "buy" else -qty
+        self.cash -= signed * price
+        held = self.positions.get(order["symbol"], 0.0) + signed
+        if abs(held) < 1e-9:
+            self.positions.pop(order["symbol"], None)
+        else:
+            self.positions[order["symbol"]] = held
+
+        order["status"] = "filled"
+        order["filled_qty"] = qty
+        order["filled_avg_price"] = price
+        self.fills.append({"id": order["id"], "symbol": order["symbol"], "side": order["side"],
+                           "type": order["type"], "qty": qty, "price": price})
+
+        # A filled bracket entry releases its exits; a filled exit cancels the other one.
+        for leg in order["legs"] or []:
+            if leg["status"] == "held":
+                leg["status"] = "new"
+        for other in self.groups.get(order.get("group"), []):
+            if other is not order and other["status"] in OPEN_STATUSES:
+                other["status"] = "canceled"
+
+    # Queries and cancels
+
+    def open_orders(self):
+        return [order for order in self.orders.values() if order["status"] in OPEN_STATUSES]
+
+    def cancel(self, order_id):
+        order = self.orders.get(order_id)
+        if order is None or order["status"] not in OPEN_STATUSES:
+            return False
+        order["status"] = "canceled"
+        for leg in order["legs"] or []:
+            if leg["status"] in OPEN_STATUSES:
+                leg["status"] = "canceled"
+        return True
+
+    def close(self, symbol):
+        held = self.positions.get(symbol)
+        if held is None:
+            return False
+        reserved = sum(order["qty"] or 0 for order in self.open_orders()
+                       if order["symbol"] == symbol and order["side"] == ("sell" if held > 0 else "buy"))
+        if reserved > 0:
+            raise Rejected("insufficient qty available for order (held by open orders)")
+        if symbol not in self.prices:
+            raise Rejected("no price posted for %s" % symbol)
+        order = self.new_order(symbol, "sell" if held > 0 else "buy", "market", abs(held), {})
+        self.fill(order, self.prices[symbol])
+        return True
+
+    def position_list(self):
+        return [{"symbol": symbol, "qty": str(qty), "side": "long" if qty > 0 else "short",
+                 "current_price": self.prices.get(symbol)} for symbol, qty in self.positions.items()]
+
+
+class Handler(BaseHTTPRequestHandler):
+    broker = None
+
+    def reply(self, status, payload):
+        body = json.dumps(payload).encode()
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def body(self):
+        length = int(self.headers.get("Content-Length") or 0)
+        try:
+            return json.loads(self.rfile.read(length) or b"{}")
+        except ValueError:
+            raise Rejected("request body is not JSON")
+
+    def route(self, method):
+        path = self.path.split("?")[0].rstrip("/")
+        broker = self.broker
+        with broker.lock:
+            try:
+                if method == "GET" and path == "/v2/account":
+                    return self.reply(200, {"buying_power": "%.2f" % broker.cash, "cash": "%.2f" % broker.cash})
+                if method == "GET" and path == "/v2/orders":
+                    return self.reply(200, broker.open_orders())
+                if method == "POST" and path == "/v2/orders":
+                    return self.reply(200, broker.submit(self.body()))
+                if method == "DELETE" and path == "/v2/orders":
+                    ids = [order["id"] for order in broker.open_orders() if order["parent"] is None]
+                    return self.reply(207, [{"id": i, "status": 200 if broker.cancel(i) else 404} for i in ids])
+                match = re.match(r"^/v2/orders/([\w-]+)$", path)
+                if method == "DELETE" and match:
+                    return self.reply(204 if broker.cancel(match.group(1)) else 404, {})
+                if method == "GET" and path == "/v2/positions":
+                    return self.reply(200, broker.position_list())
+                if method == "DELETE" and path == "/v2/positions":
+                    symbols = list(broker.positions)
+                    return self.reply(207, [{"symbol": s, "status": 200 if broker.close(s) else 404} for s in symbols])
+                match = re.match(r"^/v2/positions/(\w+)$", path)
+                if method == "DELETE" and match:
+                    return self.reply(200 if broker.close(match.group(1)) else 404, {})
+                if method == "POST" and path == "/standin/prices":
+                    broker.post_prices(self.body())
+                    return self.reply(200, broker.prices)
+                if method == "GET" and path == "/standin/fills":
+                    return self.reply(200, broker.fills)
+                return self.reply(404, {"message": "not found"})
+            except Rejected as error:
+                return self.reply(422, {"message": str(error)})
+
+    def do_GET(self):
+        self.route("GET")
+
+    def do_POST(self):
+        self.route("POST")
+
+    def do_DELETE(self):
+        self.route("DELETE")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--buying-power", type=float, default=100000.0)
+    args = parser.parse_args()
+
+    Handler.broker = Broker(args.buying_power)
+    server = HTTPServer((args.host, args.port), Handler)
+    print("Alpaca stand-in on http://%s:%d" % (args.host, args.port))
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
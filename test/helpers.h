@@ -0,0 +1,80 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+
+// Shared by the host test suites: reproducible price walks, the worst error against a
+// reference, and timings.
+
+namespace Helpers
+{
+    // Uniform in [-1, 1) from a fixed LCG, so every host sees the same data.
+    class Random
+    {
+    public:
+        explicit Random(uint32_t seed) : state{seed} {}
+
+        float next()
+        {
+            state = state * 1664525u + 1013904223u;
+            return (state >> 8) / 8388608.0f - 1.0f;
+        }
+
+    private:
+        uint32_t state;
+    };
+
+    // count prices starting at level, each moving by up to step * price, with a
+    // drift of drift * price per bar.
+    inline std::vector<float> walk(int count, float level, float step, uint32_t seed, float drift = 0)
+    {
+        std::vector<float> prices;
+        Random random{seed};
+        float price{level};
+        for (int i = 0; i < count; i++)
+        {
+            price *= 1 + drift + step * random.next();
+            prices.push_back(price);
+        }
+        return prices;
+    }
+
+    // Largest |out - expected| over count values, relative to scale.
+    template <typename Out, typename Expected>
+    double worst(const Out *out, const Expected *expected, int count, double scale = 1)
+    {
+        double error{0};
+        for (int i = 0; i < count; i++)
+        {
+            error = fmax(error, fabs(static_cast<double>(out[i]) - static_cast<double>(expected[i])) / scale);
+        }
+        return error;
+    }
+
+    // Microseconds per call: the median of several batches of repeats calls, so one
+    // preempted batch doesn't decide it.
+    template <typename Call>
+    double microseconds(Call call, int repeats)
+    {
+        const int batches{7};
+        double times[batches];
+        for (int b = 0; b < batches; b++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < repeats; i++)
+            {
+                call();
+            }
+            times[b] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeats;
+        }
+        std::sort(times, times + batches);
+        return times[batches / 2];
+    }
+
+    // Host timings are noisy and say little about the ESP32, so they only catch gross
+    // regressions, like a rolling kernel that went O(n * period): each model must stay
+    // within this factor of ta-lib on the same data.
+    const double slowdown_bound{3.0};
+}
\ No newline at end of file
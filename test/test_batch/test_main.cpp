@@ -0,0 +1,184 @@
+#include <unity.h>
+#include <stdio.h>
+#include <vector>
+#include <ta_func.h>
+#include "models/batch.h"
+#include "../helpers.h"
+
+// Batch:: against ta-lib's double kernels fed each symbol's floats in turn (TA_S_*).
+// Symbols are interleaved into one matrix with uneven lengths, so interleave's
+// trimming to the shortest series is covered too. The timing compares one batch
+// call with ta-lib called once per symbol, within Helpers::slowdown_bound.
+
+namespace
+{
+    using Helpers::worst;
+
+    const int symbols{100};
+    const int steps{2000};
+    const float level{100};
+    const int repeats{20};
+
+    // Each symbol's own walk, the later ones a few bars longer at the front.
+    std::vector<std::vector<float>> series()
+    {
+        std::vector<std::vector<float>> all;
+        for (int s = 0; s < symbols; s++)
+        {
+            all.push_back(Helpers::walk(steps + s % 5, level, 0.01f, 200 + s));
+        }
+        return all;
+    }
+
+    // symbol's last count values, the ones the matrix holds.
+    std::vector<float> tail(const std::vector<float> &values, int count)
+    {
+        return std::vector<float>(values.end() - count, values.end());
+    }
+
+    std::vector<float> column(const Batch::Matrix &matrix, int symbol)
+    {
+        std::vector<float> values;
+        for (int t = 0; t < matrix.steps; t++)
+        {
+            values.push_back(matrix.at(t, symbol));
+        }
+        return values;
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_interleave_keeps_the_common_tail()
+{
+    std::vector<std::vector<float>> all{series()};
+    Batch::Matrix prices{Batch::interleave(all)};
+    TEST_ASSERT_EQUAL(symbols, prices.symbols);
+    TEST_ASSERT_EQUAL(steps, prices.steps);
+    for (int s = 0; s < symbols; s++)
+    {
+        TEST_ASSERT_TRUE(tail(all[s], steps) == column(prices, s));
+    }
+    TEST_ASSERT_EQUAL(0, Batch::interleave({}).symbols);
+}
+
+void test_ema_matches_ta_ema()
+{
+    std::vector<std::vector<float>> all{series()};
+    Batch::Matrix prices{Batch::interleave(all)};
+    Batch::Matrix out;
+    int count{Batch::EMA(prices, 26, out)};
+    TEST_ASSERT_EQUAL(out.steps, count);
+    for (int s = 0; s < symbols; s++)
+    {
+        std::vector<float> in{tail(all[s], steps)};
+        std::vector<double> expected(steps);
+        int outBegIdx, outNbElement;
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_EMA(0, steps - 1, in.data(), 26, &outBegIdx, &outNbElement, expected.data()));
+        TEST_ASSERT_EQUAL(outNbElement, count);
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(column(out, s).data(), expected.data(), count, level));
+    }
+}
+
+void test_rsi_matches_ta_rsi()
+{
+    std::vector<std::vector<float>> all{series()};
+    Batch::Matrix prices{Batch::interleave(all)};
+    Batch::Matrix out;
+    int count{Batch::RSI(prices, 14, out)};
+    TEST_ASSERT_EQUAL(out.steps, count);
+    for (int s = 0; s < symbols; s++)
+    {
+        std::vector<float> in{tail(all[s], steps)};
+        std::vector<double> expected(steps);
+        int outBegIdx, outNbElement;
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_RSI(0, steps - 1, in.data(), 14, &outBegIdx, &outNbElement, expected.data()));
+        TEST_ASSERT_EQUAL(outNbElement, count);
+        // RSI is on a 0-100 scale whatever the price.
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(column(out, s).data(), expected.data(), count, 100));
+    }
+
+    TEST_ASSERT_EQUAL(0, Batch::RSI(prices, 1, out));
+    TEST_ASSERT_EQUAL(0, out.steps);
+}
+
+void test_macd_matches_ta_macd()
+{
+    std::vector<std::vector<float>> all{series()};
+    Batch::Matrix prices{Batch::interleave(all)};
+    Batch::Matrix macd, signal, hist;
+    int count{Batch::MACD(prices, 12, 26, 9, macd, signal, hist)};
+    TEST_ASSERT_EQUAL(macd.steps, count);
+    for (int s = 0; s < symbols; s++)
+    {
+        std::vector<float> in{tail(all[s], steps)};
+        std::vector<double> expected_macd(steps), expected_signal(steps), expected_hist(steps);
+        int outBegIdx, outNbElement;
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_MACD(0, steps - 1, in.data(), 12, 26, 9, &outBegIdx, &outNbElement, expected_macd.data(), expected_signal.data(), expected_hist.data()));
+        TEST_ASSERT_EQUAL(outNbElement, count);
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(column(macd, s).data(), expected_macd.data(), count, level));
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(column(signal, s).data(), expected_signal.data(), count, level));
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(column(hist, s).data(), expected_hist.data(), count, level));
+    }
+}
+
+void test_timing_against_ta_lib()
+{
+    std::vector<std::vector<float>> all{series()};
+    Batch::Matrix prices{Batch::interleave(all)};
+    std::vector<std::vector<float>> columns;
+    for (int s = 0; s < symbols; s++)
+    {
+        columns.push_back(tail(all[s], steps));
+    }
+    Batch::Matrix a, b, c;
+    std::vector<double> x(steps), y(steps), z(steps);
+    int outBegIdx, outNbElement;
+
+    double batch_ema{Helpers::microseconds([&]()
+                                           { Batch::EMA(prices, 26, a); }, repeats)};
+    double talib_ema{Helpers::microseconds([&]()
+                                           { for (const std::vector<float> &in : columns)
+                                                 TA_S_EMA(0, steps - 1, in.data(), 26, &outBegIdx, &outNbElement, x.data()); }, repeats)};
+    double batch_rsi{Helpers::microseconds([&]()
+                                           { Batch::RSI(prices, 14, a); }, repeats)};
+    double talib_rsi{Helpers::microseconds([&]()
+                                           { for (const std::vector<float> &in : columns)
+                                                 TA_S_RSI(0, steps - 1, in.data(), 14, &outBegIdx, &outNbElement, x.data()); }, repeats)};
+    double batch_macd{Helpers::microseconds([&]()
+                                            { Batch::MACD(prices, 12, 26, 9, a, b, c); }, repeats)};
+    double talib_macd{Helpers::microseconds([&]()
+                                            { for (const std::vector<float> &in : columns)
+                                                  TA_S_MACD(0, steps - 1, in.data(), 12, 26, 9, &outBegIdx, &outNbElement, x.data(), y.data(), z.data()); }, repeats)};
+
+    char line[128];
+    snprintf(line, sizeof(line), "%d x %d: Batch::EMA %.0f us, TA_S_EMA %.0f us", symbols, steps, batch_ema, talib_ema);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "%d x %d: Batch::RSI %.0f us, TA_S_RSI %.0f us", symbols, steps, batch_rsi, talib_rsi);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "%d x %d: Batch::MACD %.0f us, TA_S_MACD %.0f us", symbols, steps, batch_macd, talib_macd);
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(Helpers::slowdown_bound * talib_ema, batch_ema);
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(Helpers::slowdown_bound * talib_rsi, batch_rsi);
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(Helpers::slowdown_bound * talib_macd, batch_macd);
+}
+
+int main(int argc, char **argv)
+{
+    TA_Initialize();
+    UNITY_BEGIN();
+    RUN_TEST(test_interleave_keeps_the_common_tail);
+    RUN_TEST(test_ema_matches_ta_ema);
+    RUN_TEST(test_rsi_matches_ta_rsi);
+    RUN_TEST(test_macd_matches_ta_macd);
+    RUN_TEST(test_timing_against_ta_lib);
+    TA_Shutdown();
+    return UNITY_END();
+}
@@ -0,0 +1,153 @@
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include <ta_abstract.h>
+#include "models/candles.h"
+#include "../helpers.h"
+
+// Candles::Scanner against every TA_CDL* function, called through ta-lib's abstract
+// interface by the pattern's name, on the same bars. The bars mix long and short
+// bodies, dojis, bare shadows and gaps, with prices in cents so equal opens, closes
+// and lows come up too.
+
+namespace
+{
+    const int bars{20000};
+
+    struct Bars
+    {
+        std::vector<double> open;
+        std::vector<double> high;
+        std::vector<double> low;
+        std::vector<double> close;
+    };
+
+    float cents(float price)
+    {
+        return roundf(price * 100) / 100;
+    }
+
+    // A body of about scale times the price: long, short or a doji, picked at random.
+    float body(Helpers::Random &random)
+    {
+        float pick{random.next()};
+        float scale{pick > 0.4f ? 0.02f : pick > -0.4f ? 0.005f : 0.0003f};
+        return scale * random.next();
+    }
+
+    // No shadow a third of the time, otherwise up to scale times the price.
+    float shadow(Helpers::Random &random, float scale)
+    {
+        return random.next() < -0.33f ? 0 : scale * fabsf(random.next());
+    }
+
+    Bars shapes(uint32_t seed)
+    {
+        Helpers::Random random{seed};
+        Bars series;
+        float close{100};
+        for (int i = 0; i < bars; i++)
+        {
+            // Mostly opening near the last close, sometimes with a gap.
+            float gap{fabsf(random.next()) > 0.7f ? 0.02f * random.next() : 0.001f * random.next()};
+            float open{cents(close * (1 + gap))};
+            close = cents(open * (1 + body(random)));
+            float high{cents(fmaxf(open, close) * (1 + shadow(random, 0.01f)))};
+            float low{cents(fminf(open, close) * (1 - shadow(random, 0.01f)))};
+            series.open.push_back(open);
+            series.high.push_back(high);
+            series.low.push_back(low);
+            series.close.push_back(close);
+        }
+        return series;
+    }
+
+    // The TA_CDL* output and lookback for pattern over all of series.
+    void call(Candles::Pattern pattern, const Bars &series, std::vector<int> &out, int &outBegIdx, int &lookback)
+    {
+        const TA_FuncHandle *handle;
+        TA_ParamHolder *params;
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_GetFuncHandle(Candles::name(pattern), &handle));
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_ParamHolderAlloc(handle, &params));
+        TA_SetInputParamPricePtr(params, 0, series.open.data(), series.high.data(), series.low.data(), series.close.data(), nullptr, nullptr);
+        TA_SetOutputParamIntegerPtr(params, 0, out.data());
+        int outNbElement;
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_CallFunc(params, 0, bars - 1, &outBegIdx, &outNbElement));
+        TEST_ASSERT_EQUAL(bars - outBegIdx, outNbElement);
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_GetLookback(params, &lookback));
+        TA_ParamHolderFree(params);
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_signals_match_ta_cdl()
+{
+    Bars series{shapes(3)};
+    Candles::Scanner scanner;
+    std::vector<Candles::Signals> signals;
+    for (int i = 0; i < bars; i++)
+    {
+        signals.push_back(scanner.update(series.open[i], series.high[i], series.low[i], series.close[i]));
+    }
+
+    int fired{0};
+    std::vector<int> out(bars);
+    for (int p = 0; p < Candles::pattern_count; p++)
+    {
+        Candles::Pattern pattern{static_cast<Candles::Pattern>(p)};
+        int outBegIdx, lookback;
+        call(pattern, series, out, outBegIdx, lookback);
+
+        int found{0};
+        for (int i = 0; i < bars; i++)
+        {
+            int expected{i < outBegIdx ? 0 : out[i - outBegIdx]};
+            if (signals[i].value(pattern) != expected)
+            {
+                char line[96];
+                snprintf(line, sizeof(line), "%s bar %d: %d, ta-lib %d", Candles::name(pattern), i, signals[i].value(pattern), expected);
+                TEST_FAIL_MESSAGE(line);
+            }
+            found += expected != 0;
+        }
+        fired += found > 0;
+    }
+
+    // Otherwise most comparisons would be of zeros.
+    char line[64];
+    snprintf(line, sizeof(line), "%d of %d patterns fired", fired, Candles::pattern_count);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_GREATER_OR_EQUAL(55, fired);
+}
+
+void test_lookback_matches_ta_cdl_lookback()
+{
+    Bars series{shapes(5)};
+    std::vector<int> out(bars);
+    for (int p = 0; p < Candles::pattern_count; p++)
+    {
+        Candles::Pattern pattern{static_cast<Candles::Pattern>(p)};
+        int outBegIdx, lookback;
+        call(pattern, series, out, outBegIdx, lookback);
+        TEST_ASSERT_EQUAL_MESSAGE(lookback, Candles::lookback(pattern), Candles::name(pattern));
+        TEST_ASSERT_EQUAL(lookback, outBegIdx);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    TA_Initialize();
+    UNITY_BEGIN();
+    RUN_TEST(test_signals_match_ta_cdl);
+    RUN_TEST(test_lookback_matches_ta_cdl_lookback);
+    TA_Shutdown();
+    return UNITY_END();
+}
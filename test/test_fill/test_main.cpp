@@ -0,0 +1,107 @@
+#include <unity.h>
+#include <vector>
+#include "models/fill.h"
+
+// Fill::simulate on a handful of hand-made bars: market orders priced by the models
+// with their slippage, and limit orders filled in parts by each bar's volume.
+
+namespace
+{
+    // Bar i opens at open[i] and trades 1000 shares between low[i] and high[i].
+    Fill::Bars bars(std::vector<float> open, std::vector<float> high, std::vector<float> low)
+    {
+        Fill::Bars bars;
+        bars.open = open;
+        bars.high = high;
+        bars.low = low;
+        bars.close = open;
+        bars.volume.assign(open.size(), 1000);
+        return bars;
+    }
+
+    Fill::Config no_slippage(int limit_lifetime)
+    {
+        Fill::Config config{Fill::default_config};
+        config.half_spread = 0;
+        config.impact = 0;
+        config.limit_lifetime = limit_lifetime;
+        return config;
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_market_order_fills_next_bar()
+{
+    Fill::Bars history{bars({10, 11, 12}, {10, 13, 12}, {10, 9, 12})};
+    history.close = {10, 11, 12};
+    Fill::Orders orders;
+    orders.add(0, 10, 1);
+
+    Fill::Fills fills;
+    Fill::Config config{no_slippage(1)};
+    config.model = Fill::bar_ohlc4;
+    Fill::simulate(history, orders, config, fills);
+    TEST_ASSERT_EQUAL(1, fills.size());
+    TEST_ASSERT_EQUAL(1, fills.bar[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, (11 + 13 + 9 + 11) / 4.0f, fills.price[0]);
+
+    // A buy pays the half spread plus impact * sqrt(qty / volume) on top.
+    fills.clear();
+    config.half_spread = 0.001f;
+    config.impact = 0.1f;
+    Fill::simulate(history, orders, config, fills);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, (11 + 13 + 9 + 11) / 4.0f * (1 + 0.001f + 0.1f * 0.1f), fills.price[0]);
+}
+
+void test_limit_order_fills_in_parts()
+{
+    // 10% of 1000 shares a bar: 250 shares take three bars, bar 2 never reaches the limit.
+    Fill::Bars history{bars({10, 10, 11, 10.5f, 9.5f}, {10, 10.5f, 11.5f, 11, 10}, {10, 9.8f, 10.5f, 9.9f, 9})};
+    Fill::Orders orders;
+    orders.add(0, 250, 1, 10);
+
+    Fill::Fills fills;
+    Fill::simulate(history, orders, no_slippage(4), fills);
+    TEST_ASSERT_EQUAL(3, fills.size());
+    TEST_ASSERT_EQUAL(1, fills.bar[0]);
+    TEST_ASSERT_EQUAL(3, fills.bar[1]);
+    TEST_ASSERT_EQUAL(4, fills.bar[2]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 100, fills.qty[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 100, fills.qty[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 50, fills.qty[2]);
+    // At the limit, or at the open when the bar opens through it.
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 10, fills.price[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 10, fills.price[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 9.5f, fills.price[2]);
+}
+
+void test_limit_order_rest_is_cancelled()
+{
+    // A sell resting two bars gets 100 shares from each and the other 300 are dropped.
+    Fill::Bars history{bars({10, 10, 10, 10}, {11, 11, 11, 11}, {9, 9, 9, 9})};
+    Fill::Orders orders;
+    orders.add(0, 500, -1, 10.5f);
+
+    Fill::Fills fills;
+    Fill::simulate(history, orders, no_slippage(2), fills);
+    TEST_ASSERT_EQUAL(2, fills.size());
+    TEST_ASSERT_EQUAL(2, fills.bar[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 200, fills.qty[0] + fills.qty[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 10.5f, fills.price[0]);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_market_order_fills_next_bar);
+    RUN_TEST(test_limit_order_fills_in_parts);
+    RUN_TEST(test_limit_order_rest_is_cancelled);
+    return UNITY_END();
+}
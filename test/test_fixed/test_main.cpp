@@ -0,0 +1,150 @@
+#include <unity.h>
+#include <stdio.h>
+#include <vector>
+#include <ta_func.h>
+#include "models/ta_fixed.h"
+#include "../helpers.h"
+
+// TA::Fixed against ta-lib's double kernels on the same Q15.16-quantized prices, at
+// the error bounds documented in ta_fixed.h, plus a timing of both within
+// Helpers::slowdown_bound.
+
+using TA::Fixed::q16;
+
+namespace
+{
+    const int bars{400};
+
+    struct Series
+    {
+        std::vector<q16> fixed;
+        std::vector<double> exact;
+    };
+
+    // A reproducible random walk around start, kept inside [low, high].
+    Series walk(float start, float step, float low, float high)
+    {
+        Series series;
+        Helpers::Random random{12345};
+        float price{start};
+        for (int i = 0; i < bars; i++)
+        {
+            price += step * random.next();
+            price = price < low ? 2 * low - price : price > high ? 2 * high - price : price;
+            q16 quantized{TA::Fixed::from_float(price)};
+            series.fixed.push_back(quantized);
+            series.exact.push_back(TA::Fixed::to_float(quantized));
+        }
+        return series;
+    }
+
+    double worst(const q16 *fixed, const double *exact, int count)
+    {
+        std::vector<float> converted(count);
+        for (int i = 0; i < count; i++)
+        {
+            converted[i] = TA::Fixed::to_float(fixed[i]);
+        }
+        return Helpers::worst(converted.data(), exact, count);
+    }
+
+    void check_rsi(const Series &series)
+    {
+        std::vector<q16> out(bars);
+        std::vector<double> expected(bars);
+        int outBegIdx, outNbElement;
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_RSI(0, bars - 1, series.exact.data(), 14, &outBegIdx, &outNbElement, expected.data()));
+        TEST_ASSERT_EQUAL(outNbElement, TA::Fixed::RSI(series.fixed.data(), bars, 14, out.data()));
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(5e-4, worst(out.data(), expected.data(), outNbElement));
+    }
+
+    void check_macd(const Series &series)
+    {
+        std::vector<q16> macd(bars), signal(bars), hist(bars);
+        std::vector<double> expected_macd(bars), expected_signal(bars), expected_hist(bars);
+        int outBegIdx, outNbElement;
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_MACD(0, bars - 1, series.exact.data(), 12, 26, 9, &outBegIdx, &outNbElement, expected_macd.data(), expected_signal.data(), expected_hist.data()));
+        TEST_ASSERT_EQUAL(outNbElement, TA::Fixed::MACD(series.fixed.data(), bars, 12, 26, 9, macd.data(), signal.data(), hist.data()));
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-4, worst(macd.data(), expected_macd.data(), outNbElement));
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-4, worst(signal.data(), expected_signal.data(), outNbElement));
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-4, worst(hist.data(), expected_hist.data(), outNbElement));
+    }
+
+    const int repeats{2000};
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_ema_within_rounding_bound()
+{
+    Series series{walk(100, 1.5f, 20, 400)};
+    for (int period : {9, 12, 26})
+    {
+        std::vector<q16> out(bars);
+        std::vector<double> expected(bars);
+        int outBegIdx, outNbElement;
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_EMA(0, bars - 1, series.exact.data(), period, &outBegIdx, &outNbElement, expected.data()));
+        TEST_ASSERT_EQUAL(outNbElement, TA::Fixed::EMA(series.fixed.data(), bars, period, out.data()));
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE((period + 1) / 4.0 / 65536.0, worst(out.data(), expected.data(), outNbElement));
+    }
+}
+
+void test_rsi_matches_ta_rsi()
+{
+    check_rsi(walk(100, 1.5f, 20, 400));
+}
+
+// Average gains in the thousands used to overflow the 64-bit scale in rsi_value.
+void test_rsi_survives_large_moves()
+{
+    check_rsi(walk(16000, 3000, 1000, 30000));
+}
+
+void test_macd_matches_ta_macd()
+{
+    check_macd(walk(100, 1.5f, 20, 400));
+}
+
+void test_timing_against_ta_lib()
+{
+    Series series{walk(100, 1.5f, 20, 400)};
+    std::vector<q16> a(bars), b(bars), c(bars);
+    std::vector<double> x(bars), y(bars), z(bars);
+    int outBegIdx, outNbElement;
+
+    double fixed_rsi{Helpers::microseconds([&]()
+                                           { TA::Fixed::RSI(series.fixed.data(), bars, 14, a.data()); }, repeats)};
+    double talib_rsi{Helpers::microseconds([&]()
+                                           { TA_RSI(0, bars - 1, series.exact.data(), 14, &outBegIdx, &outNbElement, x.data()); }, repeats)};
+    double fixed_macd{Helpers::microseconds([&]()
+                                            { TA::Fixed::MACD(series.fixed.data(), bars, 12, 26, 9, a.data(), b.data(), c.data()); }, repeats)};
+    double talib_macd{Helpers::microseconds([&]()
+                                            { TA_MACD(0, bars - 1, series.exact.data(), 12, 26, 9, &outBegIdx, &outNbElement, x.data(), y.data(), z.data()); }, repeats)};
+
+    char line[128];
+    snprintf(line, sizeof(line), "%d bars: Fixed::RSI %.2f us, TA_RSI %.2f us", bars, fixed_rsi, talib_rsi);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "%d bars: Fixed::MACD %.2f us, TA_MACD %.2f us", bars, fixed_macd, talib_macd);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(Helpers::slowdown_bound * talib_rsi, fixed_rsi);
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(Helpers::slowdown_bound * talib_macd, fixed_macd);
+}
+
+int main(int argc, char **argv)
+{
+    TA_Initialize();
+    UNITY_BEGIN();
+    RUN_TEST(test_ema_within_rounding_bound);
+    RUN_TEST(test_rsi_matches_ta_rsi);
+    RUN_TEST(test_rsi_survives_large_moves);
+    RUN_TEST(test_macd_matches_ta_macd);
+    RUN_TEST(test_timing_against_ta_lib);
+    TA_Shutdown();
+    return UNITY_END();
+}
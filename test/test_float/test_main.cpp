@@ -0,0 +1,207 @@
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include <ta_func.h>
+#include "models/ta_float.h"
+#include "../helpers.h"
+
+// TA::Float against ta-lib's double kernels fed the same float prices (TA_S_*), plus
+// a timing of both within Helpers::slowdown_bound. Errors are relative to the price
+// level, since the float kernels carry about seven significant digits whatever the
+// price.
+
+namespace
+{
+    using Helpers::worst;
+
+    const int bars{400};
+    const int repeats{2000};
+
+    std::vector<float> walk(float level, float step, uint32_t seed)
+    {
+        return Helpers::walk(bars, level, step, seed);
+    }
+
+    const float levels[]{100, 30000};
+    const int unstable_periods[]{0, 24};
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+    TA_SetUnstablePeriod(TA_FUNC_UNST_ALL, 0);
+}
+
+void test_ema_matches_ta_ema()
+{
+    for (float level : levels)
+    {
+        for (int unstable : unstable_periods)
+        {
+            std::vector<float> in{walk(level, 0.01f, 7)};
+            std::vector<float> out(bars);
+            std::vector<double> expected(bars);
+            int outBegIdx, outNbElement;
+            TA_SetUnstablePeriod(TA_FUNC_UNST_EMA, unstable);
+            TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_EMA(0, bars - 1, in.data(), 26, &outBegIdx, &outNbElement, expected.data()));
+            TEST_ASSERT_EQUAL(outNbElement, TA::Float::EMA(in.data(), bars, 26, out.data(), unstable));
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(out.data(), expected.data(), outNbElement, level));
+        }
+    }
+}
+
+void test_rsi_matches_ta_rsi()
+{
+    for (float level : levels)
+    {
+        for (int unstable : unstable_periods)
+        {
+            std::vector<float> in{walk(level, 0.01f, 11)};
+            std::vector<float> out(bars);
+            std::vector<double> expected(bars);
+            int outBegIdx, outNbElement;
+            TA_SetUnstablePeriod(TA_FUNC_UNST_RSI, unstable);
+            TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_RSI(0, bars - 1, in.data(), 14, &outBegIdx, &outNbElement, expected.data()));
+            TEST_ASSERT_EQUAL(outNbElement, TA::Float::RSI(in.data(), bars, 14, out.data(), unstable));
+            // RSI is on a 0-100 scale whatever the price.
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(out.data(), expected.data(), outNbElement, 100));
+        }
+    }
+}
+
+void test_macd_matches_ta_macd()
+{
+    for (float level : levels)
+    {
+        for (int unstable : unstable_periods)
+        {
+            std::vector<float> in{walk(level, 0.01f, 13)};
+            std::vector<float> macd(bars), signal(bars), hist(bars);
+            std::vector<double> expected_macd(bars), expected_signal(bars), expected_hist(bars);
+            int outBegIdx, outNbElement;
+            TA_SetUnstablePeriod(TA_FUNC_UNST_EMA, unstable);
+            TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_MACD(0, bars - 1, in.data(), 12, 26, 9, &outBegIdx, &outNbElement, expected_macd.data(), expected_signal.data(), expected_hist.data()));
+            TEST_ASSERT_EQUAL(outNbElement, TA::Float::MACD(in.data(), bars, 12, 26, 9, macd.data(), signal.data(), hist.data(), unstable));
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(macd.data(), expected_macd.data(), outNbElement, level));
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(signal.data(), expected_signal.data(), outNbElement, level));
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(hist.data(), expected_hist.data(), outNbElement, level));
+        }
+    }
+}
+
+void test_sma_matches_ta_sma()
+{
+    for (float level : levels)
+    {
+        for (int period : {2, 20, 50})
+        {
+            std::vector<float> in{walk(level, 0.01f, 17)};
+            std::vector<float> out(bars);
+            std::vector<double> expected(bars);
+            int outBegIdx, outNbElement;
+            TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_SMA(0, bars - 1, in.data(), period, &outBegIdx, &outNbElement, expected.data()));
+            TEST_ASSERT_EQUAL(outNbElement, TA::Float::SMA(in.data(), bars, period, out.data()));
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(out.data(), expected.data(), outNbElement, level));
+        }
+    }
+}
+
+void test_atr_matches_ta_atr()
+{
+    for (float level : levels)
+    {
+        for (int period : {1, 14})
+        {
+            for (int unstable : unstable_periods)
+            {
+                // Bars around a close walk, with shadows of up to 1% either side.
+                std::vector<float> close{walk(level, 0.01f, 23)};
+                std::vector<float> high(bars), low(bars);
+                Helpers::Random random{29};
+                for (int i = 0; i < bars; i++)
+                {
+                    high[i] = close[i] * (1 + 0.01f * fabsf(random.next()));
+                    low[i] = close[i] * (1 - 0.01f * fabsf(random.next()));
+                }
+                std::vector<float> out(bars);
+                std::vector<double> expected(bars);
+                int outBegIdx, outNbElement;
+                TA_SetUnstablePeriod(TA_FUNC_UNST_ATR, unstable);
+                TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_ATR(0, bars - 1, high.data(), low.data(), close.data(), period, &outBegIdx, &outNbElement, expected.data()));
+                TEST_ASSERT_EQUAL(outNbElement, TA::Float::ATR(high.data(), low.data(), close.data(), bars, period, out.data(), unstable));
+                TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(out.data(), expected.data(), outNbElement, level));
+            }
+        }
+    }
+}
+
+void test_bbands_matches_ta_bbands()
+{
+    for (float level : levels)
+    {
+        for (int period : {2, 20, 50})
+        {
+            std::vector<float> in{walk(level, 0.01f, 19)};
+            std::vector<float> upper(bars), middle(bars), lower(bars);
+            std::vector<double> expected_upper(bars), expected_middle(bars), expected_lower(bars);
+            int outBegIdx, outNbElement;
+            TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_BBANDS(0, bars - 1, in.data(), period, 2, 2, TA_MAType_SMA, &outBegIdx, &outNbElement, expected_upper.data(), expected_middle.data(), expected_lower.data()));
+            TEST_ASSERT_EQUAL(outNbElement, TA::Float::BBANDS(in.data(), bars, period, 2, 2, upper.data(), middle.data(), lower.data()));
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(upper.data(), expected_upper.data(), outNbElement, level));
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(middle.data(), expected_middle.data(), outNbElement, level));
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(lower.data(), expected_lower.data(), outNbElement, level));
+        }
+    }
+}
+
+void test_timing_against_ta_lib()
+{
+    std::vector<float> in{walk(100, 0.01f, 7)};
+    std::vector<float> a(bars), b(bars), c(bars);
+    std::vector<double> x(bars), y(bars), z(bars);
+    int outBegIdx, outNbElement;
+
+    double float_ema{Helpers::microseconds([&]()
+                                           { TA::Float::EMA(in.data(), bars, 26, a.data()); }, repeats)};
+    double talib_ema{Helpers::microseconds([&]()
+                                           { TA_S_EMA(0, bars - 1, in.data(), 26, &outBegIdx, &outNbElement, x.data()); }, repeats)};
+    double float_rsi{Helpers::microseconds([&]()
+                                           { TA::Float::RSI(in.data(), bars, 14, a.data()); }, repeats)};
+    double talib_rsi{Helpers::microseconds([&]()
+                                           { TA_S_RSI(0, bars - 1, in.data(), 14, &outBegIdx, &outNbElement, x.data()); }, repeats)};
+    double float_macd{Helpers::microseconds([&]()
+                                            { TA::Float::MACD(in.data(), bars, 12, 26, 9, a.data(), b.data(), c.data()); }, repeats)};
+    double talib_macd{Helpers::microseconds([&]()
+                                            { TA_S_MACD(0, bars - 1, in.data(), 12, 26, 9, &outBegIdx, &outNbElement, x.data(), y.data(), z.data()); }, repeats)};
+
+    char line[128];
+    snprintf(line, sizeof(line), "%d bars: Float::EMA %.2f us, TA_S_EMA %.2f us", bars, float_ema, talib_ema);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "%d bars: Float::RSI %.2f us, TA_S_RSI %.2f us", bars, float_rsi, talib_rsi);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "%d bars: Float::MACD %.2f us, TA_S_MACD %.2f us", bars, float_macd, talib_macd);
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(Helpers::slowdown_bound * talib_ema, float_ema);
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(Helpers::slowdown_bound * talib_rsi, float_rsi);
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(Helpers::slowdown_bound * talib_macd, float_macd);
+}
+
+int main(int argc, char **argv)
+{
+    TA_Initialize();
+    UNITY_BEGIN();
+    RUN_TEST(test_ema_matches_ta_ema);
+    RUN_TEST(test_rsi_matches_ta_rsi);
+    RUN_TEST(test_macd_matches_ta_macd);
+    RUN_TEST(test_sma_matches_ta_sma);
+    RUN_TEST(test_atr_matches_ta_atr);
+    RUN_TEST(test_bbands_matches_ta_bbands);
+    RUN_TEST(test_timing_against_ta_lib);
+    TA_Shutdown();
+    return UNITY_END();
+}
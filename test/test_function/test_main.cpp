@@ -0,0 +1,132 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+#include <vector>
+#include <ta_func.h>
+#include "models/ta_function.h"
+#include "../helpers.h"
+
+using namespace fakeit;
+
+// TA::Function against the same ta-lib functions called directly, and its error
+// reporting: a lookup that fails, a fractional value for an integer option and a
+// binding ta-lib rejects.
+
+namespace
+{
+    const int bars{300};
+
+    std::vector<double> closes()
+    {
+        std::vector<float> walk{Helpers::walk(bars, 100, 0.01f, 23)};
+        return std::vector<double>(walk.begin(), walk.end());
+    }
+}
+
+void setUp()
+{
+    When(OverloadedMethod(ArduinoFake(Serial), print, size_t(const char *))).AlwaysReturn(0);
+    When(OverloadedMethod(ArduinoFake(Serial), println, size_t(const char *))).AlwaysReturn(0);
+}
+
+void tearDown()
+{
+}
+
+void test_bbands_matches_ta_bbands()
+{
+    std::vector<double> in{closes()};
+    std::vector<double> upper(bars), middle(bars), lower(bars);
+    std::vector<double> expected_upper(bars), expected_middle(bars), expected_lower(bars);
+    int outBegIdx, outNbElement, expectedBegIdx, expectedNbElement;
+
+    // Integers for the real deviations too: options are set by their declared type.
+    TA::Function bbands{"BBANDS"};
+    TEST_ASSERT_TRUE(bbands.valid());
+    bbands.inputs(in.data()).options(20, 2, 2, 0).outputs(upper.data(), middle.data(), lower.data());
+    TEST_ASSERT_EQUAL(TA_SUCCESS, bbands.call(0, bars - 1, &outBegIdx, &outNbElement));
+    TEST_ASSERT_EQUAL(TA_SUCCESS, TA_BBANDS(0, bars - 1, in.data(), 20, 2, 2, TA_MAType_SMA, &expectedBegIdx, &expectedNbElement, expected_upper.data(), expected_middle.data(), expected_lower.data()));
+
+    TEST_ASSERT_EQUAL(TA_BBANDS_Lookback(20, 2, 2, TA_MAType_SMA), bbands.lookback());
+    TEST_ASSERT_EQUAL(expectedBegIdx, outBegIdx);
+    TEST_ASSERT_EQUAL(expectedNbElement, outNbElement);
+    TEST_ASSERT_EQUAL_DOUBLE_ARRAY(expected_upper.data(), upper.data(), outNbElement);
+    TEST_ASSERT_EQUAL_DOUBLE_ARRAY(expected_middle.data(), middle.data(), outNbElement);
+    TEST_ASSERT_EQUAL_DOUBLE_ARRAY(expected_lower.data(), lower.data(), outNbElement);
+}
+
+void test_macd_matches_ta_macd()
+{
+    std::vector<double> in{closes()};
+    std::vector<double> macd(bars), signal(bars), hist(bars);
+    std::vector<double> expected_macd(bars), expected_signal(bars), expected_hist(bars);
+    int outBegIdx, outNbElement, expectedBegIdx, expectedNbElement;
+
+    TA::Function function{"MACD"};
+    function.inputs(in.data()).options(12, 26, 9).outputs(macd.data(), signal.data(), hist.data());
+    TEST_ASSERT_EQUAL(TA_SUCCESS, function.call(0, bars - 1, &outBegIdx, &outNbElement));
+    TEST_ASSERT_EQUAL(TA_SUCCESS, TA_MACD(0, bars - 1, in.data(), 12, 26, 9, &expectedBegIdx, &expectedNbElement, expected_macd.data(), expected_signal.data(), expected_hist.data()));
+
+    TEST_ASSERT_EQUAL(TA_MACD_Lookback(12, 26, 9), function.lookback());
+    TEST_ASSERT_EQUAL(expectedBegIdx, outBegIdx);
+    TEST_ASSERT_EQUAL(expectedNbElement, outNbElement);
+    TEST_ASSERT_EQUAL_DOUBLE_ARRAY(expected_macd.data(), macd.data(), outNbElement);
+    TEST_ASSERT_EQUAL_DOUBLE_ARRAY(expected_signal.data(), signal.data(), outNbElement);
+    TEST_ASSERT_EQUAL_DOUBLE_ARRAY(expected_hist.data(), hist.data(), outNbElement);
+}
+
+void test_fractional_integer_option_is_rejected()
+{
+    std::vector<double> in{closes()};
+    std::vector<double> out(bars);
+    int outBegIdx, outNbElement;
+
+    TA::Function sma{"SMA"};
+    sma.inputs(in.data()).options(20.5).outputs(out.data());
+    TEST_ASSERT_EQUAL(TA_BAD_PARAM, sma.status());
+    TEST_ASSERT_EQUAL(TA_BAD_PARAM, sma.call(0, bars - 1, &outBegIdx, &outNbElement));
+
+    // 20.0 is an integer, whatever its C++ type.
+    sma.options(20.0);
+    TEST_ASSERT_EQUAL(TA_SUCCESS, sma.call(0, bars - 1, &outBegIdx, &outNbElement));
+    TEST_ASSERT_EQUAL(19, outBegIdx);
+}
+
+void test_unknown_name_is_not_valid()
+{
+    int outBegIdx, outNbElement;
+    TA::Function missing{"NOSUCHFUNC"};
+    TEST_ASSERT_FALSE(missing.valid());
+    TEST_ASSERT_NOT_EQUAL(TA_SUCCESS, missing.call(0, bars - 1, &outBegIdx, &outNbElement));
+    TEST_ASSERT_EQUAL(0, missing.lookback());
+}
+
+void test_bad_binding_is_reported_by_next_call()
+{
+    std::vector<double> in{closes()};
+    std::vector<double> out(bars);
+    int outBegIdx, outNbElement;
+
+    // SMA has one output, so output 1 doesn't exist.
+    TA::Function sma{"SMA"};
+    sma.inputs(in.data()).options(20).outputs(out.data(), out.data());
+    TEST_ASSERT_NOT_EQUAL(TA_SUCCESS, sma.status());
+    TEST_ASSERT_NOT_EQUAL(TA_SUCCESS, sma.call(0, bars - 1, &outBegIdx, &outNbElement));
+
+    // Reported once; the bindings that did succeed are still in place.
+    TEST_ASSERT_EQUAL(TA_SUCCESS, sma.status());
+    TEST_ASSERT_EQUAL(TA_SUCCESS, sma.call(0, bars - 1, &outBegIdx, &outNbElement));
+    TEST_ASSERT_EQUAL(bars - 19, outNbElement);
+}
+
+int main(int argc, char **argv)
+{
+    TA_Initialize();
+    UNITY_BEGIN();
+    RUN_TEST(test_bbands_matches_ta_bbands);
+    RUN_TEST(test_macd_matches_ta_macd);
+    RUN_TEST(test_fractional_integer_option_is_rejected);
+    RUN_TEST(test_unknown_name_is_not_valid);
+    RUN_TEST(test_bad_binding_is_reported_by_next_call);
+    TA_Shutdown();
+    return UNITY_END();
+}
\ No newline at end of file
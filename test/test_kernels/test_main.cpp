@@ -0,0 +1,212 @@
+#include <unity.h>
+#include <stdio.h>
+#include <vector>
+#include <ta_func.h>
+#include "models/kernels.h"
+#include "../helpers.h"
+
+// Kernels:: with its SIMD paths (AVX2 here, NEON on ARM hosts) against the same calls
+// with SIMD turned off, and both against ta-lib fed the same floats (TA_S_*). Sizes
+// are odd and span several rolling blocks, so the scalar tails and block restarts
+// are exercised too. Errors are relative to the price level, and the timing has to
+// stay within Helpers::slowdown_bound of ta-lib.
+
+namespace
+{
+    const int bars{5000};
+    const float level{100};
+
+    std::vector<float> walk(uint32_t seed, int count = bars)
+    {
+        return Helpers::walk(count, level, 0.01f, seed);
+    }
+
+    template <typename Expected>
+    double worst(const float *out, const Expected *expected, int count)
+    {
+        return Helpers::worst(out, expected, count, level);
+    }
+
+    // Runs call once with SIMD on and once with it off.
+    template <typename Call>
+    void both_paths(Call call, std::vector<float> &simd, std::vector<float> &scalar)
+    {
+        Kernels::set_simd(true);
+        call(simd);
+        Kernels::set_simd(false);
+        call(scalar);
+        Kernels::set_simd(true);
+    }
+
+    const int repeats{200};
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+    Kernels::set_simd(true);
+}
+
+void test_typical_prices_match_ta_typprice()
+{
+    std::vector<float> high{walk(3)}, low{walk(5)}, close{walk(7)};
+    std::vector<float> simd(bars), scalar(bars);
+    both_paths([&](std::vector<float> &out)
+               { Kernels::typical_prices(high.data(), low.data(), close.data(), bars, out.data()); },
+               simd, scalar);
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(simd.data(), scalar.data(), bars));
+
+    std::vector<double> expected(bars);
+    int outBegIdx, outNbElement;
+    TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_TYPPRICE(0, bars - 1, high.data(), low.data(), close.data(), &outBegIdx, &outNbElement, expected.data()));
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(simd.data(), expected.data(), bars));
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(scalar.data(), expected.data(), bars));
+}
+
+void test_sma_matches_ta_sma()
+{
+    std::vector<float> in{walk(11, bars - 3)};
+    const int size{bars - 3};
+    for (int period : {2, 5, 30, 200})
+    {
+        std::vector<float> simd(size), scalar(size);
+        int count{0};
+        both_paths([&](std::vector<float> &out)
+                   { count = Kernels::sma(in.data(), size, period, out.data()); },
+                   simd, scalar);
+        TEST_ASSERT_EQUAL(size - period + 1, count);
+        // The SIMD scan carries float partial sums through each block (kernels.h).
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-5, worst(simd.data(), scalar.data(), count));
+
+        std::vector<double> expected(size);
+        int outBegIdx, outNbElement;
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_SMA(0, size - 1, in.data(), period, &outBegIdx, &outNbElement, expected.data()));
+        TEST_ASSERT_EQUAL(outNbElement, count);
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-5, worst(simd.data(), expected.data(), count));
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(scalar.data(), expected.data(), count));
+    }
+}
+
+void test_ema_many_matches_ta_ema()
+{
+    // 13 series: one AVX2 row of 8 (or three NEON rows of 4) plus a scalar tail.
+    const int series{13};
+    const int size{bars / 10 + 1};
+    const int period{26};
+    std::vector<std::vector<float>> columns;
+    std::vector<float> in(size * series);
+    for (int s = 0; s < series; s++)
+    {
+        columns.push_back(walk(17 + s, size));
+        for (int t = 0; t < size; t++)
+        {
+            in[t * series + s] = columns[s][t];
+        }
+    }
+
+    std::vector<float> simd(size * series), scalar(size * series);
+    int count{0};
+    both_paths([&](std::vector<float> &out)
+               { count = Kernels::ema_many(in.data(), series, size, period, out.data()); },
+               simd, scalar);
+    TEST_ASSERT_EQUAL(size - period + 1, count);
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(simd.data(), scalar.data(), count * series));
+
+    TA_SetUnstablePeriod(TA_FUNC_UNST_EMA, 0);
+    for (int s = 0; s < series; s++)
+    {
+        std::vector<double> expected(size);
+        int outBegIdx, outNbElement;
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_EMA(0, size - 1, columns[s].data(), period, &outBegIdx, &outNbElement, expected.data()));
+        TEST_ASSERT_EQUAL(outNbElement, count);
+        std::vector<float> column(count);
+        for (int t = 0; t < count; t++)
+        {
+            column[t] = simd[t * series + s];
+        }
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(column.data(), expected.data(), count));
+    }
+}
+
+void test_rsi_many_matches_ta_rsi()
+{
+    // As for ema_many, 13 series cover the SIMD rows and a scalar tail.
+    const int series{13};
+    const int size{bars / 10 + 1};
+    const int period{14};
+    std::vector<std::vector<float>> columns;
+    std::vector<float> in(size * series);
+    for (int s = 0; s < series; s++)
+    {
+        columns.push_back(walk(31 + s, size));
+        for (int t = 0; t < size; t++)
+        {
+            in[t * series + s] = columns[s][t];
+        }
+    }
+
+    std::vector<float> simd(size * series), scalar(size * series);
+    int count{0};
+    both_paths([&](std::vector<float> &out)
+               { count = Kernels::rsi_many(in.data(), series, size, period, out.data()); },
+               simd, scalar);
+    TEST_ASSERT_EQUAL(size - period, count);
+    // RSI is on a 0-100 scale, so these are relative to 100 like the prices.
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(simd.data(), scalar.data(), count * series));
+
+    TA_SetUnstablePeriod(TA_FUNC_UNST_RSI, 0);
+    for (int s = 0; s < series; s++)
+    {
+        std::vector<double> expected(size);
+        int outBegIdx, outNbElement;
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_RSI(0, size - 1, columns[s].data(), period, &outBegIdx, &outNbElement, expected.data()));
+        TEST_ASSERT_EQUAL(outNbElement, count);
+        std::vector<float> column(count);
+        for (int t = 0; t < count; t++)
+        {
+            column[t] = simd[t * series + s];
+        }
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(column.data(), expected.data(), count));
+    }
+}
+
+void test_timing_against_ta_lib()
+{
+    std::vector<float> in{walk(11)};
+    std::vector<float> out(bars);
+    std::vector<double> x(bars);
+    int outBegIdx, outNbElement;
+
+    Kernels::set_simd(true);
+    double simd_sma{Helpers::microseconds([&]()
+                                          { Kernels::sma(in.data(), bars, 30, out.data()); }, repeats)};
+    Kernels::set_simd(false);
+    double scalar_sma{Helpers::microseconds([&]()
+                                            { Kernels::sma(in.data(), bars, 30, out.data()); }, repeats)};
+    Kernels::set_simd(true);
+    double talib_sma{Helpers::microseconds([&]()
+                                           { TA_S_SMA(0, bars - 1, in.data(), 30, &outBegIdx, &outNbElement, x.data()); }, repeats)};
+
+    char line[128];
+    snprintf(line, sizeof(line), "%d bars: sma(30) SIMD %.1f us (avx2 %s), scalar %.1f us, TA_S_SMA %.1f us",
+             bars, simd_sma, Kernels::has_avx2() ? "yes" : "no", scalar_sma, talib_sma);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(Helpers::slowdown_bound * talib_sma, simd_sma);
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(Helpers::slowdown_bound * talib_sma, scalar_sma);
+}
+
+int main(int argc, char **argv)
+{
+    TA_Initialize();
+    UNITY_BEGIN();
+    RUN_TEST(test_typical_prices_match_ta_typprice);
+    RUN_TEST(test_sma_matches_ta_sma);
+    RUN_TEST(test_ema_many_matches_ta_ema);
+    RUN_TEST(test_rsi_many_matches_ta_rsi);
+    RUN_TEST(test_timing_against_ta_lib);
+    TA_Shutdown();
+    return UNITY_END();
+}
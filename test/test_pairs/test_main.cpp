@@ -0,0 +1,153 @@
+#include <unity.h>
+#include <math.h>
+#include <vector>
+#include <ta_func.h>
+#include "models/pairs.h"
+#include "../helpers.h"
+
+// Pairs::matrix against TA_CORREL and TA_BETA over windows covering every step, for
+// every pair of symbols. There are enough symbols for several tiles a side, so pairs
+// within a tile, across tiles and in the ragged last tile are all covered, and one
+// symbol's price never moves.
+
+namespace
+{
+    const int symbols{150};
+    const int steps{300};
+    const int flat{70};
+
+    std::vector<std::vector<float>> prices()
+    {
+        std::vector<std::vector<float>> series;
+        for (int s = 0; s < symbols; s++)
+        {
+            series.push_back(Helpers::walk(steps, 20 + s, 0.02f, 100 + s));
+        }
+        series[flat].assign(steps, 42);
+        return series;
+    }
+
+    std::vector<float> column(const Batch::Matrix &matrix, int symbol)
+    {
+        std::vector<float> values;
+        for (int t = 0; t < matrix.steps; t++)
+        {
+            values.push_back(matrix.at(t, symbol));
+        }
+        return values;
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_returns_are_per_step_changes()
+{
+    std::vector<std::vector<float>> series{prices()};
+    Batch::Matrix returns;
+    Pairs::returns(Batch::interleave(series), returns);
+    TEST_ASSERT_EQUAL(symbols, returns.symbols);
+    TEST_ASSERT_EQUAL(steps - 1, returns.steps);
+    for (int s = 0; s < symbols; s++)
+    {
+        for (int t = 0; t < returns.steps; t++)
+        {
+            TEST_ASSERT_TRUE((series[s][t + 1] - series[s][t]) / series[s][t] == returns.at(t, s));
+        }
+    }
+}
+
+void test_matrix_matches_ta_correl_and_ta_beta()
+{
+    std::vector<std::vector<float>> series{prices()};
+    Batch::Matrix returns;
+    Pairs::returns(Batch::interleave(series), returns);
+    Pairs::Matrix out;
+    TEST_ASSERT_TRUE(Pairs::matrix(returns, out));
+    TEST_ASSERT_EQUAL(symbols, out.symbols);
+
+    const int period{returns.steps};
+    std::vector<std::vector<float>> columns;
+    for (int s = 0; s < symbols; s++)
+    {
+        columns.push_back(column(returns, s));
+    }
+
+    double correlation_error{0};
+    double beta_error{0};
+    for (int i = 0; i < symbols; i++)
+    {
+        for (int j = 0; j < symbols; j++)
+        {
+            double correlation, beta;
+            int outBegIdx, outNbElement;
+            TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_CORREL(0, period - 1, columns[i].data(), columns[j].data(), period, &outBegIdx, &outNbElement, &correlation));
+            TEST_ASSERT_EQUAL(1, outNbElement);
+            // TA_BETA takes prices and works out the same returns itself.
+            TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_BETA(0, steps - 1, series[i].data(), series[j].data(), period, &outBegIdx, &outNbElement, &beta));
+            TEST_ASSERT_EQUAL(1, outNbElement);
+
+            if (i == flat || j == flat)
+            {
+                TEST_ASSERT_EQUAL(0, correlation);
+                TEST_ASSERT_EQUAL(0, out.correlation(i, j));
+            }
+            if (i == flat)
+            {
+                TEST_ASSERT_EQUAL(0, beta);
+                TEST_ASSERT_EQUAL(0, out.beta(i, j));
+            }
+            correlation_error = fmax(correlation_error, fabs(out.correlation(i, j) - correlation));
+            beta_error = fmax(beta_error, fabs(out.beta(i, j) - beta) / fmax(1, fabs(beta)));
+        }
+    }
+
+    // Correlations lie in [-1, 1]; betas are compared relative to their size above 1.
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-5, correlation_error);
+    TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-5, beta_error);
+}
+
+void test_thread_counts_give_identical_matrices()
+{
+    std::vector<std::vector<float>> series{prices()};
+    Batch::Matrix returns;
+    Pairs::returns(Batch::interleave(series), returns);
+
+    Pairs::Matrix one;
+    TEST_ASSERT_TRUE(Pairs::matrix(returns, one, 1));
+    for (int threads : {2, 4, 0})
+    {
+        Pairs::Matrix many;
+        TEST_ASSERT_TRUE(Pairs::matrix(returns, many, threads));
+        TEST_ASSERT_EQUAL_MEMORY(one.correlations.data(), many.correlations.data(), one.correlations.size() * sizeof(float));
+        TEST_ASSERT_EQUAL_MEMORY(one.betas.data(), many.betas.data(), one.betas.size() * sizeof(float));
+    }
+}
+
+void test_single_step_is_rejected()
+{
+    Batch::Matrix returns;
+    Pairs::returns(Batch::interleave({{100, 101}, {50, 49}}), returns);
+    TEST_ASSERT_EQUAL(1, returns.steps);
+    Pairs::Matrix out;
+    TEST_ASSERT_FALSE(Pairs::matrix(returns, out));
+    TEST_ASSERT_EQUAL(2, out.symbols);
+    TEST_ASSERT_EQUAL(0, out.correlation(0, 1));
+}
+
+int main(int argc, char **argv)
+{
+    TA_Initialize();
+    UNITY_BEGIN();
+    RUN_TEST(test_returns_are_per_step_changes);
+    RUN_TEST(test_matrix_matches_ta_correl_and_ta_beta);
+    RUN_TEST(test_thread_counts_give_identical_matrices);
+    RUN_TEST(test_single_step_is_rejected);
+    TA_Shutdown();
+    return UNITY_END();
+}
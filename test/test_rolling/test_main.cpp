@@ -0,0 +1,131 @@
+#include <unity.h>
+#include <vector>
+#include <ta_func.h>
+#include "models/rolling.h"
+#include "../helpers.h"
+
+// Rolling:: against ta-lib's double kernels fed the same floats (TA_S_*). The runs are
+// many times Rolling::rebuild_windows windows long, so every output after the first
+// few windows comes through remove(), Series' shift() and the periodic rebuilds. The
+// walks drift, so the values also move far from the origin they started at.
+
+namespace
+{
+    using Helpers::worst;
+
+    const int bars{2000};
+    const int periods[]{2, 14, 30};
+
+    std::vector<float> walk(float level, float step, float drift, uint32_t seed)
+    {
+        return Helpers::walk(bars, level, step, seed, drift);
+    }
+
+    double mean(const double *values, int count)
+    {
+        double sum{0};
+        for (int i = 0; i < count; i++)
+        {
+            sum += values[i];
+        }
+        return sum / count;
+    }
+
+    const float levels[]{100, 30000};
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_variance_matches_ta_var()
+{
+    for (float level : levels)
+    {
+        for (int period : periods)
+        {
+            std::vector<float> in{walk(level, 0.01f, 0.001f, 3)};
+            std::vector<float> out(bars), streamed(bars);
+            std::vector<double> expected(bars);
+            int outBegIdx, outNbElement;
+            TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_VAR(0, bars - 1, in.data(), period, 1, &outBegIdx, &outNbElement, expected.data()));
+            TEST_ASSERT_EQUAL(outNbElement, Rolling::variance(in.data(), bars, period, out.data()));
+
+            Rolling::Series series(period);
+            int count{0};
+            for (float value : in)
+            {
+                if (series.update(value))
+                {
+                    streamed[count++] = series.variance();
+                }
+            }
+            TEST_ASSERT_EQUAL(outNbElement, count);
+
+            // Relative to the typical variance: the price level grows along the walk.
+            double scale{mean(expected.data(), outNbElement)};
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-4, worst(out.data(), expected.data(), outNbElement, scale));
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-4, worst(streamed.data(), expected.data(), outNbElement, scale));
+        }
+    }
+}
+
+void test_slope_matches_ta_linearreg_slope()
+{
+    for (float level : levels)
+    {
+        for (int period : periods)
+        {
+            std::vector<float> in{walk(level, 0.01f, 0.001f, 5)};
+            std::vector<float> out(bars);
+            std::vector<double> expected(bars);
+            int outBegIdx, outNbElement;
+            TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_LINEARREG_SLOPE(0, bars - 1, in.data(), period, &outBegIdx, &outNbElement, expected.data()));
+            TEST_ASSERT_EQUAL(outNbElement, Rolling::slope(in.data(), bars, period, out.data()));
+
+            // Relative to the walk's typical step, the size of a slope.
+            double scale{0.01 * mean(std::vector<double>(in.begin(), in.end()).data(), bars)};
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-4, worst(out.data(), expected.data(), outNbElement, scale));
+        }
+    }
+}
+
+void test_correlation_matches_ta_correl()
+{
+    // Not 2: two bars that barely move make TA_CORREL's variance product fall under its
+    // absolute 1e-8 threshold and return 0 where Rolling returns +-1.
+    for (float level : levels)
+    {
+        for (int period : {5, 14, 30})
+        {
+            std::vector<float> x{walk(level, 0.01f, 0.001f, 7)};
+            std::vector<float> y{walk(level, 0.01f, -0.001f, 11)};
+            for (int i = 0; i < bars; i++)
+            {
+                y[i] += 0.5f * x[i];
+            }
+            std::vector<float> out(bars);
+            std::vector<double> expected(bars);
+            int outBegIdx, outNbElement;
+            TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_CORREL(0, bars - 1, x.data(), y.data(), period, &outBegIdx, &outNbElement, expected.data()));
+            TEST_ASSERT_EQUAL(outNbElement, Rolling::correlation(x.data(), y.data(), bars, period, out.data()));
+            // Correlations are within [-1, 1] whatever the price.
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(5e-4, worst(out.data(), expected.data(), outNbElement, 1));
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    TA_Initialize();
+    UNITY_BEGIN();
+    RUN_TEST(test_variance_matches_ta_var);
+    RUN_TEST(test_slope_matches_ta_linearreg_slope);
+    RUN_TEST(test_correlation_matches_ta_correl);
+    TA_Shutdown();
+    return UNITY_END();
+}
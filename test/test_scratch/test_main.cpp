@@ -0,0 +1,160 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+#include <math.h>
+#include <stdlib.h>
+#include <new>
+#include <vector>
+#include "models/ta.h"
+
+using namespace fakeit;
+
+// Heap high-water test for the TA wrappers: once warmed up, a decision cycle must not
+// touch the heap, and the scratch arena must hold a full-length MACD.
+
+namespace
+{
+    size_t heap_calls{0};
+
+    void *counted_malloc(size_t size, void *)
+    {
+        heap_calls++;
+        return malloc(size);
+    }
+
+    void *counted_realloc(void *ptr, size_t size, void *)
+    {
+        heap_calls++;
+        return realloc(ptr, size);
+    }
+
+    void counted_free(void *ptr, void *)
+    {
+        free(ptr);
+    }
+
+    std::vector<float> prices(int count)
+    {
+        std::vector<float> out;
+        float price{100};
+        for (int i = 0; i < count; i++)
+        {
+            price += sinf(i * 0.37f) + 0.2f * cosf(i * 1.3f);
+            out.push_back(price);
+        }
+        return out;
+    }
+
+    struct Outputs
+    {
+        std::vector<float> rsi;
+        std::vector<float> rsi_ema;
+        std::vector<float> macd;
+        std::vector<float> signal;
+        std::vector<float> hist;
+
+        void clear()
+        {
+            rsi.clear();
+            rsi_ema.clear();
+            macd.clear();
+            signal.clear();
+            hist.clear();
+        }
+    };
+
+    // What one decision asks of the wrappers, the arena reset after it as loop() does.
+    void cycle(const std::vector<float> &in, Outputs &out)
+    {
+        out.clear();
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA::RSI(in, 14, out.rsi));
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA::EMA(out.rsi, 14, out.rsi_ema));
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA::MACD(in, 12, 26, 9, out.macd, out.signal, out.hist));
+        TA::Scratch::reset();
+    }
+}
+
+// Counts C++ allocations too, so output vectors that regrow show up.
+void *operator new(size_t size)
+{
+    heap_calls++;
+    void *ptr{malloc(size)};
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+    TA::Scratch::reset();
+}
+
+void test_arena_holds_macd_at_max_bars()
+{
+    std::vector<float> in{prices(TA_MAX_BARS)};
+    Outputs out;
+    cycle(in, out);
+    TEST_ASSERT_TRUE(TA::Scratch::high_water() <= TA_SCRATCH_DOUBLES);
+    TEST_ASSERT_EQUAL(3 * TA_MAX_BARS, TA::Scratch::high_water());
+    TEST_ASSERT_EQUAL(0, TA::Scratch::mark());
+}
+
+void test_cycles_leave_heap_alone_after_warm_up()
+{
+    std::vector<float> in{prices(TA_MAX_BARS)};
+    Outputs out;
+    cycle(in, out);
+    const size_t peak{TA::Scratch::high_water()};
+
+    TA_SetAllocator(counted_malloc, counted_realloc, counted_free, nullptr);
+    heap_calls = 0;
+    for (int i = 0; i < 200; i++)
+    {
+        cycle(in, out);
+    }
+    const size_t calls{heap_calls};
+    TA_SetAllocator(nullptr, nullptr, nullptr, nullptr);
+
+    TEST_ASSERT_EQUAL(0, calls);
+    TEST_ASSERT_EQUAL(peak, TA::Scratch::high_water());
+    TEST_ASSERT_EQUAL(0, TA::Scratch::mark());
+}
+
+void test_series_past_the_arena_fail_cleanly()
+{
+    When(OverloadedMethod(ArduinoFake(Serial), println, size_t(const char *))).AlwaysReturn(0);
+    std::vector<float> in{prices(2 * TA_MAX_BARS)};
+    Outputs out;
+    TEST_ASSERT_EQUAL(TA_ALLOC_ERR, TA::MACD(in, 12, 26, 9, out.macd, out.signal, out.hist));
+    TEST_ASSERT_EQUAL(0, out.macd.size());
+    TEST_ASSERT_EQUAL(0, TA::Scratch::mark());
+
+    // Only the tail is staged, so a tail-only request over the same series fits.
+    TEST_ASSERT_EQUAL(TA_SUCCESS, TA::MACD(in, 12, 26, 9, out.macd, out.signal, out.hist, 13));
+    TEST_ASSERT_EQUAL(13, out.macd.size());
+}
+
+int main(int argc, char **argv)
+{
+    TA::init();
+    UNITY_BEGIN();
+    RUN_TEST(test_arena_holds_macd_at_max_bars);
+    RUN_TEST(test_cycles_leave_heap_alone_after_warm_up);
+    RUN_TEST(test_series_past_the_arena_fail_cleanly);
+    return UNITY_END();
+}
@@ -0,0 +1,193 @@
+#include <unity.h>
+#include <math.h>
+#include <vector>
+#include <ta_func.h>
+#include "models/sweep.h"
+#include "../helpers.h"
+
+// Sweep:: against ta-lib's double kernels fed the same floats (TA_S_*), one call per
+// parameter set. With an unstable period ta-lib leaves out its first values, so each
+// set's column is compared from ta-lib's outBegIdx; the bars before the set's lookback
+// must be NaN.
+
+namespace
+{
+    using Helpers::worst;
+
+    const int bars{400};
+    const std::vector<int> periods{2, 5, 9, 14, 26, 50, 100};
+    const int unstable_periods[]{0, 24};
+
+    std::vector<float> walk(float level, uint32_t seed)
+    {
+        return Helpers::walk(bars, level, 0.01f, seed);
+    }
+
+    // set's values from bar begin on.
+    std::vector<float> column(const Sweep::Matrix &matrix, int set, int begin)
+    {
+        std::vector<float> values;
+        for (int t = begin; t < matrix.size; t++)
+        {
+            values.push_back(matrix.at(set, t));
+        }
+        return values;
+    }
+
+    // No value before lookback, and one on it.
+    void assert_starts_at(const Sweep::Matrix &matrix, int set, int lookback)
+    {
+        for (int t = 0; t < lookback; t++)
+        {
+            TEST_ASSERT_TRUE(isnan(matrix.at(set, t)));
+        }
+        TEST_ASSERT_FALSE(isnan(matrix.at(set, lookback)));
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+    TA_SetUnstablePeriod(TA_FUNC_UNST_ALL, 0);
+}
+
+void test_ema_matches_ta_ema()
+{
+    std::vector<float> in{walk(100, 7)};
+    Sweep::Matrix out;
+    TEST_ASSERT_TRUE(Sweep::EMA(in.data(), bars, periods, out));
+    TEST_ASSERT_EQUAL(static_cast<int>(periods.size()), out.sets);
+    TEST_ASSERT_EQUAL(bars, out.size);
+
+    for (int unstable : unstable_periods)
+    {
+        TA_SetUnstablePeriod(TA_FUNC_UNST_EMA, unstable);
+        for (int p = 0; p < out.sets; p++)
+        {
+            std::vector<double> expected(bars);
+            int outBegIdx, outNbElement;
+            TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_EMA(0, bars - 1, in.data(), periods[p], &outBegIdx, &outNbElement, expected.data()));
+            TEST_ASSERT_EQUAL(periods[p] - 1 + unstable, outBegIdx);
+            assert_starts_at(out, p, periods[p] - 1);
+            std::vector<float> values{column(out, p, outBegIdx)};
+            TEST_ASSERT_EQUAL(outNbElement, static_cast<int>(values.size()));
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(values.data(), expected.data(), outNbElement, 100));
+        }
+    }
+}
+
+void test_rsi_matches_ta_rsi()
+{
+    std::vector<float> in{walk(100, 11)};
+    Sweep::Matrix out;
+    TEST_ASSERT_TRUE(Sweep::RSI(in.data(), bars, periods, out));
+
+    for (int unstable : unstable_periods)
+    {
+        TA_SetUnstablePeriod(TA_FUNC_UNST_RSI, unstable);
+        for (int p = 0; p < out.sets; p++)
+        {
+            std::vector<double> expected(bars);
+            int outBegIdx, outNbElement;
+            TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_RSI(0, bars - 1, in.data(), periods[p], &outBegIdx, &outNbElement, expected.data()));
+            TEST_ASSERT_EQUAL(periods[p] + unstable, outBegIdx);
+            assert_starts_at(out, p, periods[p]);
+            std::vector<float> values{column(out, p, outBegIdx)};
+            TEST_ASSERT_EQUAL(outNbElement, static_cast<int>(values.size()));
+            // RSI is on a 0-100 scale whatever the price.
+            TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(values.data(), expected.data(), outNbElement, 100));
+        }
+    }
+}
+
+void test_macd_matches_ta_macd()
+{
+    std::vector<float> in{walk(100, 13)};
+    const std::vector<int> fastPeriods{5, 12, 26};
+    const std::vector<int> slowPeriods{12, 26, 50};
+    const int signalPeriod{9};
+    std::vector<std::pair<int, int>> pairs;
+    Sweep::Matrix macd, signal, hist;
+    TEST_ASSERT_TRUE(Sweep::MACD(in.data(), bars, fastPeriods, slowPeriods, signalPeriod, pairs, macd, signal, hist));
+
+    // fast < slow only: 5 with all three, 12 with 26 and 50, 26 with 50.
+    TEST_ASSERT_EQUAL(6, static_cast<int>(pairs.size()));
+    TEST_ASSERT_EQUAL(6, macd.sets);
+    for (int i = 0; i < macd.sets; i++)
+    {
+        TEST_ASSERT_TRUE(pairs[i].first < pairs[i].second);
+        std::vector<double> expected_macd(bars), expected_signal(bars), expected_hist(bars);
+        int outBegIdx, outNbElement;
+        TEST_ASSERT_EQUAL(TA_SUCCESS, TA_S_MACD(0, bars - 1, in.data(), pairs[i].first, pairs[i].second, signalPeriod, &outBegIdx, &outNbElement, expected_macd.data(), expected_signal.data(), expected_hist.data()));
+        assert_starts_at(macd, i, outBegIdx);
+        assert_starts_at(signal, i, outBegIdx);
+        assert_starts_at(hist, i, outBegIdx);
+        std::vector<float> macd_values{column(macd, i, outBegIdx)};
+        std::vector<float> signal_values{column(signal, i, outBegIdx)};
+        std::vector<float> hist_values{column(hist, i, outBegIdx)};
+        TEST_ASSERT_EQUAL(outNbElement, static_cast<int>(macd_values.size()));
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(macd_values.data(), expected_macd.data(), outNbElement, 100));
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(signal_values.data(), expected_signal.data(), outNbElement, 100));
+        TEST_ASSERT_LESS_OR_EQUAL_DOUBLE(1e-6, worst(hist_values.data(), expected_hist.data(), outNbElement, 100));
+    }
+}
+
+void test_short_prices_leave_columns_empty()
+{
+    // Fewer bars than the longest period: that set never gets a value.
+    std::vector<float> in{walk(100, 17)};
+    Sweep::Matrix out;
+    TEST_ASSERT_TRUE(Sweep::EMA(in.data(), 60, periods, out));
+    TEST_ASSERT_EQUAL(60, out.size);
+    TEST_ASSERT_FALSE(isnan(out.at(5, 59)));
+    TEST_ASSERT_TRUE(isnan(out.at(6, 59)));
+
+    TEST_ASSERT_TRUE(Sweep::RSI(in.data(), 1, periods, out));
+    TEST_ASSERT_EQUAL(1, out.size);
+    TEST_ASSERT_TRUE(isnan(out.at(0, 0)));
+}
+
+void test_out_of_range_periods_are_rejected()
+{
+    std::vector<float> in{walk(100, 19)};
+    Sweep::Matrix out, macd, signal, hist;
+    std::vector<std::pair<int, int>> pairs;
+
+    for (int period : {1, 0, -3, 100001})
+    {
+        std::vector<int> bad{periods};
+        bad.push_back(period);
+        TEST_ASSERT_FALSE(Sweep::EMA(in.data(), bars, bad, out));
+        TEST_ASSERT_EQUAL(0, out.sets);
+        TEST_ASSERT_EQUAL(0, static_cast<int>(out.values.size()));
+        TEST_ASSERT_FALSE(Sweep::RSI(in.data(), bars, bad, out));
+        TEST_ASSERT_EQUAL(0, static_cast<int>(out.values.size()));
+        TEST_ASSERT_FALSE(Sweep::MACD(in.data(), bars, bad, {26}, 9, pairs, macd, signal, hist));
+        TEST_ASSERT_FALSE(Sweep::MACD(in.data(), bars, {12}, bad, 9, pairs, macd, signal, hist));
+        TEST_ASSERT_EQUAL(0, static_cast<int>(pairs.size()));
+        TEST_ASSERT_EQUAL(0, static_cast<int>(macd.values.size()));
+    }
+
+    // The signal period may be 1, as in TA_MACD, but not 0 or above 100000.
+    TEST_ASSERT_TRUE(Sweep::MACD(in.data(), bars, {12}, {26}, 1, pairs, macd, signal, hist));
+    TEST_ASSERT_FALSE(Sweep::MACD(in.data(), bars, {12}, {26}, 0, pairs, macd, signal, hist));
+    TEST_ASSERT_FALSE(Sweep::MACD(in.data(), bars, {12}, {26}, 100001, pairs, macd, signal, hist));
+    TEST_ASSERT_EQUAL(0, static_cast<int>(signal.values.size()));
+    TEST_ASSERT_EQUAL(0, static_cast<int>(hist.values.size()));
+}
+
+int main(int argc, char **argv)
+{
+    TA_Initialize();
+    UNITY_BEGIN();
+    RUN_TEST(test_ema_matches_ta_ema);
+    RUN_TEST(test_rsi_matches_ta_rsi);
+    RUN_TEST(test_macd_matches_ta_macd);
+    RUN_TEST(test_short_prices_leave_columns_empty);
+    RUN_TEST(test_out_of_range_periods_are_rejected);
+    TA_Shutdown();
+    return UNITY_END();
+}